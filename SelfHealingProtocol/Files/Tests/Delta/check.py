@@ -0,0 +1,75 @@
+"""
+Check that a delta schedule applied over its baseline gives the same binary schedule as the full output.
+The patched schedule of the link failure is the baseline of the delta of the optimized schedule, and the optimize
+uses the local search so the check does not need the solver.
+
+Usage: check.py <server_executable>
+"""
+
+import os
+import sys
+import tempfile
+from struct import Struct
+from subprocess import run
+from typing import Dict, Tuple
+
+BINARY_HEADER = Struct('=4s3i4q4i')    # magic, version, kind, sections, hyperperiod, slot, protocol, sizes
+BINARY_LINK = Struct('=2iq')           # link id, number of frames, execution time
+BINARY_OFFSET = Struct('=6i')          # frame id, link id, instances, replicas, time slots to transmit
+BINARY_TIME = Struct('=q')             # transmission time
+
+
+def read_schedule(schedule_file: str) -> Tuple[tuple, Dict[Tuple[int, int], tuple]]:
+    """
+    Read a binary patched or optimized schedule, without the execution times that change in every execution
+    :param schedule_file: name of the binary schedule file
+    :return: header without the number of links, and the offsets with their transmission times by link and frame
+    """
+    with open(schedule_file, 'rb') as file:
+        schedule = file.read()
+    header = BINARY_HEADER.unpack_from(schedule, 0)
+    position = BINARY_HEADER.size
+    offsets = {}
+    for _ in range(header[3]):
+        link_id, num_frames, _ = BINARY_LINK.unpack_from(schedule, position)
+        position += BINARY_LINK.size
+        for _ in range(num_frames):
+            frame_id, _, num_instances, num_replicas, time, _ = BINARY_OFFSET.unpack_from(schedule, position)
+            position += BINARY_OFFSET.size
+            times = [BINARY_TIME.unpack_from(schedule, position + BINARY_TIME.size * i)[0]
+                     for i in range(num_instances * num_replicas)]
+            position += BINARY_TIME.size * num_instances * num_replicas
+            offsets[(link_id, frame_id)] = (num_instances, num_replicas, time, times)
+    if position != len(schedule):
+        raise ValueError('The binary schedule ' + schedule_file + ' has data after its last link')
+    return header[:3] + header[4:], offsets
+
+
+if __name__ == "__main__":
+
+    directory = os.path.dirname(os.path.abspath(__file__))
+    server = sys.argv[1] if len(sys.argv) > 1 else 'Server'
+    with tempfile.TemporaryDirectory() as outputs:
+        baseline_file = os.path.join(outputs, 'Patched.bin')
+        full_file = os.path.join(outputs, 'Optimized.bin')
+        delta_file = os.path.join(outputs, 'Delta.bin')
+        applied_file = os.path.join(outputs, 'Applied.bin')
+        execution_file = os.path.join(outputs, 'Execution.xml')
+        patch_file = os.path.join(directory, 'Patch.xml')
+        optimize_file = os.path.join(directory, 'Optimize.xml')
+        requests = [['Patch', patch_file, baseline_file, execution_file, '-', '-', 'Binary'],
+                    ['Optimize', optimize_file, full_file, execution_file, 'LocalSearch', 'Binary'],
+                    ['Optimize', optimize_file, delta_file, execution_file, 'LocalSearch', 'Delta', '-', '-',
+                     baseline_file],
+                    ['Apply', baseline_file, delta_file, applied_file],
+                    ['Quit']]
+        answers = run([server], input=''.join('\t'.join(request) + '\n' for request in requests),
+                      capture_output=True, text=True).stdout.split()
+        if answers != ['OK'] * len(requests):
+            print('The server answered ' + ' '.join(answers))
+            sys.exit(1)
+        if read_schedule(applied_file) != read_schedule(full_file):
+            print('The delta applied over its baseline is not the optimized schedule')
+            sys.exit(1)
+        print('The delta applied over its baseline is the optimized schedule, ' + str(os.path.getsize(delta_file)) +
+              ' bytes instead of ' + str(os.path.getsize(full_file)))
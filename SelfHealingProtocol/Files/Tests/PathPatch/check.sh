@@ -0,0 +1,28 @@
+#!/bin/sh
+#
+# Check that the failure of the link 0 of the network is only patched when all the links of the path that replaces
+# it are patched at once, as its frames do not fit in the part of the range that every link gets one by one.
+# The failures are only reported as patched if the validator accepts the schedule with the path that replaces the
+# failed link, so the path patch also has to keep the distance between the links of the path.
+#
+# Usage: check.sh <failures_executable>
+#
+
+DIR=$(dirname "$0")
+FAILURES=${1:-Failures}
+REPORT=$(mktemp)
+
+status() {
+    "$FAILURES" "$DIR/Network.xml" "$DIR/$1" "$REPORT" > /dev/null 2>&1
+    awk -F, '$1 == 0 { print $2 }' "$REPORT"
+}
+
+LINK_STATUS=$(status LinkPatch.xml)
+PATH_STATUS=$(status PathPatch.xml)
+rm -f "$REPORT"
+
+if [ "$LINK_STATUS" != "NotPatched" ] || [ "$PATH_STATUS" != "Patched" ]; then
+    echo "The link 0 is $LINK_STATUS with the link patch and $PATH_STATUS with the path patch"
+    exit 1
+fi
+echo "The link 0 is only patched with the path patch, and the validator accepts it"
@@ -23,6 +23,8 @@ from xml.dom import minidom
 import networkx
 from enum import Enum
 from typing import NamedTuple, List, Tuple, Dict
+from struct import Struct
+from mmap import mmap, ACCESS_READ
 from Node import Node
 from Link import Link
 from Frame import Frame, Offset
@@ -185,6 +187,19 @@ class Network:
         starting_time: int  # Starting time or offset to start after the period in nanoseconds
         end_to_end: int  # Maximum time in nanoseconds from the transmission to the reception of the frame
 
+    # Constants #
+
+    # Records of the binary schedule files written by the scheduler (see Binary_Header in Network.h), in machine order
+    BINARY_MAGIC = b'SHPB'
+    BINARY_VERSION = 1
+    BINARY_HEADER = Struct('=4s3i4q4i')    # magic, version, kind, sections, hyperperiod, slot, protocol, sizes, delta
+    BINARY_FRAME = Struct('=2i4q2i')       # frame id, size, period, deadline, starting, end to end, paths
+    BINARY_PATH = Struct('=2i')            # path number, number of links
+    BINARY_LINK = Struct('=2iq')           # link id, number of frames, execution time
+    BINARY_OFFSET = Struct('=6i')          # frame id, link id, instances, replicas, time slots to transmit
+    BINARY_DELTA = Struct('=6i')           # frame id, link id, instances, replicas, time slots, number of changes
+    BINARY_CHANGE = Struct('=2iq')         # position of the transmission, padding, new transmission time
+
     # Init #
 
     def __init__(self):
@@ -1329,6 +1344,67 @@ class Network:
                             self.__link_utilization[link_id] += time_transmission / self.__hyper_period
                             self.__utilization += time_transmission / self.__hyper_period / self.__num_links
 
+    def read_schedule_binary(self, schedule_file: str) -> None:
+        """
+        Read the schedule from a binary file and save the transmission times, as read_schedule_xml does
+        :param schedule_file: name and path of the binary schedule file
+        :return: nothing
+        """
+        with open(schedule_file, 'rb') as file, mmap(file.fileno(), 0, access=ACCESS_READ) as schedule:
+            magic, version, kind, num_frames, hyper_period, time_slot_size, _, _, num_links, num_nodes, _, _ = \
+                self.BINARY_HEADER.unpack_from(schedule, 0)
+            if magic != self.BINARY_MAGIC or version != self.BINARY_VERSION or kind != 1:
+                raise ValueError('The file is not a binary schedule of a supported version')
+            position = self.BINARY_HEADER.size
+
+            # General information of the schedule
+            self.num_nodes = num_nodes
+            self.num_links = num_links
+            self.time_slot_size = time_slot_size
+            self.hyper_period = hyper_period * self.time_slot_size
+
+            # Read all frames in the schedule
+            self.__num_frames = num_frames
+            for _ in range(num_frames):
+                frame_id, _, _, _, _, _, num_paths, _ = self.BINARY_FRAME.unpack_from(schedule, position)
+                position += self.BINARY_FRAME.size
+                added_links = []    # Auxiliary added links to not double add link utilization
+
+                # Read all the paths of the frame to check the transmissions of the each link
+                for _ in range(num_paths):
+                    _, num_path_links = self.BINARY_PATH.unpack_from(schedule, position)
+                    position += self.BINARY_PATH.size
+                    for _ in range(num_path_links):
+                        _, link_id, num_instances, num_replicas, time = self.BINARY_OFFSET.unpack_from(schedule,
+                                                                                                       position)[:5]
+                        position += self.BINARY_OFFSET.size
+                        transmissions = Struct('=%dq' % (num_instances * num_replicas)).unpack_from(schedule,
+                                                                                                    position)
+                        position += 8 * num_instances * num_replicas
+
+                        # Check if the utilization should be taken into account
+                        add_ut = False
+                        if link_id not in added_links:
+                            added_links.append(link_id)
+                            add_ut = True
+                        if link_id not in self.__link_utilization.keys():
+                            self.__link_utilization[link_id] = 0.0
+
+                        # Read all instances, the replicas are not used yet
+                        self.frames[frame_id].prepare_link_offset(link_id, num_instances, 0)
+                        for instance_it in range(num_instances):
+                            transmission = transmissions[instance_it * num_replicas]
+                            start_time = transmission * self.time_slot_size
+                            self.frames[frame_id].set_offset_transmission_time(link_id, instance_it, 0, start_time)
+                            end_time = (transmission + time - 1) * self.time_slot_size
+                            self.frames[frame_id].set_offset_ending_time(link_id, instance_it, 0, end_time)
+
+                            # Add the transmission to the utilization
+                            if add_ut:
+                                time_transmission = float(end_time - start_time + self.__time_slot_size)
+                                self.__link_utilization[link_id] += time_transmission / self.__hyper_period
+                                self.__utilization += time_transmission / self.__hyper_period / self.__num_links
+
     # Output Functions #
 
     def write_network_xml(self, network_filename: str) -> None:
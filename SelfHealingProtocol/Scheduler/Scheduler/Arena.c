@@ -0,0 +1,126 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Arena.c                                                                                                            *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Arena.h                                                                                             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Arena.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Round the size to the alignment of the arena
+
+ @param size size in bytes
+ @return size aligned
+ */
+size_t align_arena(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+                                                    /* FUNCTIONS */
+
+/* Getters */
+
+/**
+ Get the total number of bytes given by the arena
+ */
+size_t get_arena_size(Arena *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given arena pointer is NULL\n");
+        return 0;
+    }
+    
+    return pt->total_size;
+}
+
+/* Functions */
+
+/**
+ Init the arena with the given size of chunks
+ */
+int init_arena(Arena *pt, size_t chunk_size) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given arena pointer is NULL\n");
+        return -1;
+    }
+    
+    pt->chunk = NULL;
+    pt->chunk_size = chunk_size;
+    pt->total_size = 0;
+    return 0;
+}
+
+/**
+ Get a piece of memory from the arena, it is only released when the whole arena is released
+ */
+void* alloc_arena(Arena *pt, size_t size) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given arena pointer is NULL\n");
+        return NULL;
+    }
+    
+    size = align_arena(size);
+    
+    // If it does not fit in the current chunk, get a new one large enough
+    if (pt->chunk == NULL || pt->chunk->used + size > pt->chunk->size) {
+        size_t chunk_size = pt->chunk_size != 0 ? pt->chunk_size : ARENA_CHUNK_SIZE;
+        if (size > chunk_size) {
+            chunk_size = size;
+        }
+        Arena_Chunk *chunk_pt = malloc(align_arena(sizeof(Arena_Chunk)) + chunk_size);
+        if (chunk_pt == NULL) {
+            fprintf(stderr, "Not enough memory to grow the arena\n");
+            return NULL;
+        }
+        chunk_pt->next_chunk = pt->chunk;
+        chunk_pt->size = chunk_size;
+        chunk_pt->used = 0;
+        pt->chunk = chunk_pt;
+    }
+    
+    void *memory = (char *) pt->chunk + align_arena(sizeof(Arena_Chunk)) + pt->chunk->used;
+    pt->chunk->used += size;
+    pt->total_size += size;
+    return memory;
+}
+
+/**
+ Get a piece of memory from the arena set to zero
+ */
+void* calloc_arena(Arena *pt, size_t size) {
+    
+    void *memory = alloc_arena(pt, size);
+    if (memory != NULL) {
+        memset(memory, 0, size);
+    }
+    return memory;
+}
+
+/**
+ Release all the memory given by the arena, after it the arena can be used again
+ */
+int release_arena(Arena *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given arena pointer is NULL\n");
+        return -1;
+    }
+    
+    while (pt->chunk != NULL) {
+        Arena_Chunk *next_pt = pt->chunk->next_chunk;
+        free(pt->chunk);
+        pt->chunk = next_pt;
+    }
+    pt->total_size = 0;
+    return 0;
+}
@@ -0,0 +1,94 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Arena.h                                                                                                            *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that contains a memory arena.                                                                              *
+ *  The arena takes large chunks of memory and gives consecutive pieces of them, so all the small structures live      *
+ *  together in memory and they are released at once with a single call instead of one free per structure.             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Arena_h
+#define Arena_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#endif /* Arena_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define ARENA_CHUNK_SIZE (1 << 20)          // Default size of the chunks in bytes
+#define ARENA_ALIGNMENT 16                  // Alignment of all the pieces given by the arena
+
+/**
+ Chunk of memory of the arena, the memory given follows the header of the chunk
+ */
+typedef struct Arena_Chunk {
+    struct Arena_Chunk *next_chunk;     // Previous chunk filled of the arena
+    size_t size;                        // Size of the memory of the chunk in bytes
+    size_t used;                        // Bytes of the chunk already given
+}Arena_Chunk;
+
+/**
+ Structure with the information of the arena. An arena set to zero is ready to be used
+ */
+typedef struct Arena {
+    Arena_Chunk *chunk;                 // Chunk currently being filled
+    size_t chunk_size;                  // Size of the new chunks in bytes (0 => ARENA_CHUNK_SIZE)
+    size_t total_size;                  // Total bytes given by the arena
+}Arena;
+
+                                                /* CODE DEFINITIONS */
+
+/* Getters */
+
+/**
+ Get the total number of bytes given by the arena
+
+ @param pt pointer to the arena
+ @return number of bytes
+ */
+size_t get_arena_size(Arena *pt);
+
+/* Functions */
+
+/**
+ Init the arena with the given size of chunks
+
+ @param pt pointer to the arena
+ @param chunk_size size of the chunks in bytes
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_arena(Arena *pt, size_t chunk_size);
+
+/**
+ Get a piece of memory from the arena, it is only released when the whole arena is released
+
+ @param pt pointer to the arena
+ @param size size of the memory in bytes
+ @return pointer to the memory, NULL if there is no memory left
+ */
+void* alloc_arena(Arena *pt, size_t size);
+
+/**
+ Get a piece of memory from the arena set to zero
+
+ @param pt pointer to the arena
+ @param size size of the memory in bytes
+ @return pointer to the memory, NULL if there is no memory left
+ */
+void* calloc_arena(Arena *pt, size_t size);
+
+/**
+ Release all the memory given by the arena, after it the arena can be used again
+
+ @param pt pointer to the arena
+ @return 0 if done correctly, -1 otherwise
+ */
+int release_arena(Arena *pt);
@@ -0,0 +1,481 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Benchmark.c                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Benchmark.h                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Network.h"
+#include "Scheduler.h"
+#include "Benchmark.h"
+
+                                                    /* VARIABLES */
+
+const char *workload_names[] = {"Heuristic", "OneShot", "Incremental", "Patch", "Optimize"};
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Save the measures of a run of a workload, the size of its models is read from the profile of the thread. Only the
+ time of the runs that found a schedule is kept, so the runs that fail do not change the percentiles
+
+ @param result pointer to the measures of the workload
+ @param solved 1 if the run found a schedule, 0 otherwise
+ @param time time of the run in ns
+ @param num_frames number of frames scheduled in the run
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_benchmark_run(Benchmark_Result *result, int solved, long long int time, long long int num_frames) {
+    
+    if (solved == 1 && result->num_solved == result->max_runs) {
+        int max_runs = result->max_runs == 0 ? 64 : result->max_runs * 2;
+        long long int *times = realloc(result->times, sizeof(long long int) * max_runs);
+        if (times == NULL) {
+            fprintf(stderr, "Not enough memory for the measures of the benchmark\n");
+            return -1;
+        }
+        result->times = times;
+        result->max_runs = max_runs;
+    }
+    result->num_runs++;
+    if (solved == 1) {
+        result->times[result->num_solved] = time;
+        result->num_solved++;
+        result->num_frames += num_frames;
+        result->solved_time += time;
+    }
+    
+    result->num_models += get_profile_num_models();
+    for (int i = 0; i < num_counters; i++) {
+        result->total[i] += get_profile_total(i);
+        if (get_profile_largest(i) > result->largest[i]) {
+            result->largest[i] = get_profile_largest(i);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Start a run in a new network and scheduler, with the parameters of the given scheduler. The new network keeps how
+ the current one stores the offsets and orders the frames, as they are read with the parameters
+
+ @param parameters_pt pointer to the scheduler with the parameters
+ @param network_pt pointer to save the new network
+ @param scheduler_pt pointer to save the new scheduler
+ @return 0 if done correctly, -1 otherwise
+ */
+int start_benchmark_run(Scheduler_Context *parameters_pt, Network **network_pt, Scheduler_Context **scheduler_pt) {
+    
+    int periodic_offsets = get_network()->periodic_offsets;
+    Frame_Order frame_order = get_frame_order();
+    *network_pt = new_network();
+    *scheduler_pt = new_scheduler_context();
+    if (*network_pt == NULL || *scheduler_pt == NULL) {
+        fprintf(stderr, "Not enough memory for a run of the benchmark\n");
+        if (*network_pt != NULL) {
+            free_network(*network_pt);
+        }
+        if (*scheduler_pt != NULL) {
+            free_scheduler_context(*scheduler_pt);
+        }
+        return -1;
+    }
+    set_network(*network_pt);
+    set_periodic_offsets(periodic_offsets);
+    set_frame_order(frame_order);
+    set_scheduler_context(*scheduler_pt);
+    copy_scheduler_parameters(parameters_pt);
+    
+    return 0;
+}
+
+/**
+ End a run releasing its network and scheduler, and go back to the given ones
+
+ @param network_pt pointer to the network of the run
+ @param scheduler_pt pointer to the scheduler of the run
+ @param previous_network pointer to the network to go back to
+ @param previous_scheduler pointer to the scheduler to go back to
+ @return 0 if done correctly, -1 otherwise
+ */
+int end_benchmark_run(Network *network_pt, Scheduler_Context *scheduler_pt, Network *previous_network,
+                      Scheduler_Context *previous_scheduler) {
+    
+    // The scheduler uses the link ids of the network, so it goes first
+    free_scheduler_context(scheduler_pt);
+    free_network(network_pt);
+    set_network(previous_network);
+    set_scheduler_context(previous_scheduler);
+    
+    return 0;
+}
+
+/**
+ Measure a workload that schedules the whole network
+
+ @param report pointer to the report
+ @param workload workload to measure, one of the scheduling algorithms
+ @return 0 if done correctly, -1 otherwise
+ */
+int run_schedule_workload(Benchmark_Report *report, Benchmark_Workload workload) {
+    
+    Network *previous_network = get_network();
+    Scheduler_Context *previous_scheduler = get_scheduler_context();
+    Benchmark_Result *result = &report->results[workload];
+    
+    for (int rep = 0; rep < report->repetitions; rep++) {
+        Network *network_pt;
+        Scheduler_Context *scheduler_pt;
+        if (start_benchmark_run(previous_scheduler, &network_pt, &scheduler_pt) == -1) {
+            return -1;
+        }
+        if (read_network_xml(report->network_file) == -1 || prepare_network() == -1) {
+            end_benchmark_run(network_pt, scheduler_pt, previous_network, previous_scheduler);
+            return -1;
+        }
+        
+        // Only the algorithm is measured, not reading and preparing the network
+        reset_profile();
+        uint64_t starting = get_monotonic_time();
+        int solved;
+        if (workload == workload_one_shot) {
+            solved = one_shot_scheduling() == 0;
+        } else if (workload == workload_incremental) {
+            solved = incremental_approach() == 0;
+        } else {
+            solved = heuristic_scheduling() == 0;
+        }
+        long long int time = (long long int) (get_monotonic_time() - starting);
+        int error = add_benchmark_run(result, solved, time, get_traffic()->num_frames);
+        
+        end_benchmark_run(network_pt, scheduler_pt, previous_network, previous_scheduler);
+        if (error == -1) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Measure a run of a workload that patches or optimizes a failed link of the current network, that is scheduled.
+ The failures whose traffic has no time left in the path can not be measured, they are counted as skipped
+
+ @param result pointer to the measures of the workload
+ @param workload workload to measure, the patch or the optimize
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @param path_it position in the path of the link to optimize, not used by the patch
+ @return 0 if done correctly, -1 otherwise
+ */
+int run_failure(Benchmark_Result *result, Benchmark_Workload workload, int link_id, int *path, int len_path,
+                int path_it) {
+    
+    Network *scheduled_pt = get_network();
+    Scheduler_Context *previous_scheduler = get_scheduler_context();
+    Network *network_pt;
+    Scheduler_Context *scheduler_pt;
+    if (start_benchmark_run(previous_scheduler, &network_pt, &scheduler_pt) == -1) {
+        return -1;
+    }
+    
+    int error = 0;
+    if (workload == workload_patch && read_failure_patch(scheduled_pt, link_id, path, len_path) == 0) {
+        reset_profile();
+        uint64_t starting = get_monotonic_time();
+        int solved = patch() == 0;
+        long long int time = (long long int) (get_monotonic_time() - starting);
+        long long int num_frames = 0;
+        for (int i = 0; i < get_num_link_patches(); i++) {
+            num_frames += get_link_patch(i)->num_frames - get_link_patch(i)->num_fixed;
+        }
+        error = add_benchmark_run(result, solved, time, num_frames);
+    } else if (workload == workload_optimize &&
+               read_failure_optimize(scheduled_pt, link_id, path, len_path, path_it) == 0) {
+        reset_profile();
+        uint64_t starting = get_monotonic_time();
+        int solved = optimize() == 0;
+        long long int time = (long long int) (get_monotonic_time() - starting);
+        error = add_benchmark_run(result, solved, time, get_traffic()->num_frames - get_num_fixed_frames());
+    } else {
+        result->num_skipped++;
+    }
+    
+    end_benchmark_run(network_pt, scheduler_pt, scheduled_pt, previous_scheduler);
+    return error;
+}
+
+/**
+ Measure the patch and the optimize over the failures of all the links of the current network, that is scheduled
+
+ @param report pointer to the report
+ @return 0 if done correctly, -1 otherwise
+ */
+int run_failure_workloads(Benchmark_Report *report) {
+    
+    int *path = malloc(sizeof(int) * (get_network()->number_links + 1));
+    if (path == NULL) {
+        fprintf(stderr, "Not enough memory for the paths of the failures of the benchmark\n");
+        return -1;
+    }
+    
+    for (int rep = 0; rep < report->repetitions; rep++) {
+        for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+            if (get_link(link_id) == NULL || get_num_link_offsets(link_id) == 0) {
+                continue;
+            }
+            int len_path = get_failure_path(link_id, path);
+            if (len_path <= 0) {
+                continue;
+            }
+            if (report->results[workload_patch].enabled == 1 &&
+                run_failure(&report->results[workload_patch], workload_patch, link_id, path, len_path, 0) == -1) {
+                free(path);
+                return -1;
+            }
+            for (int path_it = 0; path_it < len_path && report->results[workload_optimize].enabled == 1; path_it++) {
+                if (run_failure(&report->results[workload_optimize], workload_optimize, link_id, path, len_path,
+                                path_it) == -1) {
+                    free(path);
+                    return -1;
+                }
+            }
+        }
+    }
+    
+    free(path);
+    return 0;
+}
+
+/**
+ Compare two times, to sort them from the shortest
+
+ @param a pointer to a time
+ @param b pointer to the other time
+ @return negative if a is shorter, positive if it is longer, 0 if they are equal
+ */
+int compare_times(const void *a, const void *b) {
+    
+    long long int time_a = *(const long long int *) a;
+    long long int time_b = *(const long long int *) b;
+    return (time_a > time_b) - (time_a < time_b);
+}
+
+/**
+ Get a percentile of the times sorted from the shortest, the smallest time with the given part of the times below
+
+ @param times times sorted
+ @param num_times number of times
+ @param percentile percentile between 1 and 100
+ @return time of the percentile, 0 if there are no times
+ */
+long long int get_percentile(long long int *times, int num_times, int percentile) {
+    
+    if (num_times == 0) {
+        return 0;
+    }
+    int pos = (int) (((long long int) num_times * percentile + 99) / 100) - 1;
+    return times[pos];
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Prepare the report to measure the network, with all the workloads enabled
+ */
+int init_benchmark_report(Benchmark_Report *report, char *network_file, int repetitions) {
+    
+    if (report == NULL || network_file == NULL) {
+        fprintf(stderr, "The given report or file pointer is NULL\n");
+        return -1;
+    }
+    if (repetitions < 1) {
+        fprintf(stderr, "The benchmark has to repeat every workload at least once\n");
+        return -1;
+    }
+    
+    memset(report, 0, sizeof(Benchmark_Report));
+    report->network_file = network_file;
+    report->repetitions = repetitions;
+    for (int i = 0; i < num_workloads; i++) {
+        report->results[i].enabled = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ Enable only the given workloads
+ */
+int set_benchmark_workloads(Benchmark_Report *report, char *names) {
+    
+    if (strcmp(names, "All") == 0) {
+        for (int i = 0; i < num_workloads; i++) {
+            report->results[i].enabled = 1;
+        }
+        return 0;
+    }
+    
+    for (int i = 0; i < num_workloads; i++) {
+        report->results[i].enabled = 0;
+    }
+    const char *name = names;
+    while (*name != '\0') {
+        size_t len_name = strcspn(name, ",");
+        int found = 0;
+        for (int i = 0; i < num_workloads; i++) {
+            if (strlen(workload_names[i]) == len_name && strncmp(name, workload_names[i], len_name) == 0) {
+                report->results[i].enabled = 1;
+                found = 1;
+            }
+        }
+        if (found == 0) {
+            fprintf(stderr, "The given workload is not defined\n");
+            return -1;
+        }
+        name += name[len_name] == ',' ? len_name + 1 : len_name;
+    }
+    
+    return 0;
+}
+
+/**
+ Measure the enabled workloads on the network of the report, with the parameters of the current scheduler
+ */
+int run_benchmark(Benchmark_Report *report) {
+    
+    if (report == NULL) {
+        fprintf(stderr, "The given report pointer is NULL\n");
+        return -1;
+    }
+    Network *previous_network = get_network();
+    Scheduler_Context *previous_scheduler = get_scheduler_context();
+    
+    // Every workload schedules the network again in a run of its own
+    for (int i = workload_heuristic; i <= workload_incremental; i++) {
+        if (report->results[i].enabled == 1 && run_schedule_workload(report, i) == -1) {
+            fprintf(stderr, "The %s workload could not be measured\n", workload_names[i]);
+            return -1;
+        }
+    }
+    
+    // The failures are derived from the schedule of the algorithm of the parameters, as in the failure evaluation
+    Network *network_pt;
+    Scheduler_Context *scheduler_pt;
+    if (start_benchmark_run(previous_scheduler, &network_pt, &scheduler_pt) == -1) {
+        return -1;
+    }
+    if (read_network_xml(report->network_file) == -1 || prepare_network() == -1) {
+        end_benchmark_run(network_pt, scheduler_pt, previous_network, previous_scheduler);
+        return -1;
+    }
+    report->num_nodes = get_network()->number_nodes;
+    report->num_links = get_network()->number_links;
+    report->num_frames = get_traffic()->num_frames;
+    int error = 0;
+    if (report->results[workload_patch].enabled == 1 || report->results[workload_optimize].enabled == 1) {
+        if (schedule_network() == -1) {
+            fprintf(stderr, "The network could not be scheduled, the patch and the optimize can not be measured\n");
+            error = -1;
+        } else {
+            error = run_failure_workloads(report);
+        }
+    }
+    end_benchmark_run(network_pt, scheduler_pt, previous_network, previous_scheduler);
+    
+    return error;
+}
+
+/**
+ Write the measures of the enabled workloads in a csv file, one workload per line
+ */
+int write_benchmark_report_csv(Benchmark_Report *report, char *csv_file) {
+    
+    if (report == NULL || csv_file == NULL) {
+        fprintf(stderr, "The given report or file pointer is NULL\n");
+        return -1;
+    }
+    FILE *file_pt = fopen(csv_file, "a");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The csv file of the benchmark could not be opened\n");
+        return -1;
+    }
+    
+    // The header only goes in new files, so the results of several releases can be kept in the same file
+    fseek(file_pt, 0, SEEK_END);
+    if (ftell(file_pt) == 0) {
+        fprintf(file_pt, "Network,Workload,Nodes,Links,Frames,Runs,Solved,Failed,Skipped,MinTime,MeanTime,P50Time,"
+                "P90Time,P99Time,MaxTime,FramesPerSecond,Models");
+        for (int i = 0; i < num_counters; i++) {
+            fprintf(file_pt, ",Total%s,Largest%s", get_profile_counter_name(i), get_profile_counter_name(i));
+        }
+        fprintf(file_pt, ",ProcessPeakMemory\n");
+    }
+    
+    // The times are only the ones of the runs that found a schedule
+    int last_workload = 0;
+    for (int i = 0; i < num_workloads; i++) {
+        if (report->results[i].enabled == 1) {
+            last_workload = i;
+        }
+    }
+    for (int i = 0; i < num_workloads; i++) {
+        Benchmark_Result *result = &report->results[i];
+        if (result->enabled == 0) {
+            continue;
+        }
+        int num_solved = result->num_solved;
+        qsort(result->times, num_solved, sizeof(long long int), compare_times);
+        double frames_second = result->solved_time > 0 ? result->num_frames * 1e9 / result->solved_time : 0;
+        fprintf(file_pt, "%s,%s,%d,%d,%d,%d,%d,%d,%d,%lld,%lld,%lld,%lld,%lld,%lld,%.3f,%d", report->network_file,
+                workload_names[i], report->num_nodes, report->num_links, report->num_frames, result->num_runs,
+                num_solved, result->num_runs - num_solved, result->num_skipped,
+                num_solved > 0 ? result->times[0] : 0, num_solved > 0 ? result->solved_time / num_solved : 0,
+                get_percentile(result->times, num_solved, 50), get_percentile(result->times, num_solved, 90),
+                get_percentile(result->times, num_solved, 99), get_percentile(result->times, num_solved, 100),
+                frames_second, result->num_models);
+        for (int j = 0; j < num_counters; j++) {
+            fprintf(file_pt, ",%lld,%lld", result->total[j], result->largest[j]);
+        }
+        // The peak of the memory is of the whole process, not of the workload, so it is only written once
+        if (i == last_workload) {
+            fprintf(file_pt, ",%lld\n", get_peak_memory());
+        } else {
+            fprintf(file_pt, ",\n");
+        }
+    }
+    
+    if (fclose(file_pt) != 0) {
+        fprintf(stderr, "The csv file of the benchmark could not be written\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Free the measures of the report
+ */
+int free_benchmark_report(Benchmark_Report *report) {
+    
+    if (report == NULL) {
+        fprintf(stderr, "The given report pointer is NULL\n");
+        return -1;
+    }
+    
+    for (int i = 0; i < num_workloads; i++) {
+        free(report->results[i].times);
+        report->results[i].times = NULL;
+        report->results[i].num_runs = 0;
+        report->results[i].max_runs = 0;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,118 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Benchmark.h                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that measures the scheduler on a network, so a change can be compared with the previous releases. The      *
+ *  network is scheduled several times with every algorithm. The patch and the optimize need a network already         *
+ *  scheduled, so they are measured over the failures of the links of the schedule found by the algorithm of the       *
+ *  parameters, as the failures are evaluated. Every workload reports the percentiles of the time of the runs that     *
+ *  found a schedule, the frames scheduled per second and the size of the models given to the solver.                  *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Benchmark_h
+#define Benchmark_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Profile.h"
+
+#endif /* Benchmark_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Workloads measured by the benchmark
+ */
+typedef enum Benchmark_Workload {
+    workload_heuristic,             // Schedule the network with the heuristic
+    workload_one_shot,              // Schedule the network with the one-shot approach
+    workload_incremental,           // Schedule the network with the incremental approach
+    workload_patch,                 // Patch the path that replaces every failed link
+    workload_optimize,              // Optimize every link of the path that replaces every failed link
+    num_workloads
+}Benchmark_Workload;
+
+/**
+ Measures of the runs of a workload
+ */
+typedef struct Benchmark_Result {
+    int enabled;                    // 1 if the workload is measured, 0 otherwise
+    int num_runs;                   // Number of runs, the ones that found a schedule and the ones that failed
+    int num_solved;                 // Number of runs that found a schedule
+    int num_skipped;                // Number of failures not measured, as their traffic has no time left in the path
+    long long int num_frames;       // Number of frames scheduled in the runs that found a schedule
+    long long int solved_time;      // Time of the runs that found a schedule together in ns
+    long long int *times;           // Time of every run that found a schedule in ns
+    int max_runs;                   // Number of runs that fit in the memory of the times
+    int num_models;                 // Number of models created in the solver in all the runs
+    long long int total[num_counters];      // Size of all the models of all the runs together
+    long long int largest[num_counters];    // Size of the largest model of all the runs
+}Benchmark_Result;
+
+/**
+ Report with the measures of all the workloads on a network
+ */
+typedef struct Benchmark_Report {
+    char *network_file;             // Name and path of the network measured
+    int num_nodes;                  // Number of nodes of the network
+    int num_links;                  // Number of links of the network
+    int num_frames;                 // Number of frames of the network
+    int repetitions;                // Number of times every workload is repeated
+    Benchmark_Result results[num_workloads];    // Measures of every workload
+}Benchmark_Report;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Prepare the report to measure the network, with all the workloads enabled
+
+ @param report pointer to the report, it has to be freed with free_benchmark_report
+ @param network_file name and path of the network file
+ @param repetitions number of times every workload is repeated
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_benchmark_report(Benchmark_Report *report, char *network_file, int repetitions);
+
+/**
+ Enable only the given workloads
+
+ @param report pointer to the report
+ @param names names of the workloads separated by commas ("Heuristic", "OneShot", "Incremental", "Patch", "Optimize")
+ or "All"
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_benchmark_workloads(Benchmark_Report *report, char *names);
+
+/**
+ Measure the enabled workloads on the network of the report, with the parameters of the current scheduler.
+ Every run works in its own network and scheduler, so the current ones of the thread are not changed
+
+ @param report pointer to the report
+ @return 0 if done correctly, -1 otherwise
+ */
+int run_benchmark(Benchmark_Report *report);
+
+/**
+ Write the measures of the enabled workloads in a csv file, one workload per line. The lines are added at the end of
+ the file, and the header with the name of the columns is only written if the file is new. The times are in ns.
+ The peak of the memory is of the whole process, so it is only written in the last line of the report
+
+ @param report pointer to the report
+ @param csv_file name and path of the csv file
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_benchmark_report_csv(Benchmark_Report *report, char *csv_file);
+
+/**
+ Free the measures of the report
+
+ @param report pointer to the report
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_benchmark_report(Benchmark_Report *report);
@@ -0,0 +1,586 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Failure.c                                                                                                          *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Failure.h                                                                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Network.h"
+#include "Scheduler.h"
+#include "Repair.h"
+#include "Failure.h"
+#include "Profile.h"
+#include "Validator.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the utilization of a link in the current network, the part of the hyperperiod used by its transmissions
+
+ @param link_id id of the link
+ @return utilization of the link
+ */
+double get_link_utilization(int link_id) {
+    
+    long long int used = 0;
+    Link_Offset *link_offsets = get_link_offsets(link_id);
+    for (int i = 0; i < get_num_link_offsets(link_id); i++) {
+        Offset *offset_pt = link_offsets[i].offset_pt;
+        used += (long long int) get_off_num_instances(offset_pt) * get_off_num_replicas(offset_pt) *
+                get_off_time(offset_pt);
+    }
+    
+    return (double) used / get_hyperperiod();
+}
+
+/**
+ Get the utilization that the patch of a link adds to it, the part of the hyperperiod used by the patched frames
+
+ @param link_patch pointer to the patch of the link
+ @return utilization added to the link
+ */
+double get_patch_utilization(Link_Patch *link_patch) {
+    
+    long long int used = 0;
+    Traffic *t = get_traffic();
+    for (int i = link_patch->first_frame + link_patch->num_fixed; i < link_patch->first_frame + link_patch->num_frames;
+         i++) {
+        Offset *offset_pt = get_offset_it(&t->frames[i], 0);
+        used += (long long int) get_off_num_instances(offset_pt) * get_off_num_replicas(offset_pt) *
+                get_off_time(offset_pt);
+    }
+    
+    return (double) used / get_hyperperiod();
+}
+
+/**
+ Get the offset of a frame of the failed link in a link of the path once patched. A frame that the link already
+ transmitted keeps its offset of the schedule, otherwise it takes a copy of the patched offset in the link of the path
+
+ @param frame_pt pointer to the frame in the scheduled network
+ @param frame_id id of the frame
+ @param link_id id of the link of the path
+ @param link_patch pointer to the patch of the link
+ @param arena_pt pointer to the arena where to copy the offset
+ @return pointer to the offset, NULL if the link does not transmit the frame
+ */
+Offset * get_failure_path_offset(Frame *frame_pt, int frame_id, int link_id, Link_Patch *link_patch,
+                                 Arena *arena_pt) {
+    
+    Offset *offset_pt = get_offset_by_link(frame_pt, link_id);
+    if (offset_pt != NULL) {
+        return offset_pt;
+    }
+    
+    // The patched offsets do not save their link, as the patched link is the only one of the patch
+    Traffic *t = get_traffic();
+    for (int i = link_patch->first_frame + link_patch->num_fixed; i < link_patch->first_frame + link_patch->num_frames;
+         i++) {
+        if (t->frames_id[i] == frame_id) {
+            offset_pt = alloc_arena(arena_pt, sizeof(Offset));
+            if (offset_pt == NULL) {
+                return NULL;
+            }
+            *offset_pt = *get_offset_it(&t->frames[i], 0);
+            offset_pt->link_id = link_id;
+            return offset_pt;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ Replace the failed link with the path in the offsets and paths of a frame of the failed link. The copy of the frame
+ shares the schedule of the original one, only its lists of offsets and paths are new
+
+ @param frame_pt pointer to the copy of the frame
+ @param frame_id id of the frame
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @param arena_pt pointer to the arena where to allocate the lists
+ @return 0 if done correctly, -1 otherwise
+ */
+int replace_failed_link(Frame *frame_pt, int frame_id, int link_id, int *path, int len_path, Arena *arena_pt) {
+    
+    Offset *failed_pt = get_offset_by_link(frame_pt, link_id);
+    Offset **path_offsets = alloc_arena(arena_pt, sizeof(Offset*) * len_path);
+    Offset **offset_it = alloc_arena(arena_pt, sizeof(Offset*) * (get_num_offsets(frame_pt) + len_path));
+    Path *list_paths = alloc_arena(arena_pt, sizeof(Path) * get_num_paths(frame_pt));
+    if (path_offsets == NULL || offset_it == NULL || list_paths == NULL) {
+        return -1;
+    }
+    
+    // The offsets of the frame without the failed link, followed by the new ones of the path
+    int num_offsets = 0;
+    for (int i = 0; i < get_num_offsets(frame_pt); i++) {
+        if (get_offset_it(frame_pt, i) != failed_pt) {
+            offset_it[num_offsets++] = get_offset_it(frame_pt, i);
+        }
+    }
+    for (int i = 0; i < len_path; i++) {
+        path_offsets[i] = get_failure_path_offset(frame_pt, frame_id, path[i], get_link_patch(i), arena_pt);
+        if (path_offsets[i] == NULL) {
+            fprintf(stderr, "The frame %d is not patched in the link %d of the path\n", frame_id, path[i]);
+            return -1;
+        }
+        if (get_offset_by_link(frame_pt, path[i]) == NULL) {
+            offset_it[num_offsets++] = path_offsets[i];
+        }
+    }
+    
+    // Every path of the frame that went through the failed link goes through the path that replaces it
+    for (int i = 0; i < get_num_paths(frame_pt); i++) {
+        Path *path_pt = get_path(frame_pt, i);
+        list_paths[i] = *path_pt;
+        int pos = 0;
+        while (pos < get_num_links_path(path_pt) && get_offset_path_link(path_pt, pos) != failed_pt) {
+            pos++;
+        }
+        if (pos == get_num_links_path(path_pt)) {
+            continue;
+        }
+        int len_new = get_num_links_path(path_pt) - 1 + len_path;
+        list_paths[i].length_path = len_new;
+        list_paths[i].path = alloc_arena(arena_pt, sizeof(int) * len_new);
+        list_paths[i].list_offsets = alloc_arena(arena_pt, sizeof(Offset*) * len_new);
+        if (list_paths[i].path == NULL || list_paths[i].list_offsets == NULL) {
+            return -1;
+        }
+        for (int j = 0, it = 0; j < get_num_links_path(path_pt); j++) {
+            if (j != pos) {
+                list_paths[i].path[it] = path_pt->path[j];
+                list_paths[i].list_offsets[it++] = get_offset_path_link(path_pt, j);
+                continue;
+            }
+            for (int h = 0; h < len_path; h++) {
+                list_paths[i].path[it] = path[h];
+                list_paths[i].list_offsets[it++] = path_offsets[h];
+            }
+        }
+    }
+    
+    frame_pt->num_offsets = num_offsets;
+    frame_pt->offset_it = offset_it;
+    frame_pt->list_paths = list_paths;
+    frame_pt->offset_hash = NULL;
+    
+    return 0;
+}
+
+/**
+ Check the schedule of a patched failure with the validator. The frames of the failed link take the path that
+ replaces it with their patched transmissions, and the rest of the frames keep their schedule. Only the frames
+ transmitted in the failed link or in the path are checked, as the schedule of the other links does not change.
+ The current network of the thread is the network of the patch
+
+ @param pool pointer to the shared state of the pool
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @return number of violations found, -1 if something went wrong
+ */
+int validate_failure_patch(Failure_Pool *pool, int link_id, int *path, int len_path) {
+    
+    Network *patch_pt = get_network();
+    Traffic *scheduled_t = &pool->network_pt->traffic;
+    Arena arena;
+    memset(&arena, 0, sizeof(Arena));
+    Traffic check_t;
+    check_t.num_frames = 0;
+    check_t.frames = alloc_arena(&arena, sizeof(Frame) * (scheduled_t->num_frames + 1));
+    check_t.frames_id = alloc_arena(&arena, sizeof(int) * (scheduled_t->num_frames + 1));
+    char *taken = calloc_arena(&arena, sizeof(char) * (scheduled_t->num_frames + 1));
+    if (check_t.frames == NULL || check_t.frames_id == NULL || taken == NULL) {
+        fprintf(stderr, "Not enough memory to validate the patch of the failed link %d\n", link_id);
+        release_arena(&arena);
+        return -1;
+    }
+    
+    // The frames of the failed link and of the links of the path, every frame only once
+    int error = 0;
+    for (int i = -1; i < len_path && error == 0; i++) {
+        int check_link = i == -1 ? link_id : path[i];
+        Link_Offset *link_offsets = pool->network_pt->link_offsets[check_link];
+        for (int j = 0; j < pool->network_pt->num_link_offsets[check_link] && error == 0; j++) {
+            int frame_pos = link_offsets[j].frame_pos;
+            if (taken[frame_pos] == 1) {
+                continue;
+            }
+            taken[frame_pos] = 1;
+            Frame *frame_pt = &check_t.frames[check_t.num_frames];
+            *frame_pt = scheduled_t->frames[frame_pos];
+            check_t.frames_id[check_t.num_frames] = scheduled_t->frames_id[frame_pos];
+            check_t.num_frames++;
+            if (i == -1) {
+                error = replace_failed_link(frame_pt, scheduled_t->frames_id[frame_pos], link_id, path, len_path,
+                                            &arena);
+            }
+        }
+    }
+    if (error == -1) {
+        fprintf(stderr, "The patch of the failed link %d could not be validated\n", link_id);
+        release_arena(&arena);
+        return -1;
+    }
+    
+    // The validation runs in the scheduled network, the one of the protocol reservation of the links
+    Schedule_Report report;
+    set_network(pool->network_pt);
+    int num_violations = validate_schedule(&check_t, 1, &report);
+    set_network(patch_pt);
+    if (num_violations > 0) {
+        fprintf(stderr, "The patch of the failed link %d violates %d constraints of the schedule\n", link_id,
+                num_violations);
+    }
+    if (num_violations != -1) {
+        free_schedule_report(&report);
+    }
+    release_arena(&arena);
+    
+    return num_violations;
+}
+
+/**
+ Evaluate the failure of a link, the current network of the thread is empty and it is used for the patch.
+ When it returns, the current network of the thread is the network of the patch. If the pool has a cache, the
+ patched links are saved in it as the repair plans of the failure
+
+ @param pool pointer to the shared state of the pool
+ @param result pointer to the result of the failure, with the failed link id
+ @param path memory for the path that replaces the failed link
+ @param path_utilization memory for the utilization of every link of the path
+ @return 0 if done correctly, -1 otherwise
+ */
+int evaluate_link_failure(Failure_Pool *pool, Failure_Result *result, int *path, double *path_utilization) {
+    
+    uint64_t starting = get_monotonic_time();
+    Network *patch_pt = get_network();
+    
+    // Traffic and path of the failed link in the scheduled network
+    set_network(pool->network_pt);
+    result->num_frames = get_num_link_offsets(result->link_id);
+    result->link_utilization = get_link_utilization(result->link_id);
+    result->len_path = 0;
+    result->path_utilization = 0;
+    result->patch_time = 0;
+    if (result->num_frames == 0) {
+        result->status = failure_no_traffic;
+        set_network(patch_pt);
+        result->execution_time = (long long int) (get_monotonic_time() - starting);
+        return 0;
+    }
+    int len_path = get_failure_path(result->link_id, path);
+    if (len_path <= 0) {
+        result->status = failure_no_path;
+        set_network(patch_pt);
+        result->execution_time = (long long int) (get_monotonic_time() - starting);
+        return len_path;
+    }
+    for (int i = 0; i < len_path; i++) {
+        path_utilization[i] = get_link_utilization(path[i]);
+    }
+    result->len_path = len_path;
+    
+    // Derive the patch of the links of the path and patch them
+    set_network(patch_pt);
+    result->status = failure_not_patched;
+    if (read_failure_patch(pool->network_pt, result->link_id, path, len_path) == 0 && patch() == 0) {
+        result->status = failure_patched;
+    }
+    
+    // The patched failure is only counted if the validator accepts the schedule with the path
+    int error = 0;
+    if (result->status == failure_patched) {
+        int num_violations = validate_failure_patch(pool, result->link_id, path, len_path);
+        if (num_violations != 0) {
+            result->status = failure_invalid;
+            error = num_violations == -1 ? -1 : 0;
+        }
+    }
+    for (int i = 0; i < get_num_link_patches(); i++) {
+        Link_Patch *link_patch = get_link_patch(i);
+        if (link_patch->execution_time > result->patch_time) {
+            result->patch_time = link_patch->execution_time;
+        }
+        if (result->status == failure_patched &&
+            path_utilization[i] + get_patch_utilization(link_patch) > result->path_utilization) {
+            result->path_utilization = path_utilization[i] + get_patch_utilization(link_patch);
+        }
+    }
+    result->execution_time = (long long int) (get_monotonic_time() - starting);
+    
+    // The patched links of the path are saved as the repair plans of the failure
+    if (pool->cache != NULL && result->status == failure_patched) {
+        Traffic *t = get_traffic();
+        pthread_mutex_lock(&pool->lock);
+        for (int i = 0; i < get_num_link_patches() && error == 0; i++) {
+            Link_Patch *link_patch = get_link_patch(i);
+            Traffic link_traffic;
+            link_traffic.num_frames = link_patch->num_frames;
+            link_traffic.frames = &t->frames[link_patch->first_frame];
+            link_traffic.frames_id = &t->frames_id[link_patch->first_frame];
+            error = add_repair_plan(pool->cache, &link_traffic, link_patch->num_fixed, link_patch->link_id,
+                                    result->link_id);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    return error;
+}
+
+/**
+ Thread that takes the next failure to evaluate until all the failures are evaluated
+
+ @param pool_pt pointer to the shared state of the pool
+ @return NULL
+ */
+void * evaluate_failures_thread(void *pool_pt) {
+    
+    Failure_Pool *pool = pool_pt;
+    
+    // Every thread patches in its own network and scheduler, with the parameters of the thread that started the pool
+    Network *patch_pt = new_network();
+    Scheduler_Context *scheduler_pt = new_scheduler_context();
+    int *path = malloc(sizeof(int) * (pool->network_pt->number_links + 1));
+    double *path_utilization = malloc(sizeof(double) * (pool->network_pt->number_links + 1));
+    if (patch_pt == NULL || scheduler_pt == NULL || path == NULL || path_utilization == NULL) {
+        fprintf(stderr, "Not enough memory for the thread that evaluates the failures\n");
+        pthread_mutex_lock(&pool->lock);
+        pool->error = 1;
+        pthread_mutex_unlock(&pool->lock);
+        if (patch_pt != NULL) {
+            free_network(patch_pt);
+        }
+        if (scheduler_pt != NULL) {
+            free_scheduler_context(scheduler_pt);
+        }
+        free(path);
+        free(path_utilization);
+        return NULL;
+    }
+    set_scheduler_context(scheduler_pt);
+    copy_scheduler_parameters(pool->scheduler_pt);
+    set_patch_threads(1);
+    set_baseline_timelines(pool->baseline);
+    set_repair_cache(pool->scheduler_pt->repair_cache);
+    
+    while (1) {
+        pthread_mutex_lock(&pool->lock);
+        int pos = pool->next_result;
+        pool->next_result += 1;
+        pthread_mutex_unlock(&pool->lock);
+        if (pos >= pool->report->num_results) {
+            break;
+        }
+        
+        set_network(patch_pt);
+        if (evaluate_link_failure(pool, &pool->report->results[pos], path, path_utilization) == -1) {
+            pthread_mutex_lock(&pool->lock);
+            pool->error = 1;
+            pthread_mutex_unlock(&pool->lock);
+        }
+        // The patch network is empty again for the next failure
+        reset_network();
+    }
+    
+    set_network(pool->network_pt);
+    free_network(patch_pt);
+    free_scheduler_context(scheduler_pt);
+    free(path);
+    free(path_utilization);
+    return NULL;
+}
+
+/**
+ Evaluate the failure of every link of the current network with a pool of threads and save all the results in the
+ report
+
+ @param num_threads number of threads, 0 to use one per available processor
+ @param report pointer to the report to fill, it has to be freed with free_failure_report
+ @param cache pointer to the cache where the patched links are saved as repair plans, NULL to not save them
+ @return number of failures patched, -1 if something went wrong
+ */
+int run_failure_pool(int num_threads, Failure_Report *report, Repair_Cache *cache) {
+    
+    if (report == NULL) {
+        fprintf(stderr, "The given report pointer is NULL\n");
+        return -1;
+    }
+    memset(report, 0, sizeof(Failure_Report));
+    if (get_network()->link_offsets == NULL || get_hyperperiod() <= 0) {
+        fprintf(stderr, "The network has to be scheduled to evaluate its link failures\n");
+        return -1;
+    }
+    
+    // One result for every link of the network, sorted by link id
+    report->results = calloc(get_higher_link_id() + 1, sizeof(Failure_Result));
+    if (report->results == NULL) {
+        fprintf(stderr, "Not enough memory for the results of the link failures\n");
+        return -1;
+    }
+    for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+        if (get_link(link_id) != NULL) {
+            report->results[report->num_results].link_id = link_id;
+            report->num_results++;
+        }
+    }
+    
+    // The fixed traffic of every link is the same in all the failures, so it is built only once
+    Baseline_Timelines baseline;
+    if (build_baseline_timelines(&baseline) == -1) {
+        free_failure_report(report);
+        return -1;
+    }
+    
+    Failure_Pool pool;
+    pool.report = report;
+    pool.next_result = 0;
+    pool.error = 0;
+    pool.network_pt = get_network();
+    pool.scheduler_pt = get_scheduler_context();
+    pool.baseline = &baseline;
+    pool.cache = cache;
+    pthread_mutex_init(&pool.lock, NULL);
+    
+    if (num_threads == 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads > report->num_results) {
+        num_threads = report->num_results;
+    }
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+    pthread_t *threads = malloc(sizeof(pthread_t) * num_threads);
+    if (threads == NULL) {
+        fprintf(stderr, "Not enough memory for the threads that evaluate the failures\n");
+        pthread_mutex_destroy(&pool.lock);
+        free_baseline_timelines(&baseline);
+        free_failure_report(report);
+        return -1;
+    }
+    
+    // If a thread can not be created, the ones already created evaluate all the failures
+    int created = 0;
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&threads[created], NULL, evaluate_failures_thread, &pool) == 0) {
+            created++;
+        }
+    }
+    if (created == 0) {
+        evaluate_failures_thread(&pool);
+    }
+    for (int i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    pthread_mutex_destroy(&pool.lock);
+    free_baseline_timelines(&baseline);
+    
+    // If a thread failed, some failures might have not been evaluated
+    if (pool.error == 1 || pool.next_result < report->num_results) {
+        fprintf(stderr, "Some of the link failures could not be evaluated\n");
+        free_failure_report(report);
+        return -1;
+    }
+    
+    int num_patched = 0;
+    for (int i = 0; i < report->num_results; i++) {
+        if (report->results[i].status == failure_patched) {
+            num_patched++;
+        }
+    }
+    
+    return num_patched;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Evaluate the failure of every link of the current network and save all the results in the report
+ */
+int evaluate_link_failures(int num_threads, Failure_Report *report) {
+    
+    return run_failure_pool(num_threads, report, NULL);
+}
+
+/**
+ Build the repair plans of the failures of every link of the current network
+ */
+int build_repair_cache(int num_threads, Repair_Cache *cache) {
+    
+    if (cache == NULL || get_network_file() == NULL) {
+        fprintf(stderr, "The given cache pointer is NULL or the network was not read from a file\n");
+        return -1;
+    }
+    if (init_repair_cache(cache, get_network_file()) == -1) {
+        return -1;
+    }
+    
+    // The results are not needed, only the plans saved while patching
+    Failure_Report report;
+    if (run_failure_pool(num_threads, &report, cache) == -1) {
+        free_repair_cache(cache);
+        return -1;
+    }
+    free_failure_report(&report);
+    sort_repair_plans(cache);
+    
+    return cache->num_plans;
+}
+
+/**
+ Write the results of the report in a csv file, one failure per line after a header with the name of the columns
+ */
+int write_failure_report_csv(Failure_Report *report, char *csv_file) {
+    
+    if (report == NULL || csv_file == NULL) {
+        fprintf(stderr, "The given report or file pointer is NULL\n");
+        return -1;
+    }
+    FILE *file_pt = fopen(csv_file, "w");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The csv file of the failures could not be created\n");
+        return -1;
+    }
+    
+    const char *status_names[] = {"Patched", "NotPatched", "NoPath", "NoTraffic", "Invalid"};
+    fprintf(file_pt, "LinkID,Status,Frames,PathLinks,LinkUtilization,PathUtilization,PatchTime,ExecutionTime\n");
+    for (int i = 0; i < report->num_results; i++) {
+        Failure_Result *result = &report->results[i];
+        fprintf(file_pt, "%d,%s,%d,%d,%.6f,%.6f,%lld,%lld\n", result->link_id, status_names[result->status],
+                result->num_frames, result->len_path, result->link_utilization, result->path_utilization,
+                result->patch_time, result->execution_time);
+    }
+    
+    if (fclose(file_pt) != 0) {
+        fprintf(stderr, "The csv file of the failures could not be written\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Free the results of the report
+ */
+int free_failure_report(Failure_Report *report) {
+    
+    if (report == NULL) {
+        fprintf(stderr, "The given report pointer is NULL\n");
+        return -1;
+    }
+    
+    free(report->results);
+    report->results = NULL;
+    report->num_results = 0;
+    
+    return 0;
+}
@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Failure.h                                                                                                          *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that evaluates the failure of every link of a scheduled network, one failure at a time, as the evaluator   *
+ *  does with the simulator but without writing any file. The network is read and scheduled once, and every failure    *
+ *  derives the patch of the links of the path that replaces the failed link directly from the schedule in memory.     *
+ *  The failures are spread over a pool of threads, every thread patches in its own network and scheduler.             *
+ *  The same evaluation builds the repair plans of all the failures, so they are patched offline only once.            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Failure_h
+#define Failure_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#endif /* Failure_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Result of the failure of a link
+ */
+typedef enum Failure_Status {
+    failure_patched,                // All the links of the path that replaces the failed link were patched
+    failure_not_patched,            // The traffic of the failed link could not be patched in the path
+    failure_no_path,                // There is no path that replaces the failed link
+    failure_no_traffic,             // The failed link had no traffic, nothing to patch
+    failure_invalid                 // The path was patched but the validator found violations in the schedule
+}Failure_Status;
+
+/**
+ Evaluation of the failure of a link
+ */
+typedef struct Failure_Result {
+    int link_id;                    // Failed link
+    Failure_Status status;          // Result of the failure
+    int num_frames;                 // Number of frames transmitted in the failed link
+    int len_path;                   // Number of links of the path that replaces the failed link, 0 if there is none
+    double link_utilization;        // Utilization of the failed link before the failure
+    double path_utilization;        // Highest utilization of the links of the path once patched
+    long long int patch_time;       // Longest time to patch a link of the path in ns, they are patched in parallel
+    long long int execution_time;   // Time to derive and patch the failure in ns
+}Failure_Result;
+
+/**
+ Report with the results of the failures of all the links
+ */
+typedef struct Failure_Report {
+    Failure_Result *results;        // Results sorted by link id
+    int num_results;                // Number of results, one per link of the network
+}Failure_Report;
+
+/**
+ Shared state of the threads that evaluate the failures
+ */
+typedef struct Failure_Pool {
+    Failure_Report *report;         // Report where every thread saves its results
+    int next_result;                // Position of the next failure to evaluate
+    int error;                      // 1 if a thread could not evaluate its failures, 0 otherwise
+    pthread_mutex_t lock;           // Lock to take the next failure
+    Network *network_pt;            // Scheduled network, only read by the threads
+    Scheduler_Context *scheduler_pt;    // Scheduler with the parameters of the patches
+    Baseline_Timelines *baseline;   // Fixed traffic of the links in the schedule, copied by all the patches
+    Repair_Cache *cache;            // Cache where the patched links are saved as repair plans, NULL if not saved
+}Failure_Pool;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Evaluate the failure of every link of the current network, that has to be scheduled, and save all the results in
+ the report. Every failure is patched with the parameters of the current scheduler, and the links of its path are
+ patched one after the other, as the failures already run in parallel. A failure is only counted as patched if the
+ validator accepts the schedule where its frames take the path that replaces the failed link
+
+ @param num_threads number of threads, 0 to use one per available processor
+ @param report pointer to the report to fill, it has to be freed with free_failure_report
+ @return number of failures patched, -1 if something went wrong
+ */
+int evaluate_link_failures(int num_threads, Failure_Report *report);
+
+/**
+ Build the repair plans of the failures of every link of the current network, that has to be scheduled. Every
+ failure is patched as in the evaluation, and every link of its path that is patched is saved as a plan of the cache
+
+ @param num_threads number of threads, 0 to use one per available processor
+ @param cache pointer to the cache to fill, it has to be freed with free_repair_cache
+ @return number of plans built, -1 if something went wrong
+ */
+int build_repair_cache(int num_threads, Repair_Cache *cache);
+
+/**
+ Write the results of the report in a csv file, one failure per line after a header with the name of the columns.
+ The times are in ns
+
+ @param report pointer to the report
+ @param csv_file name and path of the csv file
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_failure_report_csv(Failure_Report *report, char *csv_file);
+
+/**
+ Free the results of the report
+
+ @param report pointer to the report
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_failure_report(Failure_Report *report);
@@ -14,6 +14,71 @@
 
                                                 /* AUXILIAR FUNCTIONS */
 
+/**
+ Allocate in the arena an offset with all its matrices in a single block of memory
+
+ @param num_instances number of instances of the offset
+ @param num_replicas number of replicas of the offset
+ @param patch if the offset also needs the minimum and maximum transmission times (for patching)
+ @param period period between instances to store only the first one (strictly periodic), 0 to store all
+ @param arena_pt pointer to the arena
+ @return pointer to the offset, NULL if there is no memory
+ */
+Offset* alloc_offset(int num_instances, int num_replicas, int patch, long long int period, Arena *arena_pt) {
+    
+    size_t num_elements = (size_t)(period != 0 ? 1 : num_instances) * num_replicas;
+    size_t size_matrices = sizeof(long long int) * num_elements * (patch ? 3 : 1) + sizeof(int) * num_elements;
+    if (patch) {
+        size_matrices += sizeof(char) * num_elements;
+    }
+    
+    // The offset is followed by its matrices, first the 64 bits ones to keep them aligned
+    Offset *off_pt = alloc_arena(arena_pt, sizeof(Offset) + size_matrices);
+    if (off_pt == NULL) {
+        return NULL;
+    }
+    long long int *matrix_pt = (long long int *) (off_pt + 1);
+    off_pt->offset = matrix_pt;
+    matrix_pt += num_elements;
+    if (patch) {
+        off_pt->min_offset = matrix_pt;
+        matrix_pt += num_elements;
+        off_pt->max_offset = matrix_pt;
+        matrix_pt += num_elements;
+    } else {
+        off_pt->min_offset = NULL;
+        off_pt->max_offset = NULL;
+    }
+    off_pt->var_num = (int *) matrix_pt;
+    off_pt->var_name = patch ? (char *) (off_pt->var_num + num_elements) : NULL;
+    
+    // The offsets to patch are in the only link of their network, the other ones get their link from the hash
+    off_pt->link_id = 0;
+    off_pt->num_instances = num_instances;
+    off_pt->num_replicas = num_replicas;
+    off_pt->period = period;
+    for (size_t i = 0; i < num_elements; i++) {
+        off_pt->offset[i] = -1;
+        off_pt->var_num[i] = -1;
+    }
+    return off_pt;
+}
+
+/**
+ Get the position of the given instance and replica in the matrices of the offset.
+ All the instances of a strictly periodic offset share the position of the first one
+
+ @param pt pointer to the offset
+ @param instance instance of the offset
+ @param replica replica of the offset
+ @return position in the matrices
+ */
+size_t get_off_position(Offset *pt, int instance, int replica) {
+    
+    return (size_t)(pt->period != 0 ? 0 : instance) * pt->num_replicas + replica;
+}
+
+
                                                     /* FUNCTIONS */
 
 /* Getters */
@@ -146,6 +211,32 @@ int get_off_num_instances(Offset *pt) {
     return pt->num_instances;
 }
 
+/**
+ Get the number of instances of the offset that have their own transmission time and solver variable
+ */
+int get_off_stored_instances(Offset *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return -1;
+    }
+    
+    return pt->period != 0 ? 1 : pt->num_instances;
+}
+
+/**
+ Get the period between the instances of a strictly periodic offset
+ */
+long long int get_off_period(Offset *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return -1;
+    }
+    
+    return pt->period;
+}
+
 /**
  Get the number of replicas for the offset
  */
@@ -174,6 +265,19 @@ int get_off_time(Offset *pt) {
     return pt->time;
 }
 
+/**
+ Get the link id of the offset
+ */
+int get_off_link_id(Offset *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return -1;
+    }
+    
+    return pt->link_id;
+}
+
 /**
  Get the number of paths of the frame
  */
@@ -235,7 +339,7 @@ int get_var_name(Offset *pt, int instance, int replica) {
         return -1;
     }
     
-    return pt->var_num[instance][replica];
+    return pt->var_num[get_off_position(pt, instance, replica)];
 }
 
 /**
@@ -256,7 +360,46 @@ long long int get_trans_time(Offset *pt, int instance, int replica) {
         return -1;
     }
     
-    return pt->offset[instance][replica];
+    // The instances of a strictly periodic offset are a period after the previous one
+    long long int trans_time = pt->offset[get_off_position(pt, instance, replica)];
+    if (pt->period != 0 && trans_time != -1) {
+        trans_time += pt->period * instance;
+    }
+    return trans_time;
+}
+
+/**
+ Get the transmission times of all the replicas of the given instance, they are contiguous in memory
+ */
+long long int *get_replica_times(Offset *pt, int instance) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return NULL;
+    }
+    if (instance >= pt->num_instances || instance < 0) {
+        fprintf(stderr, "The given instance is outside the range of instances\n");
+        return NULL;
+    }
+    
+    return &pt->offset[get_off_position(pt, instance, 0)];
+}
+
+/**
+ Get the solver variables of all the replicas of the given instance, they are contiguous in memory
+ */
+int *get_replica_vars(Offset *pt, int instance) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return NULL;
+    }
+    if (instance >= pt->num_instances || instance < 0) {
+        fprintf(stderr, "The given instance is outside the range of instances\n");
+        return NULL;
+    }
+    
+    return &pt->var_num[get_off_position(pt, instance, 0)];
 }
 
 /**
@@ -277,7 +420,12 @@ long long int get_min_trans_time(Offset *pt, int instance, int replica) {
         return -1;
     }
     
-    return pt->min_offset[instance][replica];
+    // As the transmission time, the window of a strictly periodic offset is a period after the previous one
+    long long int min_transmission = pt->min_offset[get_off_position(pt, instance, replica)];
+    if (pt->period != 0) {
+        min_transmission += pt->period * instance;
+    }
+    return min_transmission;
 }
 
 /**
@@ -298,7 +446,24 @@ long long int get_max_trans_time(Offset *pt, int instance, int replica) {
         return -1;
     }
     
-    return pt->max_offset[instance][replica];
+    long long int max_transmission = pt->max_offset[get_off_position(pt, instance, replica)];
+    if (pt->period != 0) {
+        max_transmission += pt->period * instance;
+    }
+    return max_transmission;
+}
+
+/**
+ Check if the offset has a range of possible transmission times
+ */
+int has_trans_range(Offset *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return -1;
+    }
+    
+    return pt->min_offset != NULL;
 }
 
 /**
@@ -403,6 +568,12 @@ int set_period(Frame *pt, long long int period) {
     }
     
     pt->period = period;
+    // The strictly periodic offsets also keep the period, in case it is changed after they were created
+    for (int i = 0; i < pt->num_offsets; i++) {
+        if (pt->offset_it[i]->period != 0) {
+            pt->offset_it[i]->period = period;
+        }
+    }
     return 0;
 }
 
@@ -565,7 +736,7 @@ int set_var_name(Offset *pt, int instance, int replica, int name) {
         return -1;
     }
 
-    pt->var_num[instance][replica] = name;
+    pt->var_num[get_off_position(pt, instance, replica)] = name;
     return 0;
 }
 
@@ -587,7 +758,11 @@ int set_trans_time(Offset *pt, int instance, int replica, long long int time) {
         return -1;
     }
     
-    pt->offset[instance][replica] = time;
+    // Strictly periodic offsets save the time given by any instance as the time of the first instance
+    if (pt->period != 0 && time != -1) {
+        time -= pt->period * instance;
+    }
+    pt->offset[get_off_position(pt, instance, replica)] = time;
     return 0;
 }
 
@@ -610,9 +785,37 @@ int set_trans_range(Offset *pt, int instance, int replica, long long int min_tra
         return -1;
     }
     
+    // Strictly periodic offsets save the range given by any instance as the range of the first instance
+    if (pt->period != 0) {
+        min_transmission -= pt->period * instance;
+        max_transmission -= pt->period * instance;
+    }
     pt->time = time_slots;
-    pt->min_offset[instance][replica] = min_transmission;
-    pt->max_offset[instance][replica] = max_transmission;
+    pt->min_offset[get_off_position(pt, instance, replica)] = min_transmission;
+    pt->max_offset[get_off_position(pt, instance, replica)] = max_transmission;
+    
+    return 0;
+}
+
+/**
+ Set the range of all the replicas of an instance of an offset, every replica goes after the previous one
+ */
+int set_instance_range(Offset *pt, int instance, long long int min_transmission, long long int max_transmission,
+                       int time_slots) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given offset pointer is NULL\n");
+        return -1;
+    }
+    
+    // The first replica starts at the minimum and the last one at the maximum at the latest
+    for (int repl = 0; repl < pt->num_replicas; repl++) {
+        long long int min = min_transmission + (long long int) repl * time_slots;
+        long long int max = max_transmission - (long long int) (pt->num_replicas - 1 - repl) * time_slots;
+        if (set_trans_range(pt, instance, repl, min, max, time_slots) == -1) {
+            return -1;
+        }
+    }
     
     return 0;
 }
@@ -622,7 +825,8 @@ int set_trans_range(Offset *pt, int instance, int replica, long long int min_tra
 /**
  Initialize all the offsets once the frame values and the paths are filled
  */
-int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod) {
+int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod, int periodic, int *link_replicas,
+                 Arena *arena_pt) {
     
     if (pt == NULL) {
         fprintf(stderr, "The given pointer is NULL\n");
@@ -630,53 +834,54 @@ int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod) {
     }
     
     // Init the offset hash depending in the number of max link ids
-    pt->num_offsets = 0;
-    pt->offset_it = NULL;
-    pt->offset_hash = malloc(sizeof(Offset*) * max_link_id + 1);
+    pt->offset_hash = alloc_arena(arena_pt, sizeof(Offset*) * (max_link_id + 1));
+    if (pt->offset_hash == NULL) {
+        return -1;
+    }
     for (int i = 0; i <= max_link_id; i++) {
         pt->offset_hash[i] = NULL;
     }
     int instances = (int)(hyperperiod / pt->period);
-    // For all paths in the network
+    
+    // The offset iterator cannot be larger than all the links in the paths together
+    int max_offsets = 0;
+    for (int i = 0; i < pt->num_paths; i++) {
+        max_offsets += pt->list_paths[i].length_path;
+    }
+    pt->offset_it = alloc_arena(arena_pt, sizeof(Offset*) * max_offsets);
+    if (pt->offset_it == NULL) {
+        return -1;
+    }
+    
+    // For all the links in all the paths, create the offset if it does not exist yet
+    pt->num_offsets = 0;
     for (int i = 0; i < pt->num_paths; i++) {
-        // For all the links in the path
-        pt->list_paths[i].list_offsets = malloc(sizeof(Offset*) * pt->list_paths[i].length_path);
+        pt->list_paths[i].list_offsets = alloc_arena(arena_pt, sizeof(Offset*) * pt->list_paths[i].length_path);
+        if (pt->list_paths[i].list_offsets == NULL) {
+            return -1;
+        }
         for (int j = 0; j < pt->list_paths[i].length_path; j++) {
             
             // If the offset in the hash has not been initialized yet, init before assign it
             int link_id = pt->list_paths[i].path[j];
             if (pt->offset_hash[link_id] == NULL) {
                 
-                // Populate the offset
-                pt->offset_hash[link_id] = malloc(sizeof(Offset));
+                // Populate the offset, the transmission times matrix is set to undefined
+                long long int period = periodic == 1 ? pt->period : 0;
+                int replicas = link_replicas != NULL ? link_replicas[link_id] : 1;
+                pt->offset_hash[link_id] = alloc_offset(instances, replicas, 0, period, arena_pt);
+                if (pt->offset_hash[link_id] == NULL) {
+                    return -1;
+                }
                 pt->offset_hash[link_id]->link_id = link_id;
-                pt->offset_hash[link_id]->num_instances = instances;
-                pt->offset_hash[link_id]->num_replicas = 1;     // We do not implement Wireless yet...
                 pt->offset_hash[link_id]->time = -1;            // Will be defined later
-                // Allocate also the transmission times matrix and set to undifined
-                pt->offset_hash[link_id]->offset = malloc(sizeof(long long int*) *
-                                                          pt->offset_hash[link_id]->num_instances);
-                pt->offset_hash[link_id]->var_num = malloc(sizeof(int*) * pt->offset_hash[link_id]->num_instances);
-                for (int inst = 0; inst < pt->offset_hash[link_id]->num_instances; inst++) {
-                    pt->offset_hash[link_id]->offset[inst] = malloc(sizeof(long long int) *
-                                                                    pt->offset_hash[link_id]->num_replicas);
-                    pt->offset_hash[link_id]->var_num[inst] = malloc(sizeof(int) *
-                                                                     pt->offset_hash[link_id]->num_replicas);
-                    for (int repl = 0; repl < pt->offset_hash[link_id]->num_replicas; repl++) {
-                        pt->offset_hash[link_id]->offset[inst][repl] = -1;
-                        pt->offset_hash[link_id]->var_num[inst][repl] = -1;
-                    }
-                }
                 
                 // Add the offset to the offset iterator
+                pt->offset_it[pt->num_offsets] = pt->offset_hash[link_id];
                 pt->num_offsets += 1;
-                pt->offset_it = realloc(pt->offset_it, sizeof(Offset*) * pt->num_offsets);
-                pt->offset_it[pt->num_offsets - 1] = pt->offset_hash[link_id];
-                
             }
             pt->list_paths[i].list_offsets[j] = pt->offset_hash[link_id];
         }
-        
     }
     
     return 0;
@@ -689,7 +894,7 @@ int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod) {
  The purpose of these kind of frames is to avoid other frames to be transmitted in the times the reservation is active.
 
  */
-int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperiod) {
+int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperiod, Arena *arena_pt) {
     
     if (pt == NULL) {
         fprintf(stderr, "The given pointer is NULL\n");
@@ -697,32 +902,23 @@ int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperio
     }
     
     // Init the offset iterator depending in the number of max link ids
-    pt->num_offsets = 0;
-    pt->offset_hash = malloc(sizeof(Offset*) * max_link_id + 1);
+    pt->num_offsets = max_link_id + 1;
+    pt->offset_hash = alloc_arena(arena_pt, sizeof(Offset*) * (max_link_id + 1));
+    pt->offset_it = alloc_arena(arena_pt, sizeof(Offset*) * (max_link_id + 1));
+    if (pt->offset_hash == NULL || pt->offset_it == NULL) {
+        return -1;
+    }
     int instances = (int)(hyperperiod / pt->period);
     
     // For all possible links we create the offset, eventhough we might not needed
     for (int i = 0; i <= max_link_id; i++) {
-        pt->offset_hash[i] = malloc(sizeof(Offset));
+        pt->offset_hash[i] = alloc_offset(instances, 1, 0, 0, arena_pt);
+        if (pt->offset_hash[i] == NULL) {
+            return -1;
+        }
         pt->offset_hash[i]->link_id = i;
-        pt->offset_hash[i]->num_instances = instances;
-        pt->offset_hash[i]->num_replicas = 1;
         pt->offset_hash[i]->time = pt->size;
-        
-        // Allocate the transmission times and already set them as we know them
-        pt->offset_hash[i]->offset = malloc(sizeof(long long int*) * instances);
-        pt->offset_hash[i]->var_num = malloc(sizeof(int*) * instances);
-        for (int inst = 0; inst < instances; inst++) {
-            pt->offset_hash[i]->offset[inst] = malloc(sizeof(long long int));
-            pt->offset_hash[i]->var_num[inst] = malloc(sizeof(int) * instances);
-            pt->offset_hash[i]->offset[inst][0] = pt->period * inst;
-            pt->offset_hash[i]->offset[inst][0] = -1;
-        }
-        
-        // Add the offset to the offset iterator
-        pt->num_offsets += 1;
-        pt->offset_it = realloc(pt->offset_it, sizeof(Offset*) * pt->num_offsets);
-        pt->offset_it[pt->num_offsets - 1] = pt->offset_hash[i];
+        pt->offset_it[i] = pt->offset_hash[i];
     }
     
     return 0;
@@ -731,7 +927,7 @@ int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperio
 /**
  For the given frame, init the offset needed to save the information of a frame with a single offset
  */
-int init_offset_patch(Frame *pt, int instance, int replica) {
+int init_offset_patch(Frame *pt, int instance, int replica, Arena *arena_pt) {
     
     if (instance <= 0) {
         fprintf(stderr, "The number of instances should be a positive number\n");
@@ -744,23 +940,35 @@ int init_offset_patch(Frame *pt, int instance, int replica) {
     
     // Init the offset in the frame
     pt->num_offsets = 1;
-    pt->offset_it = malloc(sizeof(Offset*));
-    pt->offset_it[0] = malloc(sizeof(Offset));
+    pt->offset_it = alloc_arena(arena_pt, sizeof(Offset*));
+    if (pt->offset_it == NULL) {
+        return -1;
+    }
     
     // Allocate the needed information of the offset
-    pt->offset_it[0]->num_instances = instance;
-    pt->offset_it[0]->num_replicas = replica + 1;
-    pt->offset_it[0]->offset = malloc(sizeof(long long int *) * instance);
-    pt->offset_it[0]->min_offset = malloc(sizeof(long long int *) * instance);
-    pt->offset_it[0]->max_offset = malloc(sizeof(long long int *) * instance);
-    pt->offset_it[0]->var_num = malloc(sizeof(int *) * instance);
-    pt->offset_it[0]->var_name = malloc(sizeof(char *) * instance);
-    for (int i = 0; i < instance; i++) {
-        pt->offset_it[0]->offset[i] = malloc(sizeof(long long int) * (replica + 1));
-        pt->offset_it[0]->min_offset[i] = malloc(sizeof(long long int) * (replica + 1));
-        pt->offset_it[0]->max_offset[i] = malloc(sizeof(long long int) * (replica + 1));
-        pt->offset_it[0]->var_num[i] = malloc(sizeof(int) * (replica + 1));
-        pt->offset_it[0]->var_name[i] = malloc(sizeof(char) * (replica + 1));
+    pt->offset_it[0] = alloc_offset(instance, replica + 1, 1, 0, arena_pt);
+    if (pt->offset_it[0] == NULL) {
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Forget all the offsets of the frame, their memory is released when the arena that contains them is released
+ */
+int clear_offsets(Frame *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given pointer is NULL\n");
+        return -1;
+    }
+    
+    pt->offset_hash = NULL;
+    pt->offset_it = NULL;
+    pt->num_offsets = 0;
+    for (int i = 0; i < pt->num_paths; i++) {
+        pt->list_paths[i].list_offsets = NULL;
     }
     
     return 0;
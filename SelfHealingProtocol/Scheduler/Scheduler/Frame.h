@@ -18,21 +18,30 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "Arena.h"
 
 #endif /* Frame_h */
 
                                                 /* STRUCT DEFINITIONS */
 
+/**
+ Structure with the information of the offset of a frame in a link.
+ All the matrices are stored flattened in one row, the position of every instance and replica is
+ [instance * num_replicas + replica].
+ If the offset is strictly periodic, only the first instance is stored and the instance k is transmitted k periods
+ after it
+ */
 typedef struct Offset {
-    long long int **offset;             // Matrix with the transmission times in ns
-    long long int **min_offset;         // Matrix with the minimum transmission time allowed in ns (for patching)
-    long long int **max_offset;         // Matrix with the maximum transmission time allowed in ns (for patching)
-    int **var_num;                      // Variable number for the gurobi solver
-    char **var_name;                    // Variable name for the gurobi solver
+    long long int *offset;              // Matrix with the transmission times in ns
+    long long int *min_offset;          // Matrix with the minimum transmission time allowed in ns (for patching)
+    long long int *max_offset;          // Matrix with the maximum transmission time allowed in ns (for patching)
+    int *var_num;                       // Variable number for the gurobi solver
+    char *var_name;                     // Variable name for the gurobi solver
     int num_instances;                  // Number of offset instances (hyperperiod / period frame)
     int num_replicas;                   // Number of offset replicas due to wireless (1 => no replication)
     int time;                           // Number of timeslots to transmit in the current link
     int link_id;                        // Link id of the current offset
+    long long int period;               // Period between instances if only the first is stored, 0 otherwise
 }Offset;
 
 /**
@@ -167,6 +176,23 @@ int get_off_num_instances(Offset *pt);
  */
 int get_off_num_replicas(Offset *pt);
 
+/**
+ Get the number of instances of the offset that have their own transmission time and solver variable.
+ It is 1 for strictly periodic offsets, as the rest of instances are a period after the previous one
+
+ @param pt pointer to the offset
+ @return number of stored instances
+ */
+int get_off_stored_instances(Offset *pt);
+
+/**
+ Get the period between the instances of a strictly periodic offset
+
+ @param pt pointer to the offset
+ @return period in ns, 0 if all the instances are stored, -1 if something went wrong
+ */
+long long int get_off_period(Offset *pt);
+
 /**
  Get the time to transmit the offset in the specific link
 
@@ -175,6 +201,14 @@ int get_off_num_replicas(Offset *pt);
  */
 int get_off_time(Offset *pt);
 
+/**
+ Get the link id of the offset
+
+ @param pt pointer to the offset
+ @return link id of the offset
+ */
+int get_off_link_id(Offset *pt);
+
 /**
  Get the number of paths of the frame
 
@@ -213,7 +247,29 @@ int get_var_name(Offset *pt, int instance, int replica);
 long long int get_trans_time(Offset *pt, int instance, int replica);
 
 /**
- Get the minimum possible transmission time of the given offset, instance and replica
+ Get the transmission times of all the replicas of the given instance, they are contiguous so the loops over the
+ replicas do not check every access. Strictly periodic offsets return the times of the first instance, that have to
+ be shifted by the period of the instance
+
+ @param pt pointer to the offset
+ @param instance number of instance
+ @return pointer to the transmission times of the replicas, NULL if the instance does not exist
+ */
+long long int *get_replica_times(Offset *pt, int instance);
+
+/**
+ Get the solver variables of all the replicas of the given instance, they are contiguous so the loops over the
+ replicas do not check every access
+
+ @param pt pointer to the offset
+ @param instance number of instance
+ @return pointer to the variables of the replicas, NULL if the instance does not exist
+ */
+int *get_replica_vars(Offset *pt, int instance);
+
+/**
+ Get the minimum possible transmission time of the given offset, instance and replica.
+ The instances of a strictly periodic offset have the window of the first instance a period after the previous one
  
  @param pt pointer to the offset
  @param instance number of instance
@@ -223,7 +279,8 @@ long long int get_trans_time(Offset *pt, int instance, int replica);
 long long int get_min_trans_time(Offset *pt, int instance, int replica);
 
 /**
- Get the maximum possible transmission time of the given offset, instance and replica
+ Get the maximum possible transmission time of the given offset, instance and replica.
+ The instances of a strictly periodic offset have the window of the first instance a period after the previous one
  
  @param pt pointer to the offset
  @param instance number of instance
@@ -232,6 +289,14 @@ long long int get_min_trans_time(Offset *pt, int instance, int replica);
  */
 long long int get_max_trans_time(Offset *pt, int instance, int replica);
 
+/**
+ Check if the offset has a range of possible transmission times, only the offsets to patch have it
+ 
+ @param pt pointer to the offset
+ @return 1 if the offset has a range, 0 if not, -1 if the offset is NULL
+ */
+int has_trans_range(Offset *pt);
+
 /**
  Get the number of paths in a link
 
@@ -381,6 +446,20 @@ int set_trans_time(Offset *pt, int instance, int replica, long long int time);
 int set_trans_range(Offset *pt, int instance, int replica, long long int min_transmission,
                     long long int max_transmission, int time_slots);
 
+/**
+ Set the available range of transmission time of all the replicas of an instance of an offset. Every replica goes
+ after the previous one, so the first replica starts from the minimum and the last one until the maximum
+ 
+ @param pt pointer to the offset
+ @param instance number of instance
+ @param min_transmission minimum available transmission of the first replica
+ @param max_transmission maximum available transmission of the last replica
+ @param time_slots number of time slots of every transmission
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_instance_range(Offset *pt, int instance, long long int min_transmission, long long int max_transmission,
+                       int time_slots);
+
 /* Functions */
 
 /**
@@ -389,9 +468,13 @@ int set_trans_range(Offset *pt, int instance, int replica, long long int min_tra
  @param pt pointer to the frame
  @param max_link_id maximum link id needed to init the offset hash
  @param hyperperiod hyperperiod of the schedule needed to calculate the frame number of instances
+ @param periodic 1 to store only the first instance of every offset (strictly periodic), 0 to store all of them
+ @param link_replicas number of replicas of every link id, NULL if no link repeats the transmissions
+ @param arena_pt pointer to the arena where the offsets are allocated
  @return 0 if done correctly, -1 otherwise
  */
-int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod);
+int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod, int periodic, int *link_replicas,
+                 Arena *arena_pt);
 
 /**
  Initialize all the offsets for a reservation frame.
@@ -402,9 +485,10 @@ int init_offsets(Frame *pt, int max_link_id, long long int hyperperiod);
  @param pt pointer to the reservation frame
  @param max_link_id maximum link id needed to init the offset hash
  @param hyperperiod of the schedule needed to calculate the frame number of instances
+ @param arena_pt pointer to the arena where the offsets are allocated
  @return 0 if done correctly, -1 otherwise
  */
-int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperiod);
+int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperiod, Arena *arena_pt);
 
 /**
  For the given frame, init the offset needed to save the information of a frame with a single offset
@@ -412,6 +496,15 @@ int init_offset_reservation(Frame *pt, int max_link_id, long long int hyperperio
  @param pt pointer to the frame
  @param instance number of instances in the offset
  @param replica number of replicas in the offset
+ @param arena_pt pointer to the arena where the offset is allocated
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_offset_patch(Frame *pt, int instance, int replica, Arena *arena_pt);
+
+/**
+ Forget all the offsets of the frame, their memory is released when the arena that contains them is released
+
+ @param pt pointer to the frame
  @return 0 if done correctly, -1 otherwise
  */
-int init_offset_patch(Frame *pt, int instance, int replica);
+int clear_offsets(Frame *pt);
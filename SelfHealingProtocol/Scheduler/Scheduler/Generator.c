@@ -0,0 +1,497 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Generator.c                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Generator.h                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Generator.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get the next random number of a xorshift generator, so the same seed always generates the same network
+
+ @param seed pointer to the state of the generator
+ @return random number
+ */
+unsigned int next_random(unsigned int *seed) {
+    
+    // A zero state would only generate zeros
+    if (*seed == 0) {
+        *seed = 2463534242;
+    }
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+/**
+ Get a random number between two given values, both included
+
+ @param seed pointer to the state of the generator
+ @param min minimum value
+ @param max maximum value
+ @return random number
+ */
+int get_random(unsigned int *seed, int min, int max) {
+    
+    return min + (int) (next_random(seed) % (unsigned int) (max - min + 1));
+}
+
+/**
+ Search the link that goes from a node to another
+
+ @param gen pointer to the generated network
+ @param sender id of the sender node
+ @param receiver id of the receiver node
+ @return id of the link, -1 if the nodes are not connected
+ */
+int find_generator_link(Generator_Network *gen, int sender, int receiver) {
+    
+    for (int i = 0; i < gen->num_links; i++) {
+        if (gen->link_sender[i] == sender && gen->link_receiver[i] == receiver) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ Connect two nodes with a link in each direction, the memory of the links is already allocated
+
+ @param gen pointer to the generated network
+ @param node_a id of a node
+ @param node_b id of the other node
+ @return 0 if done correctly, -1 if they were already connected
+ */
+int connect_generator_nodes(Generator_Network *gen, int node_a, int node_b) {
+    
+    if (node_a == node_b || find_generator_link(gen, node_a, node_b) != -1) {
+        return -1;
+    }
+    gen->link_sender[gen->num_links] = node_a;
+    gen->link_receiver[gen->num_links] = node_b;
+    gen->num_links++;
+    gen->link_sender[gen->num_links] = node_b;
+    gen->link_receiver[gen->num_links] = node_a;
+    gen->num_links++;
+    
+    return 0;
+}
+
+/**
+ Connect the switches in the topology of the parameters and the end systems to their switches.
+ The switches are the first nodes, and the end systems of every switch follow them in order
+
+ @param params pointer to the parameters
+ @param gen pointer to the generated network, with the memory of the links already allocated
+ @param seed pointer to the state of the random generator
+ @return 0 if done correctly, -1 otherwise
+ */
+int build_generator_topology(Generator_Parameters *params, Generator_Network *gen, unsigned int *seed) {
+    
+    int num_switches = params->num_switches;
+    gen->num_nodes = num_switches + num_switches * params->num_end_systems;
+    gen->num_links = 0;
+    for (int i = 0; i < num_switches - 1; i++) {
+        connect_generator_nodes(gen, i, i + 1);
+    }
+    // With two switches the ring is already a line
+    if (params->topology != topology_line && num_switches > 2) {
+        connect_generator_nodes(gen, num_switches - 1, 0);
+    }
+    if (params->topology == topology_mesh) {
+        int added = 0;
+        for (int attempt = 0; added < params->num_extra_links && attempt < 100 * params->num_extra_links; attempt++) {
+            int node_a = get_random(seed, 0, num_switches - 1);
+            int node_b = get_random(seed, 0, num_switches - 1);
+            if (connect_generator_nodes(gen, node_a, node_b) == 0) {
+                added++;
+            }
+        }
+        if (added < params->num_extra_links) {
+            fprintf(stderr, "Only %d extra links could be added to the mesh\n", added);
+        }
+    }
+    for (int i = 0; i < num_switches * params->num_end_systems; i++) {
+        connect_generator_nodes(gen, num_switches + i, i / params->num_end_systems);
+    }
+    
+    return 0;
+}
+
+/**
+ Get the shortest path between two end systems, only through switches
+
+ @param gen pointer to the generated network
+ @param params pointer to the parameters
+ @param sender id of the sender end system
+ @param receiver id of the receiver end system
+ @param path memory for the link ids of the path
+ @param previous memory for the link that reaches every switch
+ @param queue memory for the switches to visit
+ @return number of links of the path, -1 if there is no path
+ */
+int get_generator_path(Generator_Network *gen, Generator_Parameters *params, int sender, int receiver, int *path,
+                       int *previous, int *queue) {
+    
+    int first = (sender - params->num_switches) / params->num_end_systems;
+    int last = (receiver - params->num_switches) / params->num_end_systems;
+    for (int i = 0; i < params->num_switches; i++) {
+        previous[i] = -2;
+    }
+    
+    // Breadth first search from the switch of the sender, the links are visited in order so it is deterministic
+    int head = 0, tail = 0;
+    previous[first] = -1;
+    queue[tail++] = first;
+    while (head < tail && previous[last] == -2) {
+        int node = queue[head++];
+        for (int i = 0; i < gen->num_links; i++) {
+            int next = gen->link_receiver[i];
+            if (gen->link_sender[i] == node && next < params->num_switches && previous[next] == -2) {
+                previous[next] = i;
+                queue[tail++] = next;
+            }
+        }
+    }
+    if (previous[last] == -2) {
+        return -1;
+    }
+    
+    // Count the switch links to write the path from the sender
+    int len_path = 2;
+    for (int node = last; previous[node] != -1; node = gen->link_sender[previous[node]]) {
+        len_path++;
+    }
+    path[0] = find_generator_link(gen, sender, first);
+    path[len_path - 1] = find_generator_link(gen, last, receiver);
+    int path_it = len_path - 2;
+    for (int node = last; previous[node] != -1; node = gen->link_sender[previous[node]]) {
+        path[path_it--] = previous[node];
+    }
+    
+    return len_path;
+}
+
+/**
+ Write a value with its unit as a child of the given node
+
+ @param root_xml pointer to the parent node
+ @param name name of the child
+ @param value value of the child
+ @param unit unit of the value, NULL if it has no unit
+ @return pointer to the child
+ */
+xmlNode * write_generator_value_xml(xmlNode *root_xml, char *name, long long int value, char *unit) {
+    
+    char char_value[100];
+    
+    sprintf(char_value, "%lld", value);
+    xmlNode *value_xml = xmlNewChild(root_xml, NULL, BAD_CAST name, BAD_CAST char_value);
+    if (unit != NULL) {
+        xmlNewProp(value_xml, BAD_CAST "unit", BAD_CAST unit);
+    }
+    return value_xml;
+}
+
+/**
+ Write the general information of the generated network
+
+ @param root_xml pointer to the root of the network
+ @param params pointer to the parameters
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_generator_general_xml(xmlNode *root_xml, Generator_Parameters *params) {
+    
+    xmlNode *general_xml = xmlNewChild(root_xml, NULL, BAD_CAST "GeneralInformation", NULL);
+    xmlNode *switch_xml = xmlNewChild(general_xml, NULL, BAD_CAST "SwitchInformation", NULL);
+    write_generator_value_xml(switch_xml, "MinimumTime", params->switch_time, "ns");
+    if (params->protocol_period != 0) {
+        xmlNode *protocol_xml = xmlNewChild(general_xml, NULL, BAD_CAST "SelfHealingProtocol", NULL);
+        write_generator_value_xml(protocol_xml, "Period", params->protocol_period, "us");
+        write_generator_value_xml(protocol_xml, "Time", params->protocol_time, "ns");
+    }
+    
+    return 0;
+}
+
+/**
+ Write the nodes of the generated network with their connections
+
+ @param root_xml pointer to the root of the network
+ @param gen pointer to the generated network
+ @param params pointer to the parameters
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_generator_topology_xml(xmlNode *root_xml, Generator_Network *gen, Generator_Parameters *params) {
+    
+    xmlNode *topology_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TopologyInformation", NULL);
+    for (int node = 0; node < gen->num_nodes; node++) {
+        xmlNode *node_xml = xmlNewChild(topology_xml, NULL, BAD_CAST "Node", NULL);
+        xmlNewProp(node_xml, BAD_CAST "category", BAD_CAST (node < params->num_switches ? "Switch" : "EndSystem"));
+        write_generator_value_xml(node_xml, "NodeID", node, NULL);
+        for (int i = 0; i < gen->num_links; i++) {
+            if (gen->link_sender[i] == node) {
+                xmlNode *connection_xml = xmlNewChild(node_xml, NULL, BAD_CAST "Connection", NULL);
+                write_generator_value_xml(connection_xml, "NodeID", gen->link_receiver[i], NULL);
+                xmlNode *link_xml = xmlNewChild(connection_xml, NULL, BAD_CAST "Link", NULL);
+                xmlNewProp(link_xml, BAD_CAST "category", BAD_CAST "Wired");
+                write_generator_value_xml(link_xml, "LinkID", i, NULL);
+                write_generator_value_xml(link_xml, "Speed", params->speed, "MBs");
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Generate the frames until the number of frames is reached or no more frames fit in the links, and write them
+
+ @param root_xml pointer to the root of the network
+ @param gen pointer to the generated network
+ @param params pointer to the parameters
+ @param seed pointer to the state of the random generator
+ @return number of frames generated, -1 if something went wrong
+ */
+int write_generator_traffic_xml(xmlNode *root_xml, Generator_Network *gen, Generator_Parameters *params,
+                                unsigned int *seed) {
+    
+    int num_end_systems = params->num_switches * params->num_end_systems;
+    int max_receivers = params->max_receivers < num_end_systems - 1 ? params->max_receivers : num_end_systems - 1;
+    int max_len = params->num_switches + 1;
+    int *receivers = malloc(sizeof(int) * num_end_systems);
+    int *paths = malloc(sizeof(int) * max_receivers * max_len);
+    int *len_paths = malloc(sizeof(int) * max_receivers);
+    int *previous = malloc(sizeof(int) * params->num_switches);
+    int *queue = malloc(sizeof(int) * params->num_switches);
+    int *frame_links = malloc(sizeof(int) * gen->num_links);
+    int *last_use = malloc(sizeof(int) * gen->num_links);
+    char *path_value = malloc(sizeof(char) * max_len * 12);
+    if (receivers == NULL || paths == NULL || len_paths == NULL || previous == NULL || queue == NULL ||
+        frame_links == NULL || last_use == NULL || path_value == NULL) {
+        fprintf(stderr, "Not enough memory to generate the frames\n");
+        free(receivers);
+        free(paths);
+        free(len_paths);
+        free(previous);
+        free(queue);
+        free(frame_links);
+        free(last_use);
+        free(path_value);
+        return -1;
+    }
+    for (int i = 0; i < gen->num_links; i++) {
+        last_use[i] = -1;
+    }
+    
+    xmlNode *traffic_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TrafficDescription", NULL);
+    int num_frames = 0;
+    for (int attempt = 0; num_frames < params->num_frames && attempt < 20 * params->num_frames; attempt++) {
+        
+        // A random sender with random different receivers, chosen from the end systems shuffled
+        int sender = params->num_switches + get_random(seed, 0, num_end_systems - 1);
+        int num_receivers = get_random(seed, 1, max_receivers);
+        for (int i = 0; i < num_end_systems; i++) {
+            receivers[i] = params->num_switches + i;
+        }
+        receivers[sender - params->num_switches] = receivers[num_end_systems - 1];
+        for (int i = 0; i < num_receivers; i++) {
+            int pos = get_random(seed, i, num_end_systems - 2);
+            int receiver = receivers[pos];
+            receivers[pos] = receivers[i];
+            receivers[i] = receiver;
+        }
+        long long int period = params->periods[get_random(seed, 0, params->num_periods - 1)];
+        int size = get_random(seed, params->min_size, params->max_size);
+        
+        // The frame fits if all the links of its paths, counted once, keep under the utilization
+        double frame_utilization = (double) size / params->speed / period;
+        int num_links = 0, fits = 1;
+        for (int i = 0; i < num_receivers && fits == 1; i++) {
+            len_paths[i] = get_generator_path(gen, params, sender, receivers[i], &paths[i * max_len], previous,
+                                              queue);
+            if (len_paths[i] == -1) {
+                fits = 0;
+                break;
+            }
+            for (int j = 0; j < len_paths[i]; j++) {
+                int link_id = paths[i * max_len + j];
+                if (last_use[link_id] != attempt) {
+                    last_use[link_id] = attempt;
+                    frame_links[num_links++] = link_id;
+                    if (gen->link_utilization[link_id] + frame_utilization > params->utilization) {
+                        fits = 0;
+                    }
+                }
+            }
+        }
+        if (fits == 0) {
+            continue;
+        }
+        for (int i = 0; i < num_links; i++) {
+            gen->link_utilization[frame_links[i]] += frame_utilization;
+        }
+        
+        xmlNode *frame_xml = xmlNewChild(traffic_xml, NULL, BAD_CAST "Frame", NULL);
+        write_generator_value_xml(frame_xml, "FrameID", num_frames, NULL);
+        write_generator_value_xml(frame_xml, "SenderID", sender, NULL);
+        write_generator_value_xml(frame_xml, "Period", period, "us");
+        write_generator_value_xml(frame_xml, "Deadline", period, "us");
+        write_generator_value_xml(frame_xml, "Size", size, "Byte");
+        xmlNode *paths_xml = xmlNewChild(frame_xml, NULL, BAD_CAST "Paths", NULL);
+        for (int i = 0; i < num_receivers; i++) {
+            xmlNode *receiver_xml = xmlNewChild(paths_xml, NULL, BAD_CAST "Receiver", NULL);
+            write_generator_value_xml(receiver_xml, "ReceiverID", receivers[i], NULL);
+            int len_value = 0;
+            for (int j = 0; j < len_paths[i]; j++) {
+                len_value += sprintf(&path_value[len_value], j == 0 ? "%d" : ";%d", paths[i * max_len + j]);
+            }
+            xmlNewChild(receiver_xml, NULL, BAD_CAST "Path", BAD_CAST path_value);
+        }
+        num_frames++;
+    }
+    
+    free(receivers);
+    free(paths);
+    free(len_paths);
+    free(previous);
+    free(queue);
+    free(frame_links);
+    free(last_use);
+    free(path_value);
+    return num_frames;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Set the parameters of a generated network to their default values
+ */
+int set_default_generator_parameters(Generator_Parameters *params) {
+    
+    if (params == NULL) {
+        fprintf(stderr, "The given parameters pointer is NULL\n");
+        return -1;
+    }
+    
+    params->topology = topology_ring;
+    params->num_switches = 4;
+    params->num_end_systems = 2;
+    params->num_extra_links = 0;
+    params->num_frames = 20;
+    params->num_periods = 3;
+    params->periods[0] = 1000;
+    params->periods[1] = 2000;
+    params->periods[2] = 4000;
+    params->min_size = 100;
+    params->max_size = 1500;
+    params->max_receivers = 2;
+    params->utilization = 0.5;
+    params->speed = 100;
+    params->switch_time = 1000;
+    params->protocol_period = 500;
+    params->protocol_time = 2000;
+    params->seed = 1;
+    
+    return 0;
+}
+
+/**
+ Set the topology of the generated network from its name
+ */
+int set_generator_topology(Generator_Parameters *params, char *name) {
+    
+    if (strcmp(name, "Line") == 0) {
+        params->topology = topology_line;
+    } else if (strcmp(name, "Ring") == 0) {
+        params->topology = topology_ring;
+    } else if (strcmp(name, "Mesh") == 0) {
+        params->topology = topology_mesh;
+    } else {
+        fprintf(stderr, "The given topology is not defined\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Generate a network with the given parameters and write it in a network xml file
+ */
+int generate_network_xml(Generator_Parameters *params, char *network_file) {
+    
+    if (params == NULL || network_file == NULL) {
+        fprintf(stderr, "The given parameters or file pointer is NULL\n");
+        return -1;
+    }
+    if (params->num_switches < 1 || params->num_end_systems < 1 || params->num_switches * params->num_end_systems < 2) {
+        fprintf(stderr, "The generated network needs at least one switch and two end systems\n");
+        return -1;
+    }
+    if (params->num_periods < 1 || params->num_periods > MAX_GENERATOR_PERIODS || params->min_size < 1 ||
+        params->min_size > params->max_size || params->max_receivers < 1 || params->speed <= 0 ||
+        params->num_extra_links < 0) {
+        fprintf(stderr, "The parameters of the generated network are not well defined\n");
+        return -1;
+    }
+    for (int i = 0; i < params->num_periods; i++) {
+        if (params->periods[i] <= 0) {
+            fprintf(stderr, "The periods of the generated network have to be larger than 0\n");
+            return -1;
+        }
+    }
+    
+    // Every connection has two links, and the end systems have one connection each
+    Generator_Network gen;
+    int max_links = 2 * (params->num_switches + params->num_extra_links +
+                         params->num_switches * params->num_end_systems);
+    gen.link_sender = malloc(sizeof(int) * max_links);
+    gen.link_receiver = malloc(sizeof(int) * max_links);
+    gen.link_utilization = malloc(sizeof(double) * max_links);
+    if (gen.link_sender == NULL || gen.link_receiver == NULL || gen.link_utilization == NULL) {
+        fprintf(stderr, "Not enough memory to generate the network\n");
+        free(gen.link_sender);
+        free(gen.link_receiver);
+        free(gen.link_utilization);
+        return -1;
+    }
+    unsigned int seed = params->seed;
+    build_generator_topology(params, &gen, &seed);
+    
+    // The self-healing protocol uses its part of every link before any frame
+    for (int i = 0; i < gen.num_links; i++) {
+        gen.link_utilization[i] = 0;
+        if (params->protocol_period != 0) {
+            gen.link_utilization[i] = (double) params->protocol_time / (params->protocol_period * 1000);
+        }
+    }
+    
+    xmlDoc *top_xml = xmlNewDoc(BAD_CAST "1.0");
+    xmlNode *root_xml = xmlNewNode(NULL, BAD_CAST "NetworkConfiguration");
+    xmlDocSetRootElement(top_xml, root_xml);
+    write_generator_general_xml(root_xml, params);
+    write_generator_topology_xml(root_xml, &gen, params);
+    int num_frames = write_generator_traffic_xml(root_xml, &gen, params, &seed);
+    if (num_frames != -1 && xmlSaveFormatFileEnc(network_file, top_xml, "UTF-8", 1) == -1) {
+        fprintf(stderr, "The generated network could not be written\n");
+        num_frames = -1;
+    }
+    if (num_frames != -1 && num_frames < params->num_frames) {
+        fprintf(stderr, "Only %d frames fit in the utilization of the generated network\n", num_frames);
+    }
+    
+    xmlFreeDoc(top_xml);
+    free(gen.link_sender);
+    free(gen.link_receiver);
+    free(gen.link_utilization);
+    return num_frames;
+}
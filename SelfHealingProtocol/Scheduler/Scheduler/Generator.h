@@ -0,0 +1,100 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Generator.h                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that generates synthetic networks, written in the same xml format that the scheduler reads, so the         *
+ *  scheduler can be measured without the network generator of the evaluator. The switches are connected in a line,    *
+ *  a ring or a mesh, and every switch has the same number of end systems. The frames go from an end system to one or  *
+ *  several others through the shortest path between their switches, and they are added until the number of frames     *
+ *  is reached or no more frames fit in the utilization given to the links.                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Generator_h
+#define Generator_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#endif /* Generator_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define MAX_GENERATOR_PERIODS 16        // Maximum number of periods the frames can choose from
+
+/**
+ Topologies of the switches of the generated networks
+ */
+typedef enum Generator_Topology {
+    topology_line,                  // Every switch connected to the previous and the next one
+    topology_ring,                  // A line where the last switch is also connected to the first one
+    topology_mesh                   // A ring with extra links between random switches
+}Generator_Topology;
+
+/**
+ Parameters of a generated network, the times have the units of the network files
+ */
+typedef struct Generator_Parameters {
+    Generator_Topology topology;    // Topology of the switches
+    int num_switches;               // Number of switches
+    int num_end_systems;            // Number of end systems connected to every switch
+    int num_extra_links;            // Number of extra links between switches in the mesh topology
+    int num_frames;                 // Number of frames to generate
+    int num_periods;                // Number of periods the frames choose from
+    long long int periods[MAX_GENERATOR_PERIODS];   // Periods the frames choose from in us
+    int min_size;                   // Minimum size of the frames in bytes
+    int max_size;                   // Maximum size of the frames in bytes
+    int max_receivers;              // Maximum number of receivers of a frame
+    double utilization;             // Maximum part of the time of a link used by the frames and the protocol
+    int speed;                      // Speed of all the links in MB/s
+    long long int switch_time;      // Minimum time of the switches in ns
+    long long int protocol_period;  // Period of the self-healing protocol in us, 0 if there is no protocol
+    long long int protocol_time;    // Time reserved for the self-healing protocol in ns
+    unsigned int seed;              // Seed of the random generator, the same seed generates the same network
+}Generator_Parameters;
+
+/**
+ Links of a generated network
+ */
+typedef struct Generator_Network {
+    int num_nodes;                  // Number of nodes, the switches first
+    int num_links;                  // Number of links, every connection has a link in each direction
+    int *link_sender;               // Sender node of every link
+    int *link_receiver;             // Receiver node of every link
+    double *link_utilization;       // Part of the time of every link already used
+}Generator_Network;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Set the parameters of a generated network to their default values, a ring of 4 switches with 2 end systems each
+
+ @param params pointer to the parameters
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_default_generator_parameters(Generator_Parameters *params);
+
+/**
+ Set the topology of the generated network from its name
+
+ @param params pointer to the parameters
+ @param name name of the topology ("Line", "Ring" or "Mesh")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_generator_topology(Generator_Parameters *params, char *name);
+
+/**
+ Generate a network with the given parameters and write it in a network xml file
+
+ @param params pointer to the parameters
+ @param network_file name and path of the network file
+ @return number of frames generated, -1 if something went wrong
+ */
+int generate_network_xml(Generator_Parameters *params, char *network_file);
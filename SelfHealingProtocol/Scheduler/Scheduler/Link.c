@@ -44,6 +44,19 @@ LinkType get_linktype(Link *pt) {
     return pt->type;
 }
 
+/**
+ Get the number of times every frame is transmitted in the link
+ */
+int get_link_replicas(Link *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given link pointer is null\n");
+        return -1;
+    }
+    
+    return pt->num_replicas;
+}
+
 /* Setters */
 
 /**
@@ -63,6 +76,7 @@ int set_link(Link *pt, LinkType type, int speed) {
     
     pt->speed = speed;
     pt->type = type;
+    pt->num_replicas = 1;
     return 0;
 }
 
@@ -81,6 +95,7 @@ int set_link_str(Link *pt, char* type, int speed) {
         return -1;
     }
     pt->speed = speed;
+    pt->num_replicas = 1;
     if (strcmp(type, "Wired") == 0) {
         pt->type = wired;
     } else if (strcmp(type, "Wireless") == 0) {
@@ -91,3 +106,25 @@ int set_link_str(Link *pt, char* type, int speed) {
     }
     return 0;
 }
+
+/**
+ Set the number of times every frame is transmitted in the link, only wireless links can repeat them
+ */
+int set_link_replicas(Link *pt, int num_replicas) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given link pointer is null\n");
+        return -1;
+    }
+    
+    if (num_replicas <= 0) {
+        fprintf(stderr, "The number of replicas of a link should be a positive number\n");
+        return -1;
+    }
+    if (num_replicas > 1 && pt->type != wireless) {
+        fprintf(stderr, "Only the wireless links can repeat the transmissions of the frames\n");
+        return -1;
+    }
+    pt->num_replicas = num_replicas;
+    return 0;
+}
@@ -35,6 +35,7 @@ typedef enum LinkType {
 typedef struct Link {
     LinkType type;          // Type of the link
     int speed;              // Speed of the link in MB/s
+    int num_replicas;       // Number of times every frame is transmitted in the link (only wireless repeats them)
 }Link;
 
                                                 /* CODE DEFINITIONS */
@@ -57,6 +58,14 @@ int get_speed(Link *pt);
  */
 LinkType get_linktype(Link *pt);
 
+/**
+ Get the number of times every frame is transmitted in the link
+
+ @param pt pointer to the link
+ @return number of replicas, 1 if the frames are not repeated
+ */
+int get_link_replicas(Link *pt);
+
 /* Setters */
 
 /**
@@ -78,3 +87,12 @@ int set_link(Link *pt, LinkType type, int speed);
  @return 0 if done correctly, -1 otherwise
  */
 int set_link_str(Link *pt, char* type, int speed);
+
+/**
+ Set the number of times every frame is transmitted in the link, only wireless links can repeat them
+
+ @param pt pointer to the link
+ @param num_replicas number of replicas, 1 if the frames are not repeated
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_link_replicas(Link *pt, int num_replicas);
@@ -13,29 +13,12 @@
 
 #include "Network.h"
 #include "Scheduler.h"
+#include "Profile.h"
 
                                                 /* VARIABLES */
 
-Switch_Information switch_info;     // Information of the behaviour of switches
-SelfHealing_Protocol healing_prot;  // Information of the self-healing protocol characteristics
-int number_nodes;                   // Number of nodes in the network
-Node_Topology *topology;            // Topology of the network saved as a list of all nodes and their connections
-Traffic traffic;                    // Struct that contains all the traffic in the network
-int number_links;                   // Number of links in the network
-long long int hyperperiod = 0;      // HyperPeriod of all the frames in the network
-int size_timeslot = 0;              // Size of time slot in nanoseconds
-
-// Accelerator variables indexed by the ID to find values in O(1)
-int higher_link_id = 0;             // Higher read link id, used for the offset hash accelerator (hopefully not large)
-int higher_frame_id = 0;            // Higher read frame id, used for frame hash accelerator (hopefully not large)
-int higher_node_id = 0;             // Higher read node id, used for frame hash accelerator (hopefully not large)
-Link **link_accelerator;            // List of pointers to the links in the topology indexed by id
-Node **node_accelerator;            // List of pointers to the nodes in the topology indexed by id
-Frame **frame_accelerator;          // List of pointers to the frames in the topology indexed by id
-
-// Patching needed extra information
-int patched_link;                   // Link being patched
-int num_frames_fixed;               // Number of frames that are already fixed
+Network default_network;            // Network of the threads that did not set another one
+_Thread_local Network *network = &default_network;  // Network the calling thread works on
 
                                             /* AUXILIAR FUNCTIONS */
 
@@ -140,8 +123,8 @@ int convert_to_byte(int value, char* type) {
 int is_node_id_defined(int id) {
     
     // Search in all nodes
-    for (int i = 0; i < number_nodes; i++) {
-        if (topology[i].node_id == id) {
+    for (int i = 0; i < network->number_nodes; i++) {
+        if (network->topology[i].node_id == id) {
             return 0;
         }
     }
@@ -149,6 +132,48 @@ int is_node_id_defined(int id) {
     return -1;
 }
 
+/**
+ Prepare the list of offsets of every link, so the frames sharing a link are found without searching all frames
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int prepare_link_offsets(void) {
+    
+    network->link_offsets = alloc_arena(&network->network_arena, sizeof(Link_Offset*) * (network->higher_link_id + 1));
+    network->num_link_offsets = calloc_arena(&network->network_arena, sizeof(int) * (network->higher_link_id + 1));
+    if (network->link_offsets == NULL || network->num_link_offsets == NULL) {
+        return -1;
+    }
+    
+    // Count first the offsets of every link to allocate the lists
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        for (int j = 0; j < network->traffic.frames[i].num_offsets; j++) {
+            network->num_link_offsets[get_link_id_offset_it(&network->traffic.frames[i], j)] += 1;
+        }
+    }
+    for (int link_id = 0; link_id <= network->higher_link_id; link_id++) {
+        network->link_offsets[link_id] = alloc_arena(&network->network_arena,
+                                                     sizeof(Link_Offset) * network->num_link_offsets[link_id]);
+        if (network->link_offsets[link_id] == NULL && network->num_link_offsets[link_id] != 0) {
+            return -1;
+        }
+        network->num_link_offsets[link_id] = 0;
+    }
+    
+    // Fill the lists following the order of the frames in the traffic
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        for (int j = 0; j < network->traffic.frames[i].num_offsets; j++) {
+            int link_id = get_link_id_offset_it(&network->traffic.frames[i], j);
+            Link_Offset *link_off = &network->link_offsets[link_id][network->num_link_offsets[link_id]];
+            link_off->frame_pos = i;
+            link_off->offset_pt = get_offset_it(&network->traffic.frames[i], j);
+            network->num_link_offsets[link_id] += 1;
+        }
+    }
+    
+    return 0;
+}
+
                                                 /* FUNCTIONS */
 
 /* Getters */
@@ -158,7 +183,7 @@ int is_node_id_defined(int id) {
  */
 int get_num_fixed_frames(void) {
     
-    return num_frames_fixed;
+    return network->num_frames_fixed;
 }
 
 /**
@@ -166,7 +191,15 @@ int get_num_fixed_frames(void) {
  */
 long long int get_switch_min_time(void) {
     
-    return switch_info.min_time;
+    return network->switch_info.min_time;
+}
+
+/**
+ Get the minimum distance from the transmission of a frame in a link of a path to its transmission in the next link
+ */
+long long int get_hop_distance(long long int time_slots, long long int switch_time) {
+    
+    return time_slots + switch_time;
 }
 
 /**
@@ -174,7 +207,7 @@ long long int get_switch_min_time(void) {
  */
 SelfHealing_Protocol * get_healing_protocol(void) {
     
-    return &healing_prot;
+    return &network->healing_prot;
 }
 
 /**
@@ -182,7 +215,7 @@ SelfHealing_Protocol * get_healing_protocol(void) {
  */
 int get_frame_id(int pos) {
     
-    return traffic.frames_id[pos];
+    return network->traffic.frames_id[pos];
 }
 
 /**
@@ -190,7 +223,7 @@ int get_frame_id(int pos) {
  */
 Traffic * get_traffic(void) {
     
-    return &traffic;
+    return &network->traffic;
 }
 
 /**
@@ -198,7 +231,7 @@ Traffic * get_traffic(void) {
  */
 int get_higher_link_id(void) {
     
-    return higher_link_id;
+    return network->higher_link_id;
 }
 
 /**
@@ -206,7 +239,79 @@ int get_higher_link_id(void) {
  */
 long long int get_hyperperiod(void) {
     
-    return hyperperiod;
+    return network->hyperperiod;
+}
+
+/**
+ Get the number of frames that have an offset in the given link
+ */
+int get_num_link_offsets(int link_id) {
+    
+    if (network->num_link_offsets == NULL || link_id < 0 || link_id > network->higher_link_id) {
+        return 0;
+    }
+    
+    return network->num_link_offsets[link_id];
+}
+
+/**
+ Get the list of offsets in the given link, sorted by the position of their frames in the traffic
+ */
+Link_Offset * get_link_offsets(int link_id) {
+    
+    if (network->link_offsets == NULL || link_id < 0 || link_id > network->higher_link_id) {
+        return NULL;
+    }
+    
+    return network->link_offsets[link_id];
+}
+
+/**
+ Get the number of links read from a patch file with several links
+ */
+int get_num_link_patches(void) {
+    
+    return network->num_link_patches;
+}
+
+/**
+ Get the information of one of the links to patch
+ */
+Link_Patch * get_link_patch(int pos) {
+    
+    if (pos < 0 || pos >= network->num_link_patches) {
+        return NULL;
+    }
+    
+    return &network->link_patches[pos];
+}
+
+/**
+ Get the link with the given id
+ */
+Link * get_link(int link_id) {
+    
+    if (network->link_accelerator == NULL || link_id < 0 || link_id > network->higher_link_id) {
+        return NULL;
+    }
+    
+    return network->link_accelerator[link_id];
+}
+
+/**
+ Get the network file read in the current network
+ */
+char * get_network_file(void) {
+    
+    return network->network_file;
+}
+
+/**
+ Get the order of the frames in the traffic once the network is prepared
+ */
+Frame_Order get_frame_order(void) {
+    
+    return network->frame_order;
 }
 
 /* Setters */
@@ -221,7 +326,7 @@ int set_switch_information(long long int min_time) {
         return -1;
     }
     
-    switch_info.min_time = min_time;
+    network->switch_info.min_time = min_time;
     return 0;
 }
 
@@ -231,15 +336,80 @@ int set_switch_information(long long int min_time) {
 int set_healing_protocol(long long int period, long long int time) {
     
     if (period == 0) {
-        healing_prot.period = 0;
-        healing_prot.time = 0;
+        network->healing_prot.period = 0;
+        network->healing_prot.time = 0;
     } else if (period < 0 || time <= 0) {
         fprintf(stderr, "The values in the Self-Healing Protocol should be natural\n");
         return -1;
     } else {
-        healing_prot.period = period;
-        healing_prot.time = time;
+        network->healing_prot.period = period;
+        network->healing_prot.time = time;
+    }
+    return 0;
+}
+
+/**
+ Set the format of the schedule, patched schedule and optimized schedule files
+ */
+int set_output_format(char *name) {
+    
+    if (strcmp(name, "XML") == 0) {
+        network->output_format = xml_format;
+    } else if (strcmp(name, "Binary") == 0) {
+        network->output_format = binary_format;
+    } else if (strcmp(name, "Delta") == 0) {
+        network->output_format = delta_format;
+    } else {
+        fprintf(stderr, "The given output format is not defined\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Set the binary schedule that the delta files are relative to
+ */
+int set_delta_baseline(char *baseline_file) {
+    
+    free(network->delta_baseline);
+    network->delta_baseline = NULL;
+    if (baseline_file != NULL) {
+        network->delta_baseline = strdup(baseline_file);
+        if (network->delta_baseline == NULL) {
+            fprintf(stderr, "Not enough memory for the name of the baseline file\n");
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Set if the offsets of the frames only store their first instance, so all instances are strictly periodic
+ */
+int set_periodic_offsets(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The strictly periodic value should be 0 or 1\n");
+        return -1;
+    }
+    
+    network->periodic_offsets = value;
+    return 0;
+}
+
+/**
+ Set the order of the frames in the traffic
+ */
+int set_frame_order(Frame_Order order) {
+    
+    if (order != file_order && order != period_order && order != utilization_order) {
+        fprintf(stderr, "The given frame order is not defined\n");
+        return -1;
     }
+    
+    network->frame_order = order;
     return 0;
 }
 
@@ -253,20 +423,21 @@ int set_healing_protocol(long long int period, long long int time) {
 int prepare_healing_protocol(void) {
     
     // If there exists healing protocol, set the frame, otherwise leave it empty
-    if (healing_prot.period != 0) {
+    if (network->healing_prot.period != 0) {
         // Save the size to calculate the larger size slot possible
-        size_timeslot = (int) healing_prot.time;
+        network->size_timeslot = (int) network->healing_prot.time;
         
         // Save the information of the frame needed
-        set_period(&healing_prot.reservation, healing_prot.period);
+        set_period(&network->healing_prot.reservation, network->healing_prot.period);
         // We set the transmission time as the size for the special case of a frame reserving bandwidth
-        set_size(&healing_prot.reservation, (int)healing_prot.time);
-        set_deadline(&healing_prot.reservation, healing_prot.period);
-        set_end_to_end(&healing_prot.reservation, 0);
-        set_starting_time(&healing_prot.reservation, 0);
+        set_size(&network->healing_prot.reservation, (int)network->healing_prot.time);
+        set_deadline(&network->healing_prot.reservation, network->healing_prot.period);
+        set_end_to_end(&network->healing_prot.reservation, 0);
+        set_starting_time(&network->healing_prot.reservation, 0);
         
         // Create the offset iterator and fill the offsets
-        if (init_offset_reservation(&healing_prot.reservation, higher_link_id, hyperperiod) == -1) {
+        if (init_offset_reservation(&network->healing_prot.reservation, network->higher_link_id, network->hyperperiod,
+                                    &network->network_arena) == -1) {
             fprintf(stderr, "The preparation of the offsets in the self-healing protocol failed\n");
             return -1;
         }
@@ -275,621 +446,672 @@ int prepare_healing_protocol(void) {
     return 0;
 }
 
+/**
+ Compare two frames by the key of their order, the largest key goes first, and then the shortest period
+
+ @param a pointer to the first Frame_Key
+ @param b pointer to the second Frame_Key
+ @return negative if the first frame goes first, positive otherwise
+ */
+int compare_frame_keys(const void *a, const void *b) {
+    
+    const Frame_Key *key_a = a;
+    const Frame_Key *key_b = b;
+    
+    if (key_a->key != key_b->key) {
+        return key_a->key > key_b->key ? -1 : 1;
+    }
+    if (key_a->period != key_b->period) {
+        return key_a->period < key_b->period ? -1 : 1;
+    }
+    return key_a->pos - key_b->pos;
+}
+
+/**
+ Sort the frames of the traffic in the order of the network, before their offsets are allocated.
+ The utilization of a link is the part of its time used by the frames that cross it, and the key of a frame is the
+ utilization of the most used link of its paths
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int sort_traffic(void) {
+    
+    int num_frames = network->traffic.num_frames;
+    Frame_Key *keys = malloc(sizeof(Frame_Key) * (num_frames + 1));
+    Frame *frames = malloc(sizeof(Frame) * (num_frames + 1));
+    int *frames_id = malloc(sizeof(int) * (num_frames + 1));
+    long long int *speeds = calloc(network->higher_link_id + 1, sizeof(long long int));
+    double *utilization = calloc(network->higher_link_id + 1, sizeof(double));
+    int *last_frame = malloc(sizeof(int) * (network->higher_link_id + 1));
+    if (keys == NULL || frames == NULL || frames_id == NULL || speeds == NULL || utilization == NULL ||
+        last_frame == NULL) {
+        fprintf(stderr, "Not enough memory to sort the frames\n");
+        free(keys);
+        free(frames);
+        free(frames_id);
+        free(speeds);
+        free(utilization);
+        free(last_frame);
+        return -1;
+    }
+    
+    // The links are not accelerated yet, so their speeds are taken from the topology
+    for (int i = 0; i < network->number_nodes; i++) {
+        for (int j = 0; j < network->topology[i].num_connection; j++) {
+            Connection_Topology *connection_pt = &network->topology[i].connections_pt[j];
+            speeds[connection_pt->link_id] = get_speed(connection_pt->link_pt);
+        }
+    }
+    for (int i = 0; i <= network->higher_link_id; i++) {
+        last_frame[i] = -1;
+    }
+    
+    // A frame with several paths counts once in the links shared by its paths
+    for (int i = 0; i < num_frames && network->frame_order == utilization_order; i++) {
+        Frame *frame_pt = &network->traffic.frames[i];
+        for (int p = 0; p < frame_pt->num_paths; p++) {
+            for (int l = 0; l < frame_pt->list_paths[p].length_path; l++) {
+                int link_id = frame_pt->list_paths[p].path[l];
+                if (last_frame[link_id] != i && speeds[link_id] > 0) {
+                    utilization[link_id] += ((double) get_size(frame_pt) * 1000 / speeds[link_id]) /
+                                            get_period(frame_pt);
+                    last_frame[link_id] = i;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < num_frames; i++) {
+        Frame *frame_pt = &network->traffic.frames[i];
+        keys[i].pos = i;
+        keys[i].period = get_period(frame_pt);
+        keys[i].key = 0;
+        for (int p = 0; p < frame_pt->num_paths && network->frame_order == utilization_order; p++) {
+            for (int l = 0; l < frame_pt->list_paths[p].length_path; l++) {
+                int link_id = frame_pt->list_paths[p].path[l];
+                if (utilization[link_id] > keys[i].key) {
+                    keys[i].key = utilization[link_id];
+                }
+            }
+        }
+    }
+    qsort(keys, num_frames, sizeof(Frame_Key), compare_frame_keys);
+    
+    memcpy(frames, network->traffic.frames, sizeof(Frame) * num_frames);
+    memcpy(frames_id, network->traffic.frames_id, sizeof(int) * num_frames);
+    for (int i = 0; i < num_frames; i++) {
+        network->traffic.frames[i] = frames[keys[i].pos];
+        network->traffic.frames_id[i] = frames_id[keys[i].pos];
+    }
+    
+    free(keys);
+    free(frames);
+    free(frames_id);
+    free(speeds);
+    free(utilization);
+    free(last_frame);
+    return 0;
+}
+
 /**
  After reading a network it prepares all the needed variables to be ready to be scheduled.
  This includes allocating offsets, calculating timeslot length, and population needed global variables
  */
 int prepare_network(void) {
     
+    profile_phase(phase_prepare);
+    
+    // The frames are sorted before anything points to them
+    if (network->frame_order != file_order && sort_traffic() == -1) {
+        return -1;
+    }
+    
     // Initialize the offsets of the Self-Healing Protocol
     if (prepare_healing_protocol() == -1) {
         fprintf(stderr, "The preparation of the frame in the self-healing protocol failed\n");
         return -1;
     }
     
-    // Initialize the offsets of all the frames
-    for (int i = 0; i < traffic.num_frames; i++) {
-        init_offsets(&traffic.frames[i], higher_link_id, hyperperiod);
-    }
-    
     // Prepare the hash accelerators ids, first we allocate the needed memory, set everything to NULL, then
     // iterate over all the defined nodes, links and frames to link the pointers
-    node_accelerator = malloc(sizeof(Node*) * higher_node_id + 1);
-    for (int i = 0; i <= higher_node_id; i++) {
-        node_accelerator[i] = NULL;
+    network->node_accelerator = malloc(sizeof(Node*) * (network->higher_node_id + 1));
+    for (int i = 0; i <= network->higher_node_id; i++) {
+        network->node_accelerator[i] = NULL;
     }
-    link_accelerator = malloc(sizeof(Link*) * higher_link_id + 1);
-    for (int i = 0; i <= higher_link_id; i++) {
-        link_accelerator[i] = NULL;
+    network->link_accelerator = malloc(sizeof(Link*) * (network->higher_link_id + 1));
+    for (int i = 0; i <= network->higher_link_id; i++) {
+        network->link_accelerator[i] = NULL;
     }
-    frame_accelerator = malloc(sizeof(Frame*) * higher_frame_id + 1);
-    for (int i = 0; i <= higher_frame_id; i++) {
-        frame_accelerator[i] = NULL;
+    network->frame_accelerator = malloc(sizeof(Frame*) * (network->higher_frame_id + 1));
+    for (int i = 0; i <= network->higher_frame_id; i++) {
+        network->frame_accelerator[i] = NULL;
     }
     
-    for (int i = 0; i < number_nodes; i++) {
-        node_accelerator[topology[i].node_id] = topology[i].node_pt;
-        for (int j = 0; j < topology[i].num_connection; j++) {
-            int link_id = topology[i].connections_pt[j].link_id;
-            if (link_accelerator[link_id] == NULL) {
-                link_accelerator[link_id] = topology[i].connections_pt[j].link_pt;
+    for (int i = 0; i < network->number_nodes; i++) {
+        network->node_accelerator[network->topology[i].node_id] = network->topology[i].node_pt;
+        for (int j = 0; j < network->topology[i].num_connection; j++) {
+            int link_id = network->topology[i].connections_pt[j].link_id;
+            if (network->link_accelerator[link_id] == NULL) {
+                network->link_accelerator[link_id] = network->topology[i].connections_pt[j].link_pt;
             }
         }
     }
-    for (int i = 0; i < traffic.num_frames; i++) {
-        frame_accelerator[traffic.frames_id[i]] = &traffic.frames[i];
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        network->frame_accelerator[network->traffic.frames_id[i]] = &network->traffic.frames[i];
+    }
+    
+    // Initialize the offsets of all the frames, with a replica for every repetition of the wireless links
+    int *link_replicas = malloc(sizeof(int) * (network->higher_link_id + 1));
+    if (link_replicas == NULL) {
+        fprintf(stderr, "Not enough memory to prepare the offsets of the frames\n");
+        return -1;
+    }
+    for (int link_id = 0; link_id <= network->higher_link_id; link_id++) {
+        link_replicas[link_id] = network->link_accelerator[link_id] != NULL ?
+                                 get_link_replicas(network->link_accelerator[link_id]) : 1;
+    }
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        if (init_offsets(&network->traffic.frames[i], network->higher_link_id, network->hyperperiod,
+                         network->periodic_offsets, link_replicas, &network->network_arena) == -1) {
+            fprintf(stderr, "The preparation of the offsets of the frames failed\n");
+            free(link_replicas);
+            return -1;
+        }
     }
+    free(link_replicas);
     
     // Adjust the timeslot to the maximum size possible (1 nanoseconds is the minimum)
-    for (int i = 0; i < traffic.num_frames; i++) {
-        for (int j = 0; j < traffic.frames[i].num_offsets; j++) {
-            for (int link_id = 0; link_id < number_links; link_id++) {
-                int time_frame = (get_size(&traffic.frames[i]) * 1000) / get_speed(link_accelerator[link_id]);
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        for (int j = 0; j < network->traffic.frames[i].num_offsets; j++) {
+            for (int link_id = 0; link_id < network->number_links; link_id++) {
+                int time_frame = (get_size(&network->traffic.frames[i]) * 1000) /
+                                 get_speed(network->link_accelerator[link_id]);
                 // Do not allow the time frame to be less than 1ns, force a minimum of 1ns
                 if (time_frame == 0) {
                     time_frame = 1;
                 }
-                if (size_timeslot == 0) {
-                    size_timeslot = time_frame;
+                if (network->size_timeslot == 0) {
+                    network->size_timeslot = time_frame;
                 } else {
-                    size_timeslot = (int)gcd(size_timeslot, time_frame);
+                    network->size_timeslot = (int)gcd(network->size_timeslot, time_frame);
                 }
             }
         }
     }
     // Once we have the minimum possible timeslot, we normalize the values and save it (makes the scheduler faster)
-    if (size_timeslot == 0) {
+    if (network->size_timeslot == 0) {
         fprintf(stderr, "For some reason the size of the time slot is 0, this cannot happen\n");
         return -1;
     } else {
-        hyperperiod /= size_timeslot;
-    }
-    for (int i = 0; i < traffic.num_frames; i++) {
-        set_period(&traffic.frames[i], get_period(&traffic.frames[i]) / size_timeslot);
-        set_deadline(&traffic.frames[i], get_deadline(&traffic.frames[i]) / size_timeslot);
-        set_starting_time(&traffic.frames[i], get_starting_time(&traffic.frames[i]) / size_timeslot);
-        set_end_to_end(&traffic.frames[i], get_end_to_end(&traffic.frames[i]) / size_timeslot);
-        for (int j = 0; j < traffic.frames[i].num_offsets; j++) {
-            int link_id = get_link_id_offset_it(&traffic.frames[i], j);
-            int time_frame = (get_size(&traffic.frames[i]) * 1000) / get_speed(link_accelerator[link_id]);
-            time_frame = time_frame / size_timeslot;
-            set_time_offset_it(&traffic.frames[i], j, time_frame);
+        network->hyperperiod /= network->size_timeslot;
+    }
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        Frame *frame_pt = &network->traffic.frames[i];
+        set_period(frame_pt, get_period(frame_pt) / network->size_timeslot);
+        set_deadline(frame_pt, get_deadline(frame_pt) / network->size_timeslot);
+        set_starting_time(frame_pt, get_starting_time(frame_pt) / network->size_timeslot);
+        set_end_to_end(frame_pt, get_end_to_end(frame_pt) / network->size_timeslot);
+        for (int j = 0; j < frame_pt->num_offsets; j++) {
+            int link_id = get_link_id_offset_it(frame_pt, j);
+            int time_frame = (get_size(frame_pt) * 1000) / get_speed(network->link_accelerator[link_id]);
+            time_frame = time_frame / network->size_timeslot;
+            set_time_offset_it(frame_pt, j, time_frame);
         }
     }
     // Also prepare the self healing protocol if active
-    if (healing_prot.period != 0) {
-        set_period(&healing_prot.reservation, get_period(&healing_prot.reservation) / size_timeslot);
-        set_deadline(&healing_prot.reservation, get_deadline(&healing_prot.reservation) / size_timeslot);
-        set_starting_time(&healing_prot.reservation, get_starting_time(&healing_prot.reservation) / size_timeslot);
-        set_end_to_end(&healing_prot.reservation, get_end_to_end(&healing_prot.reservation) / size_timeslot);
-        healing_prot.period /= size_timeslot;
-        healing_prot.time /= size_timeslot;
-        for (int j = 0; j < healing_prot.reservation.num_offsets; j++) {
-            int time_frame = get_size(&healing_prot.reservation) / size_timeslot;
-            set_time_offset_it(&healing_prot.reservation, j, time_frame);
+    if (network->healing_prot.period != 0) {
+        Frame *reservation_pt = &network->healing_prot.reservation;
+        set_period(reservation_pt, get_period(reservation_pt) / network->size_timeslot);
+        set_deadline(reservation_pt, get_deadline(reservation_pt) / network->size_timeslot);
+        set_starting_time(reservation_pt, get_starting_time(reservation_pt) / network->size_timeslot);
+        set_end_to_end(reservation_pt, get_end_to_end(reservation_pt) / network->size_timeslot);
+        network->healing_prot.period /= network->size_timeslot;
+        network->healing_prot.time /= network->size_timeslot;
+        for (int j = 0; j < reservation_pt->num_offsets; j++) {
+            int time_frame = get_size(reservation_pt) / network->size_timeslot;
+            set_time_offset_it(reservation_pt, j, time_frame);
         }
     }
     
+    // Prepare the lists of offsets per link needed to find the frames that may collide
+    if (prepare_link_offsets() == -1) {
+        fprintf(stderr, "The preparation of the offsets of every link failed\n");
+        return -1;
+    }
+    
     return 0;
 }
 
-/* Input Functions */
-
 /**
- Given the top xml of the tree and the path, get the time converted to ns
- 
- @param top_xml pointer to the top of the tree
- @param path path where to find the value
- @return the value read converted to nanoseconds
+ Release the memory of all the offsets of the network in a single step
  */
-long long int get_time_value_xml(xmlDoc *top_xml, char* path) {
+int release_network_offsets(void) {
     
-    // Init xml variables needed to search information in the file
-    xmlChar *value, *value2;
-    xmlXPathContextPtr context;
-    xmlXPathObjectPtr result;
-    
-    long long int time;
-    
-    // Search for the value
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return -1;
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        clear_offsets(&network->traffic.frames[i]);
     }
-    value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    value2 = xmlGetProp(result->nodesetval->nodeTab[0], (xmlChar*) "unit");
+    clear_offsets(&network->healing_prot.reservation);
+    network->link_offsets = NULL;
+    network->num_link_offsets = NULL;
     
-    // Convert the read value into nanoseconds and save
-    time = atoll((const char*) value);
-    time = convert_to_ns(time, (char*) value2);
+    return release_arena(&network->network_arena);
+}
+
+/**
+ Release all the memory of the network and set its variables as if nothing was read
+ */
+int reset_network(void) {
     
-    // Free xml objects
-    xmlFree(value);
-    xmlFree(value2);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
+    release_network_offsets();
     
-    return time;
+    // Traffic
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        for (int j = 0; j < network->traffic.frames[i].num_paths; j++) {
+            free(network->traffic.frames[i].list_paths[j].path);
+        }
+        free(network->traffic.frames[i].receivers_id);
+        free(network->traffic.frames[i].list_paths);
+    }
+    free(network->traffic.frames);
+    free(network->traffic.frames_id);
+    network->traffic.frames = NULL;
+    network->traffic.frames_id = NULL;
+    network->traffic.num_frames = 0;
+    
+    // Topology
+    for (int i = 0; i < network->number_nodes; i++) {
+        free(network->topology[i].node_pt);
+        for (int j = 0; j < network->topology[i].num_connection; j++) {
+            free(network->topology[i].connections_pt[j].link_pt);
+        }
+        free(network->topology[i].connections_pt);
+    }
+    free(network->topology);
+    network->topology = NULL;
+    network->number_nodes = 0;
+    network->number_links = 0;
+    
+    // Accelerators
+    free(network->node_accelerator);
+    free(network->link_accelerator);
+    free(network->frame_accelerator);
+    network->node_accelerator = NULL;
+    network->link_accelerator = NULL;
+    network->frame_accelerator = NULL;
+    network->higher_link_id = 0;
+    network->higher_frame_id = 0;
+    network->higher_node_id = 0;
+    
+    // General information and patching
+    memset(&network->switch_info, 0, sizeof(Switch_Information));
+    memset(&network->healing_prot, 0, sizeof(SelfHealing_Protocol));
+    network->hyperperiod = 0;
+    network->size_timeslot = 0;
+    network->patched_link = 0;
+    network->num_frames_fixed = 0;
+    free(network->link_patches);
+    network->link_patches = NULL;
+    network->num_link_patches = 0;
+    network->output_format = xml_format;
+    free(network->delta_baseline);
+    network->delta_baseline = NULL;
+    network->periodic_offsets = 0;
+    network->frame_order = file_order;
+    free(network->network_file);
+    network->network_file = NULL;
     
+    return 0;
 }
 
 /**
- Given the top xml of the tree and the path, get the time converted to ns
- 
- @param top_xml pointer to the top of the tree
- @param path path where to find the value
- @return the value read converted to nanoseconds
+ Create a new empty network, as if nothing was read
  */
-long long int get_value_xml(xmlDoc *top_xml, char* path) {
- 
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context;
-    xmlXPathObjectPtr result;
+Network * new_network(void) {
+    
+    // Every value of an empty network is 0
+    Network *network_pt = calloc(1, sizeof(Network));
+    if (network_pt == NULL) {
+        fprintf(stderr, "Not enough memory for the network\n");
+    }
     
-    long long int return_value;
+    return network_pt;
+}
+
+/**
+ Release all the memory of a network created with new_network, and the network itself
+ */
+int free_network(Network *network_pt) {
     
-    // Search for the value
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
+    if (network_pt == NULL || network_pt == &default_network) {
+        fprintf(stderr, "Only the networks created with new_network can be freed\n");
         return -1;
     }
-    value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
     
-    // Convert the read value into int and save
-    return_value = atoll((const char*) value);
+    // The network is reset as the current one of the thread
+    Network *current_pt = network;
+    network = network_pt;
+    reset_network();
+    network = current_pt == network_pt ? &default_network : current_pt;
+    free(network_pt);
     
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
+    return 0;
+}
+
+/**
+ Set the network the calling thread works on
+ */
+int set_network(Network *network_pt) {
     
-    return return_value;
+    network = network_pt != NULL ? network_pt : &default_network;
+    
+    return 0;
 }
 
 /**
- Get the time value of a given path in an ocurrence
- 
- @param top_xml pointer to the top of the tree
- @param path path to find the ocurrence
- @param num number of the ocurrence
- @param subpath path inside the ocurrence
- @return time value in nanoseconds
+ Get the network the calling thread works on
  */
-long long int get_occur_time_value_xml(xmlDoc *top_xml, char* path, int num, char* subpath) {
+Network * get_network(void) {
     
-    // Init xml variables needed to search information in the file
-    xmlChar *value, *value2;
-    xmlXPathContextPtr context, context_value;
-    xmlXPathObjectPtr result, result_value;
+    return network;
+}
+
+/**
+ Copy the transmission times of all the frames of another network to the current network
+ */
+int copy_network_schedule(Network *source_pt) {
     
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeNr == 0) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return -1;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
+    if (source_pt == NULL || source_pt == network || source_pt->traffic.num_frames != network->traffic.num_frames) {
+        fprintf(stderr, "The schedule can only be copied from another network with the same traffic\n");
         return -1;
     }
     
-    // Set new context to the given num and search for the value
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    if (result_value->nodesetval->nodeNr == 0) {
-        return -1;
+    for (int i = 0; i < network->traffic.num_frames; i++) {
+        Frame *frame_pt = &network->traffic.frames[i];
+        Frame *source_frame = &source_pt->traffic.frames[i];
+        if (get_num_offsets(frame_pt) != get_num_offsets(source_frame)) {
+            fprintf(stderr, "The frame %d does not have the same offsets in both networks\n", get_frame_id(i));
+            return -1;
+        }
+        for (int j = 0; j < get_num_offsets(frame_pt); j++) {
+            Offset *offset_pt = get_offset_it(frame_pt, j);
+            Offset *source_offset = get_offset_it(source_frame, j);
+            if (get_off_link_id(offset_pt) != get_off_link_id(source_offset) ||
+                get_off_stored_instances(offset_pt) != get_off_stored_instances(source_offset) ||
+                get_off_num_replicas(offset_pt) != get_off_num_replicas(source_offset)) {
+                fprintf(stderr, "The frame %d does not have the same offsets in both networks\n", get_frame_id(i));
+                return -1;
+            }
+            // Only the stored instances, the strictly periodic offsets get the others from the first one
+            for (int inst = 0; inst < get_off_stored_instances(offset_pt); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(offset_pt); repl++) {
+                    set_trans_time(offset_pt, inst, repl, get_trans_time(source_offset, inst, repl));
+                }
+            }
+        }
     }
-    value = xmlNodeListGetString(top_xml, result_value->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    value2 = xmlGetProp(result_value->nodesetval->nodeTab[0], (xmlChar*) "unit");
     
-    // Convert the read value into nanoseconds and save
-    long long int time = atoll((const char*) value);
-    time = convert_to_ns(time, (char*) value2);
-    
-    // Free xml objects
-    xmlFree(value);
-    xmlFree(value2);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
-    
-    return time;
+    return 0;
 }
 
 /**
- Get the size in bytes of a value in an ocurrence
-
- @param top_xml pointer to the top of the tree
- @param path to find the occurrence
- @param num number of the ocurrence
- @param subpath path to find the value inside the ocurrence
- @return the found value converted to byes
+ Get the shortest path that replaces a failed link, from its sender to its receiver without using the failed link
  */
-int get_occur_size_value_xml(xmlDoc *top_xml, char* path, int num, char* subpath) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value, *value2;
-    xmlXPathContextPtr context, context_value;
-    xmlXPathObjectPtr result, result_value;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeNr == 0) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return -1;
+int get_failure_path(int link_id, int *path) {
+    
+    // Search the sender and the receiver of the failed link
+    int sender = -1;
+    int receiver_id = -1;
+    for (int i = 0; i < network->number_nodes && sender == -1; i++) {
+        for (int j = 0; j < network->topology[i].num_connection; j++) {
+            if (network->topology[i].connections_pt[j].link_id == link_id) {
+                sender = i;
+                receiver_id = network->topology[i].connections_pt[j].node_id;
+                break;
+            }
+        }
     }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
+    if (sender == -1) {
+        fprintf(stderr, "The failed link %d does not exist\n", link_id);
         return -1;
     }
     
-    // Set new context to the given num and search for the value
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    if (result_value->nodesetval->nodeNr == 0) {
+    // Position of every node id in the topology, and the node and link used to reach every node in the search
+    int *node_pos = malloc(sizeof(int) * (network->higher_node_id + 1));
+    int *queue = malloc(sizeof(int) * network->number_nodes);
+    int *prev_node = malloc(sizeof(int) * network->number_nodes);
+    int *prev_link = malloc(sizeof(int) * network->number_nodes);
+    if (node_pos == NULL || queue == NULL || prev_node == NULL || prev_link == NULL) {
+        fprintf(stderr, "Not enough memory to search the path of the failed link %d\n", link_id);
+        free(node_pos);
+        free(queue);
+        free(prev_node);
+        free(prev_link);
         return -1;
     }
-    value = xmlNodeListGetString(top_xml, result_value->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    value2 = xmlGetProp(result_value->nodesetval->nodeTab[0], (xmlChar*) "unit");
+    for (int node_id = 0; node_id <= network->higher_node_id; node_id++) {
+        node_pos[node_id] = -1;
+    }
+    for (int i = 0; i < network->number_nodes; i++) {
+        node_pos[network->topology[i].node_id] = i;
+        prev_node[i] = -1;
+    }
     
-    // Convert the read value into nanoseconds and save
-    int size = atoi((const char*) value);
-    size = convert_to_byte(size, (char*) value2);
+    // Breadth first search from the sender, so the first path found to the receiver has the fewest links
+    int head = 0, tail = 1, found = -1;
+    queue[0] = sender;
+    prev_node[sender] = sender;
+    while (head < tail && found == -1) {
+        Node_Topology *node_pt = &network->topology[queue[head]];
+        head++;
+        // The path can start in an end system, but not go through one
+        if (node_pt != &network->topology[sender] && get_nodetype(node_pt->node_pt) == EndSystem) {
+            continue;
+        }
+        for (int j = 0; j < node_pt->num_connection && found == -1; j++) {
+            Connection_Topology *connection_pt = &node_pt->connections_pt[j];
+            if (connection_pt->link_id == link_id || connection_pt->node_id > network->higher_node_id ||
+                node_pos[connection_pt->node_id] == -1 || prev_node[node_pos[connection_pt->node_id]] != -1) {
+                continue;
+            }
+            int next = node_pos[connection_pt->node_id];
+            prev_node[next] = (int)(node_pt - network->topology);
+            prev_link[next] = connection_pt->link_id;
+            if (connection_pt->node_id == receiver_id) {
+                found = next;
+            }
+            queue[tail] = next;
+            tail++;
+        }
+    }
     
-    // Free xml objects
-    xmlFree(value);
-    xmlFree(value2);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
+    // Walk back from the receiver to save the links of the path in order
+    int len_path = 0;
+    for (int pos = found; pos != -1 && pos != sender; pos = prev_node[pos]) {
+        len_path++;
+    }
+    for (int pos = found, it = len_path - 1; pos != -1 && pos != sender; pos = prev_node[pos], it--) {
+        path[it] = prev_link[pos];
+    }
     
-    return size;
+    free(node_pos);
+    free(queue);
+    free(prev_node);
+    free(prev_link);
+    return len_path;
 }
 
 /**
- For the given tree and path, return the number of occurrences as a findall search
- 
- @param top_xml pointer to the top of the tree
- @param path path where to search
- @return number of occurrences
+ Check if an optional argument of the executables or the server requests is given
  */
-int get_occurences_xml(xmlDoc *top_xml, char* path) {
-    
-    // Init xml variables needed to search information in the file
-    xmlXPathContextPtr context;
-    xmlXPathObjectPtr result;
+int has_argument(int argc, char *argv[], int position) {
     
-    // Search for number of occurences
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        return 0;
-    }
-    int num = result->nodesetval->nodeNr;
-    
-    // Free xml objects
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
-    
-    return num;
+    return argc > position && strcmp(argv[position], "-") != 0;
 }
 
+/* Input Functions */
+
 /**
- For the given tree, and paths, find the number of occurences of the subpath inside the path
- 
- @param top_xml pointer to the top of the tree
- @param path path where to search the first occurrence
- @param num number of the ocurrence
- @param subpath where to search inside the ocurrence
- @return number of ocurreces found in the subpath
- */
-int get_ocurrences_in_ocurrences_xml(xmlDoc *top_xml, char* path, int num, char* subpath) {
-    
-    // Init xml variables needed to search information in the file
-    xmlXPathContextPtr context, context_value;
-    xmlXPathObjectPtr result, result_value;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return 0;
+ Get the first child element of the given node with the given name.
+ The input files are read walking the tree once from the root, instead of searching every value from the top
+
+ @param node_xml pointer to the parent node, it can be NULL
+ @param name name of the child element
+ @return pointer to the child element, NULL if there is none
+ */
+xmlNode *get_child_xml(xmlNode *node_xml, char *name) {
+    
+    if (node_xml == NULL) {
+        return NULL;
     }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return 0;
+    for (xmlNode *child_xml = node_xml->children; child_xml != NULL; child_xml = child_xml->next) {
+        if (child_xml->type == XML_ELEMENT_NODE && xmlStrcmp(child_xml->name, BAD_CAST name) == 0) {
+            return child_xml;
+        }
     }
     
-    // Set new context to the given num and search for the next subpath
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    
-    int num_occur = result_value->nodesetval->nodeNr;
+    return NULL;
+}
+
+/**
+ Get the next sibling element with the same name of the given node
+
+ @param node_xml pointer to the node
+ @return pointer to the next sibling element, NULL if there is none
+ */
+xmlNode *get_next_xml(xmlNode *node_xml) {
     
-    // Free xml objects
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
+    for (xmlNode *next_xml = node_xml->next; next_xml != NULL; next_xml = next_xml->next) {
+        if (next_xml->type == XML_ELEMENT_NODE && xmlStrcmp(next_xml->name, node_xml->name) == 0) {
+            return next_xml;
+        }
+    }
     
-    return num_occur;
+    return NULL;
 }
 
 /**
- Get the name of the given property for a given id of the occurent of the path
- 
- @param top_xml pointer to the top of the tree
- @param path path to search
- @path num id number of the occurence
- @param property name of the property to search
- @return the name of the occurrence, NULL if something went wrong
- */
-char *get_property_occur_xml(xmlDoc *top_xml, char *path, int num, char* property) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context;
-    xmlXPathObjectPtr result;
-    char *return_value;
-    
-    // Search for the value
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return NULL;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return NULL;
-    }
-    
-    // Search for the property
-    value = xmlGetProp(result->nodesetval->nodeTab[num], (xmlChar*) property);
-    return_value = (char*) xmlStrdup(value);
+ Follow the given path of element names separated by '/', taking the first element with the name in every step
+
+ @param node_xml pointer to the node where the path starts, it can be NULL
+ @param path path of element names
+ @return pointer to the element at the end of the path, NULL if it does not exist
+ */
+xmlNode *get_path_xml(xmlNode *node_xml, char *path) {
     
-    // Free xml objects
-    xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeContext(context);
+    while (node_xml != NULL && *path != '\0') {
+        
+        // Search the child with the name of the current step
+        int length = (int) strcspn(path, "/");
+        xmlNode *child_xml = node_xml->children;
+        while (child_xml != NULL && (child_xml->type != XML_ELEMENT_NODE || xmlStrlen(child_xml->name) != length ||
+                                     xmlStrncmp(child_xml->name, BAD_CAST path, length) != 0)) {
+            child_xml = child_xml->next;
+        }
+        node_xml = child_xml;
+        path += path[length] == '/' ? length + 1 : length;
+    }
     
-    return return_value;
+    return node_xml;
 }
 
 /**
- Get the value of the subpath search for the given occurrence
- 
- @param top_xml pointer to the top of the tree
- @param path path of the occurrence
- @param num number of the occurrence
- @param subpath path to search inside the occurrence
- @return value found, -1 if failed
- */
-char *get_occur_value_xml(xmlDoc *top_xml, char *path, int num, char* subpath) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context, context_value;
-    xmlXPathObjectPtr result, result_value;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return NULL;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return NULL;
+ Count the number of children elements with the given name
+
+ @param node_xml pointer to the parent node, it can be NULL
+ @param name name of the children elements
+ @return number of children elements found
+ */
+int count_children_xml(xmlNode *node_xml, char *name) {
+    
+    int num = 0;
+    for (xmlNode *child_xml = get_child_xml(node_xml, name); child_xml != NULL; child_xml = get_next_xml(child_xml)) {
+        num++;
     }
     
-    // Set new context to the given num and search for the value
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    value = xmlNodeListGetString(top_xml, result_value->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    char *return_value = (char*) xmlStrdup(value);
+    return num;
+}
+
+/**
+ Get the value of the element in the given path from the node
+
+ @param node_xml pointer to the node where the path starts
+ @param path path of the element
+ @return the value read, -1 if the element was not found
+ */
+long long int get_value_xml(xmlNode *node_xml, char *path) {
     
-    // Free xml objects
+    xmlNode *value_xml = get_path_xml(node_xml, path);
+    if (value_xml == NULL) {
+        return -1;
+    }
+    xmlChar *value = xmlNodeGetContent(value_xml);
+    long long int return_value = atoll((const char*) value);
     xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
     
     return return_value;
 }
 
 /**
- Get the property in an occurrence inside an ocurrence with a given final path
- 
- @param top_xml pointer to the top of the tree
- @param path first ocurrence path
- @param num number of the ocurrence
- @param subpath second ecurrence path
- @param subnum number of the second ocurrence
- @param find_path path to find
- @param property property to find
- @return value of the found property
- */
-char *get_prop_occur_in_occur_xml(xmlDoc *top_xml, char *path, int num, char *subpath, int subnum, char *find_path,
-                                  char *property) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context, context_value, context_final;
-    xmlXPathObjectPtr result, result_value, result_final;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return NULL;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return NULL;
-    }
+ Get the time of the element in the given path from the node converted to ns with its unit
+
+ @param node_xml pointer to the node where the path starts
+ @param path path of the element
+ @return the time read converted to nanoseconds, -1 if the element was not found
+ */
+long long int get_time_value_xml(xmlNode *node_xml, char *path) {
     
-    // Set new context to the given num and search for the next subpath
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    if (result_value->nodesetval->nodeNr < subnum) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return 0;
+    xmlNode *value_xml = get_path_xml(node_xml, path);
+    if (value_xml == NULL) {
+        return -1;
     }
-    
-    // Set the final context and catch the value
-    context_final = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result_value->nodesetval->nodeTab[subnum], context_final);
-    result_final = xmlXPathEvalExpression((xmlChar *) find_path, context_final);
-    value = xmlGetProp(result_final->nodesetval->nodeTab[0], (xmlChar*) property);
-    char *return_value = (char*) xmlStrdup(value);      // Copy the string as we free it later on
-    
-    // Free xml objects
+    xmlChar *value = xmlNodeGetContent(value_xml);
+    xmlChar *unit = xmlGetProp(value_xml, BAD_CAST "unit");
+    long long int time = convert_to_ns(atoll((const char*) value), (char*) unit);
     xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeObject(result_final);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
-    xmlXPathFreeContext(context_final);
+    xmlFree(unit);
     
-    return return_value;
+    return time;
 }
 
 /**
- Find the value from an ocurrence path inside another occurence path
- 
- @param top_xml pointer to the top of the tree
- @param path first ocurrence path
- @param num number in the ocurrence
- @param subpath second ocurrence path
- @param subnum number in the second ocurrence
- @param find_path path of the value to search
- @return value found
- */
-char *get_ocurr_in_ocurr_value_xml(xmlDoc *top_xml, char *path, int num, char *subpath, int subnum, char* find_path) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value;
-    xmlXPathContextPtr context, context_value, context_final;
-    xmlXPathObjectPtr result, result_value, result_final;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return NULL;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return NULL;
-    }
+ Get the size of the element in the given path from the node converted to bytes with its unit
+
+ @param node_xml pointer to the node where the path starts
+ @param path path of the element
+ @return the size read converted to bytes, -1 if the element was not found
+ */
+int get_size_value_xml(xmlNode *node_xml, char *path) {
     
-    // Set new context to the given num and search for the next subpath
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    if (result_value->nodesetval->nodeNr < subnum) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return NULL;
+    xmlNode *value_xml = get_path_xml(node_xml, path);
+    if (value_xml == NULL) {
+        return -1;
     }
-    
-    // Set the final context and catch the value
-    context_final = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result_value->nodesetval->nodeTab[subnum], context_final);
-    result_final = xmlXPathEvalExpression((xmlChar *) find_path, context_final);
-    value = xmlNodeListGetString(top_xml, result_final->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    char* return_value = (char*) xmlStrdup(value);
-    
-    // Free xml objects
+    xmlChar *value = xmlNodeGetContent(value_xml);
+    xmlChar *unit = xmlGetProp(value_xml, BAD_CAST "unit");
+    int size = convert_to_byte(atoi((const char*) value), (char*) unit);
     xmlFree(value);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeObject(result_final);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
-    xmlXPathFreeContext(context_final);
+    xmlFree(unit);
     
-    return return_value;
+    return size;
 }
 
 /**
- Find the speed value from an ocurrence path inside another occurence path and return it in MB/s
- 
- @param top_xml pointer to the top of the tree
- @param path first ocurrence path
- @param num number in the ocurrence
- @param subpath second ocurrence path
- @param subnum number in the second ocurrence
- @param find_path path of the value to search
- @return speed value found converted to MB/s
- */
-int get_occur_in_ocurr_speed_value_xml(xmlDoc *top_xml, char *path, int num, char *subpath, int subnum,
-                                       char* find_path) {
-    
-    // Init xml variables needed to search information in the file
-    xmlChar *value, *value2;
-    xmlXPathContextPtr context, context_value, context_final;
-    xmlXPathObjectPtr result, result_value, result_final;
-    
-    // Search for the num occurrence
-    context = xmlXPathNewContext(top_xml);
-    result = xmlXPathEvalExpression((xmlChar*) path, context);
-    if (result->nodesetval->nodeTab == NULL) {
-        fprintf(stderr, "The searched value is not defined\n");
-        return 0;
-    }
-    if (result->nodesetval->nodeNr < num) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
-        return 0;
-    }
+ Get the speed of the element in the given path from the node converted to MB/s with its unit
+
+ @param node_xml pointer to the node where the path starts
+ @param path path of the element
+ @return the speed read converted to MB/s, 0 if the element was not found
+ */
+int get_speed_value_xml(xmlNode *node_xml, char *path) {
     
-    // Set new context to the given num and search for the next subpath
-    context_value = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result->nodesetval->nodeTab[num], context_value);
-    result_value = xmlXPathEvalExpression((xmlChar*) subpath, context_value);
-    if (result_value->nodesetval->nodeNr < subnum) {
-        fprintf(stderr, "The searched path does not have as many occurences as searched\n");
+    xmlNode *value_xml = get_path_xml(node_xml, path);
+    if (value_xml == NULL) {
         return 0;
     }
-    
-    // Set the final context and catch the value
-    context_final = xmlXPathNewContext(top_xml);
-    xmlXPathSetContextNode(result_value->nodesetval->nodeTab[subnum], context_final);
-    result_final = xmlXPathEvalExpression((xmlChar *) find_path, context_final);
-    value = xmlNodeListGetString(top_xml, result_final->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-    value2 = xmlGetProp(result_final->nodesetval->nodeTab[0], (xmlChar*) "unit");
-    int speed = atoi((const char*) value);
-    speed = convert_to_mbs(speed, (char*) value2);
-    
-    // Free xml objects
+    xmlChar *value = xmlNodeGetContent(value_xml);
+    xmlChar *unit = xmlGetProp(value_xml, BAD_CAST "unit");
+    int speed = convert_to_mbs(atoi((const char*) value), (char*) unit);
     xmlFree(value);
-    xmlFree(value2);
-    xmlXPathFreeObject(result);
-    xmlXPathFreeObject(result_value);
-    xmlXPathFreeObject(result_final);
-    xmlXPathFreeContext(context);
-    xmlXPathFreeContext(context_value);
-    xmlXPathFreeContext(context_final);
+    xmlFree(unit);
     
     return speed;
 }
@@ -897,13 +1119,12 @@ int get_occur_in_ocurr_speed_value_xml(xmlDoc *top_xml, char *path, int num, cha
 /**
  Read the switch information and save its into memory
  
- @param top_xml pointer to the top of the network xml file
+ @param general_xml pointer to the general information of the network
  @return 0 if all information was saved correctly, -1 otherwise
  */
-int read_switch_xml(xmlDoc *top_xml) {
+int read_switch_xml(xmlNode *general_xml) {
     
-    char* path = "/NetworkConfiguration/GeneralInformation/SwitchInformation/MinimumTime";
-    long long int switch_time = get_time_value_xml(top_xml, path);
+    long long int switch_time = get_time_value_xml(general_xml, "SwitchInformation/MinimumTime");
     set_switch_information(switch_time);
     
     return 0;
@@ -913,13 +1134,12 @@ int read_switch_xml(xmlDoc *top_xml) {
  Read the Self-Healing Protocol information of the network and add it to the structure.
  If there is no data, set protocol as 0.
  
- @param top_xml pointer to the top of the tree
+ @param general_xml pointer to the general information of the network
  @return 0 if all information was saved correctly, -1 otherwise
  */
-int read_healing_protocol_xml(xmlDoc *top_xml) {
+int read_healing_protocol_xml(xmlNode *general_xml) {
     
-    char* path_period = "/NetworkConfiguration/GeneralInformation/SelfHealingProtocol/Period";
-    long long int period = get_time_value_xml(top_xml, path_period);
+    long long int period = get_time_value_xml(general_xml, "SelfHealingProtocol/Period");
     
     // If the data was not found or set incorrectly, assume there is no self-healing protocol
     if (period == -1) {
@@ -927,8 +1147,7 @@ int read_healing_protocol_xml(xmlDoc *top_xml) {
         return 0;
     }
     
-    char* path_time = "/NetworkConfiguration/GeneralInformation/SelfHealingProtocol/Time";
-    long long int time = get_time_value_xml(top_xml, path_time);
+    long long int time = get_time_value_xml(general_xml, "SelfHealingProtocol/Time");
     
     set_healing_protocol(period, time);
     
@@ -938,17 +1157,19 @@ int read_healing_protocol_xml(xmlDoc *top_xml) {
 /**
  Read the general information of the network and add its into the Network variables
  
- @param top_xml pointer to general information tree
+ @param root_xml pointer to the root of the network
  @return 0 if all information was saved correctly, -1 otherwise
  */
-int read_general_information_xml(xmlDoc *top_xml) {
+int read_general_information_xml(xmlNode *root_xml) {
     
-    if (read_switch_xml(top_xml) == -1) {
+    xmlNode *general_xml = get_child_xml(root_xml, "GeneralInformation");
+    
+    if (read_switch_xml(general_xml) == -1) {
         fprintf(stderr, "Error while reading the switch information\n");
         return -1;
     }
     
-    if (read_healing_protocol_xml(top_xml) == -1) {
+    if (read_healing_protocol_xml(general_xml) == -1) {
         fprintf(stderr, "Error while reading the Self-Healing Protocol information\n");
         return -1;
     }
@@ -959,110 +1180,120 @@ int read_general_information_xml(xmlDoc *top_xml) {
 /**
  Read and save the information of the topology
  
- @param top_xml pointer to the top of the tree
+ @param root_xml pointer to the root of the network
  @return 0 if read and saved correctly, -1 otherwise
  */
-int read_topology_xml(xmlDoc *top_xml) {
+int read_topology_xml(xmlNode *root_xml) {
     
     // Read the number of nodes and allocate the needed memory for the topology
-    char *path = "/NetworkConfiguration/TopologyInformation/Node";
-    int num_nodes = get_occurences_xml(top_xml, path);
+    xmlNode *topology_xml = get_child_xml(root_xml, "TopologyInformation");
+    int num_nodes = count_children_xml(topology_xml, "Node");
     if (num_nodes <= 0) {
         fprintf(stderr, "No nodes found in the topology description\n");
+        return -1;
     }
-    number_nodes = num_nodes;
-    number_links = 0;
-    topology = malloc(sizeof(Node_Topology) * num_nodes);
+    network->number_nodes = num_nodes;
+    network->number_links = 0;
+    network->topology = calloc(num_nodes, sizeof(Node_Topology));
     for (int i = 0; i < num_nodes; i++) {
-        topology[i].node_pt = malloc(sizeof(Node));     // Allocate memory first
+        network->topology[i].node_pt = malloc(sizeof(Node));     // Allocate memory first
     }
     
     // For all nodes, save the information
-    for (int i = 0; i < num_nodes; i++) {
+    xmlNode *node_xml = get_child_xml(topology_xml, "Node");
+    for (int i = 0; i < num_nodes; i++, node_xml = get_next_xml(node_xml)) {
         
         // Set the category of the node
-        char *node_type = get_property_occur_xml(top_xml, path, i, "category");
-        if (set_nodetype_str(topology[i].node_pt, node_type) == -1) {
+        xmlChar *node_type = xmlGetProp(node_xml, BAD_CAST "category");
+        int error = set_nodetype_str(network->topology[i].node_pt, (char*) node_type);
+        xmlFree(node_type);
+        if (error == -1) {
             fprintf(stderr, "The node type could not be saved correctly\n");
             return -1;
         }
         
         // Search and save the node id
-        char *value = get_occur_value_xml(top_xml, path, i, "NodeID");
-        if (value == NULL) {
+        if (get_child_xml(node_xml, "NodeID") == NULL) {
             fprintf(stderr, "The node id could not be saved correctly\n");
             return -1;
         }
-        int node_id = atoi(value);
+        int node_id = (int) get_value_xml(node_xml, "NodeID");
         if (node_id < 0) {
             fprintf(stderr, "The node id needs to be a natural number\n");
             return -1;
         }
-        if (node_id > higher_node_id) {
-            higher_node_id = node_id;
+        if (node_id > network->higher_node_id) {
+            network->higher_node_id = node_id;
         }
         // Check if the node was defined before
         for (int j = 0; j < i; j++) {
-            if (topology[j].node_id == node_id) {
+            if (network->topology[j].node_id == node_id) {
                 fprintf(stderr, "The node id %d has been defined multiple times\n", node_id);
                 return -1;
             }
         }
-        topology[i].node_id = node_id;
+        network->topology[i].node_id = node_id;
         
         // Read the number of connections and allocate the needed memory, also allocate all the pointers correctly
-        int num_connections = get_ocurrences_in_ocurrences_xml(top_xml, path, i, "Connection");
-        topology[i].connections_pt = malloc(sizeof(Connection_Topology) * num_connections);
-        topology[i].num_connection = num_connections;
+        int num_connections = count_children_xml(node_xml, "Connection");
+        network->topology[i].connections_pt = malloc(sizeof(Connection_Topology) * num_connections);
+        network->topology[i].num_connection = num_connections;
         for (int j = 0; j < num_connections; j++) {
-            topology[i].connections_pt[j].link_pt = malloc(sizeof(Link));
+            network->topology[i].connections_pt[j].link_pt = malloc(sizeof(Link));
         }
         // For all the connections, save the information
-        for (int j = 0; j < num_connections; j++) {
-            number_links += 1;
+        xmlNode *connection_xml = get_child_xml(node_xml, "Connection");
+        for (int j = 0; j < num_connections; j++, connection_xml = get_next_xml(connection_xml)) {
+            network->number_links += 1;
             // Search and save the node id and point to it
-            char *value = get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Connection", j, "NodeID");
-            if (value == NULL) {
+            if (get_child_xml(connection_xml, "NodeID") == NULL) {
                 fprintf(stderr, "The node %d failed to find the node id of one of its connections \n", node_id);
                 return -1;
             }
-            int node_id = atoi(value);
+            int node_id = (int) get_value_xml(connection_xml, "NodeID");
             if (node_id < 0) {
                 fprintf(stderr, "The node id needs to be a natural number\n");
                 return -1;
             }
-            if (node_id == topology[i].node_id) {
+            if (node_id == network->topology[i].node_id) {
                 fprintf(stderr, "The node %d is connected to itself\n", node_id);
                 return -1;
             }
-            topology[i].connections_pt[j].node_id = node_id;
+            network->topology[i].connections_pt[j].node_id = node_id;
             
             // Search the link id
-            value = get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Connection", j, "Link/LinkID");
-            if (value == NULL) {
+            xmlNode *link_xml = get_child_xml(connection_xml, "Link");
+            if (get_child_xml(link_xml, "LinkID") == NULL) {
                 fprintf(stderr, "The node %d failed to find the link id of one of its connections \n", node_id);
                 return -1;
             }
-            int link_id = atoi(value);
+            int link_id = (int) get_value_xml(link_xml, "LinkID");
             if (link_id < 0) {
                 fprintf(stderr, "The link id needs to be a natural number\n");
                 return -1;
             }
             for (int h = 0; h < j; h++) {
-                if (topology[i].connections_pt[h].link_id == link_id) {
+                if (network->topology[i].connections_pt[h].link_id == link_id) {
                     fprintf(stderr, "The node %d has two connections with the same link %d\n", node_id, link_id);
                     return -1;
                 }
             }
-            topology[i].connections_pt[j].link_id = link_id;
-            if (link_id > higher_link_id) {
-                higher_link_id = link_id;
+            network->topology[i].connections_pt[j].link_id = link_id;
+            if (link_id > network->higher_link_id) {
+                network->higher_link_id = link_id;
             }
             
             // Seach the link type and the speed and save it
-            char *link_type = get_prop_occur_in_occur_xml(top_xml, path, i, "Connection", j, "Link", "category");
-            int speed = get_occur_in_ocurr_speed_value_xml(top_xml, path, i, "Connection", j, "Link/Speed");
-            if (set_link_str(topology[i].connections_pt[j].link_pt, link_type, speed) == -1) {
+            xmlChar *link_type = xmlGetProp(link_xml, BAD_CAST "category");
+            int speed = get_speed_value_xml(link_xml, "Speed");
+            error = set_link_str(network->topology[i].connections_pt[j].link_pt, (char*) link_type, speed);
+            xmlFree(link_type);
+            // The wireless links can repeat every transmission, once if the number of replicas is not given
+            if (error == 0 && get_child_xml(link_xml, "Replicas") != NULL) {
+                error = set_link_replicas(network->topology[i].connections_pt[j].link_pt,
+                                          (int) get_value_xml(link_xml, "Replicas"));
+            }
+            if (error == -1) {
                 fprintf(stderr, "Error setting the values of link %d\n", link_id);
                 return -1;
             }
@@ -1072,158 +1303,175 @@ int read_topology_xml(xmlDoc *top_xml) {
     return 0;
 }
 
+/**
+ Read the path of a receiver, given as the list of link ids separated by ';', and save it in the frame
+
+ @param frame_pt pointer to the frame
+ @param receiver_id id of the receiver of the path
+ @param path_xml pointer to the path element
+ @return 0 if done correctly, -1 otherwise
+ */
+int read_receiver_path_xml(Frame *frame_pt, int receiver_id, xmlNode *path_xml) {
+    
+    xmlChar *value = xmlNodeGetContent(path_xml);
+    
+    // Count the number of hops first, to allocate the array only once
+    int num_hops = 1;
+    for (char *hop = strchr((char*) value, ';'); hop != NULL; hop = strchr(hop + 1, ';')) {
+        num_hops++;
+    }
+    
+    // Parse the string into the array
+    int *path_array = malloc(sizeof(int) * num_hops);
+    int link_char_it = 0;
+    char *link_char = strtok((char*) value, ";");
+    while (link_char != NULL) {
+        path_array[link_char_it] = atoi(link_char);
+        link_char = strtok(NULL, ";");
+        link_char_it++;
+    }
+    int error = set_path_receiver_id(frame_pt, receiver_id, path_array, link_char_it);
+    
+    free(path_array);
+    xmlFree(value);
+    return error;
+}
+
 /**
  Read the traffic of the network and save it in memory
  
- @param top_xml pointer to the top of the tree
+ @param root_xml pointer to the root of the network
  @return 0 if done correctly, -1 otherwise
  */
-int read_traffic_xml(xmlDoc *top_xml) {
+int read_traffic_xml(xmlNode *root_xml) {
     
     // Read the number of frames and allocate the needed memory in the list of frames
-    char *path = "/NetworkConfiguration/TrafficDescription/Frame";
-    int num_frames = get_occurences_xml(top_xml, path);
+    xmlNode *traffic_xml = get_child_xml(root_xml, "TrafficDescription");
+    int num_frames = count_children_xml(traffic_xml, "Frame");
     if (num_frames <= 0) {
         fprintf(stderr, "No frames found in the traffic description\n");
         return -1;
     }
-    traffic.num_frames = num_frames;
-    traffic.frames = malloc(sizeof(Frame) * num_frames);
-    traffic.frames_id = malloc(sizeof(int) * num_frames);
+    network->traffic.num_frames = num_frames;
+    network->traffic.frames = calloc(num_frames, sizeof(Frame));
+    network->traffic.frames_id = malloc(sizeof(int) * num_frames);
     
     // For all frames, save its information
-    for (int i = 0; i < num_frames; i++) {
+    xmlNode *frame_xml = get_child_xml(traffic_xml, "Frame");
+    for (int i = 0; i < num_frames; i++, frame_xml = get_next_xml(frame_xml)) {
         
         // Search and save the frame ID
-        char *value = get_occur_value_xml(top_xml, path, i, "FrameID");
-        if (value == NULL) {
+        if (get_child_xml(frame_xml, "FrameID") == NULL) {
             fprintf(stderr, "A frameID could not be found\n");
             return -1;
         }
-        int frame_id = atoi(value);
+        int frame_id = (int) get_value_xml(frame_xml, "FrameID");
         if (frame_id < 0) {
             fprintf(stderr, "The frameID should be a natural number\n");
             return -1;
         }
-        if (frame_id > higher_frame_id) {
-            higher_frame_id = frame_id;
+        if (frame_id > network->higher_frame_id) {
+            network->higher_frame_id = frame_id;
         }
-        traffic.frames_id[i] = frame_id;
+        network->traffic.frames_id[i] = frame_id;
         
         // Seach and save the sender ID
-        value = get_occur_value_xml(top_xml, path, i, "SenderID");
-        if (value == NULL) {
+        if (get_child_xml(frame_xml, "SenderID") == NULL) {
             fprintf(stderr, "A SenderID could not be found\n");
             return -1;
         }
-        int sender_id = atoi(value);
+        int sender_id = (int) get_value_xml(frame_xml, "SenderID");
         if (is_node_id_defined(sender_id) == -1) {
             fprintf(stderr, "The frame %d has the sender %d not defined in the topology\n", frame_id, sender_id);
             return -1;
         }
-        set_sender_id(&traffic.frames[i], sender_id);
+        set_sender_id(&network->traffic.frames[i], sender_id);
         
         // Search and save the period
-        long long int period = get_occur_time_value_xml(top_xml, path, i, "Period");
-        if (set_period(&traffic.frames[i], period) == -1) {
+        long long int period = get_time_value_xml(frame_xml, "Period");
+        if (set_period(&network->traffic.frames[i], period) == -1) {
             fprintf(stderr, "The period of the frame %d is not well defined\n", frame_id);
             return -1;
         }
         // Recalculate the hyperperiod
-        if (hyperperiod == 0) {
-            hyperperiod = period;
+        if (network->hyperperiod == 0) {
+            network->hyperperiod = period;
         } else {
-            long long int gcdnum = gcd(hyperperiod, period);
+            long long int gcdnum = gcd(network->hyperperiod, period);
             if (gcdnum <= 0) {
                 fprintf(stderr, "Something went really wrong when calculating the hyperperiod\n");
                 return -1;
             }
-            hyperperiod = (hyperperiod * period) / gcdnum;
+            network->hyperperiod = (network->hyperperiod * period) / gcdnum;
         }
         
         // Search and save the deadline, deadline == 0 or missing => deadline = period
-        long long int deadline = get_occur_time_value_xml(top_xml, path, i, "Deadline");
+        long long int deadline = get_time_value_xml(frame_xml, "Deadline");
         if (deadline == -1) {
-            set_deadline(&traffic.frames[i], 0);
+            set_deadline(&network->traffic.frames[i], 0);
         } else {
-            if (set_deadline(&traffic.frames[i], deadline) == -1) {
+            if (set_deadline(&network->traffic.frames[i], deadline) == -1) {
                 fprintf(stderr, "The deadline of the frame %d is not well defined\n", frame_id);
                 return -1;
             }
         }
         
         // Search and save the size, size missing or 0 ==> size = 1000 Bytes
-        int size = get_occur_size_value_xml(top_xml, path, i, "Size");
+        int size = get_size_value_xml(frame_xml, "Size");
         if (size == -1 || size == 0) {
-            set_size(&traffic.frames[i], 1000);
+            set_size(&network->traffic.frames[i], 1000);
         } else {
-            if (set_size(&traffic.frames[i], size) == -1) {
+            if (set_size(&network->traffic.frames[i], size) == -1) {
                 fprintf(stderr, "The size of the frame %d is not well defined\n", frame_id);
                 return -1;
             }
         }
         
         // Search and save the starting time, starting time missing ==> starting time = 0
-        long long int starting_time = get_occur_time_value_xml(top_xml, path, i, "StartingTime");
+        long long int starting_time = get_time_value_xml(frame_xml, "StartingTime");
         if (starting_time == -1) {
-            set_starting_time(&traffic.frames[i], 0);
+            set_starting_time(&network->traffic.frames[i], 0);
         } else {
-            if (set_starting_time(&traffic.frames[i], starting_time) == -1) {
+            if (set_starting_time(&network->traffic.frames[i], starting_time) == -1) {
                 fprintf(stderr, "The starting time of the frame %d is not well defined\n", frame_id);
                 return -1;
             }
         }
         
         // Seach and save the end to end time, end to end time missing ==> end to end = 0 => not taken into account
-        long long int end = get_occur_time_value_xml(top_xml, path, i, "EndToEnd");
+        long long int end = get_time_value_xml(frame_xml, "EndToEnd");
         if (end == -1) {
-            set_end_to_end(&traffic.frames[i], 0);
+            set_end_to_end(&network->traffic.frames[i], 0);
         } else {
-            if (set_end_to_end(&traffic.frames[i], end) == -1) {
+            if (set_end_to_end(&network->traffic.frames[i], end) == -1) {
                 fprintf(stderr, "The end to end time of the frame %d is not well defined\n", frame_id);
                 return -1;
             }
         }
         
         // Read the number of receivers and allocate the needed memory
-        int num_receivers = get_ocurrences_in_ocurrences_xml(top_xml, path, i, "Paths/Receiver");
-        traffic.frames[i].num_paths = num_receivers;
-        traffic.frames[i].receivers_id = malloc(sizeof(int) * num_receivers);
-        traffic.frames[i].list_paths = malloc(sizeof(Path) * num_receivers);
-        for (int j = 0; j < num_receivers; j++) {
+        xmlNode *paths_xml = get_child_xml(frame_xml, "Paths");
+        int num_receivers = count_children_xml(paths_xml, "Receiver");
+        network->traffic.frames[i].num_paths = num_receivers;
+        network->traffic.frames[i].receivers_id = malloc(sizeof(int) * num_receivers);
+        network->traffic.frames[i].list_paths = malloc(sizeof(Path) * num_receivers);
+        xmlNode *receiver_xml = get_child_xml(paths_xml, "Receiver");
+        for (int j = 0; j < num_receivers; j++, receiver_xml = get_next_xml(receiver_xml)) {
             
             // Read the receiver ID
-            value = get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Paths/Receiver", j, "ReceiverID");
-            if (value == NULL) {
+            if (get_child_xml(receiver_xml, "ReceiverID") == NULL) {
                 fprintf(stderr, "A ReceiverID could not be found\n");
                 return -1;
             }
-            int receiver_id = atoi(value);
+            int receiver_id = (int) get_value_xml(receiver_xml, "ReceiverID");
             if (is_node_id_defined(receiver_id) == -1) {
                 fprintf(stderr, "The frame %d has the sender %d not defined in the topology\n", frame_id, receiver_id);
                 return -1;
             }
-            set_receiver_id(&traffic.frames[i], j, receiver_id);
+            set_receiver_id(&network->traffic.frames[i], j, receiver_id);
             
             // Read and save the path into the traffic structure
-            value = get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Paths/Receiver", j, "Path");
-            // Parse the string into an array
-            char *link_char = strtok(value, ";");
-            int link_char_it = 0;
-            int *path_array = NULL;
-            // Count the number of hops, to avoid reallocs and potential memory leaks
-            while (link_char != NULL) {
-                if (path_array == NULL) {
-                    path_array = malloc(sizeof(int));
-                } else {
-                    path_array = realloc(path_array, sizeof(int) * link_char_it + 1);
-                }
-                path_array[link_char_it] = atoi(link_char);
-                link_char = strtok(NULL, ";");
-                link_char_it++;
-            }
-            set_path_receiver_id(&traffic.frames[i], receiver_id, path_array, link_char_it);
-            
+            read_receiver_path_xml(&network->traffic.frames[i], receiver_id, get_child_xml(receiver_xml, "Path"));
         }
     }
     return 0;
@@ -1237,6 +1485,8 @@ int read_traffic_xml(xmlDoc *top_xml) {
  */
 int read_network_xml(char *network_file) {
     
+    profile_phase(phase_read);
+    
     xmlDoc *top_xml;        // Variable that contains the xml document top tree
     
     // Open the xml file if it exists
@@ -1245,180 +1495,215 @@ int read_network_xml(char *network_file) {
         fprintf(stderr, "The given xml file does not exist\n");
         return -1;
     }
+    xmlNode *root_xml = xmlDocGetRootElement(top_xml);
+    if (root_xml == NULL || xmlStrcmp(root_xml->name, BAD_CAST "NetworkConfiguration") != 0) {
+        fprintf(stderr, "The given xml file is not a network description\n");
+        xmlFreeDoc(top_xml);
+        return -1;
+    }
     
     // Read the general information of the network
-    if (read_general_information_xml(top_xml) == -1) {
+    if (read_general_information_xml(root_xml) == -1) {
         fprintf(stderr, "The general information of the network could not be read\n");
+        xmlFreeDoc(top_xml);
         return -1;
     }
     
     // Read the topology of the network
-    if (read_topology_xml(top_xml) == -1) {
+    if (read_topology_xml(root_xml) == -1) {
         fprintf(stderr, "The topology of the network could not be read\n");
+        xmlFreeDoc(top_xml);
         return -1;
     }
     
     // Read the traffic of the network
-    if (read_traffic_xml(top_xml) == -1) {
+    if (read_traffic_xml(root_xml) == -1) {
         fprintf(stderr, "The traffic of the network could not be read\n");
+        xmlFreeDoc(top_xml);
         return -1;
     }
     
+    // The file is kept so the network can be read again, as the portfolio does for every one of its members
+    free(network->network_file);
+    network->network_file = strdup(network_file);
+    
     xmlFreeDoc(top_xml);
     return 0;
 }
 
 /**
- Read the general patch information of the network and add its into the Network variables
+ Read the general information of a patch or an optimize and add its into the Network variables
  
- @param top_xml pointer to general information tree
+ @param root_xml pointer to the root of the patch or the optimize
  @return 0 if all information was saved correctly, -1 otherwise
  */
-int read_general_patch_information_xml(xmlDoc *top_xml) {
+int read_general_patch_information_xml(xmlNode *root_xml) {
     
-    char* path = "/Patch/GeneralInformation/LinkID";
-    patched_link = (int)get_value_xml(top_xml, path);
+    xmlNode *general_xml = get_child_xml(root_xml, "GeneralInformation");
+    network->patched_link = (int) get_value_xml(general_xml, "LinkID");
     
     // Set the healing protocol
-    path = "/Patch/GeneralInformation/ProtocolPeriod";
-    long long int protocol_period = get_value_xml(top_xml, path);
-    path = "/Patch/GeneralInformation/ProtocolTime";
-    long long int protocol_time = get_value_xml(top_xml, path);
+    long long int protocol_period = get_value_xml(general_xml, "ProtocolPeriod");
+    long long int protocol_time = get_value_xml(general_xml, "ProtocolTime");
     set_healing_protocol(protocol_period, protocol_time);
     
     // Read the hyper period
-    path = "/Patch/GeneralInformation/HyperPeriod";
-    hyperperiod = get_value_xml(top_xml, path);
+    network->hyperperiod = get_value_xml(general_xml, "HyperPeriod");
+    
+    return 0;
+}
+
+/**
+ Add the given number of empty frames after the frames already read in the traffic
+
+ @param num_frames number of frames to add
+ @return position of the first added frame
+ */
+int add_patch_frames(int num_frames) {
+    
+    int first = network->traffic.num_frames;
+    network->traffic.num_frames += num_frames;
+    network->traffic.frames = realloc(network->traffic.frames, sizeof(Frame) * network->traffic.num_frames);
+    network->traffic.frames_id = realloc(network->traffic.frames_id, sizeof(int) * network->traffic.num_frames);
+    memset(&network->traffic.frames[first], 0, sizeof(Frame) * num_frames);
+    
+    return first;
+}
+
+/**
+ Prepare a frame of a patch or an optimize to use only the link being patched and allocate the instances of its offset
+
+ @param frame_it position of the frame in the traffic
+ @param frame_id id of the frame
+ @param num_instances number of instances of the frame in the link
+ @param num_replicas number of replicas of every instance, the repetitions of a wireless link
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_patch_frame(int frame_it, int frame_id, int num_instances, int num_replicas) {
+    
+    if (frame_id > network->higher_frame_id) {
+        network->higher_frame_id = frame_id;
+    }
+    network->traffic.frames_id[frame_it] = frame_id;
+    
+    // As there is only one link, there exist only one receiver
+    Frame *frame_pt = &network->traffic.frames[frame_it];
+    frame_pt->num_paths = 1;
+    frame_pt->receivers_id = malloc(sizeof(int));
+    frame_pt->list_paths = malloc(sizeof(Path));
+    set_receiver_id(frame_pt, 0, 1);
+    int path_array[] = {network->patched_link};
+    set_path_receiver_id(frame_pt, 1, path_array, 1);
+    
+    // Prepare the instances of the offset
+    if (init_offset_patch(frame_pt, num_instances, num_replicas - 1, &network->network_arena) == -1) {
+        fprintf(stderr, "The preparation of the offsets of the frames failed\n");
+        return -1;
+    }
     
     return 0;
 }
 
 /**
- Read the fixed traffic information of the patch
+ Read the frame id of a frame of a patch or an optimize, prepare the frame to use only the link being patched and
+ allocate the instances of its offset
+
+ @param frame_xml pointer to the frame element
+ @param frame_it position of the frame in the traffic
+ @return 0 if done correctly, -1 otherwise
+ */
+int read_patch_frame_xml(xmlNode *frame_xml, int frame_it) {
+    
+    // Search and save the frame ID
+    if (get_child_xml(frame_xml, "FrameID") == NULL) {
+        fprintf(stderr, "A frameID could not be found\n");
+        return -1;
+    }
+    int frame_id = (int) get_value_xml(frame_xml, "FrameID");
+    if (frame_id < 0) {
+        fprintf(stderr, "The frameID should be a natural number\n");
+        return -1;
+    }
+    
+    int num_instances = count_children_xml(get_child_xml(frame_xml, "Offset"), "Instance");
+    return init_patch_frame(frame_it, frame_id, num_instances, 1);
+}
 
- @param top_xml pointer to the top of the tree
+/**
+ Read the fixed traffic information of a patch or an optimize, the frames are added after the ones already read in
+ case there are several links to patch
+ 
+ @param root_xml pointer to the root of the patch or the optimize
+ @param ranges 1 to also set the transmission range of the instances to their transmission time, 0 otherwise
  @return 0 if done correctly, -1 otherwise
  */
-int read_patch_fixed_traffix_xml(xmlDoc *top_xml) {
+int read_patch_fixed_traffix_xml(xmlNode *root_xml, int ranges) {
     
     // Read the number of frames and allocate the needed memory in the list of frames
-    char *path = "/Patch/FixedTraffic/Frame";
-    int num_frames = get_occurences_xml(top_xml, path);
+    xmlNode *fixed_xml = get_child_xml(root_xml, "FixedTraffic");
+    int num_frames = count_children_xml(fixed_xml, "Frame");
+    network->num_frames_fixed = num_frames;
     if (num_frames == 0) {
         return 0;
     }
-    num_frames_fixed = num_frames;
-    traffic.num_frames = num_frames;
-    traffic.frames = malloc(sizeof(Frame) * num_frames);
-    traffic.frames_id = malloc(sizeof(int) * num_frames);
+    int first = add_patch_frames(num_frames);
     
     // For all frames, save its information
-    for (int i = 0; i < num_frames; i++) {
+    xmlNode *frame_xml = get_child_xml(fixed_xml, "Frame");
+    for (int i = first; i < network->traffic.num_frames; i++, frame_xml = get_next_xml(frame_xml)) {
         
-        // Search and save the frame ID
-        char *value = get_occur_value_xml(top_xml, path, i, "FrameID");
-        if (value == NULL) {
-            fprintf(stderr, "A frameID could not be found\n");
-            return -1;
-        }
-        int frame_id = atoi(value);
-        if (frame_id < 0) {
-            fprintf(stderr, "The frameID should be a natural number\n");
+        if (read_patch_frame_xml(frame_xml, i) == -1) {
             return -1;
         }
-        if (frame_id > higher_frame_id) {
-            higher_frame_id = frame_id;
-        }
-        traffic.frames_id[i] = frame_id;
-        
-        // As there is only one link, there exist only one receiver
-        traffic.frames[i].num_paths = 1;
-        traffic.frames[i].receivers_id = malloc(sizeof(int));
-        traffic.frames[i].list_paths = malloc(sizeof(Path));
-        set_receiver_id(&traffic.frames[i], 0, 1);
-        int path_array[] = {patched_link};
-        set_path_receiver_id(&traffic.frames[i], 1, path_array, 1);
         
         // Read the offsets and save the transmission and ending times
-        int num_instances = get_ocurrences_in_ocurrences_xml(top_xml, path, i, "Offset/Instance");
-        init_offset_patch(&traffic.frames[i], num_instances, 0);
-        Offset *offset_pt = get_offset_it(&traffic.frames[i], 0);
-        for (int j = 0; j < num_instances; j++) {
-            long long int trans_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", j,
-                                                                    "TransmissionTime"));
+        Offset *offset_pt = get_offset_it(&network->traffic.frames[i], 0);
+        xmlNode *instance_xml = get_path_xml(frame_xml, "Offset/Instance");
+        long long int first_trans_time = get_value_xml(instance_xml, "TransmissionTime");
+        long long int end_time = get_value_xml(instance_xml, "EndingTime");
+        for (int j = 0; instance_xml != NULL; j++, instance_xml = get_next_xml(instance_xml)) {
+            long long int trans_time = get_value_xml(instance_xml, "TransmissionTime");
             set_trans_time(offset_pt, j, 0, trans_time);
+            if (ranges == 1) {
+                set_trans_range(offset_pt, j, 0, trans_time, trans_time, 0);
+            }
         }
-        long long int trans_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", 0,
-                                                                      "TransmissionTime"));
-        long long int end_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", 0,
-                                                                      "EndingTime"));
         // Set the time to transmit the frame
-        set_time_offset_it(&traffic.frames[i], 0, (int)(end_time - trans_time));
+        set_time_offset_it(&network->traffic.frames[i], 0, (int)(end_time - first_trans_time));
     }
     
     return 0;
 }
 
 /**
- Read the traffic information of the patch to allocate
+ Read the traffic information of a patch or an optimize to allocate, the frames are added after the fixed ones
  
- @param top_xml pointer to the top of the tree
+ @param root_xml pointer to the root of the patch or the optimize
  @return 0 if done correctly, -1 otherwise
  */
-int read_patch_traffic_xml(xmlDoc *top_xml) {
+int read_patch_traffic_xml(xmlNode *root_xml) {
  
     // Read the number of frames and allocate the needed memory in the list of frames
-    char *path = "/Patch/Traffic/Frame";
-    int num_frames = get_occurences_xml(top_xml, path);
-    traffic.num_frames += num_frames;
-    // If there was no number of frames fixed, we have to allocate the traffic
-    if (num_frames_fixed == 0) {
-        traffic.frames = malloc(sizeof(Frame) * num_frames);
-        traffic.frames_id = malloc(sizeof(int) * num_frames);
-    } else {
-        traffic.frames = realloc(traffic.frames, sizeof(Frame) * traffic.num_frames);
-        traffic.frames_id = realloc(traffic.frames_id, sizeof(int) * traffic.num_frames);
-    }
+    xmlNode *traffic_xml = get_child_xml(root_xml, "Traffic");
+    int num_frames = count_children_xml(traffic_xml, "Frame");
+    // The traffic might be empty if there was no fixed frames
+    int first = add_patch_frames(num_frames);
     
     // For all frames, save its information
-    for (int i = num_frames_fixed; i < traffic.num_frames; i++) {
+    xmlNode *frame_xml = get_child_xml(traffic_xml, "Frame");
+    for (int i = first; i < network->traffic.num_frames; i++, frame_xml = get_next_xml(frame_xml)) {
         
-        // Search and save the frame ID
-        char *value = get_occur_value_xml(top_xml, path, i - num_frames_fixed, "FrameID");
-        if (value == NULL) {
-            fprintf(stderr, "A frameID could not be found\n");
+        if (read_patch_frame_xml(frame_xml, i) == -1) {
             return -1;
         }
-        int frame_id = atoi(value);
-        if (frame_id < 0) {
-            fprintf(stderr, "The frameID should be a natural number\n");
-            return -1;
-        }
-        if (frame_id > higher_frame_id) {
-            higher_frame_id = frame_id;
-        }
-        traffic.frames_id[i] = frame_id;
-        
-        // As there is only one link, there exist only one receiver
-        traffic.frames[i].num_paths = 1;
-        traffic.frames[i].receivers_id = malloc(sizeof(int));
-        traffic.frames[i].list_paths = malloc(sizeof(Path));
-        set_receiver_id(&traffic.frames[i], 0, 1);
-        int path_array[] = {patched_link};
-        set_path_receiver_id(&traffic.frames[i], 1, path_array, 1);
         
         // Read the offsets and save the transmission ranges and timeslots of the transmission
-        int num_instances = get_ocurrences_in_ocurrences_xml(top_xml, path, i - num_frames_fixed, "Offset/Instance");
-        init_offset_patch(&traffic.frames[i], num_instances, 0);
-        Offset *offset_pt = get_offset_it(&traffic.frames[i], 0);
-        int time_slot = atoi(get_occur_value_xml(top_xml, path, i - num_frames_fixed, "Offset/TimeSlots"));
-        for (int j = 0; j < num_instances; j++) {
-            long long int min_transmission = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i - num_frames_fixed,
-                                                                                "Offset/Instance", j,
-                                                                                "MinTransmission"));
-            long long int max_transmission = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i - num_frames_fixed,
-                                                                                "Offset/Instance", j,
-                                                                                "MaxTransmission"));
+        Offset *offset_pt = get_offset_it(&network->traffic.frames[i], 0);
+        int time_slot = (int) get_value_xml(frame_xml, "Offset/TimeSlots");
+        xmlNode *instance_xml = get_path_xml(frame_xml, "Offset/Instance");
+        for (int j = 0; instance_xml != NULL; j++, instance_xml = get_next_xml(instance_xml)) {
+            long long int min_transmission = get_value_xml(instance_xml, "MinTransmission");
+            long long int max_transmission = get_value_xml(instance_xml, "MaxTransmission");
             set_trans_range(offset_pt, j, 0, min_transmission, max_transmission, time_slot);
         }
     }
@@ -1427,234 +1712,421 @@ int read_patch_traffic_xml(xmlDoc *top_xml) {
 }
 
 /**
- Read the information of the patch in the xml file and saves its information into the invernal variables
+ Read the patch of every link in a patch file with several links, one after the other in the traffic
+
+ @param root_xml pointer to the root of the multi patch
+ @return 0 if done correctly, -1 otherwise
  */
-int read_patch_xml(char *patch_file) {
-    
-    xmlDoc *top_xml;        // Variable that contains the xml document top tree
+int read_multi_patch_xml(xmlNode *root_xml) {
     
-    // Open the xml file if it exists
-    top_xml = xmlReadFile(patch_file, NULL, 0);
-    if (top_xml == NULL) {
-        fprintf(stderr, "The given xml file does not exist\n");
+    // Search all the patches of the file
+    network->num_link_patches = count_children_xml(root_xml, "Patch");
+    if (network->num_link_patches == 0) {
+        fprintf(stderr, "The multi patch file does not have any patch\n");
         return -1;
     }
+    network->link_patches = malloc(sizeof(Link_Patch) * network->num_link_patches);
+    
+    xmlNode *patch_xml = get_child_xml(root_xml, "Patch");
+    for (int i = 0; i < network->num_link_patches; i++, patch_xml = get_next_xml(patch_xml)) {
+        
+        network->link_patches[i].first_frame = network->traffic.num_frames;
+        if (read_general_patch_information_xml(patch_xml) == -1 || read_patch_fixed_traffix_xml(patch_xml, 0) == -1 ||
+            read_patch_traffic_xml(patch_xml) == -1) {
+            fprintf(stderr, "The patch %d of the multi patch could not be read\n", i);
+            return -1;
+        }
+        network->link_patches[i].link_id = network->patched_link;
+        network->link_patches[i].num_fixed = network->num_frames_fixed;
+        network->link_patches[i].num_frames = network->traffic.num_frames - network->link_patches[i].first_frame;
+        network->link_patches[i].baseline = 0;
+        network->link_patches[i].patched = 0;
+        network->link_patches[i].execution_time = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ Read the general information, the fixed traffic and the traffic of a patch or an optimize
+
+ @param root_xml pointer to the root of the patch or the optimize
+ @param ranges 1 to also set the transmission range of the fixed instances, as the optimize needs, 0 otherwise
+ @return 0 if done correctly, -1 otherwise
+ */
+int read_single_patch_xml(xmlNode *root_xml, int ranges) {
     
     // Read the general information of the patch
-    if (read_general_patch_information_xml(top_xml) == -1) {
+    if (read_general_patch_information_xml(root_xml) == -1) {
         fprintf(stderr, "The general patch information of the patch could not be read\n");
         return -1;
     }
     
     // Read the fixed traffic of the patch
-    if (read_patch_fixed_traffix_xml(top_xml) == -1) {
+    if (read_patch_fixed_traffix_xml(root_xml, ranges) == -1) {
         fprintf(stderr, "The fixed traffic information of the patch could not be read\n");
         return -1;
     }
     
     // Read the traffic of the patch
-    if (read_patch_traffic_xml(top_xml) == -1) {
+    if (read_patch_traffic_xml(root_xml) == -1) {
         fprintf(stderr, "The traffic information of the patch could not be read\n");
         return -1;
     }
     
-    xmlFreeDoc(top_xml);
     return 0;
 }
 
 /**
- Read the general optimize information of the network and add its into the Network variables
- 
- @param top_xml pointer to general information tree
- @return 0 if all information was saved correctly, -1 otherwise
+ Read the information of the patch in the xml file and saves its information into the invernal variables
  */
-int read_general_optimize_information_xml(xmlDoc *top_xml) {
+int read_patch_xml(char *patch_file) {
     
-    char* path = "/Optimize/GeneralInformation/LinkID";
-    patched_link = (int)get_value_xml(top_xml, path);
+    profile_phase(phase_read);
     
-    // Set the healing protocol
-    path = "/Optimize/GeneralInformation/ProtocolPeriod";
-    long long int protocol_period = get_value_xml(top_xml, path);
-    path = "/Optimize/GeneralInformation/ProtocolTime";
-    long long int protocol_time = get_value_xml(top_xml, path);
-    set_healing_protocol(protocol_period, protocol_time);
+    xmlDoc *top_xml;        // Variable that contains the xml document top tree
     
-    // Read the hyper period
-    path = "/Optimize/GeneralInformation/HyperPeriod";
-    hyperperiod = get_value_xml(top_xml, path);
+    // Open the xml file if it exists
+    top_xml = xmlReadFile(patch_file, NULL, 0);
+    if (top_xml == NULL) {
+        fprintf(stderr, "The given xml file does not exist\n");
+        return -1;
+    }
+    xmlNode *root_xml = xmlDocGetRootElement(top_xml);
     
-    return 0;
+    // Several links can be patched from the same file
+    int error;
+    if (root_xml != NULL && xmlStrcmp(root_xml->name, BAD_CAST "MultiPatch") == 0) {
+        error = read_multi_patch_xml(root_xml);
+    } else if (root_xml != NULL && xmlStrcmp(root_xml->name, BAD_CAST "Patch") == 0) {
+        error = read_single_patch_xml(root_xml, 0);
+    } else {
+        fprintf(stderr, "The given xml file is not a patch\n");
+        error = -1;
+    }
+    
+    xmlFreeDoc(top_xml);
+    return error;
 }
 
 /**
- Read the fixed traffic information of the optimize
- 
- @param top_xml pointer to the top of the tree
- @return 0 if done correctly, -1 otherwise
+ Read the information of the optimize in the xml file and saves its information into the invernal variables
  */
-int read_optimize_fixed_traffix_xml(xmlDoc *top_xml) {
+int read_optimize_xml(char *optimize_file) {
     
-    // Read the number of frames and allocate the needed memory in the list of frames
-    char *path = "/Optimize/FixedTraffic/Frame";
-    int num_frames = get_occurences_xml(top_xml, path);
-    if (num_frames == 0) {
-        return 0;
+    profile_phase(phase_read);
+    
+    xmlDoc *top_xml;        // Variable that contains the xml document top tree
+    
+    // Open the xml file if it exists
+    top_xml = xmlReadFile(optimize_file, NULL, 0);
+    if (top_xml == NULL) {
+        fprintf(stderr, "The given xml file does not exist\n");
+        return -1;
     }
-    num_frames_fixed = num_frames;
-    traffic.num_frames = num_frames;
-    traffic.frames = malloc(sizeof(Frame) * num_frames);
-    traffic.frames_id = malloc(sizeof(int) * num_frames);
+    xmlNode *root_xml = xmlDocGetRootElement(top_xml);
     
-    // For all frames, save its information
-    for (int i = 0; i < num_frames; i++) {
+    // The optimize file has the same structure than a single patch file
+    int error;
+    if (root_xml != NULL && xmlStrcmp(root_xml->name, BAD_CAST "Optimize") == 0) {
+        error = read_single_patch_xml(root_xml, 1);
+    } else {
+        fprintf(stderr, "The given xml file is not an optimize\n");
+        error = -1;
+    }
+    
+    xmlFreeDoc(top_xml);
+    return error;
+}
+
+/**
+ Get the range where an instance of a frame of a failed link can be transmitted in the path that replaces it. It is
+ the most constrained range of all the paths of the frame that use the failed link, and it leaves time to transmit
+ the frame in the last link of the path
+
+ @param scheduled_pt pointer to the scheduled network
+ @param frame_pt pointer to the frame in the scheduled network
+ @param link_id id of the failed link
+ @param instance instance of the frame
+ @param last_time time slots to transmit the frame in the last link of the path
+ @param min pointer where to save the minimum transmission time
+ @param max pointer where to save the maximum transmission time
+ @return 0 if done correctly, -1 if there is no range left
+ */
+int get_failure_range(Network *scheduled_pt, Frame *frame_pt, int link_id, int instance, int last_time,
+                      long long int *min, long long int *max) {
+    
+    long long int switch_time = scheduled_pt->switch_info.min_time;
+    *min = 0;
+    *max = scheduled_pt->hyperperiod;
+    for (int i = 0; i < get_num_paths(frame_pt); i++) {
         
-        // Search and save the frame ID
-        char *value = get_occur_value_xml(top_xml, path, i, "FrameID");
-        if (value == NULL) {
-            fprintf(stderr, "A frameID could not be found\n");
-            return -1;
-        }
-        int frame_id = atoi(value);
-        if (frame_id < 0) {
-            fprintf(stderr, "The frameID should be a natural number\n");
-            return -1;
+        // Search the failed link in the path
+        Path *path_pt = get_path(frame_pt, i);
+        int len_path = get_num_links_path(path_pt);
+        int pos = 0;
+        while (pos < len_path && get_off_link_id(get_offset_path_link(path_pt, pos)) != link_id) {
+            pos++;
         }
-        if (frame_id > higher_frame_id) {
-            higher_frame_id = frame_id;
+        if (pos == len_path) {
+            continue;
         }
-        traffic.frames_id[i] = frame_id;
         
-        // As there is only one link, there exist only one receiver
-        traffic.frames[i].num_paths = 1;
-        traffic.frames[i].receivers_id = malloc(sizeof(int));
-        traffic.frames[i].list_paths = malloc(sizeof(Path));
-        set_receiver_id(&traffic.frames[i], 0, 1);
-        int path_array[] = {patched_link};
-        set_path_receiver_id(&traffic.frames[i], 1, path_array, 1);
-        
-        // Read the offsets and save the transmission and ending times
-        int num_instances = get_ocurrences_in_ocurrences_xml(top_xml, path, i, "Offset/Instance");
-        init_offset_patch(&traffic.frames[i], num_instances, 0);
-        Offset *offset_pt = get_offset_it(&traffic.frames[i], 0);
-        for (int j = 0; j < num_instances; j++) {
-            long long int trans_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", j,
-                                                                          "TransmissionTime"));
-            set_trans_time(offset_pt, j, 0, trans_time);
-            set_trans_range(offset_pt, j, 0, trans_time, trans_time, 0);
+        // The range goes from the end of the previous link to the start of the next link of the path
+        long long int first = get_period(frame_pt) * instance;
+        long long int last = get_deadline(frame_pt) + get_period(frame_pt) * instance;
+        if (pos > 0) {
+            Offset *prev_pt = get_offset_path_link(path_pt, pos - 1);
+            first = get_trans_time(prev_pt, instance, get_off_num_replicas(prev_pt) - 1) +
+                    get_hop_distance(get_off_time(prev_pt), switch_time);
+        }
+        if (pos < len_path - 1) {
+            last = get_trans_time(get_offset_path_link(path_pt, pos + 1), instance, 0) -
+                   get_hop_distance(last_time, switch_time);
+        } else {
+            last -= last_time;
         }
-        long long int trans_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", 0,
-                                                                      "TransmissionTime"));
-        long long int end_time = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i, "Offset/Instance", 0,
-                                                                    "EndingTime"));
-        // Set the time to transmit the frame
-        set_time_offset_it(&traffic.frames[i], 0, (int)(end_time - trans_time));
         
+        if (first > *min) {
+            *min = first;
+        }
+        if (last < *max) {
+            *max = last;
+        }
+    }
+    
+    if (*min > *max) {
+        fprintf(stderr, "The frame has no time left to be transmitted in the path that replaces the link %d\n",
+                link_id);
+        return -1;
     }
     
     return 0;
 }
 
 /**
- Read the traffic information of the optimize to allocate
- 
- @param top_xml pointer to the top of the tree
+ Read the patch of one link of the path that replaces a failed link, after the links of the path already read.
+ The frames of the failed link that the link already transmits are not patched again
+
+ @param scheduled_pt pointer to the scheduled network
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @param path_it position of the link to read in the path
+ @param min_range minimum transmission time of every instance of the frames of the failed link in the whole path
+ @param max_range maximum transmission time of every instance of the frames of the failed link in the whole path
+ @param link_patch pointer to the patch of the link to fill
  @return 0 if done correctly, -1 otherwise
  */
-int read_optimize_traffic_xml(xmlDoc *top_xml) {
-    
-    // Read the number of frames and allocate the needed memory in the list of frames
-    char *path = "/Optimize/Traffic/Frame";
-    int num_frames = get_occurences_xml(top_xml, path);
-    traffic.num_frames += num_frames;
-    // If there was no number of frames fixed, we have to allocate the traffic
-    if (num_frames_fixed == 0) {
-        traffic.frames = malloc(sizeof(Frame) * num_frames);
-        traffic.frames_id = malloc(sizeof(int) * num_frames);
-    } else {
-        traffic.frames = realloc(traffic.frames, sizeof(Frame) * traffic.num_frames);
-        traffic.frames_id = realloc(traffic.frames_id, sizeof(int) * traffic.num_frames);
+int read_failure_link_patch(Network *scheduled_pt, int link_id, int *path, int len_path, int path_it,
+                            long long int *min_range, long long int *max_range, Link_Patch *link_patch) {
+    
+    int patch_link = path[path_it];
+    Link *link_pt = scheduled_pt->link_accelerator[patch_link];
+    long long int switch_time = scheduled_pt->switch_info.min_time;
+    Link_Offset *fixed_offsets = scheduled_pt->link_offsets[patch_link];
+    int num_fixed = scheduled_pt->num_link_offsets[patch_link];
+    Link_Offset *failed_offsets = scheduled_pt->link_offsets[link_id];
+    int num_failed = scheduled_pt->num_link_offsets[link_id];
+    
+    // Count the frames of the failed link to patch in the link
+    int num_patch = 0;
+    for (int i = 0; i < num_failed; i++) {
+        if (get_offset_by_link(&scheduled_pt->traffic.frames[failed_offsets[i].frame_pos], patch_link) == NULL) {
+            num_patch++;
+        }
     }
-    
-    // For all frames, save its information
-    for (int i = num_frames_fixed; i < traffic.num_frames; i++) {
-        
-        // Search and save the frame ID
-        char *value = get_occur_value_xml(top_xml, path, i - num_frames_fixed, "FrameID");
-        if (value == NULL) {
-            fprintf(stderr, "A frameID could not be found\n");
+    network->patched_link = patch_link;
+    network->num_frames_fixed = num_fixed;
+    link_patch->link_id = patch_link;
+    link_patch->first_frame = add_patch_frames(num_fixed + num_patch);
+    link_patch->num_fixed = num_fixed;
+    link_patch->num_frames = num_fixed + num_patch;
+    link_patch->baseline = 1;
+    link_patch->patched = 0;
+    link_patch->execution_time = 0;
+    
+    // The fixed traffic is the schedule of the link, every replica of a wireless link is one more transmission
+    for (int i = 0; i < num_fixed; i++) {
+        int frame_it = link_patch->first_frame + i;
+        Offset *offset_pt = fixed_offsets[i].offset_pt;
+        int num_replicas = get_off_num_replicas(offset_pt);
+        if (init_patch_frame(frame_it, scheduled_pt->traffic.frames_id[fixed_offsets[i].frame_pos],
+                             get_off_num_instances(offset_pt) * num_replicas, 1) == -1) {
             return -1;
         }
-        int frame_id = atoi(value);
-        if (frame_id < 0) {
-            fprintf(stderr, "The frameID should be a natural number\n");
-            return -1;
+        Offset *patch_off = get_offset_it(&network->traffic.frames[frame_it], 0);
+        for (int inst = 0; inst < get_off_num_instances(offset_pt); inst++) {
+            for (int repl = 0; repl < num_replicas; repl++) {
+                set_trans_time(patch_off, inst * num_replicas + repl, 0, get_trans_time(offset_pt, inst, repl));
+            }
         }
-        if (frame_id > higher_frame_id) {
-            higher_frame_id = frame_id;
+        // As in the patch files, the time of the fixed frames is the distance from the transmission to the ending
+        set_time_offset_it(&network->traffic.frames[frame_it], 0, get_off_time(offset_pt) - 1);
+    }
+    
+    // The frames to patch get their part of the range of the whole path, with all the replicas of a wireless link
+    int link_replicas = get_link_replicas(link_pt);
+    int frame_it = link_patch->first_frame + num_fixed;
+    int range_it = 0;
+    for (int i = 0; i < num_failed; i++) {
+        Frame *frame_pt = &scheduled_pt->traffic.frames[failed_offsets[i].frame_pos];
+        int num_instances = get_off_num_instances(failed_offsets[i].offset_pt);
+        if (get_offset_by_link(frame_pt, patch_link) != NULL) {
+            range_it += num_instances;
+            continue;
         }
-        traffic.frames_id[i] = frame_id;
-        
-        // As there is only one link, there exist only one receiver
-        traffic.frames[i].num_paths = 1;
-        traffic.frames[i].receivers_id = malloc(sizeof(int));
-        traffic.frames[i].list_paths = malloc(sizeof(Path));
-        set_receiver_id(&traffic.frames[i], 0, 1);
-        int path_array[] = {patched_link};
-        set_path_receiver_id(&traffic.frames[i], 1, path_array, 1);
+        if (init_patch_frame(frame_it, scheduled_pt->traffic.frames_id[failed_offsets[i].frame_pos],
+                             num_instances, link_replicas) == -1) {
+            return -1;
+        }
+        int time_slots = get_size(frame_pt) * 1000 / get_speed(link_pt) / scheduled_pt->size_timeslot;
+        Offset *patch_off = get_offset_it(&network->traffic.frames[frame_it], 0);
         
-        // Read the offsets and save the transmission ranges and timeslots of the transmission
-        int num_instances = get_ocurrences_in_ocurrences_xml(top_xml, path, i - num_frames_fixed, "Offset/Instance");
-        init_offset_patch(&traffic.frames[i], num_instances, 0);
-        Offset *offset_pt = get_offset_it(&traffic.frames[i], 0);
-        int time_slot = atoi(get_occur_value_xml(top_xml, path, i - num_frames_fixed, "Offset/TimeSlots"));
-        for (int j = 0; j < num_instances; j++) {
-            long long int min_transmission = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i - num_frames_fixed,
-                                                                                "Offset/Instance", j,
-                                                                                "MinTransmission"));
-            long long int max_transmission = atoll(get_ocurr_in_ocurr_value_xml(top_xml, path, i - num_frames_fixed,
-                                                                                "Offset/Instance", j,
-                                                                                "MaxTransmission"));
-            set_trans_range(offset_pt, j, 0, min_transmission, max_transmission, time_slot);
+        // If the frame is already transmitted in the previous or next link of the path, those transmissions stay
+        Offset *prev_pt = path_it > 0 ? get_offset_by_link(frame_pt, path[path_it - 1]) : NULL;
+        Offset *next_pt = path_it < len_path - 1 ? get_offset_by_link(frame_pt, path[path_it + 1]) : NULL;
+        for (int inst = 0; inst < num_instances; inst++, range_it++) {
+            
+            // Every link ends its part of the range the hop distance before the part of the next link starts, the
+            // range goes from the first replica of the link to the last one
+            long long int length = max_range[range_it] - min_range[range_it];
+            long long int min = path_it * length / len_path + min_range[range_it];
+            long long int max = max_range[range_it];
+            if (path_it < len_path - 1) {
+                max = (path_it + 1) * length / len_path + min_range[range_it] -
+                      get_hop_distance(time_slots, switch_time);
+            }
+            if (prev_pt != NULL) {
+                min = get_trans_time(prev_pt, inst, get_off_num_replicas(prev_pt) - 1) +
+                      get_hop_distance(get_off_time(prev_pt), switch_time);
+            }
+            if (next_pt != NULL) {
+                max = get_trans_time(next_pt, inst, 0) - get_hop_distance(time_slots, switch_time);
+            }
+            set_instance_range(patch_off, inst, min, max, time_slots);
         }
+        frame_it++;
     }
     
     return 0;
 }
 
 /**
- Read the information of the optimize in the xml file and saves its information into the invernal variables
+ Prepare the current network for the patches derived from a scheduled network, and get the range of every instance of
+ the frames of the failed link in the whole path that replaces it
+
+ @param scheduled_pt pointer to the scheduled network
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @param num_patches number of links to patch
+ @param min_range pointer to the memory of the minimum transmission times, it has to be freed
+ @param max_range pointer to the memory of the maximum transmission times, it has to be freed
+ @return 0 if done correctly, -1 otherwise
  */
-int read_optimize_xml(char *optimize_file) {
+int init_failure_patch(Network *scheduled_pt, int link_id, int *path, int len_path, int num_patches,
+                       long long int **min_range, long long int **max_range) {
     
-    xmlDoc *top_xml;        // Variable that contains the xml document top tree
-    
-    // Open the xml file if it exists
-    top_xml = xmlReadFile(optimize_file, NULL, 0);
-    if (top_xml == NULL) {
-        fprintf(stderr, "The given xml file does not exist\n");
+    *min_range = NULL;
+    *max_range = NULL;
+    if (scheduled_pt == NULL || scheduled_pt == network || scheduled_pt->link_offsets == NULL || len_path <= 0) {
+        fprintf(stderr, "The failure patch needs a scheduled network, other than the current one, and a path\n");
         return -1;
     }
     
-    // Read the general information of the patch
-    if (read_general_optimize_information_xml(top_xml) == -1) {
-        fprintf(stderr, "The general patch information of the patch could not be read\n");
+    // The times of the scheduled network are already in time slots
+    network->hyperperiod = scheduled_pt->hyperperiod;
+    network->size_timeslot = scheduled_pt->size_timeslot;
+    set_healing_protocol(scheduled_pt->healing_prot.period, scheduled_pt->healing_prot.time);
+    set_switch_information(scheduled_pt->switch_info.min_time);
+    network->link_patches = malloc(sizeof(Link_Patch) * num_patches);
+    if (network->link_patches == NULL) {
+        fprintf(stderr, "Not enough memory for the patch of the failed link %d\n", link_id);
         return -1;
     }
+    network->num_link_patches = num_patches;
     
-    // Read the fixed traffic of the patch
-    if (read_optimize_fixed_traffix_xml(top_xml) == -1) {
-        fprintf(stderr, "The fixed traffic information of the patch could not be read\n");
+    // Range of every instance of the frames of the failed link in the whole path
+    Link_Offset *failed_offsets = scheduled_pt->link_offsets[link_id];
+    int num_failed = scheduled_pt->num_link_offsets[link_id];
+    int num_ranges = 0;
+    for (int i = 0; i < num_failed; i++) {
+        num_ranges += get_off_num_instances(failed_offsets[i].offset_pt);
+    }
+    *min_range = malloc(sizeof(long long int) * (num_ranges + 1));
+    *max_range = malloc(sizeof(long long int) * (num_ranges + 1));
+    if (*min_range == NULL || *max_range == NULL) {
+        fprintf(stderr, "Not enough memory for the patch of the failed link %d\n", link_id);
         return -1;
     }
+    Link *last_pt = scheduled_pt->link_accelerator[path[len_path - 1]];
+    for (int i = 0, range_it = 0; i < num_failed; i++) {
+        Frame *frame_pt = &scheduled_pt->traffic.frames[failed_offsets[i].frame_pos];
+        int last_time = get_size(frame_pt) * 1000 / get_speed(last_pt) / scheduled_pt->size_timeslot;
+        for (int inst = 0; inst < get_off_num_instances(failed_offsets[i].offset_pt); inst++) {
+            if (get_failure_range(scheduled_pt, frame_pt, link_id, inst, last_time, &(*min_range)[range_it],
+                                  &(*max_range)[range_it]) == -1) {
+                return -1;
+            }
+            range_it++;
+        }
+    }
     
-    // Read the traffic of the patch
-    if (read_optimize_traffic_xml(top_xml) == -1) {
-        fprintf(stderr, "The traffic information of the patch could not be read\n");
+    return 0;
+}
+
+/**
+ Read the patch of every link of the path that replaces a failed link of a scheduled network, as if it was read from
+ a multi patch file
+ */
+int read_failure_patch(Network *scheduled_pt, int link_id, int *path, int len_path) {
+    
+    long long int *min_range, *max_range;
+    int error = init_failure_patch(scheduled_pt, link_id, path, len_path, len_path, &min_range, &max_range);
+    
+    // Every link of the path is patched on its own, with its fixed frames first
+    for (int path_it = 0; path_it < len_path && error == 0; path_it++) {
+        error = read_failure_link_patch(scheduled_pt, link_id, path, len_path, path_it, min_range, max_range,
+                                        &network->link_patches[path_it]);
+    }
+    
+    free(min_range);
+    free(max_range);
+    return error;
+}
+
+/**
+ Read the optimize of one link of the path that replaces a failed link of a scheduled network, as if it was read
+ from an optimize file
+ */
+int read_failure_optimize(Network *scheduled_pt, int link_id, int *path, int len_path, int path_it) {
+    
+    if (path_it < 0 || path_it >= len_path) {
+        fprintf(stderr, "The link to optimize is not in the path that replaces the failed link %d\n", link_id);
+        return -1;
+    }
+    long long int *min_range, *max_range;
+    int error = init_failure_patch(scheduled_pt, link_id, path, len_path, 1, &min_range, &max_range);
+    if (error == 0) {
+        error = read_failure_link_patch(scheduled_pt, link_id, path, len_path, path_it, min_range, max_range,
+                                        &network->link_patches[0]);
+    }
+    free(min_range);
+    free(max_range);
+    if (error == -1) {
         return -1;
     }
     
-    xmlFreeDoc(top_xml);
+    // As in the optimize files, the fixed frames can only be transmitted at their scheduled time
+    for (int i = 0; i < network->num_frames_fixed; i++) {
+        Offset *offset_pt = get_offset_it(&network->traffic.frames[i], 0);
+        for (int inst = 0; inst < get_off_num_instances(offset_pt); inst++) {
+            long long int trans_time = get_trans_time(offset_pt, inst, 0);
+            set_trans_range(offset_pt, inst, 0, trans_time, trans_time, 0);
+        }
+    }
+    
     return 0;
 }
 
@@ -1670,10 +2142,10 @@ int write_healing_protocol_xml(xmlNode *root_xml) {
     
     char char_value[100];
     
-    sprintf(char_value, "%lld", healing_prot.period);
+    sprintf(char_value, "%lld", network->healing_prot.period);
     xmlNewChild(root_xml, NULL, BAD_CAST "Period", BAD_CAST char_value);
     
-    sprintf(char_value, "%lld", healing_prot.time);
+    sprintf(char_value, "%lld", network->healing_prot.time);
     xmlNewChild(root_xml, NULL, BAD_CAST "Time", BAD_CAST char_value);
     
     return 0;
@@ -1690,25 +2162,25 @@ int write_general_information_xml(xmlNode *root_xml) {
     char char_value[100];
     xmlNode *slot_xml;
     
-    sprintf(char_value, "%d", size_timeslot);
+    sprintf(char_value, "%d", network->size_timeslot);
     slot_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TimeslotSize", BAD_CAST char_value);
     xmlNewProp(slot_xml, BAD_CAST "unit", BAD_CAST "ns");
     
-    sprintf(char_value, "%lld", hyperperiod);
+    sprintf(char_value, "%lld", network->hyperperiod);
     xmlNewChild(root_xml, NULL, BAD_CAST "HyperPeriod", BAD_CAST char_value);
     
     // Write the self healing protocol if exists
-    if (healing_prot.period != 0) {
+    if (network->healing_prot.period != 0) {
         write_healing_protocol_xml(xmlNewChild(root_xml, NULL, BAD_CAST "SelfHealingProtocol", NULL));
     }
     
-    sprintf(char_value, "%d", number_links);
+    sprintf(char_value, "%d", network->number_links);
     xmlNewChild(root_xml, NULL, BAD_CAST "NumberLinks", BAD_CAST char_value);
     
-    sprintf(char_value, "%d", number_nodes);
+    sprintf(char_value, "%d", network->number_nodes);
     xmlNewChild(root_xml, NULL, BAD_CAST "NumberNodes", BAD_CAST char_value);
     
-    sprintf(char_value, "%d", traffic.num_frames);
+    sprintf(char_value, "%d", network->traffic.num_frames);
     xmlNewChild(root_xml, NULL, BAD_CAST "NumberFrames", BAD_CAST char_value);
     
     return 0;
@@ -1774,10 +2246,10 @@ int write_frame_xml(xmlNode *root_xml, Frame *pt, int frame_id) {
                 sprintf(char_value, "%d", h);
                 xmlNewChild(inst_xml, NULL, BAD_CAST "NumInstance", BAD_CAST char_value);
                 
-                sprintf(char_value, "%lld", off_pt->offset[h][0]);
+                sprintf(char_value, "%lld", get_trans_time(off_pt, h, 0));
                 xmlNewChild(inst_xml, NULL, BAD_CAST "TransmissionTime", BAD_CAST char_value);
                 
-                sprintf(char_value, "%lld", off_pt->offset[h][0] + off_pt->time - 1);
+                sprintf(char_value, "%lld", get_trans_time(off_pt, h, 0) + off_pt->time - 1);
                 xmlNewChild(inst_xml, NULL, BAD_CAST "EndingTime", BAD_CAST char_value);
                 
                 for (int k = 1; k < off_pt->num_replicas; k++) {
@@ -1786,10 +2258,10 @@ int write_frame_xml(xmlNode *root_xml, Frame *pt, int frame_id) {
                     sprintf(char_value, "%d", k);
                     xmlNewChild(repl_xml, NULL, BAD_CAST "NumReplica", BAD_CAST char_value);
                     
-                    sprintf(char_value, "%lld", off_pt->offset[h][k]);
+                    sprintf(char_value, "%lld", get_trans_time(off_pt, h, k));
                     xmlNewChild(repl_xml, NULL, BAD_CAST "TransmissionTime", BAD_CAST char_value);
                     
-                    sprintf(char_value, "%lld", off_pt->offset[h][k] + off_pt->time - 1);
+                    sprintf(char_value, "%lld", get_trans_time(off_pt, h, k) + off_pt->time - 1);
                     xmlNewChild(repl_xml, NULL, BAD_CAST "EndingTime", BAD_CAST char_value);
                 }
             }
@@ -1831,10 +2303,10 @@ int write_patched_frame_xml(xmlNode *root_xml, Frame *pt, int frame_id) {
         sprintf(char_value, "%d", h);
         xmlNewChild(inst_xml, NULL, BAD_CAST "NumInstance", BAD_CAST char_value);
         
-        sprintf(char_value, "%lld", off_pt->offset[h][0]);
+        sprintf(char_value, "%lld", get_trans_time(off_pt, h, 0));
         xmlNewChild(inst_xml, NULL, BAD_CAST "TransmissionTime", BAD_CAST char_value);
         
-        sprintf(char_value, "%lld", off_pt->offset[h][0] + off_pt->time - 1);
+        sprintf(char_value, "%lld", get_trans_time(off_pt, h, 0) + off_pt->time - 1);
         xmlNewChild(inst_xml, NULL, BAD_CAST "EndingTime", BAD_CAST char_value);
         
         for (int k = 1; k < off_pt->num_replicas; k++) {
@@ -1843,10 +2315,10 @@ int write_patched_frame_xml(xmlNode *root_xml, Frame *pt, int frame_id) {
             sprintf(char_value, "%d", k);
             xmlNewChild(repl_xml, NULL, BAD_CAST "NumReplica", BAD_CAST char_value);
             
-            sprintf(char_value, "%lld", off_pt->offset[h][k]);
+            sprintf(char_value, "%lld", get_trans_time(off_pt, h, k));
             xmlNewChild(repl_xml, NULL, BAD_CAST "TransmissionTime", BAD_CAST char_value);
             
-            sprintf(char_value, "%lld", off_pt->offset[h][k] + off_pt->time - 1);
+            sprintf(char_value, "%lld", get_trans_time(off_pt, h, k) + off_pt->time - 1);
             xmlNewChild(repl_xml, NULL, BAD_CAST "EndingTime", BAD_CAST char_value);
         }
     }
@@ -1875,59 +2347,92 @@ int write_schedule_xml(char *schedule_file) {
     
     // Write all frames information and transmission times
     traffic_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TrafficInformation", NULL);
-    for (int i = 0; i < traffic.num_frames; i++) {
+    for (int i = 0; i < network->traffic.num_frames; i++) {
         write_frame_xml(xmlNewChild(traffic_xml, NULL, BAD_CAST "Frame", NULL),
-                        &traffic.frames[i], traffic.frames_id[i]);
+                        &network->traffic.frames[i], network->traffic.frames_id[i]);
     }
     
     // Write the file and clean up the variables
     xmlSaveFormatFileEnc(schedule_file, top_xml, "UTF-8", 1);
     xmlFreeDoc(top_xml);
-    xmlCleanupParser();
     
     return 0;
 }
 
 /**
- Write the obtained patched schedule for all allocated frames into a xml file.
+ Write the patched schedule of a link, with its link id, the transmission times of the allocated frames and the time
+ used to patch them
+
+ @param root_xml pointer to the root of the patched schedule
+ @param link_id identifier of the patched link
+ @param first_frame position in the traffic of the first allocated frame
+ @param last_frame position in the traffic after the last allocated frame
+ @param execution_time time used to patch the link
+ @return 0 if done correctly, -1 otherwise
  */
-int write_patch_xml(char *patch_file) {
+int write_patched_link_xml(xmlNode *root_xml, int link_id, int first_frame, int last_frame,
+                           long long int execution_time) {
     
-    // Init xml variables needed to write information in the file
-    xmlDoc *top_xml;
-    xmlNode *root_xml, *general_xml, *traffic_xml, *timing_xml;
+    xmlNode *general_xml, *traffic_xml, *timing_xml;
     char char_value[100];
     
-    // Create the top file
-    top_xml = xmlNewDoc(BAD_CAST "1.0");
-    root_xml = xmlNewNode(NULL, BAD_CAST "PatchedSchedule");
-    xmlDocSetRootElement(top_xml, root_xml);
-    
     // Write the link id of the patch
     general_xml = xmlNewChild(root_xml, NULL, BAD_CAST "GeneralInformation", NULL);
-    sprintf(char_value, "%d", patched_link);
+    sprintf(char_value, "%d", link_id);
     xmlNewChild(general_xml, NULL, BAD_CAST "LinkID", BAD_CAST char_value);
     
     // Write all allocated frames information and transmission times
     traffic_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TrafficInformation", NULL);
-    for (int i = num_frames_fixed; i < traffic.num_frames; i++) {
+    for (int i = first_frame; i < last_frame; i++) {
         write_patched_frame_xml(xmlNewChild(traffic_xml, NULL, BAD_CAST "Frame", NULL),
-                                &traffic.frames[i], traffic.frames_id[i]);
+                                &network->traffic.frames[i], network->traffic.frames_id[i]);
     }
     
     // Write execution time
     timing_xml = xmlNewChild(root_xml, NULL, BAD_CAST "Timing", NULL);
-    sprintf(char_value, "%lld", get_execution_time());
+    sprintf(char_value, "%lld", execution_time);
     xmlNewChild(timing_xml, NULL, BAD_CAST "ExecutionTime", BAD_CAST char_value);
     
+    return 0;
+}
+
+/**
+ Write the obtained patched schedule for all allocated frames into a xml file.
+ */
+int write_patch_xml(char *patch_file) {
+    
+    // Init xml variables needed to write information in the file
+    xmlDoc *top_xml;
+    xmlNode *root_xml;
+    
+    // Create the top file
+    top_xml = xmlNewDoc(BAD_CAST "1.0");
+    if (network->num_link_patches == 0) {
+        root_xml = xmlNewNode(NULL, BAD_CAST "PatchedSchedule");
+        xmlDocSetRootElement(top_xml, root_xml);
+        write_patched_link_xml(root_xml, network->patched_link, network->num_frames_fixed, network->traffic.num_frames,
+                               get_execution_time());
+    } else {
+        // Only the links that could be patched are written, as a single patch that fails does not write the file
+        root_xml = xmlNewNode(NULL, BAD_CAST "MultiPatchedSchedule");
+        xmlDocSetRootElement(top_xml, root_xml);
+        for (int i = 0; i < network->num_link_patches; i++) {
+            Link_Patch *pt = &network->link_patches[i];
+            if (pt->patched == 1) {
+                write_patched_link_xml(xmlNewChild(root_xml, NULL, BAD_CAST "PatchedSchedule", NULL), pt->link_id,
+                                       pt->first_frame + pt->num_fixed, pt->first_frame + pt->num_frames,
+                                       pt->execution_time);
+            }
+        }
+    }
+    
     // Write the file and clean up the variables
     xmlSaveFormatFileEnc(patch_file, top_xml, "UTF-8", 1);
-//    xmlFreeDoc(top_xml);
+    xmlFreeDoc(top_xml);
 //    xmlFreeNode(root_xml);
 //    xmlFreeNode(general_xml);
 //    xmlFreeNode(traffic_xml);
 //    xmlFreeNode(timing_xml);
-    xmlCleanupParser();
         
     return 0;
 }
@@ -1950,14 +2455,14 @@ int write_optimize_xml(char *optimize_file) {
     
     // Write the link id of the patch
     general_xml = xmlNewChild(root_xml, NULL, BAD_CAST "GeneralInformation", NULL);
-    sprintf(char_value, "%d", patched_link);
+    sprintf(char_value, "%d", network->patched_link);
     xmlNewChild(general_xml, NULL, BAD_CAST "LinkID", BAD_CAST char_value);
     
     // Write all allocated frames information and transmission times
     traffic_xml = xmlNewChild(root_xml, NULL, BAD_CAST "TrafficInformation", NULL);
-    for (int i = num_frames_fixed; i < traffic.num_frames; i++) {
+    for (int i = network->num_frames_fixed; i < network->traffic.num_frames; i++) {
         write_patched_frame_xml(xmlNewChild(traffic_xml, NULL, BAD_CAST "Frame", NULL),
-                                &traffic.frames[i], traffic.frames_id[i]);
+                                &network->traffic.frames[i], network->traffic.frames_id[i]);
     }
     
     // Write execution time
@@ -1972,19 +2477,922 @@ int write_optimize_xml(char *optimize_file) {
 //    xmlFreeNode(general_xml);
 //    xmlFreeNode(traffic_xml);
 //    xmlFreeNode(timing_xml);
-    xmlCleanupParser();
     
     return 0;
 }
 
+/**
+ Write the header of a binary schedule file
+
+ @param file_pt pointer to the opened file
+ @param kind kind of schedule of the file
+ @param delta_kind kind of schedule that the delta gives over its baseline, 0 if the file is not a delta
+ @param num_sections number of frames or links that follow the header
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_binary_header(FILE *file_pt, Binary_Kind kind, Binary_Kind delta_kind, int num_sections) {
+    
+    Binary_Header header;
+    memset(&header, 0, sizeof(Binary_Header));
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.kind = kind;
+    header.delta_kind = delta_kind;
+    header.num_sections = num_sections;
+    header.hyperperiod = network->hyperperiod;
+    header.timeslot_size = network->size_timeslot;
+    header.protocol_period = network->healing_prot.period;
+    header.protocol_time = network->healing_prot.time;
+    header.number_links = network->number_links;
+    header.number_nodes = network->number_nodes;
+    header.number_frames = network->traffic.num_frames;
+    
+    if (fwrite(&header, sizeof(Binary_Header), 1, file_pt) != 1) {
+        fprintf(stderr, "The header of the binary file could not be written\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Write an offset and all its transmission times into a binary schedule file
+
+ @param file_pt pointer to the opened file
+ @param off_pt pointer to the offset
+ @param frame_id identifier of the frame of the offset
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_binary_offset(FILE *file_pt, Offset *off_pt, int frame_id) {
+    
+    Binary_Offset offset;
+    memset(&offset, 0, sizeof(Binary_Offset));
+    offset.frame_id = frame_id;
+    offset.link_id = off_pt->link_id;
+    offset.num_instances = off_pt->num_instances;
+    offset.num_replicas = off_pt->num_replicas;
+    offset.time = off_pt->time;
+    
+    // The transmission times are already saved flattened in the same order as in the file
+    size_t num_times = (size_t)off_pt->num_instances * off_pt->num_replicas;
+    long long int *times = off_pt->offset;
+    
+    // A strictly periodic offset only has the first instance, so all of them are expanded before writing
+    if (get_off_stored_instances(off_pt) != off_pt->num_instances) {
+        times = malloc(sizeof(long long int) * num_times);
+        if (times == NULL) {
+            fprintf(stderr, "Not enough memory to write the offset of the frame %d\n", frame_id);
+            return -1;
+        }
+        for (int inst = 0; inst < off_pt->num_instances; inst++) {
+            for (int repl = 0; repl < off_pt->num_replicas; repl++) {
+                times[inst * off_pt->num_replicas + repl] = get_trans_time(off_pt, inst, repl);
+            }
+        }
+    }
+    
+    int error = 0;
+    if (fwrite(&offset, sizeof(Binary_Offset), 1, file_pt) != 1 ||
+        fwrite(times, sizeof(int64_t), num_times, file_pt) != num_times) {
+        fprintf(stderr, "The offset of the frame %d could not be written\n", frame_id);
+        error = -1;
+    }
+    if (times != off_pt->offset) {
+        free(times);
+    }
+    return error;
+}
+
+/**
+ Write the patched or optimized schedule of a link into a binary schedule file
+
+ @param file_pt pointer to the opened file
+ @param link_id identifier of the link
+ @param first_frame position in the traffic of the first allocated frame
+ @param last_frame position in the traffic after the last allocated frame
+ @param execution_time time used to patch or optimize the link
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_binary_link(FILE *file_pt, int link_id, int first_frame, int last_frame, long long int execution_time) {
+    
+    Binary_Link link;
+    memset(&link, 0, sizeof(Binary_Link));
+    link.link_id = link_id;
+    link.num_frames = last_frame - first_frame;
+    link.execution_time = execution_time;
+    if (fwrite(&link, sizeof(Binary_Link), 1, file_pt) != 1) {
+        fprintf(stderr, "The link %d could not be written\n", link_id);
+        return -1;
+    }
+    
+    // In the patch we only need the first offset of the offset it
+    for (int i = first_frame; i < last_frame; i++) {
+        if (write_binary_offset(file_pt, network->traffic.frames[i].offset_it[0],
+                                network->traffic.frames_id[i]) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Write the obtained schedule from all frames into a binary file
+ */
+int write_schedule_binary(char *schedule_file) {
+    
+    FILE *file_pt = fopen(schedule_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The binary schedule file could not be opened\n");
+        return -1;
+    }
+    
+    int error = write_binary_header(file_pt, binary_schedule, 0, network->traffic.num_frames);
+    for (int i = 0; i < network->traffic.num_frames && error == 0; i++) {
+        Frame *pt = &network->traffic.frames[i];
+        
+        // Write the general information of the frame
+        Binary_Frame frame;
+        memset(&frame, 0, sizeof(Binary_Frame));
+        frame.frame_id = network->traffic.frames_id[i];
+        frame.size = pt->size;
+        frame.period = pt->period;
+        frame.deadline = pt->deadline;
+        frame.starting = pt->starting;
+        frame.end_to_end_delay = pt->end_to_end_delay;
+        frame.num_paths = pt->num_paths;
+        if (fwrite(&frame, sizeof(Binary_Frame), 1, file_pt) != 1) {
+            fprintf(stderr, "The frame %d could not be written\n", frame.frame_id);
+            error = -1;
+        }
+        
+        // Write the transmission times of all the paths of the frame
+        for (int j = 0; j < pt->num_paths && error == 0; j++) {
+            Binary_Path path = {j, pt->list_paths[j].length_path};
+            if (fwrite(&path, sizeof(Binary_Path), 1, file_pt) != 1) {
+                fprintf(stderr, "The path of the frame %d could not be written\n", frame.frame_id);
+                error = -1;
+            }
+            for (int k = 0; k < pt->list_paths[j].length_path && error == 0; k++) {
+                error = write_binary_offset(file_pt, pt->list_paths[j].list_offsets[k], frame.frame_id);
+            }
+        }
+    }
+    
+    fclose(file_pt);
+    return error;
+}
+
+/**
+ Write the obtained patched schedule of all patched links into a binary file
+ */
+int write_patch_binary(char *patch_file) {
+    
+    FILE *file_pt = fopen(patch_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The binary patched schedule file could not be opened\n");
+        return -1;
+    }
+    
+    int error = 0;
+    if (network->num_link_patches == 0) {
+        error = write_binary_header(file_pt, binary_patch, 0, 1);
+        if (error == 0) {
+            error = write_binary_link(file_pt, network->patched_link, network->num_frames_fixed,
+                                      network->traffic.num_frames, get_execution_time());
+        }
+    } else {
+        // Only the links that could be patched are written, as in the xml file
+        int num_patched = 0;
+        for (int i = 0; i < network->num_link_patches; i++) {
+            num_patched += network->link_patches[i].patched;
+        }
+        error = write_binary_header(file_pt, binary_patch, 0, num_patched);
+        for (int i = 0; i < network->num_link_patches && error == 0; i++) {
+            Link_Patch *pt = &network->link_patches[i];
+            if (pt->patched == 1) {
+                error = write_binary_link(file_pt, pt->link_id, pt->first_frame + pt->num_fixed,
+                                          pt->first_frame + pt->num_frames, pt->execution_time);
+            }
+        }
+    }
+    
+    fclose(file_pt);
+    return error;
+}
+
+/**
+ Write the obtained optimized schedule into a binary file
+ */
+int write_optimize_binary(char *optimize_file) {
+    
+    FILE *file_pt = fopen(optimize_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The binary optimized schedule file could not be opened\n");
+        return -1;
+    }
+    
+    int error = write_binary_header(file_pt, binary_optimize, 0, 1);
+    if (error == 0) {
+        error = write_binary_link(file_pt, network->patched_link, network->num_frames_fixed,
+                                  network->traffic.num_frames, get_execution_time());
+    }
+    
+    fclose(file_pt);
+    return error;
+}
+
+/**
+ Compare two offsets of a binary schedule by their link id and then by their frame id
+
+ @param a pointer to the record of the first offset
+ @param b pointer to the record of the second offset
+ @return negative if the first goes before, positive if it goes after, 0 if they are the same
+ */
+int compare_binary_records(const void *a, const void *b) {
+    
+    const Binary_Record *off_a = a;
+    const Binary_Record *off_b = b;
+    
+    if (off_a->link_id != off_b->link_id) {
+        return off_a->link_id < off_b->link_id ? -1 : 1;
+    }
+    if (off_a->frame_id != off_b->frame_id) {
+        return off_a->frame_id < off_b->frame_id ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Read the whole content of a binary file in memory
+
+ @param binary_file name and path of the binary file
+ @param size pointer where to save the size of the file in bytes
+ @return pointer to the content of the file, it has to be freed, NULL if it could not be read
+ */
+char * read_binary_file(char *binary_file, size_t *size) {
+    
+    FILE *file_pt = fopen(binary_file, "rb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The binary file %s could not be opened\n", binary_file);
+        return NULL;
+    }
+    fseek(file_pt, 0, SEEK_END);
+    long length = ftell(file_pt);
+    fseek(file_pt, 0, SEEK_SET);
+    
+    // All the records are a multiple of 8 bytes, so they are aligned in the memory of malloc
+    char *data = length > 0 ? malloc(length) : NULL;
+    if (data == NULL || fread(data, 1, length, file_pt) != (size_t) length) {
+        fprintf(stderr, "The binary file %s could not be read\n", binary_file);
+        free(data);
+        fclose(file_pt);
+        return NULL;
+    }
+    
+    fclose(file_pt);
+    *size = (size_t) length;
+    return data;
+}
+
+/**
+ Walk the links and offsets of a binary patched or optimized schedule read in memory, checking that they are inside
+ the file
+
+ @param baseline pointer to the baseline, with its data and header already read
+ @param fill 1 to save the position of every link and offset, 0 to only count the offsets
+ @return number of offsets, -1 if the file is truncated
+ */
+int walk_binary_baseline(Binary_Baseline *baseline, int fill) {
+    
+    size_t position = sizeof(Binary_Header);
+    int num_offsets = 0;
+    for (int i = 0; i < baseline->header->num_sections; i++) {
+        if (position + sizeof(Binary_Link) > baseline->size) {
+            return -1;
+        }
+        Binary_Link *link_pt = (Binary_Link *) (baseline->data + position);
+        position += sizeof(Binary_Link);
+        if (fill == 1) {
+            baseline->links[i] = link_pt;
+        }
+        
+        for (int j = 0; j < link_pt->num_frames; j++) {
+            Binary_Offset *off_pt = (Binary_Offset *) (baseline->data + position);
+            if (position + sizeof(Binary_Offset) > baseline->size || off_pt->num_instances < 0 ||
+                off_pt->num_replicas < 0) {
+                return -1;
+            }
+            position += sizeof(Binary_Offset) + sizeof(int64_t) * off_pt->num_instances * off_pt->num_replicas;
+            if (position > baseline->size) {
+                return -1;
+            }
+            // The offsets of a patch only have the link of their section, so they are searched by it
+            if (fill == 1) {
+                baseline->offsets[num_offsets].link_id = link_pt->link_id;
+                baseline->offsets[num_offsets].frame_id = off_pt->frame_id;
+                baseline->offsets[num_offsets].offset_pt = off_pt;
+            }
+            num_offsets++;
+        }
+    }
+    
+    return num_offsets;
+}
+
+/**
+ Release the memory of a binary schedule read in memory
+
+ @param baseline pointer to the baseline
+ @return 0 if done correctly
+ */
+int free_binary_baseline(Binary_Baseline *baseline) {
+    
+    free(baseline->data);
+    free(baseline->links);
+    free(baseline->offsets);
+    memset(baseline, 0, sizeof(Binary_Baseline));
+    
+    return 0;
+}
+
+/**
+ Read a binary patched or optimized schedule in memory, and sort its offsets so they can be searched
+
+ @param baseline_file name and path of the binary file, NULL for an empty baseline without any link
+ @param baseline pointer to the baseline to fill, it has to be freed with free_binary_baseline
+ @return 0 if done correctly, -1 otherwise
+ */
+int read_binary_baseline(char *baseline_file, Binary_Baseline *baseline) {
+    
+    memset(baseline, 0, sizeof(Binary_Baseline));
+    if (baseline_file == NULL) {
+        return 0;
+    }
+    
+    baseline->data = read_binary_file(baseline_file, &baseline->size);
+    if (baseline->data == NULL) {
+        return -1;
+    }
+    baseline->header = (Binary_Header *) baseline->data;
+    if (baseline->size < sizeof(Binary_Header) || memcmp(baseline->header->magic, BINARY_MAGIC, 4) != 0 ||
+        baseline->header->version != BINARY_VERSION ||
+        (baseline->header->kind != binary_patch && baseline->header->kind != binary_optimize)) {
+        fprintf(stderr, "The baseline file is not a binary patched or optimized schedule of a supported version\n");
+        free_binary_baseline(baseline);
+        return -1;
+    }
+    
+    // Count the offsets first to allocate the positions of all the records
+    baseline->num_offsets = walk_binary_baseline(baseline, 0);
+    if (baseline->num_offsets == -1) {
+        fprintf(stderr, "The baseline file is truncated\n");
+        free_binary_baseline(baseline);
+        return -1;
+    }
+    baseline->num_links = baseline->header->num_sections;
+    baseline->links = malloc(sizeof(Binary_Link *) * (baseline->num_links + 1));
+    baseline->offsets = malloc(sizeof(Binary_Record) * (baseline->num_offsets + 1));
+    if (baseline->links == NULL || baseline->offsets == NULL) {
+        fprintf(stderr, "Not enough memory for the baseline schedule\n");
+        free_binary_baseline(baseline);
+        return -1;
+    }
+    walk_binary_baseline(baseline, 1);
+    qsort(baseline->offsets, baseline->num_offsets, sizeof(Binary_Record), compare_binary_records);
+    
+    return 0;
+}
+
+/**
+ Search the offset of a frame in a link of a binary schedule read in memory
+
+ @param baseline pointer to the baseline
+ @param link_id id of the link
+ @param frame_id id of the frame
+ @return pointer to the offset, NULL if the frame is not in the link of the baseline
+ */
+Binary_Offset * find_binary_offset(Binary_Baseline *baseline, int link_id, int frame_id) {
+    
+    if (baseline->num_offsets == 0) {
+        return NULL;
+    }
+    
+    Binary_Record key;
+    key.link_id = link_id;
+    key.frame_id = frame_id;
+    Binary_Record *found = bsearch(&key, baseline->offsets, baseline->num_offsets, sizeof(Binary_Record),
+                                   compare_binary_records);
+    return found != NULL ? found->offset_pt : NULL;
+}
+
+/**
+ Search a link of a binary schedule read in memory
+
+ @param baseline pointer to the baseline
+ @param link_id id of the link
+ @return pointer to the link, NULL if the link is not in the baseline
+ */
+Binary_Link * find_binary_link(Binary_Baseline *baseline, int link_id) {
+    
+    for (int i = 0; i < baseline->num_links; i++) {
+        if (baseline->links[i]->link_id == link_id) {
+            return baseline->links[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ Count the transmission times of an offset that are not the same as in the baseline schedule
+
+ @param off_pt pointer to the offset
+ @param base_pt pointer to the offset of the same frame and link in the baseline, NULL if it is not there
+ @return number of transmission times that changed, all of them if the offset does not match the baseline
+ */
+int count_delta_changes(Offset *off_pt, Binary_Offset *base_pt) {
+    
+    int num_times = off_pt->num_instances * off_pt->num_replicas;
+    if (base_pt == NULL || base_pt->num_instances != off_pt->num_instances ||
+        base_pt->num_replicas != off_pt->num_replicas || base_pt->time != off_pt->time) {
+        return num_times;
+    }
+    
+    int64_t *base_times = (int64_t *) (base_pt + 1);
+    int num_changes = 0;
+    for (int inst = 0; inst < off_pt->num_instances; inst++) {
+        for (int repl = 0; repl < off_pt->num_replicas; repl++) {
+            if (get_trans_time(off_pt, inst, repl) != base_times[inst * off_pt->num_replicas + repl]) {
+                num_changes++;
+            }
+        }
+    }
+    return num_changes;
+}
+
+/**
+ Write the transmission times of an offset that changed from the baseline schedule into a binary delta file
+
+ @param file_pt pointer to the opened file
+ @param off_pt pointer to the offset
+ @param frame_id identifier of the frame of the offset
+ @param link_id identifier of the link of the offset
+ @param base_pt pointer to the offset of the same frame and link in the baseline, NULL if it is not there
+ @param num_changes number of transmission times that changed, found with count_delta_changes
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_delta_offset(FILE *file_pt, Offset *off_pt, int frame_id, int link_id, Binary_Offset *base_pt,
+                       int num_changes) {
+    
+    Binary_Delta delta;
+    memset(&delta, 0, sizeof(Binary_Delta));
+    delta.frame_id = frame_id;
+    delta.link_id = link_id;
+    delta.num_instances = off_pt->num_instances;
+    delta.num_replicas = off_pt->num_replicas;
+    delta.time = off_pt->time;
+    delta.num_changes = num_changes;
+    if (fwrite(&delta, sizeof(Binary_Delta), 1, file_pt) != 1) {
+        fprintf(stderr, "The delta of the frame %d could not be written\n", frame_id);
+        return -1;
+    }
+    
+    // If all the transmission times changed, they are written without their positions, as in a Binary_Offset
+    int num_times = off_pt->num_instances * off_pt->num_replicas;
+    for (int inst = 0; inst < off_pt->num_instances; inst++) {
+        for (int repl = 0; repl < off_pt->num_replicas; repl++) {
+            int transmission = inst * off_pt->num_replicas + repl;
+            int64_t time = get_trans_time(off_pt, inst, repl);
+            size_t written = 1;
+            if (num_changes == num_times) {
+                written = fwrite(&time, sizeof(int64_t), 1, file_pt);
+            } else if (time != ((int64_t *) (base_pt + 1))[transmission]) {
+                Binary_Change change = {transmission, 0, time};
+                written = fwrite(&change, sizeof(Binary_Change), 1, file_pt);
+            }
+            if (written != 1) {
+                fprintf(stderr, "The delta of the frame %d could not be written\n", frame_id);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ Write the offsets of the patched or optimized frames of a link that changed from the baseline schedule into a
+ binary delta file
+
+ @param file_pt pointer to the opened file
+ @param baseline pointer to the baseline schedule
+ @param link_id identifier of the link
+ @param first_frame position in the traffic of the first allocated frame
+ @param last_frame position in the traffic after the last allocated frame
+ @param execution_time time used to patch or optimize the link
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_delta_link(FILE *file_pt, Binary_Baseline *baseline, int link_id, int first_frame, int last_frame,
+                     long long int execution_time) {
+    
+    // Only the offsets with some change are written, so they are counted first
+    Binary_Link link;
+    memset(&link, 0, sizeof(Binary_Link));
+    link.link_id = link_id;
+    link.execution_time = execution_time;
+    for (int i = first_frame; i < last_frame; i++) {
+        Offset *off_pt = network->traffic.frames[i].offset_it[0];
+        Binary_Offset *base_pt = find_binary_offset(baseline, link_id, network->traffic.frames_id[i]);
+        if (count_delta_changes(off_pt, base_pt) > 0) {
+            link.num_frames++;
+        }
+    }
+    if (fwrite(&link, sizeof(Binary_Link), 1, file_pt) != 1) {
+        fprintf(stderr, "The link %d could not be written\n", link_id);
+        return -1;
+    }
+    
+    for (int i = first_frame; i < last_frame; i++) {
+        Offset *off_pt = network->traffic.frames[i].offset_it[0];
+        Binary_Offset *base_pt = find_binary_offset(baseline, link_id, network->traffic.frames_id[i]);
+        int num_changes = count_delta_changes(off_pt, base_pt);
+        if (num_changes > 0 &&
+            write_delta_offset(file_pt, off_pt, network->traffic.frames_id[i], link_id, base_pt, num_changes) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Write the transmission times of the patched frames of all patched links that changed from the baseline schedule
+ into a binary delta file
+ */
+int write_patch_delta(char *patch_file) {
+    
+    Binary_Baseline baseline;
+    if (read_binary_baseline(network->delta_baseline, &baseline) == -1) {
+        return -1;
+    }
+    FILE *file_pt = fopen(patch_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The delta patched schedule file could not be opened\n");
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    
+    int error = 0;
+    if (network->num_link_patches == 0) {
+        error = write_binary_header(file_pt, binary_delta, binary_patch, 1);
+        if (error == 0) {
+            error = write_delta_link(file_pt, &baseline, network->patched_link, network->num_frames_fixed,
+                                     network->traffic.num_frames, get_execution_time());
+        }
+    } else {
+        // Only the links that could be patched are written, as in the xml file
+        int num_patched = 0;
+        for (int i = 0; i < network->num_link_patches; i++) {
+            num_patched += network->link_patches[i].patched;
+        }
+        error = write_binary_header(file_pt, binary_delta, binary_patch, num_patched);
+        for (int i = 0; i < network->num_link_patches && error == 0; i++) {
+            Link_Patch *pt = &network->link_patches[i];
+            if (pt->patched == 1) {
+                error = write_delta_link(file_pt, &baseline, pt->link_id, pt->first_frame + pt->num_fixed,
+                                         pt->first_frame + pt->num_frames, pt->execution_time);
+            }
+        }
+    }
+    
+    fclose(file_pt);
+    free_binary_baseline(&baseline);
+    return error;
+}
+
+/**
+ Write the transmission times of the optimized frames that changed from the baseline schedule into a binary delta
+ file
+ */
+int write_optimize_delta(char *optimize_file) {
+    
+    Binary_Baseline baseline;
+    if (read_binary_baseline(network->delta_baseline, &baseline) == -1) {
+        return -1;
+    }
+    FILE *file_pt = fopen(optimize_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The delta optimized schedule file could not be opened\n");
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    
+    int error = write_binary_header(file_pt, binary_delta, binary_optimize, 1);
+    if (error == 0) {
+        error = write_delta_link(file_pt, &baseline, network->patched_link, network->num_frames_fixed,
+                                 network->traffic.num_frames, get_execution_time());
+    }
+    
+    fclose(file_pt);
+    free_binary_baseline(&baseline);
+    return error;
+}
+
+/**
+ Apply the transmission times of an offset of a delta file to the same offset in the baseline schedule
+
+ @param baseline pointer to the baseline schedule
+ @param delta_pt pointer to the offset in the delta file
+ @return 0 if it was applied, 1 if the offset is not in the baseline and has to be added, -1 if something went wrong
+ */
+int apply_delta_offset(Binary_Baseline *baseline, Binary_Delta *delta_pt) {
+    
+    int num_times = delta_pt->num_instances * delta_pt->num_replicas;
+    Binary_Offset *base_pt = find_binary_offset(baseline, delta_pt->link_id, delta_pt->frame_id);
+    if (base_pt == NULL) {
+        if (delta_pt->num_changes != num_times) {
+            fprintf(stderr, "The frame %d is not in the link %d of the baseline, but its delta only has changes\n",
+                    delta_pt->frame_id, delta_pt->link_id);
+            return -1;
+        }
+        return 1;
+    }
+    if (base_pt->num_instances != delta_pt->num_instances || base_pt->num_replicas != delta_pt->num_replicas) {
+        fprintf(stderr, "The delta of the frame %d in the link %d does not match the baseline\n", delta_pt->frame_id,
+                delta_pt->link_id);
+        return -1;
+    }
+    
+    int64_t *base_times = (int64_t *) (base_pt + 1);
+    base_pt->time = delta_pt->time;
+    if (delta_pt->num_changes == num_times) {
+        memcpy(base_times, delta_pt + 1, sizeof(int64_t) * num_times);
+        return 0;
+    }
+    Binary_Change *changes = (Binary_Change *) (delta_pt + 1);
+    for (int i = 0; i < delta_pt->num_changes; i++) {
+        if (changes[i].transmission < 0 || changes[i].transmission >= num_times) {
+            fprintf(stderr, "The delta of the frame %d in the link %d changes a transmission that does not exist\n",
+                    delta_pt->frame_id, delta_pt->link_id);
+            return -1;
+        }
+        base_times[changes[i].transmission] = changes[i].time;
+    }
+    return 0;
+}
+
+/**
+ Write the offsets of a delta file that are not in the baseline schedule and go in the given link
+
+ @param file_pt pointer to the opened file
+ @param added offsets of the delta file that are not in the baseline
+ @param num_added number of offsets not in the baseline
+ @param link_id identifier of the link
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_added_offsets(FILE *file_pt, Binary_Delta **added, int num_added, int link_id) {
+    
+    for (int i = 0; i < num_added; i++) {
+        if (added[i]->link_id != link_id) {
+            continue;
+        }
+        
+        // The offsets not in the baseline have all their transmission times after them, as a Binary_Offset
+        Binary_Offset offset;
+        memset(&offset, 0, sizeof(Binary_Offset));
+        offset.frame_id = added[i]->frame_id;
+        offset.link_id = added[i]->link_id;
+        offset.num_instances = added[i]->num_instances;
+        offset.num_replicas = added[i]->num_replicas;
+        offset.time = added[i]->time;
+        size_t num_times = (size_t) offset.num_instances * offset.num_replicas;
+        if (fwrite(&offset, sizeof(Binary_Offset), 1, file_pt) != 1 ||
+            fwrite(added[i] + 1, sizeof(int64_t), num_times, file_pt) != num_times) {
+            fprintf(stderr, "The offset of the frame %d could not be written\n", offset.frame_id);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ Count the offsets of a delta file that are not in the baseline schedule and go in the given link
+
+ @param added offsets of the delta file that are not in the baseline
+ @param num_added number of offsets not in the baseline
+ @param link_id identifier of the link
+ @return number of offsets of the link
+ */
+int count_added_offsets(Binary_Delta **added, int num_added, int link_id) {
+    
+    int num_link = 0;
+    for (int i = 0; i < num_added; i++) {
+        if (added[i]->link_id == link_id) {
+            num_link++;
+        }
+    }
+    return num_link;
+}
+
+/**
+ Apply a binary delta file to its baseline binary schedule, and write the resulting schedule
+ */
+int apply_delta_binary(char *baseline_file, char *delta_file, char *schedule_file) {
+    
+    if (baseline_file == NULL || delta_file == NULL || schedule_file == NULL) {
+        fprintf(stderr, "The delta needs the baseline, delta and schedule files\n");
+        return -1;
+    }
+    Binary_Baseline baseline;
+    if (read_binary_baseline(baseline_file, &baseline) == -1) {
+        return -1;
+    }
+    size_t size = 0;
+    char *data = read_binary_file(delta_file, &size);
+    Binary_Header *header = (Binary_Header *) data;
+    if (data == NULL || size < sizeof(Binary_Header) || memcmp(header->magic, BINARY_MAGIC, 4) != 0 ||
+        header->version != BINARY_VERSION || header->kind != binary_delta || header->num_sections < 0 ||
+        (header->delta_kind != 0 && header->delta_kind != binary_patch && header->delta_kind != binary_optimize)) {
+        fprintf(stderr, "The delta file is not a binary delta schedule of a supported version\n");
+        free(data);
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    
+    // The offsets and links not in the baseline are added after the ones of the baseline, every offset of the delta
+    // takes at least the size of a Binary_Delta
+    int max_added = (int) (size / sizeof(Binary_Delta));
+    Binary_Delta **added = malloc(sizeof(Binary_Delta *) * (max_added + 1));
+    Binary_Link **new_links = malloc(sizeof(Binary_Link *) * (header->num_sections + 1));
+    if (added == NULL || new_links == NULL) {
+        fprintf(stderr, "Not enough memory to apply the delta file\n");
+        free(added);
+        free(new_links);
+        free(data);
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    
+    int num_added = 0, num_new_links = 0, error = 0;
+    size_t position = sizeof(Binary_Header);
+    for (int i = 0; i < header->num_sections && error == 0; i++) {
+        if (position + sizeof(Binary_Link) > size) {
+            fprintf(stderr, "The delta file is truncated\n");
+            error = -1;
+            break;
+        }
+        Binary_Link *link_pt = (Binary_Link *) (data + position);
+        position += sizeof(Binary_Link);
+        
+        // The links of the baseline take the execution time of the delta
+        Binary_Link *base_link = find_binary_link(&baseline, link_pt->link_id);
+        if (base_link != NULL) {
+            base_link->execution_time = link_pt->execution_time;
+        } else {
+            new_links[num_new_links++] = link_pt;
+        }
+        
+        for (int j = 0; j < link_pt->num_frames && error == 0; j++) {
+            Binary_Delta *delta_pt = (Binary_Delta *) (data + position);
+            if (position + sizeof(Binary_Delta) > size || delta_pt->num_instances < 0 || delta_pt->num_replicas < 0 ||
+                delta_pt->num_changes < 0 || delta_pt->num_changes > delta_pt->num_instances * delta_pt->num_replicas) {
+                fprintf(stderr, "The delta file is truncated\n");
+                error = -1;
+                break;
+            }
+            position += sizeof(Binary_Delta);
+            if (delta_pt->num_changes == delta_pt->num_instances * delta_pt->num_replicas) {
+                position += sizeof(int64_t) * delta_pt->num_changes;
+            } else {
+                position += sizeof(Binary_Change) * delta_pt->num_changes;
+            }
+            if (position > size) {
+                fprintf(stderr, "The delta file is truncated\n");
+                error = -1;
+                break;
+            }
+            
+            int applied = apply_delta_offset(&baseline, delta_pt);
+            if (applied == 1) {
+                added[num_added++] = delta_pt;
+            } else if (applied == -1) {
+                error = -1;
+            }
+        }
+    }
+    if (error == -1) {
+        free(added);
+        free(new_links);
+        free(data);
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    
+    // The schedule file might be the baseline file, it is already in memory
+    FILE *file_pt = fopen(schedule_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The binary schedule file could not be opened\n");
+        free(added);
+        free(new_links);
+        free(data);
+        free_binary_baseline(&baseline);
+        return -1;
+    }
+    Binary_Header out_header = *baseline.header;
+    out_header.num_sections += num_new_links;
+    if (header->delta_kind != 0) {
+        out_header.kind = header->delta_kind;
+    }
+    out_header.delta_kind = 0;
+    if (fwrite(&out_header, sizeof(Binary_Header), 1, file_pt) != 1) {
+        fprintf(stderr, "The header of the binary file could not be written\n");
+        error = -1;
+    }
+    
+    // Every link of the baseline keeps its offsets, already updated, followed by the added ones of the link
+    for (int i = 0; i < baseline.num_links && error == 0; i++) {
+        Binary_Link link = *baseline.links[i];
+        link.num_frames += count_added_offsets(added, num_added, link.link_id);
+        char *first = (char *) (baseline.links[i] + 1);
+        char *last = i < baseline.num_links - 1 ? (char *) baseline.links[i + 1] : baseline.data + baseline.size;
+        if (fwrite(&link, sizeof(Binary_Link), 1, file_pt) != 1 ||
+            fwrite(first, 1, last - first, file_pt) != (size_t) (last - first)) {
+            fprintf(stderr, "The link %d could not be written\n", link.link_id);
+            error = -1;
+        } else {
+            error = write_added_offsets(file_pt, added, num_added, link.link_id);
+        }
+    }
+    for (int i = 0; i < num_new_links && error == 0; i++) {
+        Binary_Link link = *new_links[i];
+        link.num_frames = count_added_offsets(added, num_added, link.link_id);
+        if (fwrite(&link, sizeof(Binary_Link), 1, file_pt) != 1) {
+            fprintf(stderr, "The link %d could not be written\n", link.link_id);
+            error = -1;
+        } else {
+            error = write_added_offsets(file_pt, added, num_added, link.link_id);
+        }
+    }
+    
+    fclose(file_pt);
+    free(added);
+    free(new_links);
+    free(data);
+    free_binary_baseline(&baseline);
+    return error;
+}
+
+/**
+ Write the obtained schedule in the format set, a schedule has no baseline so the delta format writes it in binary
+ */
+int write_schedule_file(char *schedule_file) {
+    
+    profile_phase(phase_write);
+    
+    if (network->output_format == binary_format || network->output_format == delta_format) {
+        return write_schedule_binary(schedule_file);
+    }
+    return write_schedule_xml(schedule_file);
+}
+
+/**
+ Write the obtained patched schedule in the format set
+ */
+int write_patch_file(char *patch_file) {
+    
+    profile_phase(phase_write);
+    
+    if (network->output_format == binary_format) {
+        return write_patch_binary(patch_file);
+    }
+    if (network->output_format == delta_format) {
+        return write_patch_delta(patch_file);
+    }
+    return write_patch_xml(patch_file);
+}
+
+/**
+ Write the obtained optimized schedule in the format set
+ */
+int write_optimize_file(char *optimize_file) {
+    
+    profile_phase(phase_write);
+    
+    if (network->output_format == binary_format) {
+        return write_optimize_binary(optimize_file);
+    }
+    if (network->output_format == delta_format) {
+        return write_optimize_delta(optimize_file);
+    }
+    return write_optimize_xml(optimize_file);
+}
+
 /**
  Write the execution time of the last algoritm invoqued
  */
 int write_execution_time_xml(char *execution_file) {
  
+    profile_phase(phase_write);
+    
     // Init xml variables needed to write information in the file
     xmlDoc *top_xml;
-    xmlNode *root_xml, *timing_xml;
+    xmlNode *root_xml, *timing_xml, *link_xml, *profile_xml, *phase_xml, *model_xml, *counter_xml;
     char char_value[100];
     
     // Create the top file
@@ -1997,12 +3405,50 @@ int write_execution_time_xml(char *execution_file) {
     sprintf(char_value, "%lld", get_execution_time());
     xmlNewChild(timing_xml, NULL, BAD_CAST "ExecutionTime", BAD_CAST char_value);
     
+    // Write the execution time of every link if several links were patched
+    for (int i = 0; i < network->num_link_patches; i++) {
+        link_xml = xmlNewChild(root_xml, NULL, BAD_CAST "Link", NULL);
+        
+        sprintf(char_value, "%d", network->link_patches[i].link_id);
+        xmlNewChild(link_xml, NULL, BAD_CAST "LinkID", BAD_CAST char_value);
+        
+        sprintf(char_value, "%d", network->link_patches[i].patched);
+        xmlNewChild(link_xml, NULL, BAD_CAST "Patched", BAD_CAST char_value);
+        
+        sprintf(char_value, "%lld", network->link_patches[i].execution_time);
+        xmlNewChild(link_xml, NULL, BAD_CAST "ExecutionTime", BAD_CAST char_value);
+    }
+    
+    // Write the time of every phase that was executed, with the size of the models and the memory used
+    profile_xml = xmlNewChild(root_xml, NULL, BAD_CAST "Profile", NULL);
+    for (int i = phase_idle + 1; i < num_phases; i++) {
+        if (get_profile_calls(i) > 0) {
+            phase_xml = xmlNewChild(profile_xml, NULL, BAD_CAST "Phase", NULL);
+            xmlNewChild(phase_xml, NULL, BAD_CAST "Name", BAD_CAST get_profile_phase_name(i));
+            sprintf(char_value, "%lld", get_profile_time(i));
+            xmlNewChild(phase_xml, NULL, BAD_CAST "Time", BAD_CAST char_value);
+            sprintf(char_value, "%lld", get_profile_calls(i));
+            xmlNewChild(phase_xml, NULL, BAD_CAST "Calls", BAD_CAST char_value);
+        }
+    }
+    model_xml = xmlNewChild(profile_xml, NULL, BAD_CAST "Model", NULL);
+    sprintf(char_value, "%d", get_profile_num_models());
+    xmlNewChild(model_xml, NULL, BAD_CAST "Models", BAD_CAST char_value);
+    for (int i = 0; i < num_counters; i++) {
+        counter_xml = xmlNewChild(model_xml, NULL, BAD_CAST get_profile_counter_name(i), NULL);
+        sprintf(char_value, "%lld", get_profile_total(i));
+        xmlNewChild(counter_xml, NULL, BAD_CAST "Total", BAD_CAST char_value);
+        sprintf(char_value, "%lld", get_profile_largest(i));
+        xmlNewChild(counter_xml, NULL, BAD_CAST "Largest", BAD_CAST char_value);
+    }
+    sprintf(char_value, "%lld", get_peak_memory());
+    xmlNewChild(profile_xml, NULL, BAD_CAST "PeakMemory", BAD_CAST char_value);
+    
     // Write the file and clean up the variables
     xmlSaveFormatFileEnc(execution_file, top_xml, "UTF-8", 1);
     xmlFreeDoc(top_xml);
 //    xmlFreeNode(root_xml);
 //    xmlFreeNode(timing_xml);
-    xmlCleanupParser();
     
     return 0;
 }
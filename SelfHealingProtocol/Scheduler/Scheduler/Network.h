@@ -10,6 +10,9 @@
  *  A network has the information of all the frames saved in an array                                                  *
  *  Additions of new relations between frames are supposed to be added here, while the behavior is on the schedule,    *
  *  as done with the period and deadlines between others.                                                              *
+ *  All the information is kept in a Network structure. Every thread works on its current network, so several networks *
+ *  can be read, scheduled or patched at the same time in one process, each one by its own thread.                     *
+ *  The XML parser is shared by all the threads of the process, so it is not cleaned up after reading or writing files.*
  *                                                                                                                     *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -19,6 +22,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include "Node.h"
 #include "Link.h"
 #include "Frame.h"
@@ -77,6 +81,221 @@ typedef struct Traffic {
     int *frames_id;                     // List of all frames ids correlated to the list of Frame struct
 }Traffic;
 
+/**
+ Structure with the offset of a frame in a link, used to know which frames share every link
+ */
+typedef struct Link_Offset {
+    int frame_pos;                      // Position of the frame in the traffic
+    Offset *offset_pt;                  // Pointer to the offset of the frame in the link
+}Link_Offset;
+
+/**
+ Structure with the part of the traffic of one link when several links are patched at the same time.
+ The fixed frames of the link are first, followed by the frames to patch
+ */
+typedef struct Link_Patch {
+    int link_id;                        // ID of the link to patch
+    int first_frame;                    // Position in the traffic of the first frame of the link
+    int num_fixed;                      // Number of fixed frames of the link
+    int num_frames;                     // Number of frames of the link, including the fixed ones
+    int baseline;                       // 1 if the fixed frames are all the frames of the link in the schedule
+    int patched;                        // 1 if the link was patched, 0 otherwise
+    long long int execution_time;       // Execution time to patch the link in nanoseconds
+}Link_Patch;
+
+#define BINARY_MAGIC "SHPB"         // First bytes of the binary schedule files
+#define BINARY_VERSION 1            // Version of the binary schedule files
+
+/**
+ Format of the schedule, patched schedule and optimized schedule files
+ */
+typedef enum Output_Format {
+    xml_format,
+    binary_format,
+    delta_format
+}Output_Format;
+
+/**
+ Order of the frames in the traffic, so the incremental approach schedules the hardest frames first
+ */
+typedef enum Frame_Order {
+    file_order,                         // Order of the network file
+    period_order,                       // Shorter periods first
+    utilization_order                   // Frames crossing the most used links first, then shorter periods
+}Frame_Order;
+
+/**
+ Key to sort a frame of the traffic
+ */
+typedef struct Frame_Key {
+    int pos;                            // Position of the frame in the traffic before sorting
+    long long int period;               // Period of the frame
+    double key;                         // Key of the order, the frames with the largest key go first
+}Frame_Key;
+
+/**
+ Kind of schedule saved in a binary file
+ */
+typedef enum Binary_Kind {
+    binary_schedule = 1,
+    binary_patch = 2,
+    binary_optimize = 3,
+    binary_delta = 4
+}Binary_Kind;
+
+/**
+ Header of the binary schedule files.
+ The binary files are written in the byte order of the machine, and all the records are a multiple of 8 bytes, so
+ the transmission times of every offset can be used directly from a memory map of the file.
+ A schedule has a Binary_Frame for every frame, followed by a Binary_Path for every path of the frame, followed by
+ the offsets of every link in the path. A patched or optimized schedule has a Binary_Link for every link, followed by
+ the offsets of the link. Every offset is a Binary_Offset followed by its transmission times.
+ A delta schedule has a Binary_Link for every link, followed by a Binary_Delta for every offset whose transmission
+ times are not the same as in the baseline schedule, and its header keeps the kind of the schedule it gives
+ */
+typedef struct Binary_Header {
+    char magic[4];                      // BINARY_MAGIC without the ending character
+    int32_t version;                    // BINARY_VERSION of the writer
+    int32_t kind;                       // Binary_Kind of the schedule
+    int32_t num_sections;               // Number of frames in a schedule, number of links otherwise
+    int64_t hyperperiod;                // Hyperperiod in time slots
+    int64_t timeslot_size;              // Size of the time slot in nanoseconds
+    int64_t protocol_period;            // Period of the self-healing protocol in time slots, 0 if not active
+    int64_t protocol_time;              // Time of the self-healing protocol in time slots
+    int32_t number_links;               // Number of links in the network
+    int32_t number_nodes;               // Number of nodes in the network
+    int32_t number_frames;              // Number of frames in the traffic
+    int32_t delta_kind;                 // Binary_Kind of the schedule that a delta gives over its baseline, 0 otherwise
+}Binary_Header;
+
+/**
+ Information of a frame in a binary schedule, all the times are in time slots
+ */
+typedef struct Binary_Frame {
+    int32_t frame_id;                   // ID of the frame
+    int32_t size;                       // Size of the frame in bytes
+    int64_t period;                     // Period of the frame
+    int64_t deadline;                   // Deadline of the frame
+    int64_t starting;                   // Starting time of the frame
+    int64_t end_to_end_delay;           // End to end delay of the frame
+    int32_t num_paths;                  // Number of paths of the frame
+    int32_t reserved;                   // Padding, always 0
+}Binary_Frame;
+
+/**
+ Path of a frame in a binary schedule
+ */
+typedef struct Binary_Path {
+    int32_t path_num;                   // Position of the path in the frame
+    int32_t num_links;                  // Number of links of the path
+}Binary_Path;
+
+/**
+ Patched or optimized link in a binary schedule
+ */
+typedef struct Binary_Link {
+    int32_t link_id;                    // ID of the link
+    int32_t num_frames;                 // Number of frames allocated in the link
+    int64_t execution_time;             // Time used to patch or optimize the link in nanoseconds
+}Binary_Link;
+
+/**
+ Offset of a frame in a link in a binary schedule.
+ It is followed by num_instances * num_replicas transmission times (int64_t), in [instance * num_replicas + replica]
+ */
+typedef struct Binary_Offset {
+    int32_t frame_id;                   // ID of the frame
+    int32_t link_id;                    // ID of the link
+    int32_t num_instances;              // Number of instances of the frame in the hyperperiod
+    int32_t num_replicas;               // Number of replicas of every instance
+    int32_t time;                       // Time slots to transmit, the ending time is transmission + time - 1
+    int32_t reserved;                   // Padding, always 0
+}Binary_Offset;
+
+/**
+ Offset of a frame in a link in a binary delta schedule.
+ If all its transmission times changed, it is followed by them as a Binary_Offset, otherwise it is followed by
+ num_changes Binary_Change
+ */
+typedef struct Binary_Delta {
+    int32_t frame_id;                   // ID of the frame
+    int32_t link_id;                    // ID of the link
+    int32_t num_instances;              // Number of instances of the frame in the hyperperiod
+    int32_t num_replicas;               // Number of replicas of every instance
+    int32_t time;                       // Time slots to transmit, the ending time is transmission + time - 1
+    int32_t num_changes;                // Number of transmission times that changed
+}Binary_Delta;
+
+/**
+ Transmission time that changed in a binary delta schedule
+ */
+typedef struct Binary_Change {
+    int32_t transmission;               // Position of the transmission, instance * num_replicas + replica
+    int32_t reserved;                   // Padding, always 0
+    int64_t time;                       // New transmission time
+}Binary_Change;
+
+/**
+ Offset of a binary schedule read in memory, with the link of its section as the offsets of a patch do not save it
+ */
+typedef struct Binary_Record {
+    int32_t link_id;                    // ID of the link of the section of the offset
+    int32_t frame_id;                   // ID of the frame
+    Binary_Offset *offset_pt;           // Offset in the file, followed by its transmission times
+}Binary_Record;
+
+/**
+ Binary patched or optimized schedule read in memory, with its links and offsets, so a delta schedule can be written
+ relative to it or applied to it
+ */
+typedef struct Binary_Baseline {
+    char *data;                         // Content of the file, the records point inside it
+    size_t size;                        // Size of the file in bytes
+    Binary_Header *header;              // Header of the file
+    Binary_Link **links;                // Links in the order of the file
+    int num_links;                      // Number of links
+    Binary_Record *offsets;             // Offsets of all the links sorted by link id and frame id
+    int num_offsets;                    // Number of offsets
+}Binary_Baseline;
+
+/**
+ Structure with all the information of a network, so several networks can be read, scheduled or patched at the same
+ time in one process. Every thread works on its current network, the default one until it sets another
+ */
+typedef struct Network {
+    Switch_Information switch_info;     // Information of the behaviour of switches
+    SelfHealing_Protocol healing_prot;  // Information of the self-healing protocol characteristics
+    int number_nodes;                   // Number of nodes in the network
+    Node_Topology *topology;            // Topology of the network saved as a list of all nodes and their connections
+    Traffic traffic;                    // Struct that contains all the traffic in the network
+    int number_links;                   // Number of links in the network
+    long long int hyperperiod;          // HyperPeriod of all the frames in the network
+    int size_timeslot;                  // Size of time slot in nanoseconds
+    Arena network_arena;                // Arena with the memory of all the offsets of the network
+
+    // Accelerator variables indexed by the ID to find values in O(1)
+    int higher_link_id;                 // Higher read link id, used for the offset hash accelerator
+    int higher_frame_id;                // Higher read frame id, used for the frame hash accelerator
+    int higher_node_id;                 // Higher read node id, used for the node hash accelerator
+    Link **link_accelerator;            // List of pointers to the links in the topology indexed by id
+    Node **node_accelerator;            // List of pointers to the nodes in the topology indexed by id
+    Frame **frame_accelerator;          // List of pointers to the frames in the topology indexed by id
+    Link_Offset **link_offsets;         // Offsets of all the frames that use every link indexed by link id
+    int *num_link_offsets;              // Number of frames that use every link indexed by link id
+
+    // Patching needed extra information
+    int patched_link;                   // Link being patched
+    int num_frames_fixed;               // Number of frames that are already fixed
+    Link_Patch *link_patches;           // Links to patch when the patch file has several links
+    int num_link_patches;               // Number of links to patch when the patch file has several links
+
+    Output_Format output_format;        // Format of the schedule, patched and optimized schedule files
+    char *delta_baseline;               // Binary schedule that the delta files are relative to, NULL if none
+    int periodic_offsets;               // 1 if the offsets only store their first instance (strictly periodic)
+    char *network_file;                 // Name and path of the network file read, NULL if none was read
+    Frame_Order frame_order;            // Order of the frames in the traffic once the network is prepared
+}Network;
+
                                                     /* CODE DEFINITIONS */
 
 /* Getters */
@@ -95,6 +314,16 @@ int get_num_fixed_frames(void);
  */
 long long int get_switch_min_time(void);
 
+/**
+ Get the minimum distance from the transmission of a frame in a link of a path to its transmission in the next link,
+ as the frame has to be fully transmitted and processed by the switch between them
+
+ @param time_slots time slots to transmit the frame in the first link
+ @param switch_time minimum time of the switch
+ @return minimum distance between both transmissions
+ */
+long long int get_hop_distance(long long int time_slots, long long int switch_time);
+
 /**
  Get a pointer to the Self-Healing Protocol structure
 
@@ -131,6 +360,59 @@ int get_higher_link_id(void);
  */
 long long int get_hyperperiod(void);
 
+/**
+ Get the number of frames that have an offset in the given link
+
+ @param link_id id of the link
+ @return number of offsets in the link, 0 if there are none
+ */
+int get_num_link_offsets(int link_id);
+
+/**
+ Get the list of offsets in the given link, sorted by the position of their frames in the traffic
+
+ @param link_id id of the link
+ @return list of offsets in the link, NULL if there are none
+ */
+Link_Offset * get_link_offsets(int link_id);
+
+/**
+ Get the number of links read from a patch file with several links
+
+ @return number of links to patch, 0 if the patch file only had one link
+ */
+int get_num_link_patches(void);
+
+/**
+ Get the information of one of the links to patch
+
+ @param pos position of the link in the patch file
+ @return pointer to the link patch, NULL if it does not exist
+ */
+Link_Patch * get_link_patch(int pos);
+
+/**
+ Get the link with the given id
+
+ @param link_id id of the link
+ @return pointer to the link, NULL if it does not exist
+ */
+Link * get_link(int link_id);
+
+/**
+ Get the network file read in the current network, so it can be read again in another network
+
+ @return name and path of the network file, NULL if no network file was read
+ */
+char * get_network_file(void);
+
+/**
+ Get the order of the frames in the traffic once the network is prepared
+
+ @return order of the frames
+ */
+Frame_Order get_frame_order(void);
+
 /* Setters */
 
 /**
@@ -150,6 +432,41 @@ int set_switch_information(long long int min_time);
  */
 int set_healing_protocol(long long int period, long long int time);
 
+/**
+ Set the format of the schedule, patched schedule and optimized schedule files
+
+ @param name name of the format ("XML", "Binary" or "Delta")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_output_format(char *name);
+
+/**
+ Set the binary patched or optimized schedule that the delta files are relative to. Without it, the patched frames
+ are new in their links, so all their transmission times are written
+
+ @param baseline_file name and path of the baseline binary file, NULL to not use any
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_delta_baseline(char *baseline_file);
+
+/**
+ Set if the offsets of the frames only store their first instance, so all instances are strictly periodic.
+ It has to be set before preparing the network, as the offsets are allocated there
+
+ @param value 1 to store only the first instance, 0 to store all of them
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_periodic_offsets(int value);
+
+/**
+ Set the order of the frames in the traffic. It has to be set before preparing the network, as the frames are sorted
+ there, before their offsets are allocated
+
+ @param order order of the frames
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_frame_order(Frame_Order order);
+
 /* Functions */
 
 /**
@@ -160,6 +477,84 @@ int set_healing_protocol(long long int period, long long int time);
  */
 int prepare_network(void);
 
+/**
+ Release the memory of all the offsets of the network in a single step.
+ After it, the offsets of the frames are no longer available
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int release_network_offsets(void);
+
+/**
+ Release all the memory of the network and set its variables as if nothing was read, so a new network, patch or
+ optimize file can be read. The scheduler has to be reset before, as it uses the link ids of the network
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int reset_network(void);
+
+/**
+ Create a new empty network, as if nothing was read. To use it, the thread sets it as its current network
+
+ @return pointer to the network, NULL if there is not enough memory
+ */
+Network * new_network(void);
+
+/**
+ Release all the memory of a network created with new_network, and the network itself.
+ If it is the current network of the thread, the thread works again on the default network
+
+ @param network_pt pointer to the network
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_network(Network *network_pt);
+
+/**
+ Set the network the calling thread works on, all the functions of the network and the scheduler use it.
+ The threads start working on the default network of the process
+
+ @param network_pt pointer to the network, NULL to work on the default network
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_network(Network *network_pt);
+
+/**
+ Get the network the calling thread works on
+
+ @return pointer to the network
+ */
+Network * get_network(void);
+
+/**
+ Copy the transmission times of all the frames of another network to the current network. Both networks have to be
+ read from the same network file and prepared in the same way, so their frames and offsets are in the same order
+
+ @param source_pt pointer to the network with the schedule to copy
+ @return 0 if done correctly, -1 otherwise
+ */
+int copy_network_schedule(Network *source_pt);
+
+/**
+ Get the shortest path that replaces a failed link, from its sender to its receiver without using the failed link.
+ As the self-healing protocol does, the nodes in between have to be switches or access points, not end systems
+
+ @param link_id id of the failed link
+ @param path memory for the link ids of the path, it needs space for the number of links of the network
+ @return number of links of the path, 0 if there is no path, -1 if the link does not exist
+ */
+int get_failure_path(int link_id, int *path);
+
+/**
+ Check if an optional argument of the executables or the server requests is given. An argument "-" is left out, so
+ the next optional arguments keep their position
+
+ @param argc number of arguments
+ @param argv list of arguments
+ @param position position of the argument
+ @return 1 if the argument is given, 0 otherwise
+ */
+int has_argument(int argc, char *argv[], int position);
+
 /* Input Functions */
 
 /**
@@ -171,7 +566,8 @@ int prepare_network(void);
 int read_network_xml(char *network_file);
 
 /**
- Read the information of the patch in the xml file and saves its information into the invernal variables
+ Read the information of the patch in the xml file and saves its information into the invernal variables.
+ If the root is a MultiPatch, every Patch inside is read one after the other in the traffic
 
  @param patch_file name and path of the patching xml file
  @return 0 if correct, -1 otherwise
@@ -186,6 +582,34 @@ int read_patch_xml(char *patch_file);
  */
 int read_optimize_xml(char *optimize_file);
 
+/**
+ Read the patch of every link of the path that replaces a failed link of a scheduled network, as if it was read from
+ a multi patch file. The fixed traffic of every link is its schedule, and the frames of the failed link get the range
+ left by their previous and next links split between the links of the path, as the self-healing protocol does.
+ The current network has to be empty, and it is not the scheduled network, which is only read
+
+ @param scheduled_pt pointer to the scheduled network
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @return 0 if correct, -1 otherwise
+ */
+int read_failure_patch(Network *scheduled_pt, int link_id, int *path, int len_path);
+
+/**
+ Read the optimize of one link of the path that replaces a failed link of a scheduled network, as if it was read from
+ an optimize file. The link gets the same traffic as in the patch of the failure, but its fixed frames can only be
+ transmitted at their scheduled times. The current network has to be empty, and it is not the scheduled network
+
+ @param scheduled_pt pointer to the scheduled network
+ @param link_id id of the failed link
+ @param path link ids of the path that replaces the failed link
+ @param len_path number of links of the path
+ @param path_it position in the path of the link to optimize
+ @return 0 if correct, -1 otherwise
+ */
+int read_failure_optimize(Network *scheduled_pt, int link_id, int *path, int len_path, int path_it);
+
 /* Output Functions */
 
 /**
@@ -200,6 +624,7 @@ int write_schedule_xml(char *schedule_file);
 
 /**
  Write the obtained patched schedule for all allocated frames into a xml file.
+ If several links were patched, a MultiPatchedSchedule contains the patched schedule of every patched link
 
  @param patch_file name and path of the patched schedule xml file
  @return 0 if correct, -1 otherwise
@@ -215,6 +640,92 @@ int write_patch_xml(char *patch_file);
 int write_optimize_xml(char *optimize_file);
 
 /**
- Write the execution time of the last algoritm invoqued
+ Write the obtained schedule from all frames into a binary file, with the same information as the xml file
+
+ @param schedule_file name and path of the schedule binary file
+ @return 0 if correct, -1 otherwise
+ */
+int write_schedule_binary(char *schedule_file);
+
+/**
+ Write the obtained patched schedule of all patched links into a binary file
+
+ @param patch_file name and path of the patched schedule binary file
+ @return 0 if correct, -1 otherwise
+ */
+int write_patch_binary(char *patch_file);
+
+/**
+ Write the obtained optimized schedule into a binary file
+
+ @param optimize_file name and path of the optimized schedule binary file
+ @return 0 if correct, -1 otherwise
+ */
+int write_optimize_binary(char *optimize_file);
+
+/**
+ Write the transmission times of the patched frames of all patched links that changed from the baseline schedule into
+ a binary delta file
+
+ @param patch_file name and path of the patched schedule delta file
+ @return 0 if correct, -1 otherwise
+ */
+int write_patch_delta(char *patch_file);
+
+/**
+ Write the transmission times of the optimized frames that changed from the baseline schedule into a binary delta
+ file, the baseline is usually the patched schedule already distributed
+
+ @param optimize_file name and path of the optimized schedule delta file
+ @return 0 if correct, -1 otherwise
+ */
+int write_optimize_delta(char *optimize_file);
+
+/**
+ Apply a binary delta file to its baseline binary schedule, and write the resulting schedule as a binary file of the
+ kind that the delta gives, a patched or optimized schedule. The offsets that are not in the baseline are added to
+ their links
+
+ @param baseline_file name and path of the baseline binary file
+ @param delta_file name and path of the delta file
+ @param schedule_file name and path of the resulting binary file, it can be the baseline file
+ @return 0 if correct, -1 otherwise
+ */
+int apply_delta_binary(char *baseline_file, char *delta_file, char *schedule_file);
+
+/**
+ Write the obtained schedule in the format set, xml by default. A schedule has no baseline, so the delta format writes
+ it as a binary file
+
+ @param schedule_file name and path of the schedule file
+ @return 0 if correct, -1 otherwise
+ */
+int write_schedule_file(char *schedule_file);
+
+/**
+ Write the obtained patched schedule in the format set, xml by default. The delta format is relative to the baseline
+ set with set_delta_baseline
+
+ @param patch_file name and path of the patched schedule file
+ @return 0 if correct, -1 otherwise
+ */
+int write_patch_file(char *patch_file);
+
+/**
+ Write the obtained optimized schedule in the format set, xml by default. The delta format is relative to the
+ baseline set with set_delta_baseline
+
+ @param optimize_file name and path of the optimized schedule file
+ @return 0 if correct, -1 otherwise
+ */
+int write_optimize_file(char *optimize_file);
+
+/**
+ Write the execution time of the last algoritm invoqued.
+ If several links were patched, the execution time of every link is also written. The profile of the thread follows,
+ with the time of every phase in ns, the size of the models of the solver and the peak memory in KB
+
+ @param execution_file name and path of the execution time xml file
+ @return 0 if correct, -1 otherwise
  */
 int write_execution_time_xml(char *execution_file);
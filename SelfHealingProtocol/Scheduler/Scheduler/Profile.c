@@ -0,0 +1,234 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Profile.c                                                                                                          *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Profile.h                                                                                           *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Profile.h"
+
+                                                    /* VARIABLES */
+
+_Thread_local Profile profile;          // Measures of the calling thread, all zero is the idle phase
+
+const char *phase_names[] = {"Idle", "Read", "Prepare", "Environment", "Variables", "PathDependent", "EndToEnd",
+                             "Collision", "Symmetry", "Presolve", "Start", "Solve", "Save", "Heuristic", "Patch",
+                             "LocalSearch", "Write"};
+const char *counter_names[] = {"Variables", "Binaries", "Constraints", "GeneralConstraints"};
+
+                                                    /* FUNCTIONS */
+
+/* Getters */
+
+/**
+ Get the time of a monotonic clock
+ */
+uint64_t get_monotonic_time(void) {
+    
+    struct timespec time_spec;
+    clock_gettime(CLOCK_MONOTONIC, &time_spec);
+    return (uint64_t) time_spec.tv_sec * 1000000000 + (uint64_t) time_spec.tv_nsec;
+}
+
+/**
+ Get the time spent in a phase
+ */
+long long int get_profile_time(Profile_Phase phase) {
+    
+    if ((int) phase < 0 || phase >= num_phases) {
+        fprintf(stderr, "The given phase does not exist\n");
+        return -1;
+    }
+    
+    // The phase being measured also counts until now
+    long long int time = profile.time[phase];
+    if (phase == profile.phase && phase != phase_idle) {
+        time += (long long int) (get_monotonic_time() - profile.phase_starting);
+    }
+    return time;
+}
+
+/**
+ Get the number of times a phase was started
+ */
+long long int get_profile_calls(Profile_Phase phase) {
+    
+    if ((int) phase < 0 || phase >= num_phases) {
+        fprintf(stderr, "The given phase does not exist\n");
+        return -1;
+    }
+    
+    return profile.calls[phase];
+}
+
+/**
+ Get the name of a phase
+ */
+const char * get_profile_phase_name(Profile_Phase phase) {
+    
+    if ((int) phase < 0 || phase >= num_phases) {
+        fprintf(stderr, "The given phase does not exist\n");
+        return NULL;
+    }
+    
+    return phase_names[phase];
+}
+
+/**
+ Get the number of models created in the solver
+ */
+int get_profile_num_models(void) {
+    
+    return profile.num_models;
+}
+
+/**
+ Get the size of all the models created in the solver together
+ */
+long long int get_profile_total(Profile_Counter counter) {
+    
+    if ((int) counter < 0 || counter >= num_counters) {
+        fprintf(stderr, "The given counter does not exist\n");
+        return -1;
+    }
+    
+    return profile.total[counter];
+}
+
+/**
+ Get the size of the largest model created in the solver for the given counter
+ */
+long long int get_profile_largest(Profile_Counter counter) {
+    
+    if ((int) counter < 0 || counter >= num_counters) {
+        fprintf(stderr, "The given counter does not exist\n");
+        return -1;
+    }
+    
+    return profile.largest[counter];
+}
+
+/**
+ Get the name of a counter
+ */
+const char * get_profile_counter_name(Profile_Counter counter) {
+    
+    if ((int) counter < 0 || counter >= num_counters) {
+        fprintf(stderr, "The given counter does not exist\n");
+        return NULL;
+    }
+    
+    return counter_names[counter];
+}
+
+/**
+ Get the peak of the resident memory of the process
+ */
+long long int get_peak_memory(void) {
+    
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        fprintf(stderr, "The memory used by the process could not be read\n");
+        return -1;
+    }
+    
+    // macOS gives the peak in bytes, Linux in KB
+#ifdef __APPLE__
+    return (long long int) usage.ru_maxrss / 1024;
+#else
+    return (long long int) usage.ru_maxrss;
+#endif
+}
+
+/* Functions */
+
+/**
+ Start measuring a phase in the calling thread
+ */
+void profile_phase(Profile_Phase phase) {
+    
+    uint64_t now = get_monotonic_time();
+    if (profile.phase != phase_idle) {
+        profile.time[profile.phase] += (long long int) (now - profile.phase_starting);
+    }
+    profile.phase = phase;
+    profile.phase_starting = now;
+    if (phase != phase_idle) {
+        profile.calls[phase] += 1;
+    }
+}
+
+/**
+ Count a new model in the solver
+ */
+void profile_new_model(void) {
+    
+    profile.num_models += 1;
+    for (int i = 0; i < num_counters; i++) {
+        profile.model[i] = 0;
+    }
+}
+
+/**
+ Count an element added to the current model of the solver
+ */
+void profile_count(Profile_Counter counter) {
+    
+    profile.model[counter] += 1;
+    profile.total[counter] += 1;
+    if (profile.model[counter] > profile.largest[counter]) {
+        profile.largest[counter] = profile.model[counter];
+    }
+}
+
+/**
+ Clear all the measures of the calling thread
+ */
+int reset_profile(void) {
+    
+    Profile empty = {0};
+    profile = empty;
+    
+    return 0;
+}
+
+/**
+ Write the measures of the calling thread in a json file
+ */
+int write_profile_json(char *json_file) {
+    
+    FILE *file_pt = fopen(json_file, "w");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The json file of the profile could not be created\n");
+        return -1;
+    }
+    
+    // Only the phases that were started, the time in ns
+    fprintf(file_pt, "{\n    \"Phases\": {");
+    int first = 1;
+    for (int i = phase_idle + 1; i < num_phases; i++) {
+        if (profile.calls[i] > 0) {
+            fprintf(file_pt, "%s\n        \"%s\": {\"Time\": %lld, \"Calls\": %lld}", first ? "" : ",",
+                    phase_names[i], get_profile_time(i), profile.calls[i]);
+            first = 0;
+        }
+    }
+    fprintf(file_pt, "\n    },\n    \"Model\": {\n        \"Models\": %d", profile.num_models);
+    for (int i = 0; i < num_counters; i++) {
+        fprintf(file_pt, ",\n        \"%s\": {\"Total\": %lld, \"Largest\": %lld}", counter_names[i], profile.total[i],
+                profile.largest[i]);
+    }
+    fprintf(file_pt, "\n    },\n    \"PeakMemory\": %lld\n}\n", get_peak_memory());
+    
+    if (fclose(file_pt) != 0) {
+        fprintf(stderr, "The json file of the profile could not be written\n");
+        return -1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,194 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Profile.h                                                                                                          *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that measures where the schedule, the patch and the optimize spend their time, and the size of the models  *
+ *  given to the solver. The execution is split in phases measured with a monotonic clock, every function of a phase   *
+ *  starts it when it is called, and the time counts for that phase until another one starts. Every thread has its     *
+ *  own profile, so the threads of a pool do not mix their phases.                                                     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Profile_h
+#define Profile_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#endif /* Profile_h */
+
+// The CP-SAT backend is written in C++, and it counts the size of its models
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Phases of the execution that are measured
+ */
+typedef enum Profile_Phase {
+    phase_idle,                     // Not measured, before the first phase or after a reset
+    phase_read,                     // Reading the network, patch, optimize and parameters files
+    phase_prepare,                  // Preparing the network
+    phase_environment,              // Loading the environment of the solver
+    phase_variables,                // Creating the variables of the solver
+    phase_path,                     // Adding the path dependent constraints
+    phase_end_to_end,               // Adding the end to end delay constraints
+    phase_collision,                // Adding the constraints that avoid the collisions
+    phase_symmetry,                 // Adding the symmetry breaking constraints
+    phase_presolve,                 // Reserving the intervals of the frames already scheduled
+    phase_start,                    // Setting the starting solution of the solver
+    phase_solve,                    // Searching a solution with the solver
+    phase_save,                     // Saving and checking the schedule found
+    phase_heuristic,                // Scheduling with the heuristic
+    phase_patch,                    // Patching the traffic
+    phase_search,                   // Improving the patched traffic with the local search
+    phase_write,                    // Writing the output files
+    num_phases
+}Profile_Phase;
+
+/**
+ Counters of the size of the models given to the solver
+ */
+typedef enum Profile_Counter {
+    counter_variables,              // Variables of the model
+    counter_binaries,               // Binary variables of the model
+    counter_constraints,            // Linear constraints of the model
+    counter_general,                // Or, indicator and no-overlap constraints of the model
+    num_counters
+}Profile_Counter;
+
+/**
+ Measures of a thread
+ */
+typedef struct Profile {
+    long long int time[num_phases];             // Time spent in every phase in ns
+    long long int calls[num_phases];            // Number of times every phase was started
+    Profile_Phase phase;                        // Phase being measured
+    uint64_t phase_starting;                    // Time when the phase being measured started
+    int num_models;                             // Number of models created in the solver
+    long long int model[num_counters];          // Size of the current model
+    long long int total[num_counters];          // Size of all the models together
+    long long int largest[num_counters];        // Size of the largest model of every counter
+}Profile;
+
+                                                /* CODE DEFINITIONS */
+
+/* Getters */
+
+/**
+ Get the time of a monotonic clock, only useful to measure intervals
+
+ @return time in ns
+ */
+uint64_t get_monotonic_time(void);
+
+/**
+ Get the time spent in a phase, including the time of the phase being measured
+
+ @param phase phase
+ @return time in ns, -1 if the phase does not exist
+ */
+long long int get_profile_time(Profile_Phase phase);
+
+/**
+ Get the number of times a phase was started
+
+ @param phase phase
+ @return number of times, -1 if the phase does not exist
+ */
+long long int get_profile_calls(Profile_Phase phase);
+
+/**
+ Get the name of a phase, as written in the output files
+
+ @param phase phase
+ @return name of the phase, NULL if it does not exist
+ */
+const char * get_profile_phase_name(Profile_Phase phase);
+
+/**
+ Get the number of models created in the solver
+
+ @return number of models
+ */
+int get_profile_num_models(void);
+
+/**
+ Get the size of all the models created in the solver together
+
+ @param counter counter of the size
+ @return size, -1 if the counter does not exist
+ */
+long long int get_profile_total(Profile_Counter counter);
+
+/**
+ Get the size of the largest model created in the solver for the given counter
+
+ @param counter counter of the size
+ @return size, -1 if the counter does not exist
+ */
+long long int get_profile_largest(Profile_Counter counter);
+
+/**
+ Get the name of a counter, as written in the output files
+
+ @param counter counter
+ @return name of the counter, NULL if it does not exist
+ */
+const char * get_profile_counter_name(Profile_Counter counter);
+
+/**
+ Get the peak of the resident memory of the process
+
+ @return peak memory in KB, -1 if it could not be read
+ */
+long long int get_peak_memory(void);
+
+/* Functions */
+
+/**
+ Start measuring a phase in the calling thread, the phase measured before stops
+
+ @param phase phase to start, phase_idle to stop measuring
+ */
+void profile_phase(Profile_Phase phase);
+
+/**
+ Count a new model in the solver, the size of the previous one is already in the totals
+ */
+void profile_new_model(void);
+
+/**
+ Count an element added to the current model of the solver
+
+ @param counter counter of the element
+ */
+void profile_count(Profile_Counter counter);
+
+/**
+ Clear all the measures of the calling thread
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int reset_profile(void);
+
+/**
+ Write the measures of the calling thread in a json file
+
+ @param json_file name and path of the json file
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_profile_json(char *json_file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,531 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Repair.c                                                                                                           *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Repair.h                                                                                            *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Network.h"
+#include "Scheduler.h"
+#include "Repair.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Add some bytes to a hash with the FNV-1a hash function
+
+ @param hash current value of the hash
+ @param data pointer to the bytes
+ @param size number of bytes
+ @return new value of the hash
+ */
+uint64_t hash_repair_bytes(uint64_t hash, const void *data, size_t size) {
+    
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= REPAIR_HASH_PRIME;
+    }
+    
+    return hash;
+}
+
+/**
+ Get the hash of the content of the network file
+
+ @param network_file name and path of the network file
+ @param hash_pt pointer to save the hash
+ @return 0 if done correctly, -1 if the file could not be read
+ */
+int hash_network_file(char *network_file, uint64_t *hash_pt) {
+    
+    FILE *file_pt = fopen(network_file, "rb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The network file of the repair cache could not be opened\n");
+        return -1;
+    }
+    
+    uint64_t hash = REPAIR_HASH_OFFSET;
+    unsigned char buffer[4096];
+    size_t num_read;
+    while ((num_read = fread(buffer, 1, sizeof(buffer), file_pt)) > 0) {
+        hash = hash_repair_bytes(hash, buffer, num_read);
+    }
+    int error = ferror(file_pt) != 0 ? -1 : 0;
+    fclose(file_pt);
+    *hash_pt = hash;
+    
+    return error;
+}
+
+/**
+ Get the key of the traffic of a link, the hash of its fixed traffic and of the ranges of its patched frames
+
+ @param t pointer to the traffic of the link
+ @param fixed_frames number of fixed frames
+ @param link_id id of the link
+ @return key of the traffic
+ */
+uint64_t get_repair_key(Traffic *t, int fixed_frames, int link_id) {
+    
+    int64_t values[3] = {link_id, fixed_frames, t->num_frames};
+    uint64_t hash = hash_repair_bytes(REPAIR_HASH_OFFSET, values, sizeof(values));
+    for (int fr_it = 0; fr_it < t->num_frames; fr_it++) {
+        // The traffic of a patch only has one offset
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        values[0] = t->frames_id[fr_it];
+        values[1] = get_off_num_instances(off_pt) * get_off_num_replicas(off_pt);
+        values[2] = get_off_time(off_pt);
+        hash = hash_repair_bytes(hash, values, sizeof(values));
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                if (fr_it < fixed_frames) {
+                    values[0] = get_trans_time(off_pt, inst, repl);
+                    hash = hash_repair_bytes(hash, values, sizeof(int64_t));
+                } else {
+                    values[0] = get_min_trans_time(off_pt, inst, repl);
+                    values[1] = get_max_trans_time(off_pt, inst, repl);
+                    hash = hash_repair_bytes(hash, values, sizeof(int64_t) * 2);
+                }
+            }
+        }
+    }
+    
+    return hash;
+}
+
+/**
+ Compare two repair plans by their link id and key
+
+ @param a pointer to the first plan
+ @param b pointer to the second plan
+ @return negative if the first plan goes first, positive if it goes after, 0 if both are equal
+ */
+int compare_repair_plans(const void *a, const void *b) {
+    
+    const Repair_Plan *plan_a = a;
+    const Repair_Plan *plan_b = b;
+    
+    if (plan_a->link_id != plan_b->link_id) {
+        return plan_a->link_id < plan_b->link_id ? -1 : 1;
+    }
+    if (plan_a->key != plan_b->key) {
+        return plan_a->key < plan_b->key ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Compare two transmissions of a link by their transmission time
+
+ @param a pointer to the first transmission
+ @param b pointer to the second transmission
+ @return negative if the first transmission goes first, positive otherwise
+ */
+int compare_repair_transmissions(const void *a, const void *b) {
+    
+    const Repair_Transmission *trans_a = a;
+    const Repair_Transmission *trans_b = b;
+    
+    if (trans_a->starting != trans_b->starting) {
+        return trans_a->starting < trans_b->starting ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Count the transmissions of the patched frames of a link, the number of transmission times of its plan
+
+ @param t pointer to the traffic of the link
+ @param fixed_frames number of fixed frames
+ @return number of transmissions, -1 if a patched frame does not store all its instances
+ */
+long long int count_patched_transmissions(Traffic *t, int fixed_frames) {
+    
+    long long int num_times = 0;
+    for (int fr_it = fixed_frames; fr_it < t->num_frames; fr_it++) {
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        // The strictly periodic offsets can not move their instances one by one
+        if (get_off_stored_instances(off_pt) != get_off_num_instances(off_pt)) {
+            return -1;
+        }
+        num_times += get_off_num_instances(off_pt) * get_off_num_replicas(off_pt);
+    }
+    
+    return num_times;
+}
+
+/**
+ Check that the transmission times of a plan are inside the ranges of the patched frames of a link, and that they do
+ not collide with the fixed frames, the self-healing protocol nor between them
+
+ @param cache pointer to the cache
+ @param plan_pt pointer to the plan
+ @param t pointer to the traffic of the link
+ @param fixed_frames number of fixed frames
+ @return 0 if the plan is valid, -1 otherwise
+ */
+int check_repair_plan(Repair_Cache *cache, Repair_Plan *plan_pt, Traffic *t, int fixed_frames) {
+    
+    if (cache->hyperperiod != get_hyperperiod() || plan_pt->num_times != count_patched_transmissions(t, fixed_frames)) {
+        return -1;
+    }
+    
+    SelfHealing_Protocol *shp = get_healing_protocol();
+    long long int instances_protocol = shp->period != 0 ? get_hyperperiod() / shp->period : 0;
+    long long int num_trans = instances_protocol + plan_pt->num_times;
+    for (int fr_it = 0; fr_it < fixed_frames; fr_it++) {
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        num_trans += get_off_num_instances(off_pt) * get_off_num_replicas(off_pt);
+    }
+    Repair_Transmission *trans = malloc(sizeof(Repair_Transmission) * (num_trans + 1));
+    if (trans == NULL) {
+        fprintf(stderr, "Not enough memory to check the repair plan\n");
+        return -1;
+    }
+    
+    long long int pos = 0;
+    for (long long int i = 0; i < instances_protocol; i++) {
+        trans[pos].starting = shp->period * i;
+        trans[pos].ending = trans[pos].starting + shp->time;
+        pos++;
+    }
+    int64_t *times = &cache->times[plan_pt->first_time];
+    long long int time_it = 0;
+    int error = 0;
+    for (int fr_it = 0; fr_it < t->num_frames; fr_it++) {
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                if (fr_it < fixed_frames) {
+                    trans[pos].starting = get_trans_time(off_pt, inst, repl);
+                } else {
+                    trans[pos].starting = times[time_it];
+                    time_it++;
+                    // As when patching, every replica goes after the previous one, and the minimum is always a
+                    // valid transmission time of the first replica
+                    long long int min = get_min_trans_time(off_pt, inst, repl);
+                    if (repl > 0 && trans[pos - 1].ending > min) {
+                        min = trans[pos - 1].ending;
+                    }
+                    if (trans[pos].starting < min || (trans[pos].starting > get_max_trans_time(off_pt, inst, repl) &&
+                                                      (repl > 0 || trans[pos].starting != min))) {
+                        error = -1;
+                    }
+                }
+                trans[pos].ending = trans[pos].starting + get_off_time(off_pt);
+                pos++;
+            }
+        }
+    }
+    
+    // Once sorted, every transmission has to end before the next one starts
+    qsort(trans, num_trans, sizeof(Repair_Transmission), compare_repair_transmissions);
+    for (long long int i = 1; i < num_trans && error == 0; i++) {
+        if (trans[i - 1].ending > trans[i].starting) {
+            error = -1;
+        }
+    }
+    free(trans);
+    
+    return error;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Start an empty cache for the plans of the current network
+ */
+int init_repair_cache(Repair_Cache *cache, char *network_file) {
+    
+    if (cache == NULL || network_file == NULL) {
+        fprintf(stderr, "The given cache or network file pointer is NULL\n");
+        return -1;
+    }
+    memset(cache, 0, sizeof(Repair_Cache));
+    if (get_hyperperiod() <= 0) {
+        fprintf(stderr, "The network has to be scheduled to build its repair plans\n");
+        return -1;
+    }
+    
+    cache->hyperperiod = get_hyperperiod();
+    cache->network_file = strdup(network_file);
+    if (cache->network_file == NULL) {
+        fprintf(stderr, "Not enough memory for the repair cache\n");
+        return -1;
+    }
+    if (hash_network_file(network_file, &cache->network_hash) == -1) {
+        free_repair_cache(cache);
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Save the patched traffic of a link as a plan of the cache
+ */
+int add_repair_plan(Repair_Cache *cache, Traffic *t, int fixed_frames, int link_id, int failed_link_id) {
+    
+    long long int num_times = count_patched_transmissions(t, fixed_frames);
+    if (num_times == -1) {
+        fprintf(stderr, "The strictly periodic offsets can not be saved in a repair plan\n");
+        return -1;
+    }
+    
+    // The memory grows twice as large every time it is full
+    if (cache->num_plans == cache->size_plans) {
+        int size_plans = cache->size_plans == 0 ? 16 : cache->size_plans * 2;
+        Repair_Plan *plans = realloc(cache->plans, sizeof(Repair_Plan) * size_plans);
+        if (plans == NULL) {
+            fprintf(stderr, "Not enough memory for the repair plans\n");
+            return -1;
+        }
+        cache->plans = plans;
+        cache->size_plans = size_plans;
+    }
+    if (cache->num_times + num_times > cache->size_times) {
+        long long int size_times = cache->size_times == 0 ? 1024 : cache->size_times * 2;
+        while (size_times < cache->num_times + num_times) {
+            size_times *= 2;
+        }
+        int64_t *times = realloc(cache->times, sizeof(int64_t) * size_times);
+        if (times == NULL) {
+            fprintf(stderr, "Not enough memory for the repair plans\n");
+            return -1;
+        }
+        cache->times = times;
+        cache->size_times = size_times;
+    }
+    
+    Repair_Plan *plan_pt = &cache->plans[cache->num_plans];
+    plan_pt->link_id = link_id;
+    plan_pt->failed_link_id = failed_link_id;
+    plan_pt->key = get_repair_key(t, fixed_frames, link_id);
+    plan_pt->first_time = cache->num_times;
+    plan_pt->num_times = num_times;
+    for (int fr_it = fixed_frames; fr_it < t->num_frames; fr_it++) {
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                cache->times[cache->num_times] = get_trans_time(off_pt, inst, repl);
+                cache->num_times++;
+            }
+        }
+    }
+    cache->num_plans++;
+    
+    return 0;
+}
+
+/**
+ Sort the plans of the cache by link id and key
+ */
+int sort_repair_plans(Repair_Cache *cache) {
+    
+    if (cache == NULL) {
+        fprintf(stderr, "The given cache pointer is NULL\n");
+        return -1;
+    }
+    
+    if (cache->num_plans > 1) {
+        qsort(cache->plans, cache->num_plans, sizeof(Repair_Plan), compare_repair_plans);
+    }
+    
+    return 0;
+}
+
+/**
+ Search a plan for the traffic of a link and set its transmission times if the plan is valid for the traffic
+ */
+int apply_repair_plan(Repair_Cache *cache, Traffic *t, int fixed_frames, int link_id) {
+    
+    if (cache == NULL || cache->num_plans == 0) {
+        return -1;
+    }
+    
+    // Binary search of the first plan of the link with the key of the traffic
+    Repair_Plan target;
+    target.link_id = link_id;
+    target.key = get_repair_key(t, fixed_frames, link_id);
+    int low = 0;
+    int high = cache->num_plans;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (compare_repair_plans(&cache->plans[mid], &target) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    // Several failures might patch the link with the same traffic, the first valid plan is used
+    for (int i = low; i < cache->num_plans && compare_repair_plans(&cache->plans[i], &target) == 0; i++) {
+        Repair_Plan *plan_pt = &cache->plans[i];
+        if (check_repair_plan(cache, plan_pt, t, fixed_frames) == -1) {
+            continue;
+        }
+        int64_t *times = &cache->times[plan_pt->first_time];
+        for (int fr_it = fixed_frames; fr_it < t->num_frames; fr_it++) {
+            Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+            for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                    set_trans_time(off_pt, inst, repl, *times);
+                    times++;
+                }
+            }
+        }
+        return 0;
+    }
+    
+    return -1;
+}
+
+/**
+ Write all the plans of the cache in a cache file
+ */
+int write_repair_cache(Repair_Cache *cache, char *cache_file) {
+    
+    if (cache == NULL || cache_file == NULL || cache->network_file == NULL) {
+        fprintf(stderr, "The given cache or file pointer is NULL\n");
+        return -1;
+    }
+    FILE *file_pt = fopen(cache_file, "wb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The repair cache file could not be created\n");
+        return -1;
+    }
+    
+    // The name of the network file is padded, so the plans and the times are aligned to 8 bytes
+    Repair_Header header;
+    memset(&header, 0, sizeof(Repair_Header));
+    memcpy(header.magic, REPAIR_MAGIC, 4);
+    header.version = REPAIR_VERSION;
+    header.num_plans = cache->num_plans;
+    header.len_network_file = (int32_t) ((strlen(cache->network_file) + 8) / 8 * 8);
+    header.num_times = cache->num_times;
+    header.hyperperiod = cache->hyperperiod;
+    header.network_hash = cache->network_hash;
+    char *name = calloc(header.len_network_file, sizeof(char));
+    int error = 0;
+    if (name == NULL) {
+        fprintf(stderr, "Not enough memory to write the repair cache\n");
+        error = -1;
+    } else {
+        strcpy(name, cache->network_file);
+    }
+    
+    // An empty cache is still written, so it is not built again while the network does not change
+    if (error == 0 && (fwrite(&header, sizeof(Repair_Header), 1, file_pt) != 1 ||
+                       fwrite(name, sizeof(char), header.len_network_file, file_pt) !=
+                       (size_t) header.len_network_file ||
+                       (cache->num_plans > 0 &&
+                        fwrite(cache->plans, sizeof(Repair_Plan), cache->num_plans, file_pt) !=
+                        (size_t) cache->num_plans) ||
+                       (cache->num_times > 0 &&
+                        fwrite(cache->times, sizeof(int64_t), cache->num_times, file_pt) !=
+                        (size_t) cache->num_times))) {
+        fprintf(stderr, "The repair cache file could not be written\n");
+        error = -1;
+    }
+    free(name);
+    if (fclose(file_pt) != 0) {
+        fprintf(stderr, "The repair cache file could not be written\n");
+        error = -1;
+    }
+    
+    return error;
+}
+
+/**
+ Read the plans of a cache file, discarding them if the network file changed
+ */
+int read_repair_cache(char *cache_file, Repair_Cache *cache) {
+    
+    if (cache == NULL || cache_file == NULL) {
+        fprintf(stderr, "The given cache or file pointer is NULL\n");
+        return -1;
+    }
+    memset(cache, 0, sizeof(Repair_Cache));
+    FILE *file_pt = fopen(cache_file, "rb");
+    if (file_pt == NULL) {
+        fprintf(stderr, "The repair cache file does not exist\n");
+        return -1;
+    }
+    
+    Repair_Header header;
+    if (fread(&header, sizeof(Repair_Header), 1, file_pt) != 1 || memcmp(header.magic, REPAIR_MAGIC, 4) != 0 ||
+        header.version != REPAIR_VERSION || header.num_plans < 0 || header.num_times < 0 ||
+        header.len_network_file <= 0) {
+        fprintf(stderr, "The given file is not a repair cache of this version\n");
+        fclose(file_pt);
+        return -1;
+    }
+    
+    cache->network_file = calloc(header.len_network_file + 1, sizeof(char));
+    cache->plans = malloc(sizeof(Repair_Plan) * (header.num_plans + 1));
+    cache->times = malloc(sizeof(int64_t) * (header.num_times + 1));
+    if (cache->network_file == NULL || cache->plans == NULL || cache->times == NULL) {
+        fprintf(stderr, "Not enough memory to read the repair cache\n");
+        fclose(file_pt);
+        free_repair_cache(cache);
+        return -1;
+    }
+    if (fread(cache->network_file, sizeof(char), header.len_network_file, file_pt) !=
+        (size_t) header.len_network_file ||
+        fread(cache->plans, sizeof(Repair_Plan), header.num_plans, file_pt) != (size_t) header.num_plans ||
+        fread(cache->times, sizeof(int64_t), header.num_times, file_pt) != (size_t) header.num_times) {
+        fprintf(stderr, "The repair cache file is incomplete\n");
+        fclose(file_pt);
+        free_repair_cache(cache);
+        return -1;
+    }
+    fclose(file_pt);
+    cache->num_plans = header.num_plans;
+    cache->size_plans = header.num_plans;
+    cache->num_times = header.num_times;
+    cache->size_times = header.num_times;
+    cache->hyperperiod = header.hyperperiod;
+    cache->network_hash = header.network_hash;
+    
+    // The plans were built for the network file as it was, if it changed they are not valid anymore
+    uint64_t network_hash;
+    if (hash_network_file(cache->network_file, &network_hash) == -1 || network_hash != cache->network_hash) {
+        fprintf(stderr, "The repair cache is outdated, the network file changed since it was built\n");
+        free_repair_cache(cache);
+        return -1;
+    }
+    for (int i = 0; i < cache->num_plans; i++) {
+        if (cache->plans[i].first_time < 0 || cache->plans[i].num_times < 0 ||
+            cache->plans[i].first_time + cache->plans[i].num_times > cache->num_times) {
+            fprintf(stderr, "The repair cache file is corrupted\n");
+            free_repair_cache(cache);
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Free the plans of the cache
+ */
+int free_repair_cache(Repair_Cache *cache) {
+    
+    if (cache == NULL) {
+        fprintf(stderr, "The given cache pointer is NULL\n");
+        return -1;
+    }
+    
+    free(cache->plans);
+    free(cache->times);
+    free(cache->network_file);
+    memset(cache, 0, sizeof(Repair_Cache));
+    
+    return 0;
+}
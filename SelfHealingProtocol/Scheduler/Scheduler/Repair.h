@@ -0,0 +1,154 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Repair.h                                                                                                           *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that keeps the repair plans of the link failures of a scheduled network in a cache, so a failure is        *
+ *  repaired with a lookup instead of patching the links of its path. The plans are built offline evaluating the       *
+ *  failure of every link, and every plan saves the transmission times of the patched frames of one link of a path.    *
+ *  A plan is found by its link and a key of the traffic of the patch, and it is only used if all its transmissions    *
+ *  are inside the ranges of the patch and do not collide with the fixed traffic nor the self-healing protocol.        *
+ *  The cache file saves a hash of the network file, so the cache is discarded once the network file changes.          *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Repair_h
+#define Repair_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#endif /* Repair_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define REPAIR_MAGIC "SHPR"                     // First bytes of the repair cache files
+#define REPAIR_VERSION 1                        // Version of the repair cache files
+#define REPAIR_HASH_OFFSET 14695981039346656037ULL  // Starting value of the hashes, as in FNV-1a
+#define REPAIR_HASH_PRIME 1099511628211ULL          // Multiplier of the hashes, as in FNV-1a
+
+/**
+ Repair plan of a link of the path that replaces a failed link
+ */
+typedef struct Repair_Plan {
+    int32_t link_id;                    // ID of the link patched by the plan
+    int32_t failed_link_id;             // ID of the failed link that the plan repairs
+    uint64_t key;                       // Hash of the fixed traffic and the ranges of the patched frames of the link
+    int64_t first_time;                 // Position of the first transmission time of the plan in the cache
+    int64_t num_times;                  // Number of transmission times, all the instances of the patched frames
+}Repair_Plan;
+
+/**
+ Header of the repair cache files, written in the byte order of the machine as the binary schedule files.
+ It is followed by the name of the network file with its ending character, padded with zeros to a multiple of 8
+ bytes, the plans sorted by link id and key, and the transmission times of all the plans (int64_t)
+ */
+typedef struct Repair_Header {
+    char magic[4];                      // REPAIR_MAGIC without the ending character
+    int32_t version;                    // REPAIR_VERSION of the writer
+    int32_t num_plans;                  // Number of plans
+    int32_t len_network_file;           // Length of the name of the network file, with the padding
+    int64_t num_times;                  // Number of transmission times of all the plans
+    int64_t hyperperiod;                // Hyperperiod of the schedule of the plans in time slots
+    uint64_t network_hash;              // Hash of the network file when the plans were built
+}Repair_Header;
+
+/**
+ Cache with the repair plans of a scheduled network. It is only read when patching, so several schedulers can share it
+ */
+typedef struct Repair_Cache {
+    Repair_Plan *plans;                 // Plans, sorted by link id and key once the cache is finished
+    int num_plans;                      // Number of plans
+    int size_plans;                     // Number of plans allocated
+    int64_t *times;                     // Transmission times of all the plans
+    long long int num_times;            // Number of transmission times
+    long long int size_times;           // Number of transmission times allocated
+    long long int hyperperiod;          // Hyperperiod of the schedule of the plans in time slots
+    uint64_t network_hash;              // Hash of the network file of the schedule
+    char *network_file;                 // Name and path of the network file of the schedule
+}Repair_Cache;
+
+/**
+ Transmission of a link when a repair plan is checked
+ */
+typedef struct Repair_Transmission {
+    long long int starting;             // Transmission time
+    long long int ending;               // End of the transmission, the next transmission can start at it
+}Repair_Transmission;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Start an empty cache for the plans of the current network, that has to be scheduled
+
+ @param cache pointer to the cache, it has to be freed with free_repair_cache
+ @param network_file name and path of the network file of the schedule
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_repair_cache(Repair_Cache *cache, char *network_file);
+
+/**
+ Save the patched traffic of a link as a plan of the cache. The traffic has the fixed frames first, and the patched
+ frames have to store all their instances
+
+ @param cache pointer to the cache
+ @param t pointer to the traffic of the link
+ @param fixed_frames number of fixed frames
+ @param link_id id of the patched link
+ @param failed_link_id id of the failed link that the patch repairs
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_repair_plan(Repair_Cache *cache, Traffic *t, int fixed_frames, int link_id, int failed_link_id);
+
+/**
+ Sort the plans of the cache by link id and key, so they can be found. It has to be called once all the plans are
+ added
+
+ @param cache pointer to the cache
+ @return 0 if done correctly, -1 otherwise
+ */
+int sort_repair_plans(Repair_Cache *cache);
+
+/**
+ Search a plan for the traffic of a link and set its transmission times if the plan is valid for the traffic.
+ The transmissions of a valid plan are inside the ranges of the patched frames and do not collide with the fixed
+ frames, the self-healing protocol nor between them
+
+ @param cache pointer to the cache
+ @param t pointer to the traffic of the link
+ @param fixed_frames number of fixed frames
+ @param link_id id of the link to patch
+ @return 0 if a valid plan was set, -1 otherwise
+ */
+int apply_repair_plan(Repair_Cache *cache, Traffic *t, int fixed_frames, int link_id);
+
+/**
+ Write all the plans of the cache in a cache file
+
+ @param cache pointer to the cache
+ @param cache_file name and path of the cache file
+ @return 0 if done correctly, -1 otherwise
+ */
+int write_repair_cache(Repair_Cache *cache, char *cache_file);
+
+/**
+ Read the plans of a cache file. The cache is discarded if the network file changed since the plans were built
+
+ @param cache_file name and path of the cache file
+ @param cache pointer to the cache to fill, it has to be freed with free_repair_cache
+ @return 0 if done correctly, -1 if the file could not be read or it is outdated
+ */
+int read_repair_cache(char *cache_file, Repair_Cache *cache);
+
+/**
+ Free the plans of the cache
+
+ @param cache pointer to the cache
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_repair_cache(Repair_Cache *cache);
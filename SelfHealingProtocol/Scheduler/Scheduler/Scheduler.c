@@ -12,33 +12,28 @@
 
 #include "Scheduler.h"
 #include "Network.h"
+#include "Validator.h"
+#include "Profile.h"
+#include "Repair.h"
+#include "View.h"
 
 
                                                     /* VARIABLES */
 
-GRBenv *env = NULL;                 // Gurobi solver environment
-GRBmodel *model = NULL;             // Gurobi model
-int var_it = 0;                     // Iterator to remember the value to position variables in gurobi
-int *frame_dis = NULL;              // Indexes for the gurobi variables for the frame distances
-int *link_dis = NULL;               // Indexes for the gurobi variables for the link distances
-double frame_dis_w = 0.9;           // Weight for the frame distances
-double link_dis_w = 0.1;            // Link for the link distances
-long long int path_con = 0;         // Counter of path dependent constraints
-long long int end_con = 0;          // Counter of end to end constraints
-long long int avoid_con = 0;        // Counter of avoid collission constraints
-long long int x_con = 0;            // Counter of x bin variables
-long long int y_con = 0;            // Counter of y bin variables
-long long int z_con = 0;            // Counter of z bin variables
-long long int or_con = 0;           // Counter of z = x or y variables
-long long int fix_con = 0;          // Counter of fixed variables
-int frames_it = 1;                  // Frames solved at each iteration of the incremental approach
-Scheduler algorithm;                // Algorithm used to schedule the network
-double MIPGAP = 0.25;               // MIP GAP limit when to stop searching
-double timelimit = 0.35;            // Time limit when to stop executing the solver (in the case of the incremetal
-                                    // it is the time limit PER ITERATION)
-LS_Transmission *sorted_trans = NULL;        // Started point of the sorted linked list with the link transmissions
-uint64_t execution_time = 0;        // Execution time of the patch or optimization algorithm
-int *var_shp_optimize = NULL;       // Gurobi variables for the SHP reservation for the optimize
+Scheduler_Context default_scheduler = {     // Scheduler of the threads that did not set another one
+    .frame_dis_w = 0.9,
+    .link_dis_w = 0.1,
+    .frames_it = 1,
+    .algorithm = one_shot,
+    .MIPGAP = 0.25,
+    .timelimit = 0.35,
+    .patch_index = gap_index,
+    .optimize_mode = patch_start,
+    .encoding = indicator_encoding,
+    .requested_encoding = indicator_encoding
+};
+_Thread_local Scheduler_Context *scheduler = &default_scheduler;   // Scheduler the calling thread works on
+_Thread_local Frame *symmetry_frames = NULL;    // Frames whose positions are being sorted to find the identical ones
 
 
                                                     /* FUNCTIONS */
@@ -54,9 +49,13 @@ int *var_shp_optimize = NULL;       // Gurobi variables for the SHP reservation
 int set_algorithm(char *name) {
     
     if (strcmp(name, "OneShot") == 0) {
-        algorithm = one_shot;
+        scheduler->algorithm = one_shot;
     } else if (strcmp(name, "Incremental") == 0) {
-        algorithm = incremental;
+        scheduler->algorithm = incremental;
+    } else if (strcmp(name, "Heuristic") == 0) {
+        scheduler->algorithm = heuristic;
+    } else if (strcmp(name, "Portfolio") == 0) {
+        scheduler->algorithm = portfolio;
     } else {
         fprintf(stderr, "The given algorithm is not defined\n");
         return -1;
@@ -78,7 +77,7 @@ int set_MIPGAP(double value) {
         return -1;
     }
     
-    MIPGAP = value;
+    scheduler->MIPGAP = value;
     
     return 0;
 }
@@ -96,39 +95,168 @@ int set_timelimit(double value) {
         return -1;
     }
     
-    timelimit = value;
+    scheduler->timelimit = value;
     
     return 0;
 }
 
 /**
- Init the solver and prepare it to add constraints
+ Set if the solver starts from the schedule found by the heuristic
 
+ @param value 1 to start from the heuristic, 0 otherwise
  @return 0 if done correctly, -1 otherwise
  */
-int init_solver(void) {
+int set_warm_start(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The warm start should be 0 or 1\n");
+        return -1;
+    }
+    
+    scheduler->warm_start = value;
+    return 0;
+}
+
+/**
+ Set if the incremental approach replaces the frames already scheduled by reserved intervals
+
+ @param value 1 to replace the scheduled frames, 0 to keep them fixed in the solver
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_presolve(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The presolve should be 0 or 1\n");
+        return -1;
+    }
+    
+    scheduler->presolve = value;
+    scheduler->requested_presolve = value;
+    return 0;
+}
+
+/**
+ Set if the incremental approach adapts the frames of every iteration to the time the solver needed
+
+ @param value 1 to adapt the frames per iteration, 0 to keep them fixed
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_adaptive(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The adaptive window should be 0 or 1\n");
+        return -1;
+    }
+    
+    scheduler->adaptive = value;
+    return 0;
+}
+
+/**
+ Set if the links of the path that replaces a failed link are patched at once, so every frame can use the whole range
+ of the path instead of a part of it in every link
+
+ @param value 1 to patch the path at once, 0 to patch every link on its own
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_path_patch(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The path patch should be 0 or 1\n");
+        return -1;
+    }
+    
+    scheduler->path_patch = value;
+    return 0;
+}
+
+/**
+ Set the number of windows the incremental approach schedules again with a window that finds no schedule
+
+ @param value number of windows, 0 to fail as soon as a window finds no schedule
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_rollback(int value) {
+    
+    if (value < 0) {
+        fprintf(stderr, "The rollback should be equal or larger than 0\n");
+        return -1;
+    }
+    
+    scheduler->rollback = value;
+    return 0;
+}
+
+/**
+ Set the order in which the incremental approach schedules the frames
+
+ @param name name of the order ("File", "Period" or "Utilization")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_incremental_order(char *name) {
+    
+    if (strcmp(name, "File") == 0) {
+        return set_frame_order(file_order);
+    } else if (strcmp(name, "Period") == 0) {
+        return set_frame_order(period_order);
+    } else if (strcmp(name, "Utilization") == 0) {
+        return set_frame_order(utilization_order);
+    }
+    
+    fprintf(stderr, "The given frame order is not defined\n");
+    return -1;
+}
+
+/**
+ Set if the one-shot breaks the symmetries between identical frames
+
+ @param value 1 to order the identical frames, 0 otherwise
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_symmetry_breaking(int value) {
     
-    int error = GRBloadenv(&env, NULL);
-    if (error || env == NULL) {
-        fprintf(stderr, "The gurobi solver could not be initialized\n");
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The symmetry breaking should be 0 or 1\n");
         return -1;
     }
     
-    // Silence the output
-    GRBsetintparam(env, GRB_INT_PAR_OUTPUTFLAG, 1);
+    scheduler->symmetry_breaking = value;
+    return 0;
+}
+
+/**
+ Init the solver and prepare it to add constraints
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_solver(void) {
     
-    // Set the MIPGAP
-    GRBsetdblparam(env, GRB_DBL_PAR_MIPGAP, MIPGAP);
-    // Set the time limit
-    GRBsetdblparam(env, GRB_DBL_PAR_TIMELIMIT, timelimit);
+    profile_phase(phase_environment);
     
-    error = GRBnewmodel(env, &model, "schedule", 0, NULL, NULL, NULL, NULL, NULL);
-    if (error) {
-        fprintf(stderr, "The gurobi solver could not create the model\n");
+    // The environment might be still loaded from a previous execution
+    if (solver_load_environment(scheduler->MIPGAP, scheduler->timelimit) == -1 || solver_new_model() == -1) {
         return -1;
     }
-    // Set as maximizing
-    GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, -1);
+    solver_set_cancel(scheduler->cancel);
+    
+    // The fallback is decided for every run, so a run with another solver still gets the encoding that was set
+    scheduler->encoding = scheduler->requested_encoding;
+    scheduler->presolve = scheduler->requested_presolve;
+    
+    // Without no-overlap constraints, the collisions are avoided with the disjunctions of every pair of transmissions
+    if (solver_no_overlap() == 0 && scheduler->encoding == no_overlap_encoding) {
+        fprintf(stderr, "The solver has no no-overlap constraints, the disjunctions are used\n");
+        scheduler->encoding = indicator_encoding;
+    }
+    // Without general constraints, the disjunctions can only be written with the big-M encoding
+    if (solver_general_constraints() == 0 && scheduler->encoding == indicator_encoding) {
+        fprintf(stderr, "The solver has no general constraints, the big-M encoding is used\n");
+        scheduler->encoding = big_m_encoding;
+    }
+    if (solver_general_constraints() == 0 && scheduler->presolve == 1) {
+        fprintf(stderr, "The solver has no general constraints, the presolve is not used\n");
+        scheduler->presolve = 0;
+    }
     
     return 0;
 }
@@ -140,8 +268,58 @@ int init_solver(void) {
  */
 int close_solver(void) {
     
-    GRBfreemodel(model);
-    GRBfreeenv(env);
+    solver_free_model();
+    if (scheduler->persistent_solver == 0) {
+        solver_free_environment();
+    }
+    
+    return 0;
+}
+
+/**
+ Replace the model of the solver by an empty one, keeping the environment and its parameters
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int reset_model(void) {
+    
+    if (solver_new_model() == -1) {
+        return -1;
+    }
+    
+    // The variables of the old model do not exist anymore
+    scheduler->var_it = 0;
+    free(scheduler->link_dis);
+    scheduler->link_dis = NULL;
+    
+    return 0;
+}
+
+/**
+ Build the view of the traffic that is scheduled, its timing does not change until the scheduler memory is freed.
+ A view that was built before is replaced, as the optimize needs the ranges of the transmissions it patches
+
+ @param do_protocol if 1, add also the reservation of the Self-Healing Protocol, the optimize does not have its offsets
+ @return 0 if done correctly, -1 otherwise
+ */
+int prepare_scheduler_view(int do_protocol) {
+    
+    if (scheduler->view != NULL) {
+        free_traffic_view(scheduler->view);
+        free(scheduler->view);
+    }
+    scheduler->view = malloc(sizeof(Traffic_View));
+    if (scheduler->view == NULL) {
+        fprintf(stderr, "Not enough memory for the view of the traffic\n");
+        return -1;
+    }
+    SelfHealing_Protocol *protocol = get_healing_protocol();
+    if (build_traffic_view(get_traffic(), do_protocol && protocol->period != 0 ? &protocol->reservation : NULL,
+                           scheduler->view) == -1) {
+        free(scheduler->view);
+        scheduler->view = NULL;
+        return -1;
+    }
     
     return 0;
 }
@@ -157,31 +335,43 @@ int close_solver(void) {
  */
 int create_offsets_variables(Frame *frames, int num, int accum_num, int do_protocol) {
     
+    profile_phase(phase_variables);
+    
     char name[100];
     
+    // The timing of the frames is read from the view of the traffic
+    if (scheduler->view == NULL && prepare_scheduler_view(1) == -1) {
+        return -1;
+    }
+    Traffic_View *view = scheduler->view;
+    
     // Add all the variables for all transmission times of all frames
     for (int i = accum_num; (i - accum_num) < num; i++) {
         int frame_id = get_frame_id(i);
         for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
             Offset *off = get_offset_it(&frames[i], j);
-            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                    
-                    sprintf(name, "Off_%d_%d_%d_%d", frame_id, get_link_id_offset_it(&frames[i], j), inst, repl);
-                    
-                    // Lower bound = starting time + (period * instance) + (replica * time transmission)
-                    long long int lb = get_starting_time(&frames[i]) + (inst * get_period(&frames[i])) +
-                                       (repl * get_off_time(off));
-                    // Upper bound = deadline - time transmission + (period * instance) - (replica * time transmission)
-                    long long int ub = get_deadline(&frames[i]) - get_off_time(off) + (get_period(&frames[i]) * inst) -
-                                       (repl * get_off_time(off));
+            int link_id = get_link_id_offset_it(&frames[i], j);
+            int num_replicas = get_off_num_replicas(off);
+            long long int time = get_off_time(off);
+            for (int inst = 0; inst < get_off_stored_instances(off); inst++) {
+                
+                // The replicas are transmitted one after the other, so the bounds of all of them are shifted from
+                // the bounds of the first one
+                // Lower bound = starting time + (period * instance) + (replica * time transmission)
+                // Upper bound = deadline + (period * instance) - ((replicas - replica) * time transmission)
+                long long int first_lb = get_view_starting(view, i) + (inst * get_view_period(view, i));
+                long long int first_ub = get_view_deadline(view, i) + (get_view_period(view, i) * inst) -
+                                         (num_replicas * time);
+                int *vars = get_replica_vars(off, inst);
+                for (int repl = 0; repl < num_replicas; repl++) {
                     
-                    if (GRBaddvar(model, 0, NULL, NULL, 0, lb, ub, GRB_INTEGER, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
+                    sprintf(name, "Off_%d_%d_%d_%d", frame_id, link_id, inst, repl);
+                    if (solver_add_var(0, first_lb + (repl * time), first_ub + (repl * time), solver_integer,
+                                       name) == -1) {
                         return -1;
                     }
-                    set_var_name(off, inst, repl, var_it);
-                    var_it += 1;
+                    vars[repl] = scheduler->var_it;
+                    scheduler->var_it += 1;
                 }
             }
         }
@@ -197,17 +387,16 @@ int create_offsets_variables(Frame *frames, int num, int accum_num, int do_proto
                 
                 long long int value = inst * get_period(&shp->reservation);
                 
-                if (GRBaddvar(model, 0, NULL, NULL, 0, value, value, GRB_INTEGER, name)) {
-                    printf("%s\n", GRBgeterrormsg(env));
+                if (solver_add_var(0, value, value, solver_integer, name) == -1) {
                     return -1;
                 }
-                set_var_name(off, inst, 0, var_it);
+                set_var_name(off, inst, 0, scheduler->var_it);
                 set_trans_time(off, inst, 0, value);
-                var_it += 1;
+                scheduler->var_it += 1;
             }
         }
     }
-    GRBupdatemodel(model);
+    solver_update();
     
     return 0;
 }
@@ -223,40 +412,40 @@ int create_offsets_variables(Frame *frames, int num, int accum_num, int do_proto
  */
 int create_intermission_variables(Frame *frames, int num, int accum_num, int it) {
     
+    profile_phase(phase_variables);
+    
     char name[100];
     
     // If link distances were init, remove the obj from them
-    if (link_dis != NULL) {
+    if (scheduler->link_dis != NULL) {
         for (int i = 0; i <= get_higher_link_id(); i++) {
-            GRBsetdblattrelement(model, GRB_DBL_ATTR_OBJ, link_dis[i], 0.0);
+            solver_set_objective(scheduler->link_dis[i], 0.0);
         }
     }
     
     // Allocate to save the frame and link distances variables
-    frame_dis = realloc(frame_dis, sizeof(int) * (accum_num + num));
-    link_dis = malloc(sizeof(int) * (get_higher_link_id() + 1));
+    scheduler->frame_dis = realloc(scheduler->frame_dis, sizeof(int) * (accum_num + num));
+    scheduler->link_dis = realloc(scheduler->link_dis, sizeof(int) * (get_higher_link_id() + 1));
     
     // Create all the frame intermissions
     for (int i = accum_num; (i - accum_num) < num; i++) {
         sprintf(name, "FrameDis_%d", get_frame_id(i));
         
-        if (GRBaddvar(model, 0, NULL, NULL, frame_dis_w, 0, get_end_to_end(&frames[i]), GRB_INTEGER, name)) {
-            printf("%s\n", GRBgeterrormsg(env));
+        if (solver_add_var(scheduler->frame_dis_w, 0, get_end_to_end(&frames[i]), solver_integer, name) == -1) {
             return -1;
         }
-        frame_dis[i] = var_it;
-        var_it += 1;
+        scheduler->frame_dis[i] = scheduler->var_it;
+        scheduler->var_it += 1;
     }
     
     // Create all the link intermissions
     for (int i = 0; i <= get_higher_link_id(); i++) {
         sprintf(name, "LinkDis_%d_%d", it, i);
-        if (GRBaddvar(model, 0, NULL, NULL, link_dis_w, 0, get_hyperperiod(), GRB_INTEGER, name)) {
-            printf("%s\n", GRBgeterrormsg(env));
+        if (solver_add_var(scheduler->link_dis_w, 0, get_hyperperiod(), solver_integer, name) == -1) {
             return -1;
         }
-        link_dis[i] = var_it;
-        var_it += 1;
+        scheduler->link_dis[i] = scheduler->var_it;
+        scheduler->var_it += 1;
     }
     
     return 0;
@@ -272,6 +461,8 @@ int create_intermission_variables(Frame *frames, int num, int accum_num, int it)
  */
 int path_dependent(Frame *frames, int num, int accum_num) {
     
+    profile_phase(phase_path);
+    
     char name[100];
     // For all frames, for every different path, iterate over all the links
     for (int i = accum_num; (i - accum_num) < num; i++) {
@@ -281,24 +472,46 @@ int path_dependent(Frame *frames, int num, int accum_num) {
             for (int h = 0; h < (get_num_links_path(path_pt) - 1); h++) {
                 Offset *off_pt = get_offset_path_link(path_pt, h);
                 Offset *next_off_pt = get_offset_path_link(path_pt, h + 1);
-                for (int inst = 0; inst < get_off_num_instances(off_pt); inst ++) {
+                int last_repl = get_off_num_replicas(off_pt) - 1;
+                for (int inst = 0; inst < get_off_stored_instances(off_pt); inst ++) {
                     
+                    // The next link waits for the last replica of the link
                     // OFFSET + MIN TIME SWITCH + TRANSMISSION TIME + FRAME INTER <= NEXT OFFSET
                     long long int distance = get_off_time(off_pt) + get_switch_min_time();
-                    int var_off[] = {get_var_name(off_pt, inst, 0), get_var_name(next_off_pt, inst, 0), frame_dis[i]};
+                    int var_off[] = {get_var_name(off_pt, inst, last_repl), get_var_name(next_off_pt, inst, 0),
+                                     scheduler->frame_dis[i]};
                     double val[] = {-1, 1, -1};
                     
-                    sprintf(name, "PathDep_%lld", path_con);
-                    path_con += 1;
-                    if (GRBaddconstr(model, 3, var_off, val, GRB_GREATER_EQUAL, distance, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
+                    sprintf(name, "PathDep_%lld", scheduler->path_con);
+                    scheduler->path_con += 1;
+                    if (solver_add_constr(3, var_off, val, solver_greater_equal, distance, name) == -1) {
+                        return -1;
+                    }
+                }
+            }
+        }
+        
+        // The replicas of a wireless link are transmitted one after the other
+        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
+            Offset *off_pt = get_offset_it(&frames[i], j);
+            for (int inst = 0; inst < get_off_stored_instances(off_pt) && get_off_num_replicas(off_pt) > 1; inst++) {
+                int *vars = get_replica_vars(off_pt, inst);
+                for (int repl = 1; repl < get_off_num_replicas(off_pt); repl++) {
+                    
+                    // REPLICA + TRANSMISSION TIME <= NEXT REPLICA
+                    int var_off[] = {vars[repl - 1], vars[repl]};
+                    double val[] = {-1, 1};
+                    
+                    sprintf(name, "PathDep_%lld", scheduler->path_con);
+                    scheduler->path_con += 1;
+                    if (solver_add_constr(2, var_off, val, solver_greater_equal, get_off_time(off_pt), name) == -1) {
                         return -1;
                     }
                 }
             }
         }
     }
-    GRBupdatemodel(model);
+    solver_update();
     
     return 0;
 }
@@ -313,6 +526,8 @@ int path_dependent(Frame *frames, int num, int accum_num) {
  */
 int end_to_end_delay(Frame *frames, int num, int accum_num) {
     
+    profile_phase(phase_end_to_end);
+    
     char name[100];
     // For all xrames, for all paths, add the constraint between the first and last link on the path
     for (int i = accum_num; (i - accum_num) < num; i++) {
@@ -320,40 +535,38 @@ int end_to_end_delay(Frame *frames, int num, int accum_num) {
             Path *path_pt = get_path(&frames[i], j);
             Offset *first_off_pt = get_offset_path_link(path_pt, 0);
             Offset *last_off_pt = get_offset_path_link(path_pt, get_num_links_path(path_pt) - 1);
-            for (int inst = 0; inst < get_off_num_instances(first_off_pt); inst ++) {
+            int last_repl = get_off_num_replicas(last_off_pt) - 1;
+            for (int inst = 0; inst < get_off_stored_instances(first_off_pt); inst ++) {
                 
-                // FIRST OFFSET + END TO END DELAY - TRANSMISSION TIME >= LAST OFFSET
+                // FIRST OFFSET + END TO END DELAY - TRANSMISSION TIME >= LAST OFFSET (its last replica)
                 long long int distance = get_end_to_end(&frames[i]) - get_off_time(first_off_pt);
-                int var_off[] = {get_var_name(first_off_pt, inst, 0), get_var_name(last_off_pt, inst, 0)};
+                int var_off[] = {get_var_name(first_off_pt, inst, 0), get_var_name(last_off_pt, inst, last_repl)};
                 double val[] = {-1, 1};
                 
-                sprintf(name, "End_%lld_1", end_con);
-                if (GRBaddconstr(model, 2, var_off, val, GRB_LESS_EQUAL, distance, name)) {
-                    printf("%s\n", GRBgeterrormsg(env));
+                sprintf(name, "End_%lld_1", scheduler->end_con);
+                if (solver_add_constr(2, var_off, val, solver_less_equal, distance, name) == -1) {
                     return -1;
                 }
                 
                 // Also add the frame intermission for the first and last offset to the starting point and deadline
                 // FIRST OFFSET >= FRAME DISTANCE + STARTING TIME
                 distance = get_starting_time(&frames[i]) + (get_period(&frames[i]) * inst);
-                var_off[1] = frame_dis[i];
+                var_off[1] = scheduler->frame_dis[i];
                 val[0] = 1; val[1] = -1;
                 
-                sprintf(name, "End_%lld_2", end_con);
-                if (GRBaddconstr(model, 2, var_off, val, GRB_GREATER_EQUAL, distance, name)) {
-                    printf("%s\n", GRBgeterrormsg(env));
+                sprintf(name, "End_%lld_2", scheduler->end_con);
+                if (solver_add_constr(2, var_off, val, solver_greater_equal, distance, name) == -1) {
                     return -1;
                 }
                 
                 // LAST OFFSET + FRAME DISTANCE <= DEADLINE
                 distance = get_deadline(&frames[i]) + (get_period(&frames[i]) * inst) - get_off_time(last_off_pt);
-                var_off[0] = get_var_name(last_off_pt, inst, 0);
+                var_off[0] = get_var_name(last_off_pt, inst, last_repl);
                 val[1] = 1;
                 
-                sprintf(name, "End_%lld_3", end_con);
-                end_con += 1;
-                if (GRBaddconstr(model, 2, var_off, val, GRB_LESS_EQUAL, distance, name)) {
-                    printf("%s\n", GRBgeterrormsg(env));
+                sprintf(name, "End_%lld_3", scheduler->end_con);
+                scheduler->end_con += 1;
+                if (solver_add_constr(2, var_off, val, solver_less_equal, distance, name) == -1) {
                     return -1;
                 }
                 
@@ -364,1058 +577,3936 @@ int end_to_end_delay(Frame *frames, int num, int accum_num) {
 }
 
 /**
- Avoid that any frame transmission collides at the same time at the same link
+ Add the constraints so two transmissions do not happen at the same time with the indicator encoding.
+ Two binary variables choose which of the transmissions goes first, and the or forces one of them to be active
 
- @param frames list of frames to create the constraint
- @param num number of frames in the list
- @param accum_num number of frames that were already created their offsets
+ @param var_off solver variable of the transmission
+ @param distance1 time slots of the transmission
+ @param var_pre_off solver variable of the previous transmission
+ @param distance2 time slots of the previous transmission
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
  @return 0 if done correctly, -1 otherwise
  */
-int contention_free(Frame *frames, int num, int accum_num) {
+int add_avoid_collision_indicator(int var_off, long long int distance1, int var_pre_off, long long int distance2,
+                                  int var_link) {
     
     char name[100];
-    // For all frames, for all its offsets, if the offsets can collide, add constraint to avoid it
-    for (int fr_it = accum_num; (fr_it - accum_num) < num; fr_it++) {
-        for (int i = 0; i < get_num_offsets(&frames[fr_it]); i++) {
-            Offset *off = get_offset_it(&frames[fr_it], i);
-            int link_id = get_link_id_offset_it(&frames[fr_it], i);
-            int link_inter = link_dis[link_id];
-            
-            // For all the frames that were added before, check if the offsets ids are the same to add the constraint
-            // Also avoid collision with the bandwith reservation if needed
-            int pre_fr_it = 0;
-            int checked_prot = 0;       // 1 if we already checked the protocol, 0 otherwise
-            SelfHealing_Protocol protocol = *get_healing_protocol();
-            if (protocol.period == 0) {
-                checked_prot = 1;
-            }
-            while (pre_fr_it < fr_it || checked_prot == 0) {
-                
-                // Get the previous frame pointer, or the bandwitdh allocation frame
-                Frame *pre_frame_pt = NULL;
-                if (checked_prot == 0) {
-                    pre_frame_pt = &protocol.reservation;
-                } else {
-                    pre_frame_pt = &frames[pre_fr_it];
-                }
-                
-                Offset *pre_off = get_offset_by_link(pre_frame_pt, link_id);
-                // If the frame has an offset with the same link, continue
-                if (pre_off != NULL) {
-                    for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                        for (int pre_inst = 0; pre_inst < get_off_num_instances(pre_off); pre_inst++) {
-                            
-                            // Check if both offsets share an interval and we need to add the constraint
-                            long long int min1 = (get_period(&frames[fr_it]) * inst) +
-                                                 (get_starting_time(&frames[fr_it]) + 1);
-                            long long int max1 = (get_period(&frames[fr_it]) * inst) +
-                                                 (get_deadline(&frames[fr_it]) + 1);
-                            long long int min2 = (get_period(pre_frame_pt) * pre_inst) +
-                                                 (get_starting_time(pre_frame_pt) + 1);
-                            long long int max2 = (get_period(pre_frame_pt) * pre_inst) +
-                                                 (get_deadline(pre_frame_pt) + 1);
-                            if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
-                                
-                                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                                    for (int pre_repl = 0; pre_repl < get_off_num_replicas(pre_off); pre_repl++) {
-                                        
-                                        long long int distance1 = get_off_time(off);
-                                        long long int distance2 = get_off_time(pre_off);
-                                        
-                                        sprintf(name, "x_%lld", x_con);
-                                        x_con += 1;
-                                        // Add two binary variables to chosse between two constraints
-                                        if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                                            printf("%s\n", GRBgeterrormsg(env));
-                                            return -1;
-                                        }
-                                        sprintf(name, "y_%lld", y_con);
-                                        y_con += 1;
-                                        if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                                            printf("%s\n", GRBgeterrormsg(env));
-                                            return -1;
-                                        }
-                                        sprintf(name, "z_%lld", z_con);
-                                        z_con += 1;
-                                        var_it += 2;
-                                        // Add binary variable to force one of both previous variables to true
-                                        if (GRBaddvar(model, 0, NULL, NULL, 0, 1, 1, GRB_BINARY, name)) {
-                                            printf("%s\n", GRBgeterrormsg(env));
-                                            return -1;
-                                        }
-                                        var_it += 1;
-                                        int ind[] = {var_it -3, var_it -2};
-                                        sprintf(name, "or_%lld", or_con);
-                                        or_con += 1;
-                                        if (GRBaddgenconstrOr(model, name, var_it - 1, 2, ind)) {
-                                            printf("%s\n", GRBgeterrormsg(env));
-                                            return -1;
-                                        }
-                                        
-                                        if (checked_prot == 0) {
-                                            // Depending of the active variable, we choose one or the other constraint
-                                            // Offset + distance1 + link_dis <= previous offset
-                                            int var[] = {get_var_name(off, inst, repl),
-                                                         get_var_name(pre_off, pre_inst, pre_repl)};
-                                            double val[] = {-1.0, 1.0};
-                                            sprintf(name, "Avoid_%lld_1", avoid_con);
-                                            if (GRBaddgenconstrIndicator(model, name, var_it - 3, 1, 2, var, val,
-                                                                         GRB_GREATER_EQUAL, distance1)) {
-                                                printf("%s\n", GRBgeterrormsg(env));
-                                                return -1;
-                                            }
-                                            // Previous offset + distance2 + link_dis <= offset
-                                            double val2[] = {1.0, -1.0};
-                                            sprintf(name, "Avoid_%lld_2", avoid_con);
-                                            avoid_con += 1;
-                                            if (GRBaddgenconstrIndicator(model, name, var_it - 2, 1, 2, var, val2,
-                                                                         GRB_GREATER_EQUAL, distance2)) {
-                                                printf("%s\n", GRBgeterrormsg(env));
-                                                return -1;
-                                            }
-
-                                        } else {
-                                            
-                                            // Depending of the active variable, we choose one or the other constraint
-                                            // Offset + distance1 + link_dis <= previous offset
-                                            int var[] = {get_var_name(off, inst, repl),
-                                                         get_var_name(pre_off, pre_inst, pre_repl),
-                                                         link_inter};
-                                            double val[] = {-1.0, 1.0, -1.0};
-                                            sprintf(name, "Avoid_%lld_1", avoid_con);
-                                            if (GRBaddgenconstrIndicator(model, name, var_it - 3, 1, 3, var, val,
-                                                                         GRB_GREATER_EQUAL, distance1)) {
-                                                printf("%s\n", GRBgeterrormsg(env));
-                                                return -1;
-                                            }
-                                            // Previous offset + distance2 + link_dis <= offset
-                                            double val2[] = {1.0, -1.0, -1.0};
-                                            sprintf(name, "Avoid_%lld_2", avoid_con);
-                                            avoid_con += 1;
-                                            if (GRBaddgenconstrIndicator(model, name, var_it - 2, 1, 3, var, val2,
-                                                                         GRB_GREATER_EQUAL, distance2)) {
-                                                printf("%s\n", GRBgeterrormsg(env));
-                                                return -1;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-                
-                // Update if we compared with the bandwidth reservation, or check the next frame
-                if (checked_prot == 0) {
-                    checked_prot = 1;
-                } else {
-                    pre_fr_it += 1;
-                }
-            }
-        }
+    
+    sprintf(name, "x_%lld", scheduler->x_con);
+    scheduler->x_con += 1;
+    // Add two binary variables to chosse between two constraints
+    if (solver_add_var(0, 0, 1, solver_binary, name) == -1) {
+        return -1;
+    }
+    sprintf(name, "y_%lld", scheduler->y_con);
+    scheduler->y_con += 1;
+    if (solver_add_var(0, 0, 1, solver_binary, name) == -1) {
+        return -1;
+    }
+    sprintf(name, "z_%lld", scheduler->z_con);
+    scheduler->z_con += 1;
+    scheduler->var_it += 2;
+    // Add binary variable to force one of both previous variables to true
+    if (solver_add_var(0, 1, 1, solver_binary, name) == -1) {
+        return -1;
+    }
+    scheduler->var_it += 1;
+    int ind[] = {scheduler->var_it -3, scheduler->var_it -2};
+    sprintf(name, "or_%lld", scheduler->or_con);
+    scheduler->or_con += 1;
+    if (solver_add_or(scheduler->var_it - 1, 2, ind, name) == -1) {
+        return -1;
+    }
+    
+    // Depending of the active variable, we choose one or the other constraint
+    // Offset + distance1 + link_dis <= previous offset
+    int num_var = var_link == -1 ? 2 : 3;
+    int var[] = {var_off, var_pre_off, var_link};
+    double val[] = {-1.0, 1.0, -1.0};
+    sprintf(name, "Avoid_%lld_1", scheduler->avoid_con);
+    if (solver_add_indicator(scheduler->var_it - 3, 1, num_var, var, val, solver_greater_equal, distance1,
+                             name) == -1) {
+        return -1;
     }
-    GRBupdatemodel(model);
+    // Previous offset + distance2 + link_dis <= offset
+    double val2[] = {1.0, -1.0, -1.0};
+    sprintf(name, "Avoid_%lld_2", scheduler->avoid_con);
+    scheduler->avoid_con += 1;
+    if (solver_add_indicator(scheduler->var_it - 2, 1, num_var, var, val2, solver_greater_equal, distance2,
+                             name) == -1) {
+        return -1;
+    }
+    
     return 0;
 }
 
 /**
- Save the obtained transmission times from the solver in the frames, also if needed, fix them into the solver
+ Add the constraints so two transmissions do not happen at the same time with the big-M encoding.
+ One binary variable chooses which of the transmissions goes first, and the other constraint is relaxed by a big-M
+ obtained from the bounds of both transmissions. The link distance is never larger than the span of both windows, as
+ the constraint that is active bounds it
 
- @param frames list of frames to create the constraint
- @param num number of frames in the list
- @param accum_num number of frames that were already created their offsets
+ @param var_off solver variable of the transmission
+ @param distance1 time slots of the transmission
+ @param lb1 lower bound of the transmission
+ @param ub1 upper bound of the transmission
+ @param var_pre_off solver variable of the previous transmission
+ @param distance2 time slots of the previous transmission
+ @param lb2 lower bound of the previous transmission
+ @param ub2 upper bound of the previous transmission
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
  @return 0 if done correctly, -1 otherwise
  */
-int save_offsets(Frame *frames, int num, int accum_num) {
+int add_avoid_collision_big_m(int var_off, long long int distance1, long long int lb1, long long int ub1,
+                              int var_pre_off, long long int distance2, long long int lb2, long long int ub2,
+                              int var_link) {
     
     char name[100];
     
-    // Iterate over all the given frames and their given offsets
-    for (int i = accum_num; (i - accum_num) < num; i++) {
-        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
-            Offset *off = get_offset_it(&frames[i], j);
-            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                    // Get the transmission time from the model and write it in the offset memory
-                    double trans_time;
-                    if (GRBgetdblattrelement(model, GRB_DBL_ATTR_X, get_var_name(off, inst, repl), &trans_time)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    set_trans_time(off, inst, repl, (long long int) trans_time);
-                    
-                    // Fix the transmission time in the model
-                    sprintf(name, "Fix_%lld", fix_con);
-                    int ind[] = {get_var_name(off, inst, repl)};
-                    double val[] = {1.0};
-                    if (GRBaddconstr(model, 1, ind, val, GRB_EQUAL, trans_time, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    fix_con += 1;
-                }
-            }
-        }
-        // Remove the objective from the scheduled frame
-        GRBsetdblattrelement(model, GRB_DBL_ATTR_OBJ, frame_dis[i], 0.0);
+    // Binary variable that is 1 if the transmission goes before the previous one
+    sprintf(name, "x_%lld", scheduler->x_con);
+    scheduler->x_con += 1;
+    if (solver_add_var(0, 0, 1, solver_binary, name) == -1) {
+        return -1;
+    }
+    int var_order = scheduler->var_it;
+    scheduler->var_it += 1;
+    
+    long long int max_link = 0;
+    if (var_link != -1) {
+        max_link = (ub1 + distance1 > ub2 + distance2 ? ub1 + distance1 : ub2 + distance2) - (lb1 < lb2 ? lb1 : lb2);
+    }
+    long long int big_m1 = distance1 + ub1 - lb2 + max_link;
+    long long int big_m2 = distance2 + ub2 - lb1 + max_link;
+    
+    // Offset + distance1 + link_dis <= previous offset + M1 * (1 - x)
+    int num_var = var_link == -1 ? 3 : 4;
+    int var[] = {var_off, var_pre_off, var_order, var_link};
+    double val[] = {-1.0, 1.0, (double) -big_m1, -1.0};
+    sprintf(name, "Avoid_%lld_1", scheduler->avoid_con);
+    if (solver_add_constr(num_var, var, val, solver_greater_equal, distance1 - big_m1, name) == -1) {
+        return -1;
+    }
+    // Previous offset + distance2 + link_dis <= offset + M2 * x
+    double val2[] = {1.0, -1.0, (double) big_m2, -1.0};
+    sprintf(name, "Avoid_%lld_2", scheduler->avoid_con);
+    scheduler->avoid_con += 1;
+    if (solver_add_constr(num_var, var, val2, solver_greater_equal, distance2, name) == -1) {
+        return -1;
     }
     
     return 0;
 }
 
 /**
- Check if the schedule obtained violates any of the constraints.
- It is useful in the case of more complex algorithms that obtain the schedule in steps and a bug might slip
+ Add the constraints so two transmissions do not happen at the same time, with the encoding chosen
 
- @param frames list of frames to create the constraint
- @param num number of frames in the list
- @return 0 if the schedule is correct, -1 if any constraint is violated
+ @param var_off solver variable of the transmission
+ @param distance1 time slots of the transmission
+ @param lb1 lower bound of the transmission
+ @param ub1 upper bound of the transmission
+ @param var_pre_off solver variable of the previous transmission
+ @param distance2 time slots of the previous transmission
+ @param lb2 lower bound of the previous transmission
+ @param ub2 upper bound of the previous transmission
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
+ @return 0 if done correctly, -1 otherwise
  */
-int check_schedule(Frame *frames, int num) {
+int add_avoid_collision(int var_off, long long int distance1, long long int lb1, long long int ub1, int var_pre_off,
+                        long long int distance2, long long int lb2, long long int ub2, int var_link) {
     
-    SelfHealing_Protocol *protocol = get_healing_protocol();
+    if (scheduler->encoding == big_m_encoding) {
+        return add_avoid_collision_big_m(var_off, distance1, lb1, ub1, var_pre_off, distance2, lb2, ub2, var_link);
+    }
+    return add_avoid_collision_indicator(var_off, distance1, var_pre_off, distance2, var_link);
+}
+
+/**
+ Avoid that the transmissions of two offsets in the same link collide.
+ The instance windows of both frames are sorted by start, so we sweep them together and only the instances whose
+ windows overlap are compared
+
+ @param frame_pos position of the frame of the offset in the view of the traffic
+ @param off pointer to the offset
+ @param pre_frame_pos position of the frame of the previous offset in the view of the traffic
+ @param pre_off pointer to the previous offset
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
+ @return 0 if done correctly, -1 otherwise
+ */
+int avoid_collision_offsets(int frame_pos, Offset *off, int pre_frame_pos, Offset *pre_off, int var_link) {
     
-    // Iterate over all the frames to check their constriants
-    for (int i = 0; i < num; i++) {
+    Traffic_View *view = scheduler->view;
+    long long int period = get_view_period(view, frame_pos), pre_period = get_view_period(view, pre_frame_pos);
+    long long int starting = get_view_starting(view, frame_pos), pre_starting = get_view_starting(view, pre_frame_pos);
+    long long int deadline = get_view_deadline(view, frame_pos), pre_deadline = get_view_deadline(view, pre_frame_pos);
+    int num_replicas = get_off_num_replicas(off), num_pre_replicas = get_off_num_replicas(pre_off);
+    int time = get_off_time(off), pre_time = get_off_time(pre_off);
+    int num_instances = get_off_num_instances(off), num_pre_instances = get_off_num_instances(pre_off);
+    int first_pre_inst = 0;
+    for (int inst = 0; inst < num_instances; inst++) {
         
-        // Check if the transmission times are between their limits
-        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
-            Offset *off = get_offset_it(&frames[i], j);
-            int link_id = get_link_id_offset_it(&frames[i], j);
-            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                    
-                    long long int trans_time = get_trans_time(off, inst, repl);
-                    long long int lb = (get_period(&frames[i]) * inst) + get_starting_time(&frames[i]);
-                    long long int ub = (get_period(&frames[i]) * inst) + get_deadline(&frames[i]) - get_off_time(off);
-                    if (trans_time < lb) {
-                        fprintf(stderr, "The transmission time of frame %d link %d is smaller than should be\n",
-                                get_frame_id(i), get_link_id_offset_it(&frames[i], j));
-                        return -1;
-                    }
-                    if (trans_time > ub) {
-                        fprintf(stderr, "The transmission time of frame %d link %d is larger than should be\n",
-                                get_frame_id(i), get_link_id_offset_it(&frames[i], j));
-                        return -1;
-                    }
-                }
-            }
-            
-            // Also check if the frame collides with the bandwidth allocation protocol
-            if (protocol->period != 0) {
-                for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                    for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                        
-                        long long int trans_time = get_trans_time(off, inst, repl);
-                        long long int end_time = get_off_time(off) + get_off_time(off);
-                        Offset *prot_off = get_offset_by_link(&protocol->reservation, link_id);
-                        for (int prot_inst = 0; prot_inst < get_off_num_instances(prot_off); prot_inst++) {
-                            
-                            long long int prot_trans_time = get_trans_time(prot_off, prot_inst, 0);
-                            long long int end_time2 = prot_trans_time + get_off_time(prot_off);
-                            
-                            
-                            if ((prot_trans_time < end_time) && (trans_time < end_time2)) {
-                                fprintf(stderr, "The frame %d collides with the protocol in link %d\n",
-                                        get_frame_id(i), link_id);
-                                return -1;
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // Check if the transmissions in the same link of different frames collide
-            for (int pre_fr_it = 0; pre_fr_it < i; pre_fr_it++) {
-
-                Offset *pre_off = get_offset_by_link(&frames[pre_fr_it], link_id);
-                // If the frame has an offset with the same link, continue
-                if (pre_off != NULL) {
-                    
-                    
-                    for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                        for (int pre_inst = 0; pre_inst < get_off_num_instances(pre_off); pre_inst++) {
-                            for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                                for (int pre_repl = 0; pre_repl < get_off_num_replicas(pre_off); pre_repl++) {
-                                    
-                                    long long int trans_time = get_trans_time(off, inst, repl);
-                                    long long int pre_trans_time = get_trans_time(pre_off, pre_inst, pre_repl);
-                                    long long int end_time = trans_time + get_off_time(off) - 1;
-                                    long long int end_time2 = pre_trans_time + get_off_time(pre_off) - 1;
-                                    
-                                    if ((pre_trans_time < end_time) && (trans_time < end_time2)) {
-                                        fprintf(stderr, "The frames %d and %d collide in link %d\n",
-                                                get_frame_id(i), get_frame_id(pre_fr_it), link_id);
-                                        return -1;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        // Window of the instance where the transmission can happen
+        long long int min1 = (period * inst) + (starting + 1);
+        long long int max1 = (period * inst) + (deadline + 1);
+        
+        // The previous instances that finished before this window also finish before the next windows
+        while (first_pre_inst < num_pre_instances && (pre_period * first_pre_inst) + (pre_deadline + 1) <= min1) {
+            first_pre_inst++;
         }
         
-        // Check if the paths are correctly followed and the end to end delay is satisfied
-        for (int j = 0; j < get_num_paths(&frames[i]); j++) {
-            Path *path_pt = get_path(&frames[i], j);
-            for (int h = 0; h < get_num_links_path(path_pt) - 1; h++) {
-                Offset *off = get_offset_path_link(path_pt, h);
-                Offset *next_off = get_offset_path_link(path_pt, h + 1);
-                for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                    for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                        
-                        long long int distance = get_off_time(off) + get_switch_min_time();
-                        long long int trans_time = get_trans_time(off, inst, repl);
-                        long long int next_trans_time = get_trans_time(next_off, inst, repl);
-                        if ((next_trans_time - trans_time) < distance) {
-                            fprintf(stderr, "The distances of the path of frame %d is wrong\n", get_frame_id(i));
+        for (int pre_inst = first_pre_inst; pre_inst < num_pre_instances; pre_inst++) {
+            
+            // Check if both offsets share an interval and we need to add the constraint
+            long long int min2 = (pre_period * pre_inst) + (pre_starting + 1);
+            long long int max2 = (pre_period * pre_inst) + (pre_deadline + 1);
+            // The rest of previous instances start after this window
+            if (min2 >= max1) {
+                break;
+            }
+            if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
+                int *vars = get_replica_vars(off, inst);
+                int *pre_vars = get_replica_vars(pre_off, pre_inst);
+                for (int repl = 0; repl < num_replicas; repl++) {
+                    for (int pre_repl = 0; pre_repl < num_pre_replicas; pre_repl++) {
+                        // Same bounds as the offset variables
+                        long long int lb1 = min1 - 1 + (repl * time);
+                        long long int ub1 = max1 - 1 - ((num_replicas - repl) * time);
+                        long long int lb2 = min2 - 1 + (pre_repl * pre_time);
+                        long long int ub2 = max2 - 1 - ((num_pre_replicas - pre_repl) * pre_time);
+                        if (add_avoid_collision(vars[repl], time, lb1, ub1, pre_vars[pre_repl], pre_time, lb2, ub2,
+                                                var_link) == -1) {
                             return -1;
                         }
                     }
                 }
             }
-            // Check the first and last links in the path for the end to end delay constraint
-            Offset *off = get_offset_path_link(path_pt, 0);
-            Offset *last_off = get_offset_path_link(path_pt, get_num_links_path(path_pt) - 1);
-            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                    
-                    long long int distance = get_end_to_end(&frames[i]) - get_off_time(off) + 1;
-                    long long int trans_time = get_trans_time(off, inst, repl);
-                    long long int last_trans_time = get_trans_time(last_off, inst, repl);
-                    if ((last_trans_time - trans_time) > distance) {
-                        fprintf(stderr, "The end to end delay of frame %d is wrong\n", get_frame_id(i));
-                        return -1;
-                    }
-                }
-            }
         }
     }
     
     return 0;
 }
 
-/* Patch functions */
+/**
+ Get the greatest common divisor of two periods
+
+ @param a first period
+ @param b second period
+ @return the greatest common divisor of a and b
+ */
+long long int gcd_periods(long long int a, long long int b) {
+    
+    while (b != 0) {
+        long long int rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
 
 /**
- Insert a fixed transmission to the list of link transmissions
+ Add the constraints so two strictly periodic transmissions do not collide in any of their instances.
+ All the instances of both transmissions meet with a distance that is a multiple of the gcd of their periods, so it
+ is enough that the first instances do not collide modulo the gcd. An integer variable q gives the multiple:
+ distance2 <= off - pre_off - gcd * q and off - pre_off - gcd * q + distance1 <= gcd
 
- @param head head to the link transmissions
- @param transmission_time starting time transmissions
- @param ending_time ending time transmission
- @return the new pointer to the head
+ @param var_off solver variable of the first instance of the transmission
+ @param distance1 time slots of the transmission
+ @param period1 period of the transmission
+ @param var_pre_off solver variable of the first instance of the previous transmission
+ @param distance2 time slots of the previous transmission
+ @param period2 period of the previous transmission
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
+ @return 0 if done correctly, -1 otherwise
  */
-LS_Transmission* insert_fixed_trans(LS_Transmission *head, long long int transmission_time, long long int ending_time) {
+int add_avoid_collision_periodic(int var_off, long long int distance1, long long int period1, int var_pre_off,
+                                 long long int distance2, long long int period2, int var_link) {
     
-    LS_Transmission *next_pt, *prev_pt;
+    char name[100];
+    long long int gcd_num = gcd_periods(period1, period2);
     
-    // Create the transmission block
-    LS_Transmission *trans_pt = malloc(sizeof(LS_Transmission));
-    trans_pt->starting = transmission_time;
-    trans_pt->ending = ending_time;
-    trans_pt->next_transmission = NULL;
+    // Both offsets are inside the hyperperiod, so the multiple is bounded by it
+    long long int max_q = (get_hyperperiod() / gcd_num) + 1;
+    sprintf(name, "q_%lld", scheduler->per_con);
+    if (solver_add_var(0, -max_q, max_q, solver_integer, name) == -1) {
+        return -1;
+    }
+    int var_q = scheduler->var_it;
+    scheduler->var_it += 1;
     
-    // If the head is not initialized, do it and add the block
-    if (head == NULL) {
-        head = trans_pt;
-    } else {
-        next_pt = head;
-        prev_pt = NULL;
-        // Search until the starting time is larger
-        while (next_pt && next_pt->starting <= trans_pt->starting) {
-            prev_pt = next_pt;
-            next_pt = next_pt->next_transmission;
-        }
-        // If is the last, add it at the end
-        if (next_pt == NULL) {
-            prev_pt->next_transmission = trans_pt;
-        // If not, it was in the middle, so add it in between
-        } else {
-            if (prev_pt) {
-                trans_pt->next_transmission = prev_pt->next_transmission;
-                prev_pt->next_transmission = trans_pt;
-            } else {
-                trans_pt->next_transmission = head;
-                head = trans_pt;
+    // Offset - previous offset - gcd * q - link_dis >= distance2
+    int num_var = var_link == -1 ? 3 : 4;
+    int var[] = {var_off, var_pre_off, var_q, var_link};
+    double val[] = {1.0, -1.0, (double) -gcd_num, -1.0};
+    sprintf(name, "Per_%lld_1", scheduler->per_con);
+    if (solver_add_constr(num_var, var, val, solver_greater_equal, distance2, name) == -1) {
+        return -1;
+    }
+    // Offset - previous offset - gcd * q + link_dis <= gcd - distance1
+    double val2[] = {1.0, -1.0, (double) -gcd_num, 1.0};
+    sprintf(name, "Per_%lld_2", scheduler->per_con);
+    scheduler->per_con += 1;
+    if (solver_add_constr(num_var, var, val2, solver_less_equal, gcd_num - distance1, name) == -1) {
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Avoid that the transmissions of a strictly periodic offset collide with another offset in the same link.
+ Only the first instances of both offsets are compared, as the rest of instances repeat with their periods
+
+ @param frame_pos position of the frame of the offset in the view of the traffic
+ @param off pointer to the offset
+ @param pre_frame_pos position of the frame of the previous offset in the view of the traffic
+ @param pre_off pointer to the previous offset
+ @param var_link solver variable of the link distance, -1 if the link distance is not taken into account
+ @return 0 if done correctly, -1 otherwise
+ */
+int avoid_collision_periodic(int frame_pos, Offset *off, int pre_frame_pos, Offset *pre_off, int var_link) {
+    
+    long long int period = get_view_period(scheduler->view, frame_pos);
+    long long int pre_period = get_view_period(scheduler->view, pre_frame_pos);
+    int *vars = get_replica_vars(off, 0);
+    int *pre_vars = get_replica_vars(pre_off, 0);
+    for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+        for (int pre_repl = 0; pre_repl < get_off_num_replicas(pre_off); pre_repl++) {
+            if (add_avoid_collision_periodic(vars[repl], get_off_time(off), period, pre_vars[pre_repl],
+                                             get_off_time(pre_off), pre_period, var_link) == -1) {
+                return -1;
             }
         }
     }
-    return head;
+    
+    return 0;
 }
 
 /**
- Allocate a new offset in the linked list
+ Avoid that a transmission collides with the reserved intervals of its link.
+ The transmission has to fit completely in one of the free gaps of its window, if there is more than one gap a binary
+ variable chooses the gap. The link distance is kept from the reserved intervals at both sides of the gap
 
- @param off_pt pointer to the offset to allocate
- @param instance number of instance
- @param head pointer to the head of the linked list transmission
- @param min minimum possible transmission time
- @param max maximum possible transmission time
- @param time_slots time slots
- @return the head pointer or null if the offset could not be patched
+ @param var_off solver variable of the transmission
+ @param lb first time slot where the transmission can start
+ @param ub last time slot where the transmission can start
+ @param time_slots time slots of the transmission
+ @param timeline_pt pointer to the timeline with the reserved intervals
+ @param var_link solver variable of the link distance
+ @return 0 if done correctly, -1 otherwise
  */
-LS_Transmission* allocate_offset_patch(Offset *off_pt, int instance, LS_Transmission *head, long long int min,
-                                       long long int max, int time_slots) {
+int avoid_reserved_intervals(int var_off, long long int lb, long long int ub, int time_slots, Timeline *timeline_pt,
+                             int var_link) {
     
-    LS_Transmission *next_pt, *prev_pt;
-    int found = 0;
+    char name[100];
     
-    // Create the transmission block
-    LS_Transmission *trans_pt = malloc(sizeof(LS_Transmission));
-    trans_pt->starting = min;
-    trans_pt->ending = min + time_slots - 1;
-    trans_pt->next_transmission = NULL;
+    // Count the gaps where the transmission fits
+    int num_gaps = 0;
+    long long int starting = first_fit_timeline(timeline_pt, lb, time_slots);
+    while (starting != -1 && starting <= ub) {
+        num_gaps++;
+        starting = first_fit_timeline(timeline_pt, get_free_until(timeline_pt, starting) + 1, time_slots);
+    }
+    if (num_gaps == 0) {
+        fprintf(stderr, "The transmission does not fit in any free gap of the link\n");
+        return -1;
+    }
     
-    // If the head is not initialized, do it and add the block
-    if (head == NULL) {
-        head = trans_pt;
-    } else {
-        next_pt = head;
-        prev_pt = NULL;
-        // Iterate over all the linked list
-        while (next_pt && found == 0) {
-            
-            // If it fits, add it
-            if (trans_pt->ending < next_pt->starting) {
-                found = 1;
-            // If not, update the transmission times
-            } else {
-                // Update starting time only if is larger than the minimum available
-                if (next_pt-> ending > min) {
-                    trans_pt->starting = next_pt->ending + 1;
-                    trans_pt->ending = trans_pt->starting + time_slots - 1;
-                    // If it goes over the maximum, we could not patch
-                    if (trans_pt->starting > max) {
-                        free(trans_pt);
-                        return NULL;
-                    }
-                }
-                
-                // Prepare pointers for the next iteration
-                prev_pt = next_pt;
-                next_pt = next_pt->next_transmission;
+    // If there is a single gap, the transmission is just bounded by it
+    int first_var = scheduler->var_it;
+    starting = first_fit_timeline(timeline_pt, lb, time_slots);
+    while (starting != -1 && starting <= ub) {
+        long long int ending = get_free_until(timeline_pt, starting);
+        int var_gap = -1;
+        if (num_gaps > 1) {
+            sprintf(name, "Gap_%lld", scheduler->gap_con);
+            if (solver_add_var(0, 0, 1, solver_binary, name) == -1) {
+                return -1;
             }
+            var_gap = scheduler->var_it;
+            scheduler->var_it += 1;
         }
         
-        // If is the last, add it at the end
-        if (next_pt == NULL) {
-            prev_pt->next_transmission = trans_pt;
-            // If not, it was in the middle, so add it in between
-        } else {
-            if (prev_pt) {
-                trans_pt->next_transmission = prev_pt->next_transmission;
-                prev_pt->next_transmission = trans_pt;
-            } else {
-                trans_pt->next_transmission = head;
-                head = trans_pt;
-            }
+        // OFFSET - LINK DISTANCE >= GAP START (the start of the window is not a reserved interval)
+        int var[] = {var_off, var_link};
+        double val[] = {1.0, starting > lb ? -1.0 : 0.0};
+        sprintf(name, "GapIn_%lld_1", scheduler->gap_con);
+        if ((var_gap == -1 && solver_add_constr(2, var, val, solver_greater_equal, starting, name) == -1) ||
+            (var_gap != -1 && solver_add_indicator(var_gap, 1, 2, var, val, solver_greater_equal, starting,
+                                                   name) == -1)) {
+            return -1;
         }
-        // Allocate the transmission to the offset
-        set_trans_time(off_pt, instance, 0, trans_pt->starting);
+        // OFFSET + TRANSMISSION TIME + LINK DISTANCE <= GAP END + 1 (the end of the window is not a reserved interval)
+        double val2[] = {1.0, ending < ub + time_slots - 1 ? 1.0 : 0.0};
+        sprintf(name, "GapIn_%lld_2", scheduler->gap_con);
+        scheduler->gap_con += 1;
+        if ((var_gap == -1 &&
+             solver_add_constr(2, var, val2, solver_less_equal, ending - time_slots + 1, name) == -1) ||
+            (var_gap != -1 && solver_add_indicator(var_gap, 1, 2, var, val2, solver_less_equal,
+                                                   ending - time_slots + 1, name) == -1)) {
+            return -1;
+        }
+        
+        starting = first_fit_timeline(timeline_pt, ending + 1, time_slots);
     }
     
-    return head;
+    // Only one of the gaps is chosen
+    if (num_gaps > 1) {
+        int *var_gaps = malloc(sizeof(int) * num_gaps);
+        double *val_gaps = malloc(sizeof(double) * num_gaps);
+        for (int i = 0; i < num_gaps; i++) {
+            var_gaps[i] = first_var + i;
+            val_gaps[i] = 1.0;
+        }
+        sprintf(name, "GapOne_%lld", scheduler->gap_con);
+        int error = solver_add_constr(num_gaps, var_gaps, val_gaps, solver_equal, 1.0, name);
+        free(var_gaps);
+        free(val_gaps);
+        if (error == -1) {
+            return -1;
+        }
+    }
+    
+    return 0;
 }
 
 /**
- Prepare the fixed traffic and load it into the sorted list of the link transmissions
+ Add the transmissions of the given frames to the reserved intervals of their links
 
- @param frames pointer to the frames to fix
- @param num number of frames to fix
- @return 0 if done corretly, -1 otherwise
+ @param frames list of frames to reserve
+ @param num number of frames in the list
+ @param accum_num number of frames that were already reserved
+ @return 0 if done correctly, -1 otherwise
  */
-int prepare_fixed_traffic(Frame *frames, int num) {
+int reserve_offsets(Frame *frames, int num, int accum_num) {
     
-    // For all the fixed frames, add them into the linked list
-    for (int fr_it = 0; fr_it < num; fr_it++) {
-        // The fixed traffic only has one offset
-        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
-        int time_slots = get_off_time(off_pt);
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            long long int trans_time = get_trans_time(off_pt, inst, 0);
-            sorted_trans = insert_fixed_trans(sorted_trans, trans_time, trans_time + time_slots);
-        }
-    }
+    profile_phase(phase_presolve);
     
-    // Also add the self healing protocol bandwith reservation
-    SelfHealing_Protocol protocol = *get_healing_protocol();
-    int instances_protocol = (int)(get_hyperperiod() / protocol.period);
-    for (int i = 0; i < instances_protocol; i++) {
-        int trans_time = (int)(protocol.period * i);
-        sorted_trans = insert_fixed_trans(sorted_trans, trans_time, trans_time + protocol.time);
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
+            Offset *off = get_offset_it(&frames[i], j);
+            Timeline *timeline_pt = &scheduler->link_timelines[get_link_id_offset_it(&frames[i], j)];
+            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                    long long int trans_time = get_trans_time(off, inst, repl);
+                    if (occupy_timeline(timeline_pt, trans_time, trans_time + get_off_time(off) - 1) == -1) {
+                        return -1;
+                    }
+                }
+            }
+        }
     }
     
     return 0;
 }
 
 /**
- Allocate the traffic in the available slots left by the dixed offsets
- 
- @param frames pointer to the frames to allocate
- @param num number of frames to fix
- @return 0 if done corretly, -1 otherwise
+ Add the intervals of all the transmissions of an offset to the lists of a no-overlap constraint.
+ The instances of a strictly periodic offset share the variable of the first one, shifted by the period
+
+ @param off pointer to the offset
+ @param start_var list of the solver variables where the intervals start
+ @param shift list of the time slots added to the variables to get the start
+ @param length list of the time slots of the intervals
+ @param num number of intervals already in the lists
+ @return number of intervals in the lists with the ones of the offset
  */
-int allocate_patch_traffic(Frame *frames, int num) {
+int add_offset_intervals(Offset *off, int *start_var, long long int *shift, long long int *length, int num) {
     
-    for (int fr_it = 0; fr_it < num; fr_it++) {
-        // The fixed traffic only has one offset
-        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
-        int time_slots = get_off_time(off_pt);
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            long long int min = get_min_trans_time(off_pt, inst, 0);
-            long long int max = get_max_trans_time(off_pt, inst, 0);
-            sorted_trans = allocate_offset_patch(off_pt, inst, sorted_trans, min, max, time_slots);
-            // If it returns null, we failed to patch
-            if (sorted_trans == NULL) {
-                fprintf(stderr, "A frame could not be patched\n");
-                return -1;
-            }
+    for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+        for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+            start_var[num] = get_var_name(off, inst, repl);
+            shift[num] = get_off_period(off) * inst;
+            length[num] = get_off_time(off);
+            num++;
         }
     }
     
-    return 0;
+    return num;
 }
 
 /**
- Add traffic with fixed transmission to the solver
+ Add the no-overlap constraints of a link. The frames keep the link distance between them, but not with the
+ reservation of the protocol, so if there are reserved intervals a second constraint covers all the intervals
 
- @param frames pointer to the frames to allocate
- @param num number of frames to fix
- @return 0 if done corretly, -1 otherwise
+ @param start_var list of the solver variables where the intervals start, the ones of the frames go first
+ @param shift list of the time slots added to the variables to get the start
+ @param length list of the time slots of the intervals
+ @param num_frames number of intervals of the frames
+ @param num number of intervals, with the frames and the reservation
+ @param var_link solver variable of the link distance
+ @return 0 if done correctly, -1 otherwise
  */
-int add_fixed_traffic(Frame *frames, int num) {
+int add_no_overlap_link(int *start_var, long long int *shift, long long int *length, int num_frames, int num,
+                        int var_link) {
     
     char name[100];
-    
-    // For all the fixed frames, add them into the solver with a fixed range
-    for (int fr_it = 0; fr_it < num; fr_it++) {
-        // The fixed traffic only has one offset
-        int frame_id = get_frame_id(fr_it);
-        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
-        // Fix the transmission time in the model
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            sprintf(name, "Fix_Off_%d_%d", frame_id, inst);
-            long long int trans_time = get_trans_time(off_pt, inst, 0);
-            
-            if (GRBaddvar(model, 0, NULL, NULL, 0, trans_time, trans_time, GRB_INTEGER, name)) {
-                printf("%s\n", GRBgeterrormsg(env));
-                return -1;
-            }
-            set_var_name(off_pt, inst, 0, var_it);
-            var_it += 1;
-        }
+    sprintf(name, "NoOverlap_%lld", scheduler->noo_con);
+    scheduler->noo_con += 1;
+    if (solver_add_no_overlap(num_frames, start_var, shift, length, var_link, name) == -1) {
+        return -1;
     }
     
-    // Add all the variables for the self-healing protocol if it exists
-    SelfHealing_Protocol *shp = get_healing_protocol();
-    int instances_protocol = (int)(get_hyperperiod() / shp->period);
-    var_shp_optimize = malloc(sizeof(int) * instances_protocol);
-    for (int i = 0; i < instances_protocol; i++) {
-        int trans_time = (int)(shp->period * i);
-        sprintf(name, "SHP_%d", i);
-        if (GRBaddvar(model, 0, NULL, NULL, 0, trans_time, trans_time, GRB_INTEGER, name)) {
-            printf("%s\n", GRBgeterrormsg(env));
+    if (num > num_frames) {
+        sprintf(name, "NoOverlap_%lld", scheduler->noo_con);
+        scheduler->noo_con += 1;
+        if (solver_add_no_overlap(num, start_var, shift, length, -1, name) == -1) {
             return -1;
         }
-        var_shp_optimize[i] = var_it;
-        var_it += 1;
     }
     
-    GRBupdatemodel(model);
-    
     return 0;
 }
 
 /**
- Add traffic to the solver with the avaiable range
- 
- @param frames pointer to the frames to allocate
- @param num number of frames to fix
+ Avoid that the transmissions collide with a no-overlap constraint for each link, instead of a disjunction for each
+ pair of transmissions. It covers the frames added in this iteration and, without the presolve, the ones added before
+ and the reservation of the protocol, as the presolve already reserves their intervals
+
+ @param num number of frames added in this iteration
  @param accum_num number of frames that were already created their offsets
- @return 0 if done corretly, -1 otherwise
+ @return 0 if done correctly, -1 otherwise
  */
-int add_traffic_optimize(Frame *frames, int num, int accum_num) {
+int no_overlap_links(int num, int accum_num) {
     
-    char name[100];
+    SelfHealing_Protocol *protocol = get_healing_protocol();
     
-    // For all the fixed frames, add them into the solver with a fixed range
-    for (int i = accum_num; (i - accum_num) < num; i++) {
-        int frame_id = get_frame_id(i);
-        Offset *off_pt = get_offset_it(&frames[i], 0);
-        // Fix the transmission time in the model
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            sprintf(name, "Off_%d_%d", frame_id, inst);
-            long long int lb = get_min_trans_time(off_pt, inst, 0);
-            long long int ub = get_max_trans_time(off_pt, inst, 0);
-            if (GRBaddvar(model, 0, NULL, NULL, 0, lb, ub, GRB_INTEGER, name)) {
-                printf("%s\n", GRBgeterrormsg(env));
-                return -1;
+    for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+        
+        // Count the transmissions of the link, they are sorted by the position of their frames
+        Link_Offset *link_off = get_link_offsets(link_id);
+        int first = scheduler->presolve == 1 ? accum_num : 0;
+        int num_frames = 0;
+        int new_frames = 0;
+        for (int j = 0; j < get_num_link_offsets(link_id) && link_off[j].frame_pos < accum_num + num; j++) {
+            if (link_off[j].frame_pos >= first) {
+                num_frames += get_off_num_instances(link_off[j].offset_pt) *
+                              get_off_num_replicas(link_off[j].offset_pt);
+                new_frames |= link_off[j].frame_pos >= accum_num;
+            }
+        }
+        // If no frame of this iteration uses the link, the constraints of previous iterations already cover it
+        if (new_frames == 0) {
+            continue;
+        }
+        
+        Offset *pre_off = NULL;
+        if (scheduler->presolve == 0 && protocol->period != 0) {
+            pre_off = get_offset_by_link(&protocol->reservation, link_id);
+        }
+        int num_reserved = pre_off != NULL ? get_off_num_instances(pre_off) * get_off_num_replicas(pre_off) : 0;
+        
+        int *start_var = malloc(sizeof(int) * (num_frames + num_reserved));
+        long long int *shift = malloc(sizeof(long long int) * (num_frames + num_reserved));
+        long long int *length = malloc(sizeof(long long int) * (num_frames + num_reserved));
+        if (start_var == NULL || shift == NULL || length == NULL) {
+            fprintf(stderr, "Not enough memory to avoid the collisions of the link %d\n", link_id);
+            free(start_var);
+            free(shift);
+            free(length);
+            return -1;
+        }
+        
+        int it = 0;
+        for (int j = 0; j < get_num_link_offsets(link_id) && link_off[j].frame_pos < accum_num + num; j++) {
+            if (link_off[j].frame_pos >= first) {
+                it = add_offset_intervals(link_off[j].offset_pt, start_var, shift, length, it);
             }
-            set_var_name(off_pt, inst, 0, var_it);
-            var_it += 1;
+        }
+        if (pre_off != NULL) {
+            it = add_offset_intervals(pre_off, start_var, shift, length, it);
+        }
+        
+        int result = add_no_overlap_link(start_var, shift, length, num_frames, it, scheduler->link_dis[link_id]);
+        free(start_var);
+        free(shift);
+        free(length);
+        if (result == -1) {
+            return -1;
         }
     }
     
-    GRBupdatemodel(model);
-    
     return 0;
 }
 
 /**
- Init the variables that maximize the distances between transmission of frames and the link for the optimize
- 
- @param frames list of frames to create the contraint
+ Avoid that any frame transmission collides at the same time at the same link
+
+ @param frames list of frames to create the constraint
  @param num number of frames in the list
  @param accum_num number of frames that were already created their offsets
- @param it iteration for creating the link intermission differently for each iteration
  @return 0 if done correctly, -1 otherwise
  */
-int create_intermission_variables_optimize(Frame *frames, int num, int accum_num, int it) {
-    
-    char name[100];
+int contention_free(Frame *frames, int num, int accum_num) {
     
-    // If link distances were init, remove the obj from them
-    if (link_dis != NULL) {
-        GRBsetdblattrelement(model, GRB_DBL_ATTR_OBJ, link_dis[0], 0.0);
-    }
+    profile_phase(phase_collision);
     
-    // Allocate to save the frame and link distances variables
-    frame_dis = realloc(frame_dis, sizeof(int) * (accum_num + num));
-    link_dis = malloc(sizeof(int));
+    SelfHealing_Protocol *protocol = get_healing_protocol();
+    Traffic_View *view = scheduler->view;
+    int reservation_pos = view->num_frames;
     
-    // Create all the frame intermissions
-    for (int i = accum_num; (i - accum_num) < num; i++) {
-        sprintf(name, "FrameDis_%d", get_frame_id(i));
-        
-        // Calculate the maximum distance the frame could have
-        Offset *off_pt = get_offset_it(&frames[i], 0);
-        long long int max_distance = get_max_trans_time(off_pt, 0, 0) - get_min_trans_time(off_pt, 0, 0);
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            long long int distance = get_max_trans_time(off_pt, inst, 0) - get_min_trans_time(off_pt, inst, 0);;
-            if (max_distance < distance) {
-                max_distance = distance;
+    // For all frames, for all its offsets, if the offsets can collide, add constraint to avoid it
+    for (int fr_it = accum_num; (fr_it - accum_num) < num; fr_it++) {
+        for (int i = 0; i < get_num_offsets(&frames[fr_it]); i++) {
+            Offset *off = get_offset_it(&frames[fr_it], i);
+            int link_id = get_link_id_offset_it(&frames[fr_it], i);
+            int link_inter = scheduler->link_dis[link_id];
+            
+            // With the presolve, the bandwidth reservation and the frames scheduled before are reserved intervals
+            if (scheduler->presolve == 1) {
+                int num_replicas = get_off_num_replicas(off);
+                int time = get_off_time(off);
+                for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+                    // Same bounds as the offset variables
+                    long long int first_lb = get_view_starting(view, fr_it) + (inst * get_view_period(view, fr_it));
+                    long long int first_ub = get_view_deadline(view, fr_it) + (get_view_period(view, fr_it) * inst) -
+                                             (num_replicas * time);
+                    for (int repl = 0; repl < num_replicas; repl++) {
+                        if (avoid_reserved_intervals(get_var_name(off, inst, repl), first_lb + (repl * time),
+                                                     first_ub + (repl * time), time,
+                                                     &scheduler->link_timelines[link_id], link_inter) == -1) {
+                            fprintf(stderr, "The frame %d does not fit in the link %d\n", get_frame_id(fr_it), link_id);
+                            return -1;
+                        }
+                    }
+                }
+            // Avoid collision with the bandwith reservation if needed
+            } else if (protocol->period != 0 && scheduler->encoding != no_overlap_encoding) {
+                Offset *pre_off = get_offset_by_link(&protocol->reservation, link_id);
+                if (pre_off != NULL && get_off_period(off) == 0 &&
+                    avoid_collision_offsets(fr_it, off, reservation_pos, pre_off, -1) == -1) {
+                    return -1;
+                }
+                if (pre_off != NULL && get_off_period(off) != 0 &&
+                    avoid_collision_periodic(fr_it, off, reservation_pos, pre_off, -1) == -1) {
+                    return -1;
+                }
             }
-        }
-    
-        if (GRBaddvar(model, 0, NULL, NULL, frame_dis_w, 0, max_distance, GRB_INTEGER, name)) {
-            printf("%s\n", GRBgeterrormsg(env));
-            return -1;
-        }
-        frame_dis[i] = var_it;
-        var_it += 1;
-        
-        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
-            int var_off[] = {get_var_name(off_pt, inst, 0), frame_dis[i]};
-            double val[] = {1, -1};
             
-            // Offset - frame distance > LB
-            if (GRBaddconstr(model, 2, var_off, val, GRB_GREATER_EQUAL, get_min_trans_time(off_pt, inst, 0), NULL)) {
-                printf("%s\n", GRBgeterrormsg(env));
-                return -1;
+            // With the no-overlap encoding, the collisions of each link are avoided all together after the loop
+            if (scheduler->encoding == no_overlap_encoding) {
+                continue;
             }
             
-            double val2[] = {1, 1};
-
-            // Offset - frame instance < UB
-            if (GRBaddconstr(model, 2, var_off, val2, GRB_LESS_EQUAL, get_max_trans_time(off_pt, inst, 0), NULL)) {
-                printf("%s\n", GRBgeterrormsg(env));
-                return -1;
+            // Only the frames added before that share the link can collide, they are sorted by position
+            Link_Offset *link_off = get_link_offsets(link_id);
+            for (int j = 0; j < get_num_link_offsets(link_id) && link_off[j].frame_pos < fr_it; j++) {
+                if (scheduler->presolve == 1 && link_off[j].frame_pos < accum_num) {
+                    continue;
+                }
+                if (get_off_period(off) == 0 &&
+                    avoid_collision_offsets(fr_it, off, link_off[j].frame_pos, link_off[j].offset_pt,
+                                            link_inter) == -1) {
+                    return -1;
+                }
+                if (get_off_period(off) != 0 &&
+                    avoid_collision_periodic(fr_it, off, link_off[j].frame_pos, link_off[j].offset_pt,
+                                             link_inter) == -1) {
+                    return -1;
+                }
             }
         }
-        
     }
-    
-    // Create the link intermissions
-    sprintf(name, "LinkDis_%d", it);
-    if (GRBaddvar(model, 0, NULL, NULL, link_dis_w, 0, get_hyperperiod(), GRB_INTEGER, name)) {
-        printf("%s\n", GRBgeterrormsg(env));
+    if (scheduler->encoding == no_overlap_encoding && no_overlap_links(num, accum_num) == -1) {
         return -1;
     }
-    link_dis[0] = var_it;
-    var_it += 1;
-    
+    solver_update();
     return 0;
 }
 
 /**
- Avoid that any frame transmission collides at the same time on the optimize
- 
+ Save the obtained transmission times from the solver in the frames, also if needed, fix them into the solver
+
  @param frames list of frames to create the constraint
  @param num number of frames in the list
  @param accum_num number of frames that were already created their offsets
  @return 0 if done correctly, -1 otherwise
  */
-int avoid_collision_optimize(Frame *frames, int num, int accum_num) {
- 
+int save_offsets(Frame *frames, int num, int accum_num) {
+    
+    profile_phase(phase_save);
+    
     char name[100];
-    SelfHealing_Protocol *shp = get_healing_protocol();
-    int instances_protocol = (int)(get_hyperperiod() / shp->period);
     
-    // For all frames, for all its offsets, if the offsets can collide, add constraint to avoid it
-    for (int fr_it = accum_num; (fr_it - accum_num) < num; fr_it++) {
-        Offset *off = get_offset_it(&frames[fr_it], 0);
-        int link_inter = link_dis[0];
-        
-        // For all the frames that were added before, check if the offsets ids are the same to add the constraint
-        int pre_fr_it = 0;
-        while (pre_fr_it < fr_it) {
-            
-            // Get the previous frame pointer, or the bandwitdh allocation frame
-            Frame *pre_frame_pt = &frames[pre_fr_it];
-            
-            Offset *pre_off = get_offset_it(pre_frame_pt, 0);
-            // If the frame has an offset with the same link, continue
-            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-                for (int pre_inst = 0; pre_inst < get_off_num_instances(pre_off); pre_inst++) {
-                    
-                    // Check if both offsets share an interval and we need to add the constraint
-                    long long int min1 = get_min_trans_time(off, inst, 0);
-                    long long int max1 = get_max_trans_time(off, inst, 0) + get_off_time(off);
-                    long long int min2 = get_min_trans_time(pre_off, pre_inst, 0);
-                    long long int max2 = get_max_trans_time(pre_off, pre_inst, 0) + get_off_time(pre_off);
-                    if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
-                        
-                        for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
-                            for (int pre_repl = 0; pre_repl < get_off_num_replicas(pre_off); pre_repl++) {
-                                
-                                long long int distance1 = get_off_time(off);
-                                long long int distance2 = get_off_time(pre_off);
-                                
-                                sprintf(name, "x_%lld", x_con);
-                                x_con += 1;
-                                // Add two binary variables to chosse between two constraints
-                                if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                                sprintf(name, "y_%lld", y_con);
-                                y_con += 1;
-                                if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                                sprintf(name, "z_%lld", z_con);
-                                z_con += 1;
-                                var_it += 2;
-                                // Add binary variable to force one of both previous variables to true
-                                if (GRBaddvar(model, 0, NULL, NULL, 0, 1, 1, GRB_BINARY, name)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                                var_it += 1;
-                                int ind[] = {var_it -3, var_it -2};
-                                sprintf(name, "or_%lld", or_con);
-                                or_con += 1;
-                                if (GRBaddgenconstrOr(model, name, var_it - 1, 2, ind)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                                
-                                // Depending of the active variable, we choose one or the other constraint
-                                // Offset + distance1 + link_dis <= previous offset
-                                int var[] = {get_var_name(off, inst, repl),
-                                    get_var_name(pre_off, pre_inst, pre_repl),
-                                    link_inter};
-                                double val[] = {-1.0, 1.0, -1.0};
-                                sprintf(name, "Avoid_%lld_1", avoid_con);
-                                if (GRBaddgenconstrIndicator(model, name, var_it - 3, 1, 3, var, val,
-                                                             GRB_GREATER_EQUAL, distance1)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                                // Previous offset + distance2 + link_dis <= offset
-                                double val2[] = {1.0, -1.0, -1.0};
-                                sprintf(name, "Avoid_%lld_2", avoid_con);
-                                avoid_con += 1;
-                                if (GRBaddgenconstrIndicator(model, name, var_it - 2, 1, 3, var, val2,
-                                                             GRB_GREATER_EQUAL, distance2)) {
-                                    printf("%s\n", GRBgeterrormsg(env));
-                                    return -1;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            pre_fr_it += 1;
-        }
-        
-        // Take into account the SHP reservation too
-        for (int inst = 0; inst < get_off_num_instances(off); inst++) {
-            for (int i = 0; i < instances_protocol; i++) {
-                
-                long long int min1 = get_min_trans_time(off, inst, 0);
-                long long int max1 = get_max_trans_time(off, inst, 0);
-                long long int min2 = (shp->period * i);
-                long long int max2 = (shp->period * i) + shp->time;
-                
-                if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
-                    
-                    long long int distance1 = get_off_time(off);
-                    long long int distance2 = shp->time;
-                    
-                    sprintf(name, "x_%lld", x_con);
-                    x_con += 1;
-                    // Add two binary variables to chosse between two constraints
-                    if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    sprintf(name, "y_%lld", y_con);
-                    y_con += 1;
-                    if (GRBaddvar(model, 0, NULL, NULL, 0, 0, 1, GRB_BINARY, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    sprintf(name, "z_%lld", z_con);
-                    z_con += 1;
-                    var_it += 2;
-                    // Add binary variable to force one of both previous variables to true
-                    if (GRBaddvar(model, 0, NULL, NULL, 0, 1, 1, GRB_BINARY, name)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    var_it += 1;
-                    int ind[] = {var_it -3, var_it -2};
-                    sprintf(name, "or_%lld", or_con);
-                    or_con += 1;
-                    if (GRBaddgenconstrOr(model, name, var_it - 1, 2, ind)) {
-                        printf("%s\n", GRBgeterrormsg(env));
+    // Iterate over all the given frames and their given offsets
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
+            Offset *off = get_offset_it(&frames[i], j);
+            for (int inst = 0; inst < get_off_stored_instances(off); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                    // Get the transmission time from the model and write it in the offset memory
+                    double trans_time;
+                    if (solver_get_value(get_var_name(off, inst, repl), &trans_time) == -1) {
                         return -1;
                     }
+                    set_trans_time(off, inst, repl, (long long int) trans_time);
                     
-                    // Depending of the active variable, we choose one or the other constraint
-                    // Offset + distance1 + link_dis <= previous offset
-                    int var[] = {get_var_name(off, inst, 0),
-                        var_shp_optimize[i]};
-                    double val[] = {-1.0, 1.0};
-                    sprintf(name, "Avoid_%lld_1", avoid_con);
-                    if (GRBaddgenconstrIndicator(model, name, var_it - 3, 1, 2, var, val,
-                                                 GRB_GREATER_EQUAL, distance1)) {
-                        printf("%s\n", GRBgeterrormsg(env));
-                        return -1;
-                    }
-                    // Previous offset + distance2 + link_dis <= offset
-                    double val2[] = {1.0, -1.0};
-                    sprintf(name, "Avoid_%lld_2", avoid_con);
-                    avoid_con += 1;
-                    if (GRBaddgenconstrIndicator(model, name, var_it - 2, 1, 2, var, val2,
-                                                 GRB_GREATER_EQUAL, distance2)) {
-                        printf("%s\n", GRBgeterrormsg(env));
+                    // Fix the transmission time in the model
+                    sprintf(name, "Fix_%lld", scheduler->fix_con);
+                    int ind[] = {get_var_name(off, inst, repl)};
+                    double val[] = {1.0};
+                    if (solver_add_constr(1, ind, val, solver_equal, trans_time, name) == -1) {
                         return -1;
                     }
-                    
+                    scheduler->fix_con += 1;
                 }
             }
         }
+        // Remove the objective from the scheduled frame
+        solver_set_objective(scheduler->frame_dis[i], 0.0);
     }
-    GRBupdatemodel(model);
+    
     return 0;
 }
 
-/* Functions */
-
 /**
- Get the execution time of the last algorithm applied
+ Check if the schedule obtained violates any of the constraints.
+ It is useful in the case of more complex algorithms that obtain the schedule in steps and a bug might slip.
+ All the violations found are written in the standard error
+
+ @param t pointer to the traffic
+ @return 0 if the schedule is correct, -1 if any constraint is violated
  */
-long long int get_execution_time(void) {
+int check_schedule(Traffic *t) {
+    
+    profile_phase(phase_save);
     
-    return (long long int) execution_time;
+    Schedule_Report report;
+    int num_violations = validate_schedule(t, 0, &report);
+    if (num_violations > 0) {
+        print_schedule_report(&report, stderr);
+    }
+    free_schedule_report(&report);
+    
+    return num_violations == 0 ? 0 : -1;
 }
 
+/* Symmetry functions */
+
 /**
- Schedule all the transmission times of all the frames at the same time given the given scheduling parameters.
- It first init the solver and the variables for all the offsets transmission times between their deadlines.
- Then avoid that any offset collides.
- Forces that all frames has to wait at least a minimum switch time
- There exist a limit between the time the transmission starts and the time all the receivers get the frame
- If the protocol bandwitch is activated, avoid frames to the transmitted at the reserver bandwidth
- There might optimization, such as minimize the timespan, of increase the reparability
+ Compare two frames to know if they are identical, they have the same timing, size and paths, so swapping all their
+ transmission times gives another schedule with the same quality
+
+ @param frame_a pointer to the first frame
+ @param frame_b pointer to the second frame
+ @return 0 if the frames are identical, -1 if the first goes before, 1 otherwise
  */
-int one_shot_scheduling(void) {
+int compare_frames_equivalent(Frame *frame_a, Frame *frame_b) {
     
-    init_solver();
-    Traffic *t = get_traffic();
+    long long int values_a[] = {get_period(frame_a), get_starting_time(frame_a), get_deadline(frame_a),
+                                get_end_to_end(frame_a), get_size(frame_a), get_num_paths(frame_a)};
+    long long int values_b[] = {get_period(frame_b), get_starting_time(frame_b), get_deadline(frame_b),
+                                get_end_to_end(frame_b), get_size(frame_b), get_num_paths(frame_b)};
+    for (int i = 0; i < 6; i++) {
+        if (values_a[i] != values_b[i]) {
+            return values_a[i] < values_b[i] ? -1 : 1;
+        }
+    }
     
-    if (create_offsets_variables(t->frames, t->num_frames, 0, 1) == -1) {
-        fprintf(stderr, "Failure creating offsets\n");
-        return -1;
+    // The paths have to go through the same links in the same order
+    for (int i = 0; i < get_num_paths(frame_a); i++) {
+        Path *path_a = get_path(frame_a, i);
+        Path *path_b = get_path(frame_b, i);
+        if (get_num_links_path(path_a) != get_num_links_path(path_b)) {
+            return get_num_links_path(path_a) < get_num_links_path(path_b) ? -1 : 1;
+        }
+        for (int j = 0; j < get_num_links_path(path_a); j++) {
+            int link_a = get_off_link_id(get_offset_path_link(path_a, j));
+            int link_b = get_off_link_id(get_offset_path_link(path_b, j));
+            if (link_a != link_b) {
+                return link_a < link_b ? -1 : 1;
+            }
+        }
     }
     
-    if (create_intermission_variables(t->frames, t->num_frames, 0, 0) == -1) {
-        fprintf(stderr, "Failure creating intermission variables\n");
-        return -1;
+    return 0;
+}
+
+/**
+ Compare the positions of two frames to sort the identical frames together and by their position in the list of
+ frames being sorted
+
+ @param a pointer to the position of the first frame
+ @param b pointer to the position of the second frame
+ @return -1 if the first frame goes before, 1 otherwise
+ */
+int compare_frames_symmetry(const void *a, const void *b) {
+    
+    int compare = compare_frames_equivalent(&symmetry_frames[*(const int *)a], &symmetry_frames[*(const int *)b]);
+    if (compare != 0) {
+        return compare;
     }
+    return *(const int *)a - *(const int *)b;
+}
 
-    if (path_dependent(t->frames, t->num_frames, 0) == -1) {
-        fprintf(stderr, "Failure adding path dependent constraints\n");
-        return -1;
+/**
+ Sort the positions of the frames so the identical frames are together and sorted by their position
+
+ @param frames list of frames to sort
+ @param num number of frames in the list
+ @return list of positions of the frames, it has to be freed, NULL if there is no memory
+ */
+int *sort_frames_symmetry(Frame *frames, int num) {
+    
+    int *order = malloc(sizeof(int) * num);
+    if (order == NULL) {
+        fprintf(stderr, "Not enough memory to find the identical frames\n");
+        return NULL;
+    }
+    for (int i = 0; i < num; i++) {
+        order[i] = i;
     }
+    // qsort has no context for the comparison, so the frames are kept for the thread while sorting
+    symmetry_frames = frames;
+    qsort(order, num, sizeof(int), compare_frames_symmetry);
+    symmetry_frames = NULL;
+    
+    return order;
+}
 
-    if (end_to_end_delay(t->frames, t->num_frames, 0) == -1) {
-        fprintf(stderr, "Failure adding end to end delay constraints\n");
+/**
+ Break the symmetries between identical frames.
+ Any schedule can swap the transmissions of two identical frames, so the first instance of every frame in the first
+ link of its first path has to be transmitted after the one of the identical frame that comes before it in the traffic.
+ This fixes the disjunction of the first instances, and the solver does not have to explore all the permutations
+
+ @param frames list of frames to create the constraint
+ @param num number of frames in the list
+ @return 0 if done correctly, -1 otherwise
+ */
+int break_symmetries(Frame *frames, int num) {
+    
+    profile_phase(phase_symmetry);
+    
+    char name[100];
+    int *order = sort_frames_symmetry(frames, num);
+    if (order == NULL) {
         return -1;
     }
+    
+    for (int i = 1; i < num; i++) {
+        if (compare_frames_equivalent(&frames[order[i - 1]], &frames[order[i]]) != 0) {
+            continue;
+        }
+        
+        // PREVIOUS OFFSET + TRANSMISSION TIME <= OFFSET (in the first link of the first path)
+        Offset *pre_off = get_offset_path_link(get_path(&frames[order[i - 1]], 0), 0);
+        Offset *off = get_offset_path_link(get_path(&frames[order[i]], 0), 0);
+        int var_off[] = {get_var_name(off, 0, 0), get_var_name(pre_off, 0, 0)};
+        double val[] = {1.0, -1.0};
+        sprintf(name, "Sym_%lld", scheduler->sym_con);
+        scheduler->sym_con += 1;
+        if (solver_add_constr(2, var_off, val, solver_greater_equal, get_off_time(pre_off), name) == -1) {
+            free(order);
+            return -1;
+        }
+    }
+    free(order);
+    solver_update();
+    
+    return 0;
+}
 
-    if (contention_free(t->frames, t->num_frames, 0) == -1) {
-        fprintf(stderr, "Failure adding contention free constraints\n");
+/**
+ Swap the transmission times of the identical frames so they follow the order of the symmetry breaking constraints.
+ A schedule found without the constraints, as the one of the heuristic, can be then used as starting solution
+
+ @param frames list of frames to sort
+ @param num number of frames in the list
+ @return 0 if done correctly, -1 otherwise
+ */
+int order_equivalent_frames(Frame *frames, int num) {
+    
+    profile_phase(phase_symmetry);
+    
+    int *order = sort_frames_symmetry(frames, num);
+    if (order == NULL) {
         return -1;
     }
     
+    int first = 0;
+    while (first < num) {
+        
+        // Find the identical frames that start at first
+        int last = first + 1;
+        while (last < num && compare_frames_equivalent(&frames[order[first]], &frames[order[last]]) == 0) {
+            last++;
+        }
+        
+        // Insert the schedule of every frame in the ones before it until they are sorted by their first transmission
+        for (int i = first + 1; i < last; i++) {
+            for (int j = i; j > first; j--) {
+                Frame *frame_pt = &frames[order[j]];
+                Frame *pre_frame_pt = &frames[order[j - 1]];
+                Offset *first_off = get_offset_path_link(get_path(frame_pt, 0), 0);
+                Offset *pre_first_off = get_offset_path_link(get_path(pre_frame_pt, 0), 0);
+                if (get_trans_time(pre_first_off, 0, 0) <= get_trans_time(first_off, 0, 0)) {
+                    break;
+                }
+                for (int h = 0; h < get_num_offsets(frame_pt); h++) {
+                    Offset *off = get_offset_it(frame_pt, h);
+                    Offset *pre_off = get_offset_by_link(pre_frame_pt, get_off_link_id(off));
+                    for (int inst = 0; inst < get_off_stored_instances(off); inst++) {
+                        for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                            long long int trans_time = get_trans_time(off, inst, repl);
+                            set_trans_time(off, inst, repl, get_trans_time(pre_off, inst, repl));
+                            set_trans_time(pre_off, inst, repl, trans_time);
+                        }
+                    }
+                }
+            }
+        }
+        first = last;
+    }
+    free(order);
+    
+    return 0;
+}
+
+/* Patch functions */
+
+/**
+ Insert a fixed transmission to the list of link transmissions
+
+ @param head head to the link transmissions
+ @param transmission_time starting time transmissions
+ @param ending_time ending time transmission
+ @return the new pointer to the head
+ */
+LS_Transmission* insert_fixed_trans(LS_Transmission *head, long long int transmission_time, long long int ending_time) {
+    
+    LS_Transmission *next_pt, *prev_pt;
+    
+    // Create the transmission block
+    LS_Transmission *trans_pt = malloc(sizeof(LS_Transmission));
+    trans_pt->starting = transmission_time;
+    trans_pt->ending = ending_time;
+    trans_pt->next_transmission = NULL;
+    
+    // If the head is not initialized, do it and add the block
+    if (head == NULL) {
+        head = trans_pt;
+    } else {
+        next_pt = head;
+        prev_pt = NULL;
+        // Search until the starting time is larger
+        while (next_pt && next_pt->starting <= trans_pt->starting) {
+            prev_pt = next_pt;
+            next_pt = next_pt->next_transmission;
+        }
+        // If is the last, add it at the end
+        if (next_pt == NULL) {
+            prev_pt->next_transmission = trans_pt;
+        // If not, it was in the middle, so add it in between
+        } else {
+            if (prev_pt) {
+                trans_pt->next_transmission = prev_pt->next_transmission;
+                prev_pt->next_transmission = trans_pt;
+            } else {
+                trans_pt->next_transmission = head;
+                head = trans_pt;
+            }
+        }
+    }
+    return head;
+}
+
+/**
+ Allocate a new offset in the linked list
+
+ @param off_pt pointer to the offset to allocate
+ @param instance number of instance
+ @param replica number of replica
+ @param head pointer to the head of the linked list transmission
+ @param min minimum possible transmission time
+ @param max maximum possible transmission time
+ @param time_slots time slots
+ @return the head pointer or null if the offset could not be patched
+ */
+LS_Transmission* allocate_offset_patch(Offset *off_pt, int instance, int replica, LS_Transmission *head,
+                                       long long int min, long long int max, int time_slots) {
+    
+    LS_Transmission *next_pt, *prev_pt;
+    int found = 0;
+    
+    // Create the transmission block
+    LS_Transmission *trans_pt = malloc(sizeof(LS_Transmission));
+    trans_pt->starting = min;
+    trans_pt->ending = min + time_slots - 1;
+    trans_pt->next_transmission = NULL;
+    
+    // If the head is not initialized, do it and add the block
+    if (head == NULL) {
+        head = trans_pt;
+    } else {
+        next_pt = head;
+        prev_pt = NULL;
+        // Iterate over all the linked list
+        while (next_pt && found == 0) {
+            
+            // If it fits, add it
+            if (trans_pt->ending < next_pt->starting) {
+                found = 1;
+            // If not, update the transmission times
+            } else {
+                // Update starting time only if is larger than the minimum available
+                if (next_pt-> ending > min) {
+                    trans_pt->starting = next_pt->ending + 1;
+                    trans_pt->ending = trans_pt->starting + time_slots - 1;
+                    // If it goes over the maximum, we could not patch
+                    if (trans_pt->starting > max) {
+                        free(trans_pt);
+                        return NULL;
+                    }
+                }
+                
+                // Prepare pointers for the next iteration
+                prev_pt = next_pt;
+                next_pt = next_pt->next_transmission;
+            }
+        }
+        
+        // If is the last, add it at the end
+        if (next_pt == NULL) {
+            prev_pt->next_transmission = trans_pt;
+            // If not, it was in the middle, so add it in between
+        } else {
+            if (prev_pt) {
+                trans_pt->next_transmission = prev_pt->next_transmission;
+                prev_pt->next_transmission = trans_pt;
+            } else {
+                trans_pt->next_transmission = head;
+                head = trans_pt;
+            }
+        }
+        // Allocate the transmission to the offset
+        set_trans_time(off_pt, instance, replica, trans_pt->starting);
+    }
+    
+    return head;
+}
+
+/**
+ Allocate a new offset in the first gap of the timeline where it fits.
+ It follows the same rules as the linked list, a transmission ending just at the minimum does not move the offset.
+
+ @param off_pt pointer to the offset to allocate
+ @param instance number of instance
+ @param replica number of replica
+ @param timeline_pt pointer to the timeline of the link
+ @param min minimum possible transmission time
+ @param max maximum possible transmission time
+ @param time_slots time slots
+ @return 0 if done correctly, -1 if the offset could not be patched
+ */
+int allocate_offset_gap(Offset *off_pt, int instance, int replica, Timeline *timeline_pt, long long int min,
+                        long long int max, int time_slots) {
+    
+    long long int starting = first_fit_timeline(timeline_pt, min, time_slots);
+    if (starting == -1) {
+        return -1;
+    }
+    // Same as in the linked list, the transmission that ends in the minimum is not taken into account
+    if (starting != min && get_free_until(timeline_pt, min) == -1 &&
+        get_free_until(timeline_pt, min + 1) >= min + time_slots - 1) {
+        starting = min;
+    }
+    // If it goes over the maximum, we could not patch
+    if (starting != min && starting > max) {
+        return -1;
+    }
+    
+    if (occupy_timeline(timeline_pt, starting, starting + time_slots - 1) == -1) {
+        return -1;
+    }
+    set_trans_time(off_pt, instance, replica, starting);
+    return 0;
+}
+
+/**
+ Allocate all the replicas of an instance of an offset, every replica in the first slot available after the previous
+ one. Only the first replica can start at its minimum even over its maximum, as with a single transmission
+
+ @param off_pt pointer to the offset to allocate
+ @param instance number of instance
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index
+ @param min minimum possible transmission time of the first replica
+ @return 0 if done correctly, -1 if the instance could not be patched
+ */
+int allocate_offset_replicas(Offset *off_pt, int instance, LS_Transmission **sorted_pt, Timeline *timeline_pt,
+                             long long int min) {
+    
+    int time_slots = get_off_time(off_pt);
+    for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+        long long int max = get_max_trans_time(off_pt, instance, repl);
+        if (repl > 0) {
+            min = get_trans_time(off_pt, instance, repl - 1) + time_slots;
+            if (get_min_trans_time(off_pt, instance, repl) > min) {
+                min = get_min_trans_time(off_pt, instance, repl);
+            }
+            if (min > max) {
+                return -1;
+            }
+        }
+        if (scheduler->patch_index == linked_list) {
+            LS_Transmission *head_pt = allocate_offset_patch(off_pt, instance, repl, *sorted_pt, min, max,
+                                                             time_slots);
+            // If it returns null, we failed to patch, the list is kept so it can be released
+            if (head_pt == NULL) {
+                return -1;
+            }
+            *sorted_pt = head_pt;
+        } else if (allocate_offset_gap(off_pt, instance, repl, timeline_pt, min, max, time_slots) == -1) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Add a fixed transmission to the sorted list or to the timeline of the link, depending on the patch index
+
+ @param starting first time slot of the transmission
+ @param ending last time slot of the transmission
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_fixed_trans(long long int starting, long long int ending, LS_Transmission **sorted_pt, Timeline *timeline_pt) {
+    
+    if (scheduler->patch_index == linked_list) {
+        *sorted_pt = insert_fixed_trans(*sorted_pt, starting, ending);
+        return 0;
+    }
+    return occupy_timeline(timeline_pt, starting, ending);
+}
+
+/**
+ Add the bandwidth reservations of the self-healing protocol to the link transmissions
+
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index
+ @return 0 if done correctly, -1 otherwise
+ */
+int reserve_protocol_traffic(LS_Transmission **sorted_pt, Timeline *timeline_pt) {
+    
+    SelfHealing_Protocol protocol = *get_healing_protocol();
+    int instances_protocol = (int)(get_hyperperiod() / protocol.period);
+    for (int i = 0; i < instances_protocol; i++) {
+        int trans_time = (int)(protocol.period * i);
+        if (add_fixed_trans(trans_time, trans_time + protocol.time, sorted_pt, timeline_pt) == -1) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Prepare the fixed traffic and load it into the sorted list of the link transmissions
+
+ @param frames pointer to the frames to fix
+ @param num number of frames to fix
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index
+ @return 0 if done corretly, -1 otherwise
+ */
+int prepare_fixed_traffic(Frame *frames, int num, LS_Transmission **sorted_pt, Timeline *timeline_pt) {
+    
+    // For all the fixed frames, add them into the linked list
+    for (int fr_it = 0; fr_it < num; fr_it++) {
+        // The fixed traffic only has one offset
+        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
+        int time_slots = get_off_time(off_pt);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            long long int trans_time = get_trans_time(off_pt, inst, 0);
+            if (add_fixed_trans(trans_time, trans_time + time_slots, sorted_pt, timeline_pt) == -1) {
+                return -1;
+            }
+        }
+    }
+    
+    // Also add the self healing protocol bandwith reservation
+    return reserve_protocol_traffic(sorted_pt, timeline_pt);
+}
+
+/**
+ Load the fixed traffic of a link copying the one built from the baseline schedule
+
+ @param fixed_pt pointer to the fixed traffic of the link in the baseline schedule
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index, not initialized
+ @return 0 if done correctly, -1 otherwise
+ */
+int clone_fixed_traffic(Fixed_Timeline *fixed_pt, LS_Transmission **sorted_pt, Timeline *timeline_pt) {
+    
+    if (scheduler->patch_index == gap_index) {
+        return copy_timeline(timeline_pt, &fixed_pt->timeline);
+    }
+    
+    // The list is already sorted, so it is copied in order without searching where every transmission goes
+    LS_Transmission **last_pt = sorted_pt;
+    for (LS_Transmission *trans_pt = fixed_pt->sorted_trans; trans_pt != NULL; trans_pt = trans_pt->next_transmission) {
+        *last_pt = malloc(sizeof(LS_Transmission));
+        if (*last_pt == NULL) {
+            fprintf(stderr, "Not enough memory to copy the fixed traffic\n");
+            return -1;
+        }
+        (*last_pt)->starting = trans_pt->starting;
+        (*last_pt)->ending = trans_pt->ending;
+        (*last_pt)->next_transmission = NULL;
+        last_pt = &(*last_pt)->next_transmission;
+    }
+    
+    return 0;
+}
+
+/**
+ Allocate the traffic in the available slots left by the dixed offsets
+ 
+ @param frames pointer to the frames to allocate
+ @param num number of frames to fix
+ @param sorted_pt pointer to the head of the sorted linked list with the link transmissions
+ @param timeline_pt pointer to the free gaps of the link when patching with the gap index
+ @return 0 if done corretly, -1 otherwise
+ */
+int allocate_patch_traffic(Frame *frames, int num, LS_Transmission **sorted_pt, Timeline *timeline_pt) {
+    
+    for (int fr_it = 0; fr_it < num; fr_it++) {
+        // The fixed traffic only has one offset
+        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            long long int min = get_min_trans_time(off_pt, inst, 0);
+            long long int max = get_max_trans_time(off_pt, inst, 0);
+            // The minimum is taken even over the maximum, so a frame without time left in the link is not patched
+            if (min > max || allocate_offset_replicas(off_pt, inst, sorted_pt, timeline_pt, min) == -1) {
+                return -1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Patch the traffic in the available slots left by the fixed traffic and the self-healing protocol
+
+ @param t pointer to the traffic
+ @param fixed_frames number of fixed frames at the start of the traffic
+ @param fixed_pt pointer to the fixed traffic already built from the baseline schedule, NULL to build it
+ @return 0 if done correctly, -1 otherwise
+ */
+int patch_traffic(Traffic *t, int fixed_frames, Fixed_Timeline *fixed_pt) {
+    
+    // The structures are local, so several links can be patched at the same time
+    LS_Transmission *sorted_trans = NULL;
+    Timeline timeline;
+    int error = 0;
+    
+    // Prepare the fixed traffic, copied if it was built before
+    if (fixed_pt != NULL) {
+        if (clone_fixed_traffic(fixed_pt, &sorted_trans, &timeline) == -1) {
+            fprintf(stderr, "Error copying the fixed traffic when patching\n");
+            error = -1;
+        }
+    } else if (scheduler->patch_index == gap_index && init_timeline(&timeline) == -1) {
+        return -1;
+    } else if (prepare_fixed_traffic(t->frames, fixed_frames, &sorted_trans, &timeline) == -1) {
+        fprintf(stderr, "Error preparing the fixed traffic when patching\n");
+        error = -1;
+    }
+    
+    // For all frames, allocate a frame at a time
+    if (error == 0 && allocate_patch_traffic(&t->frames[fixed_frames], t->num_frames - fixed_frames, &sorted_trans,
+                                             &timeline) == -1) {
+        error = -1;
+    }
+    
+    if (scheduler->patch_index == gap_index) {
+        free_timeline(&timeline);
+    }
+    while (sorted_trans != NULL) {
+        LS_Transmission *next_pt = sorted_trans->next_transmission;
+        free(sorted_trans);
+        sorted_trans = next_pt;
+    }
+    
+    return error;
+}
+
+/**
+ Get the fixed traffic of the baseline schedule that the patch of a link can copy
+
+ @param link_patch pointer to the patch of the link
+ @return pointer to the fixed traffic of the link, NULL if it has to be built
+ */
+Fixed_Timeline * get_baseline_fixed(Link_Patch *link_patch) {
+    
+    Baseline_Timelines *baseline = scheduler->baseline;
+    if (link_patch->baseline == 1 && baseline != NULL && baseline->patch_index == scheduler->patch_index &&
+        link_patch->link_id < baseline->num_links && baseline->links[link_patch->link_id].built == 1) {
+        return &baseline->links[link_patch->link_id];
+    }
+    return NULL;
+}
+
+/**
+ Thread that takes the next link to patch until all the links are patched
+
+ @param pool_pt pointer to the shared state of the pool
+ @return NULL
+ */
+void * patch_links_thread(void *pool_pt) {
+    
+    Patch_Pool *pool = pool_pt;
+    
+    // The links are patched with the network and the scheduler of the thread that started the pool
+    set_network(pool->network_pt);
+    set_scheduler_context(pool->scheduler_pt);
+    Traffic *t = get_traffic();
+    
+    while (1) {
+        pthread_mutex_lock(&pool->lock);
+        Link_Patch *link_patch = get_link_patch(pool->next_patch);
+        pool->next_patch += 1;
+        pthread_mutex_unlock(&pool->lock);
+        if (link_patch == NULL) {
+            break;
+        }
+        
+        // The traffic of the link is contiguous, so it is patched as if it was the only link
+        Traffic link_traffic;
+        link_traffic.num_frames = link_patch->num_frames;
+        link_traffic.frames = &t->frames[link_patch->first_frame];
+        link_traffic.frames_id = &t->frames_id[link_patch->first_frame];
+        
+        // If the fixed frames are the schedule of the link, its fixed traffic is copied from the baseline
+        Fixed_Timeline *fixed_pt = get_baseline_fixed(link_patch);
+        
+        // A valid repair plan of the link replaces its patch
+        uint64_t starting = get_monotonic_time();
+        if (apply_repair_plan(scheduler->repair_cache, &link_traffic, link_patch->num_fixed,
+                              link_patch->link_id) == 0) {
+            link_patch->patched = 1;
+        } else if (patch_traffic(&link_traffic, link_patch->num_fixed, fixed_pt) == 0) {
+            link_patch->patched = 1;
+        }
+        link_patch->execution_time = (long long int) (get_monotonic_time() - starting);
+    }
+    
+    return NULL;
+}
+
+/**
+ Patch all the links read at the same time with a pool of threads
+
+ @return 0 if all the links were patched, -1 otherwise
+ */
+int patch_links(void) {
+    
+    Patch_Pool pool;
+    int num_threads = scheduler->patch_threads;
+    if (num_threads == 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads > get_num_link_patches()) {
+        num_threads = get_num_link_patches();
+    }
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+    
+    pool.next_patch = 0;
+    pool.network_pt = get_network();
+    pool.scheduler_pt = scheduler;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_t *threads = malloc(sizeof(pthread_t) * num_threads);
+    if (threads == NULL) {
+        fprintf(stderr, "Not enough memory for the patching threads\n");
+        pthread_mutex_destroy(&pool.lock);
+        return -1;
+    }
+    
+    // If a thread can not be created, the ones already created patch all the links
+    int created = 0;
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&threads[created], NULL, patch_links_thread, &pool) == 0) {
+            created++;
+        }
+    }
+    if (created == 0) {
+        patch_links_thread(&pool);
+    }
+    for (int i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    pthread_mutex_destroy(&pool.lock);
+    
+    for (int i = 0; i < get_num_link_patches(); i++) {
+        if (get_link_patch(i)->patched == 0) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/* Path patch functions */
+
+/**
+ Search a frame among the frames to patch of a link
+
+ @param t pointer to the traffic
+ @param link_patch pointer to the patch of the link
+ @param frame_id id of the frame
+ @return position of the frame in the traffic, -1 if the link does not patch the frame
+ */
+int search_patched_frame(Traffic *t, Link_Patch *link_patch, int frame_id) {
+    
+    for (int i = link_patch->first_frame + link_patch->num_fixed; i < link_patch->first_frame + link_patch->num_frames;
+         i++) {
+        if (t->frames_id[i] == frame_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ Get the chain of consecutive links of the path where a frame is patched, starting in the given link
+
+ @param t pointer to the traffic
+ @param first_hop position in the path of the first link of the chain
+ @param frame_pos position of the frame in the traffic of the first link
+ @param chain memory for the position of the frame in the traffic of every link of the chain
+ @return number of links of the chain
+ */
+int get_path_chain(Traffic *t, int first_hop, int frame_pos, int *chain) {
+    
+    int len_chain = 1;
+    chain[0] = frame_pos;
+    for (int hop = first_hop + 1; hop < get_num_link_patches(); hop++) {
+        int pos = search_patched_frame(t, get_link_patch(hop), t->frames_id[frame_pos]);
+        if (pos == -1) {
+            break;
+        }
+        chain[len_chain] = pos;
+        len_chain++;
+    }
+    
+    return len_chain;
+}
+
+/**
+ Give the frame of a chain the whole range of the chain in every link, instead of the part of the range of every link.
+ The first link keeps its minimum and the last link its maximum, and the links between them get the earliest and the
+ latest transmission that leave the switch time after the last replica of the previous link and before the next one
+
+ @param t pointer to the traffic
+ @param chain position of the frame in the traffic of every link of the chain
+ @param len_chain number of links of the chain
+ @param ranges memory for the maximum transmission of every link of the chain
+ @return 0 if done correctly, -1 if the chain does not fit in its range
+ */
+int widen_chain_ranges(Traffic *t, int *chain, int len_chain, long long int *ranges) {
+    
+    long long int switch_time = get_switch_min_time();
+    int num_instances = get_off_num_instances(get_offset_it(&t->frames[chain[0]], 0));
+    for (int inst = 0; inst < num_instances; inst++) {
+        // The maximums of the last replicas go backwards from the last link, the minimums forward from the first one
+        Offset *last_pt = get_offset_it(&t->frames[chain[len_chain - 1]], 0);
+        ranges[len_chain - 1] = get_max_trans_time(last_pt, inst, get_off_num_replicas(last_pt) - 1);
+        for (int j = len_chain - 2; j >= 0; j--) {
+            Offset *next_pt = get_offset_it(&t->frames[chain[j + 1]], 0);
+            ranges[j] = ranges[j + 1] - (long long int) (get_off_num_replicas(next_pt) - 1) * get_off_time(next_pt) -
+                        get_hop_distance(get_off_time(get_offset_it(&t->frames[chain[j]], 0)), switch_time);
+        }
+        long long int min = get_min_trans_time(get_offset_it(&t->frames[chain[0]], 0), inst, 0);
+        for (int j = 0; j < len_chain; j++) {
+            Offset *off_pt = get_offset_it(&t->frames[chain[j]], 0);
+            long long int replicas_time = (long long int) (get_off_num_replicas(off_pt) - 1) * get_off_time(off_pt);
+            // The minimum is taken even over the maximum, so the chain has to fit in the range
+            if (min + replicas_time > ranges[j]) {
+                return -1;
+            }
+            if (set_instance_range(off_pt, inst, min, ranges[j], get_off_time(off_pt)) == -1) {
+                return -1;
+            }
+            min += replicas_time + get_hop_distance(get_off_time(off_pt), switch_time);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Check that every link of a chain transmits the frame the switch time after the last replica of the previous link
+
+ @param t pointer to the traffic
+ @param chain position of the frame in the traffic of every link of the chain
+ @param len_chain number of links of the chain
+ @return 0 if the transmissions are in order, -1 otherwise
+ */
+int check_chain_order(Traffic *t, int *chain, int len_chain) {
+    
+    long long int switch_time = get_switch_min_time();
+    int num_instances = get_off_num_instances(get_offset_it(&t->frames[chain[0]], 0));
+    for (int inst = 0; inst < num_instances; inst++) {
+        for (int j = 1; j < len_chain; j++) {
+            Offset *prev_pt = get_offset_it(&t->frames[chain[j - 1]], 0);
+            long long int min = get_trans_time(prev_pt, inst, get_off_num_replicas(prev_pt) - 1) +
+                                get_hop_distance(get_off_time(prev_pt), switch_time);
+            if (get_trans_time(get_offset_it(&t->frames[chain[j]], 0), inst, 0) < min) {
+                return -1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Allocate an instance of the frame of a chain in all the links of the chain, every link in the first slot available
+ after the last replica of the previous link and the switch time. The first free slot is the best one for all the next
+ links too, so the instance only fails if it can not be patched at all
+
+ @param t pointer to the traffic
+ @param chain position of the frame in the traffic of every link of the chain
+ @param len_chain number of links of the chain
+ @param first_hop position in the path of the first link of the chain
+ @param inst instance to allocate
+ @param sorted_trans sorted linked lists of every link of the path
+ @param timelines free gaps of every link of the path when patching with the gap index
+ @return 0 if done correctly, -1 otherwise
+ */
+int allocate_chain_instance(Traffic *t, int *chain, int len_chain, int first_hop, int inst,
+                            LS_Transmission **sorted_trans, Timeline *timelines) {
+    
+    long long int switch_time = get_switch_min_time();
+    long long int earliest = 0;
+    for (int j = 0; j < len_chain; j++) {
+        Offset *off_pt = get_offset_it(&t->frames[chain[j]], 0);
+        int num_replicas = get_off_num_replicas(off_pt);
+        long long int min = get_min_trans_time(off_pt, inst, 0);
+        long long int max = get_max_trans_time(off_pt, inst, 0);
+        // The minimum of the range is always valid when patching, but not the end of the previous link over the maximum
+        if (j > 0 && earliest > min) {
+            min = earliest;
+            if (min > max) {
+                return -1;
+            }
+        }
+        int hop = first_hop + j;
+        if (allocate_offset_replicas(off_pt, inst, &sorted_trans[hop], &timelines[hop], min) == -1) {
+            return -1;
+        }
+        earliest = get_trans_time(off_pt, inst, num_replicas - 1) +
+                   get_hop_distance(get_off_time(off_pt), switch_time);
+    }
+    
+    return 0;
+}
+
+/**
+ Apply a function to the chain of every frame patched in the links of the path, every frame only once
+
+ @param t pointer to the traffic
+ @param chain memory for the positions of the frame in the traffic of the links of the path
+ @param done memory to mark the frames of the traffic already visited, all of them 0
+ @param ranges memory for the ranges of the links of the path
+ @param sorted_trans sorted linked lists of every link of the path, NULL to only widen the ranges
+ @param timelines free gaps of every link of the path when patching with the gap index
+ @param check 1 to check the order of the transmissions of the chains instead of patching them
+ @return 0 if done correctly, -1 otherwise
+ */
+int visit_path_chains(Traffic *t, int *chain, int *done, long long int *ranges, LS_Transmission **sorted_trans,
+                      Timeline *timelines, int check) {
+    
+    int error = 0;
+    for (int hop = 0; hop < get_num_link_patches() && error == 0; hop++) {
+        Link_Patch *link_patch = get_link_patch(hop);
+        for (int fr_it = link_patch->first_frame + link_patch->num_fixed;
+             fr_it < link_patch->first_frame + link_patch->num_frames && error == 0; fr_it++) {
+            if (done[fr_it] == 1) {
+                continue;
+            }
+            int len_chain = get_path_chain(t, hop, fr_it, chain);
+            for (int j = 0; j < len_chain; j++) {
+                done[chain[j]] = 1;
+            }
+            if (check == 1) {
+                error = check_chain_order(t, chain, len_chain);
+            } else if (sorted_trans == NULL) {
+                error = widen_chain_ranges(t, chain, len_chain, ranges);
+            } else {
+                int num_instances = get_off_num_instances(get_offset_it(&t->frames[fr_it], 0));
+                for (int inst = 0; inst < num_instances && error == 0; inst++) {
+                    error = allocate_chain_instance(t, chain, len_chain, hop, inst, sorted_trans, timelines);
+                }
+            }
+        }
+    }
+    memset(done, 0, sizeof(int) * t->num_frames);
+    
+    return error;
+}
+
+/**
+ Search the repair plans of all the links of the path, they are only used if every link has a valid plan and the
+ frames keep their order along the path
+
+ @param t pointer to the traffic
+ @param chain memory for the positions of the frame in the traffic of the links of the path
+ @param done memory to mark the frames of the traffic already visited, all of them 0
+ @return 0 if all the links were repaired from their plans, -1 otherwise
+ */
+int apply_path_plans(Traffic *t, int *chain, int *done) {
+    
+    if (scheduler->repair_cache == NULL) {
+        return -1;
+    }
+    for (int hop = 0; hop < get_num_link_patches(); hop++) {
+        Link_Patch *link_patch = get_link_patch(hop);
+        Traffic link_traffic;
+        link_traffic.num_frames = link_patch->num_frames;
+        link_traffic.frames = &t->frames[link_patch->first_frame];
+        link_traffic.frames_id = &t->frames_id[link_patch->first_frame];
+        if (apply_repair_plan(scheduler->repair_cache, &link_traffic, link_patch->num_fixed,
+                              link_patch->link_id) == -1) {
+            return -1;
+        }
+    }
+    
+    return visit_path_chains(t, chain, done, NULL, NULL, NULL, 1);
+}
+
+/**
+ Copy the ranges of the frames patched in the links of the path to the given memory, or from it if restore is 1, so
+ the ranges of every link can be recovered after they are widened to the whole path
+
+ @param t pointer to the traffic
+ @param ranges memory with the minimum of the first replica and the maximum of the last replica of every instance of
+ the patched frames, if ranges is NULL only the number of instances is counted
+ @param restore 1 to write the ranges in the frames, 0 to read them from the frames
+ @return number of instances of the patched frames
+ */
+int copy_path_ranges(Traffic *t, long long int *ranges, int restore) {
+    
+    int pos = 0;
+    for (int hop = 0; hop < get_num_link_patches(); hop++) {
+        Link_Patch *link_patch = get_link_patch(hop);
+        for (int fr_it = link_patch->first_frame + link_patch->num_fixed;
+             fr_it < link_patch->first_frame + link_patch->num_frames; fr_it++) {
+            Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+            int last_replica = get_off_num_replicas(off_pt) - 1;
+            for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+                if (ranges != NULL && restore == 1) {
+                    set_instance_range(off_pt, inst, ranges[2 * pos], ranges[2 * pos + 1], get_off_time(off_pt));
+                } else if (ranges != NULL) {
+                    ranges[2 * pos] = get_min_trans_time(off_pt, inst, 0);
+                    ranges[2 * pos + 1] = get_max_trans_time(off_pt, inst, last_replica);
+                }
+                pos++;
+            }
+        }
+    }
+    
+    return pos;
+}
+
+/**
+ Patch all the links of the path that replaces a failed link at once. Every frame is patched in all the consecutive
+ links of the path where it is patched, one link after the other with the switch time between them, so the range of
+ the frame in the path is not split in a fixed part for every link. If the path can not be patched at once, the links
+ get back their own ranges and are patched one by one
+
+ @return 0 if all the links were patched, -1 otherwise
+ */
+int patch_failure_path(void) {
+    
+    Traffic *t = get_traffic();
+    int len_path = get_num_link_patches();
+    LS_Transmission **sorted_trans = calloc(len_path, sizeof(LS_Transmission *));
+    Timeline *timelines = calloc(len_path, sizeof(Timeline));
+    int *chain = malloc(sizeof(int) * len_path);
+    long long int *ranges = malloc(sizeof(long long int) * len_path);
+    int *done = calloc(t->num_frames + 1, sizeof(int));
+    long long int *link_ranges = malloc(sizeof(long long int) * 2 * (copy_path_ranges(t, NULL, 0) + 1));
+    if (sorted_trans == NULL || timelines == NULL || chain == NULL || ranges == NULL || done == NULL ||
+        link_ranges == NULL) {
+        fprintf(stderr, "Not enough memory to patch the path\n");
+        free(sorted_trans);
+        free(timelines);
+        free(chain);
+        free(ranges);
+        free(done);
+        free(link_ranges);
+        return -1;
+    }
+    
+    uint64_t starting = get_monotonic_time();
+    copy_path_ranges(t, link_ranges, 0);
+    int error = visit_path_chains(t, chain, done, ranges, NULL, NULL, 0);
+    
+    // The fixed traffic of every link of the path, copied if it was built before
+    int built = 0;
+    if (error == 0 && apply_path_plans(t, chain, done) == -1) {
+        for (int hop = 0; hop < len_path && error == 0; hop++) {
+            Link_Patch *link_patch = get_link_patch(hop);
+            Fixed_Timeline *fixed_pt = get_baseline_fixed(link_patch);
+            if (fixed_pt == NULL && scheduler->patch_index == gap_index && init_timeline(&timelines[hop]) == -1) {
+                error = -1;
+                break;
+            }
+            built = hop + 1;
+            if (fixed_pt != NULL) {
+                error = clone_fixed_traffic(fixed_pt, &sorted_trans[hop], &timelines[hop]);
+            } else {
+                error = prepare_fixed_traffic(&t->frames[link_patch->first_frame], link_patch->num_fixed,
+                                              &sorted_trans[hop], &timelines[hop]);
+            }
+        }
+        if (error == 0 && visit_path_chains(t, chain, done, ranges, sorted_trans, timelines, 0) == -1) {
+            error = -1;
+        }
+    }
+    
+    long long int execution_time = (long long int) (get_monotonic_time() - starting);
+    for (int hop = 0; hop < len_path; hop++) {
+        get_link_patch(hop)->patched = error == 0 ? 1 : 0;
+        get_link_patch(hop)->execution_time = execution_time;
+    }
+    for (int hop = 0; hop < built; hop++) {
+        if (scheduler->patch_index == gap_index) {
+            free_timeline(&timelines[hop]);
+        }
+        while (sorted_trans[hop] != NULL) {
+            LS_Transmission *next_pt = sorted_trans[hop]->next_transmission;
+            free(sorted_trans[hop]);
+            sorted_trans[hop] = next_pt;
+        }
+    }
+    free(sorted_trans);
+    free(timelines);
+    free(chain);
+    free(ranges);
+    free(done);
+    
+    // The path patch is never worse than patching the links one by one, as it falls back to it
+    if (error == -1) {
+        copy_path_ranges(t, link_ranges, 1);
+        error = patch_links();
+    }
+    free(link_ranges);
+    
+    return error;
+}
+
+/* Local search functions */
+
+/**
+ Compare two transmissions of the local search by their transmission time
+
+ @param a pointer to the first transmission
+ @param b pointer to the second transmission
+ @return negative if the first transmission goes first, positive otherwise
+ */
+int compare_search_transmissions(const void *a, const void *b) {
+    
+    const Search_Transmission *trans_a = a;
+    const Search_Transmission *trans_b = b;
+    
+    if (trans_a->starting != trans_b->starting) {
+        return trans_a->starting < trans_b->starting ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ Get the transmission time that leaves the same free time before and after a transmission, without leaving its
+ range nor overlapping the transmissions around it, so the smallest of both free times is as large as possible
+
+ @param trans list of transmissions sorted by their transmission time
+ @param num number of transmissions in the list
+ @param pos position of the transmission to move
+ @return new transmission time, the current one if it can not move
+ */
+long long int center_transmission(Search_Transmission *trans, int num, int pos) {
+    
+    Search_Transmission *trans_pt = &trans[pos];
+    long long int length = trans_pt->ending - trans_pt->starting;
+    long long int lb = trans_pt->min;
+    long long int ub = trans_pt->max;
+    if (pos > 0 && trans[pos - 1].ending > lb) {
+        lb = trans[pos - 1].ending;
+    }
+    if (pos < num - 1 && trans[pos + 1].starting - length < ub) {
+        ub = trans[pos + 1].starting - length;
+    }
+    if (lb > ub) {
+        return trans_pt->starting;
+    }
+    
+    // Without a transmission on one side, only the free time of the other side can grow
+    if (pos == 0) {
+        return lb;
+    }
+    if (pos == num - 1) {
+        return ub;
+    }
+    long long int centered = (trans[pos - 1].ending + trans[pos + 1].starting - length) / 2;
+    if (centered < lb) {
+        return lb;
+    }
+    if (centered > ub) {
+        return ub;
+    }
+    return centered;
+}
+
+/**
+ Improve the patched schedule moving the patched transmissions inside their ranges, so the free time between
+ consecutive transmissions of the link grows, the link distance that the optimize maximizes with the solver.
+ Every sweep centers every patched transmission between its neighbours, and the sweeps stop when nothing moves, when
+ LOCAL_SEARCH_SWEEPS are done or when the time limit of the scheduler is reached. The order of the transmissions
+ never changes, so the schedule stays valid after every move
+
+ @param t pointer to the patched traffic, the fixed frames first
+ @param fixed_frames number of fixed frames
+ @return 0 if done correctly, -1 otherwise
+ */
+int local_search_traffic(Traffic *t, int fixed_frames) {
+    
+    profile_phase(phase_search);
+    
+    SelfHealing_Protocol *shp = get_healing_protocol();
+    int instances_protocol = shp->period != 0 ? (int)(get_hyperperiod() / shp->period) : 0;
+    int num_trans = instances_protocol;
+    for (int fr_it = 0; fr_it < t->num_frames; fr_it++) {
+        num_trans += get_off_num_instances(get_offset_it(&t->frames[fr_it], 0));
+    }
+    Search_Transmission *trans = malloc(sizeof(Search_Transmission) * (num_trans + 1));
+    if (trans == NULL) {
+        fprintf(stderr, "Not enough memory for the local search\n");
+        return -1;
+    }
+    
+    // The reservations of the protocol and the fixed frames can not move
+    int pos = 0;
+    for (int i = 0; i < instances_protocol; i++) {
+        trans[pos].starting = shp->period * i;
+        trans[pos].ending = trans[pos].starting + shp->time;
+        trans[pos].min = trans[pos].starting;
+        trans[pos].max = trans[pos].starting;
+        trans[pos].offset_pt = NULL;
+        trans[pos].instance = 0;
+        pos++;
+    }
+    for (int fr_it = 0; fr_it < t->num_frames; fr_it++) {
+        // The patched traffic only has one offset, the strictly periodic ones would move all their instances at once
+        Offset *off_pt = get_offset_it(&t->frames[fr_it], 0);
+        int movable = fr_it >= fixed_frames && get_off_stored_instances(off_pt) == get_off_num_instances(off_pt);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            trans[pos].starting = get_trans_time(off_pt, inst, 0);
+            trans[pos].ending = trans[pos].starting + get_off_time(off_pt);
+            trans[pos].min = movable ? get_min_trans_time(off_pt, inst, 0) : trans[pos].starting;
+            trans[pos].max = movable ? get_max_trans_time(off_pt, inst, 0) : trans[pos].starting;
+            trans[pos].offset_pt = movable ? off_pt : NULL;
+            trans[pos].instance = inst;
+            pos++;
+        }
+    }
+    qsort(trans, num_trans, sizeof(Search_Transmission), compare_search_transmissions);
+    
+    uint64_t limit = get_monotonic_time() + (uint64_t) (scheduler->timelimit * 1000000000.0);
+    int moved = 1;
+    for (int sweep = 0; sweep < LOCAL_SEARCH_SWEEPS && moved == 1 && get_monotonic_time() < limit; sweep++) {
+        moved = 0;
+        for (int i = 0; i < num_trans; i++) {
+            if (trans[i].offset_pt == NULL) {
+                continue;
+            }
+            long long int starting = center_transmission(trans, num_trans, i);
+            if (starting != trans[i].starting) {
+                trans[i].ending += starting - trans[i].starting;
+                trans[i].starting = starting;
+                moved = 1;
+            }
+        }
+    }
+    
+    for (int i = 0; i < num_trans; i++) {
+        if (trans[i].offset_pt != NULL) {
+            set_trans_time(trans[i].offset_pt, trans[i].instance, 0, trans[i].starting);
+        }
+    }
+    free(trans);
+    
+    return 0;
+}
+
+/**
+ Copy the transmission times of the patched frames to the given memory, or from it if restore is 1
+
+ @param frames pointer to the patched frames
+ @param num number of patched frames
+ @param times memory with one transmission time per instance of the patched frames
+ @param restore 1 to write the times in the frames, 0 to read them from the frames
+ @return 0 if done correctly, -1 otherwise
+ */
+int copy_patch_times(Frame *frames, int num, long long int *times, int restore) {
+    
+    int pos = 0;
+    for (int fr_it = 0; fr_it < num; fr_it++) {
+        // The patched traffic only has one offset
+        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            if (restore == 1) {
+                set_trans_time(off_pt, inst, 0, times[pos]);
+            } else {
+                times[pos] = get_trans_time(off_pt, inst, 0);
+            }
+            pos++;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Add traffic with fixed transmission to the solver
+
+ @param frames pointer to the frames to allocate
+ @param num number of frames to fix
+ @return 0 if done corretly, -1 otherwise
+ */
+int add_fixed_traffic(Frame *frames, int num) {
+    
+    profile_phase(phase_variables);
+    
+    char name[100];
+    
+    // For all the fixed frames, add them into the solver with a fixed range
+    for (int fr_it = 0; fr_it < num; fr_it++) {
+        // The fixed traffic only has one offset
+        int frame_id = get_frame_id(fr_it);
+        Offset *off_pt = get_offset_it(&frames[fr_it], 0);
+        // Fix the transmission time in the model
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            sprintf(name, "Fix_Off_%d_%d", frame_id, inst);
+            long long int trans_time = get_trans_time(off_pt, inst, 0);
+            
+            if (solver_add_var(0, trans_time, trans_time, solver_integer, name) == -1) {
+                return -1;
+            }
+            set_var_name(off_pt, inst, 0, scheduler->var_it);
+            scheduler->var_it += 1;
+        }
+    }
+    
+    // Add all the variables for the self-healing protocol if it exists
+    SelfHealing_Protocol *shp = get_healing_protocol();
+    int instances_protocol = (int)(get_hyperperiod() / shp->period);
+    scheduler->var_shp_optimize = malloc(sizeof(int) * instances_protocol);
+    for (int i = 0; i < instances_protocol; i++) {
+        int trans_time = (int)(shp->period * i);
+        sprintf(name, "SHP_%d", i);
+        if (solver_add_var(0, trans_time, trans_time, solver_integer, name) == -1) {
+            return -1;
+        }
+        scheduler->var_shp_optimize[i] = scheduler->var_it;
+        scheduler->var_it += 1;
+    }
+    
+    solver_update();
+    
+    return 0;
+}
+
+/**
+ Add traffic to the solver with the avaiable range
+ 
+ @param frames pointer to the frames to allocate
+ @param num number of frames to fix
+ @param accum_num number of frames that were already created their offsets
+ @return 0 if done corretly, -1 otherwise
+ */
+int add_traffic_optimize(Frame *frames, int num, int accum_num) {
+    
+    profile_phase(phase_variables);
+    
+    char name[100];
+    
+    // For all the fixed frames, add them into the solver with a fixed range
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        int frame_id = get_frame_id(i);
+        Offset *off_pt = get_offset_it(&frames[i], 0);
+        // Fix the transmission time in the model
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            sprintf(name, "Off_%d_%d", frame_id, inst);
+            long long int lb = get_min_trans_time(off_pt, inst, 0);
+            long long int ub = get_max_trans_time(off_pt, inst, 0);
+            if (solver_add_var(0, lb, ub, solver_integer, name) == -1) {
+                return -1;
+            }
+            set_var_name(off_pt, inst, 0, scheduler->var_it);
+            scheduler->var_it += 1;
+        }
+    }
+    
+    solver_update();
+    
+    return 0;
+}
+
+/**
+ Init the variables that maximize the distances between transmission of frames and the link for the optimize
+ 
+ @param frames list of frames to create the contraint
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @param it iteration for creating the link intermission differently for each iteration
+ @return 0 if done correctly, -1 otherwise
+ */
+int create_intermission_variables_optimize(Frame *frames, int num, int accum_num, int it) {
+    
+    profile_phase(phase_variables);
+    
+    char name[100];
+    
+    // If link distances were init, remove the obj from them
+    if (scheduler->link_dis != NULL) {
+        solver_set_objective(scheduler->link_dis[0], 0.0);
+    }
+    
+    // Allocate to save the frame and link distances variables
+    scheduler->frame_dis = realloc(scheduler->frame_dis, sizeof(int) * (accum_num + num));
+    scheduler->link_dis = realloc(scheduler->link_dis, sizeof(int));
+    
+    // Create all the frame intermissions
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        sprintf(name, "FrameDis_%d", get_frame_id(i));
+        
+        // Calculate the maximum distance the frame could have
+        Offset *off_pt = get_offset_it(&frames[i], 0);
+        long long int max_distance = get_max_trans_time(off_pt, 0, 0) - get_min_trans_time(off_pt, 0, 0);
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            long long int distance = get_max_trans_time(off_pt, inst, 0) - get_min_trans_time(off_pt, inst, 0);;
+            if (max_distance < distance) {
+                max_distance = distance;
+            }
+        }
+    
+        if (solver_add_var(scheduler->frame_dis_w, 0, max_distance, solver_integer, name) == -1) {
+            return -1;
+        }
+        scheduler->frame_dis[i] = scheduler->var_it;
+        scheduler->var_it += 1;
+        
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            int var_off[] = {get_var_name(off_pt, inst, 0), scheduler->frame_dis[i]};
+            double val[] = {1, -1};
+            
+            // Offset - frame distance > LB
+            if (solver_add_constr(2, var_off, val, solver_greater_equal, get_min_trans_time(off_pt, inst, 0),
+                                  NULL) == -1) {
+                return -1;
+            }
+            
+            double val2[] = {1, 1};
+
+            // Offset - frame instance < UB
+            if (solver_add_constr(2, var_off, val2, solver_less_equal, get_max_trans_time(off_pt, inst, 0),
+                                  NULL) == -1) {
+                return -1;
+            }
+        }
+        
+    }
+    
+    // Create the link intermissions
+    sprintf(name, "LinkDis_%d", it);
+    if (solver_add_var(scheduler->link_dis_w, 0, get_hyperperiod(), solver_integer, name) == -1) {
+        return -1;
+    }
+    scheduler->link_dis[0] = scheduler->var_it;
+    scheduler->var_it += 1;
+    
+    return 0;
+}
+
+/**
+ Remember the starting value of a solver variable for the current optimize iteration
+
+ @param var solver variable
+ @param value starting value
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_start_value(int var, double value) {
+    
+    if (scheduler->num_starts == scheduler->size_starts) {
+        scheduler->size_starts = scheduler->size_starts == 0 ? 1024 : scheduler->size_starts * 2;
+        scheduler->start_vars = realloc(scheduler->start_vars, sizeof(int) * scheduler->size_starts);
+        scheduler->start_values = realloc(scheduler->start_values, sizeof(double) * scheduler->size_starts);
+        if (scheduler->start_vars == NULL || scheduler->start_values == NULL) {
+            fprintf(stderr, "Not enough memory for the starting values of the optimize\n");
+            return -1;
+        }
+    }
+    scheduler->start_vars[scheduler->num_starts] = var;
+    scheduler->start_values[scheduler->num_starts] = value;
+    scheduler->num_starts++;
+    
+    return 0;
+}
+
+/**
+ Give starting values to the binaries of the last collision constraint added, so they agree with the patched schedule.
+ The x binary is active if the transmission goes first, the y binary if the previous transmission goes first
+
+ @param trans_time transmission time of the transmission
+ @param distance1 time slots of the transmission
+ @param pre_trans_time transmission time of the previous transmission
+ @param distance2 time slots of the previous transmission
+ @param use_link 1 if the constraint uses the link distance, 0 otherwise
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_collision_start(long long int trans_time, long long int distance1, long long int pre_trans_time,
+                        long long int distance2, int use_link) {
+    
+    int first = trans_time <= pre_trans_time;
+    long long int slack = first ? pre_trans_time - trans_time - distance1 : trans_time - pre_trans_time - distance2;
+    
+    // The variables x, y and z are the last three added, or only x with the big-M encoding
+    if (scheduler->encoding == big_m_encoding && add_start_value(scheduler->var_it - 1, first ? 1.0 : 0.0) == -1) {
+        return -1;
+    }
+    if (scheduler->encoding != big_m_encoding &&
+        (add_start_value(scheduler->var_it - 3, first ? 1.0 : 0.0) == -1 ||
+         add_start_value(scheduler->var_it - 2, first ? 0.0 : 1.0) == -1 ||
+         add_start_value(scheduler->var_it - 1, 1.0) == -1)) {
+        return -1;
+    }
+    
+    // The link distance can not be larger than the free time between both transmissions
+    if (use_link == 1 && slack >= 0 && slack < scheduler->link_dis_start) {
+        scheduler->link_dis_start = slack;
+    }
+    
+    return 0;
+}
+
+/**
+ Set the patched schedule as starting solution of the solver for the frames of the current optimize iteration
+
+ @param frames list of frames to set the starting solution
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_start_optimize(Frame *frames, int num, int accum_num) {
+    
+    profile_phase(phase_start);
+    
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        Offset *off_pt = get_offset_it(&frames[i], 0);
+        
+        // The frame distance is the smallest distance of the transmissions to the limits of their windows
+        long long int frame_distance = get_hyperperiod();
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            long long int trans_time = get_trans_time(off_pt, inst, 0);
+            long long int distance = trans_time - get_min_trans_time(off_pt, inst, 0);
+            if (get_max_trans_time(off_pt, inst, 0) - trans_time < distance) {
+                distance = get_max_trans_time(off_pt, inst, 0) - trans_time;
+            }
+            if (distance < frame_distance) {
+                frame_distance = distance;
+            }
+            if (add_start_value(get_var_name(off_pt, inst, 0), (double) trans_time) == -1) {
+                return -1;
+            }
+        }
+        if (add_start_value(scheduler->frame_dis[i], (double) (frame_distance < 0 ? 0 : frame_distance)) == -1) {
+            return -1;
+        }
+    }
+    if (add_start_value(scheduler->link_dis[0], (double) scheduler->link_dis_start) == -1) {
+        return -1;
+    }
+    
+    for (int i = 0; i < scheduler->num_starts; i++) {
+        if (solver_set_start(scheduler->start_vars[i], scheduler->start_values[i]) == -1) {
+            return -1;
+        }
+    }
+    
+    // Prepare for the next iteration
+    scheduler->num_starts = 0;
+    scheduler->link_dis_start = get_hyperperiod();
+    
+    return 0;
+}
+
+/**
+ Check if the windows of all the instances of the transmissions of a frame in the view are sorted by start and end
+
+ @param view pointer to the view of the traffic
+ @param first position of the first transmission of the frame in the view
+ @param num_instances number of instances of the frame
+ @param num_replicas number of replicas of the frame
+ @return 1 if sorted, 0 otherwise
+ */
+int sorted_windows(Traffic_View *view, int first, int num_instances, int num_replicas) {
+    
+    for (int pos = first + num_replicas; pos < first + num_instances * num_replicas; pos += num_replicas) {
+        if (view->trans_min[pos] < view->trans_min[pos - num_replicas] ||
+            view->trans_max[pos] < view->trans_max[pos - num_replicas]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ Compare two transmissions by their transmission time, qsort style
+
+ @param a pointer to the transmission time and the end of the first transmission
+ @param b pointer to the transmission time and the end of the second transmission
+ @return negative if the first transmission goes first, positive if it goes later, 0 otherwise
+ */
+int compare_transmission_times(const void *a, const void *b) {
+    
+    long long int time_a = ((const long long int *)a)[0];
+    long long int time_b = ((const long long int *)b)[0];
+    
+    return time_a < time_b ? -1 : time_a > time_b;
+}
+
+/**
+ Lower the given distance to the smallest free time between two consecutive transmissions of the given offsets,
+ that have to be in the same link
+
+ @param offsets list of offsets of the link
+ @param num number of offsets in the list
+ @param distance pointer to the distance to lower
+ @return 0 if done correctly, -1 otherwise
+ */
+int min_transmission_slack(Offset **offsets, int num, long long int *distance) {
+    
+    int num_trans = 0;
+    for (int off_it = 0; off_it < num; off_it++) {
+        Offset *off = offsets[off_it];
+        num_trans += get_off_num_instances(off) * get_off_num_replicas(off);
+    }
+    
+    // Transmission time and end of every transmission, sorted by the transmission time
+    long long int *times = malloc(sizeof(long long int) * 2 * num_trans);
+    if (times == NULL) {
+        fprintf(stderr, "Not enough memory for the link distance\n");
+        return -1;
+    }
+    int it = 0;
+    for (int off_it = 0; off_it < num; off_it++) {
+        Offset *off = offsets[off_it];
+        for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+            for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                times[2 * it] = get_trans_time(off, inst, repl);
+                times[2 * it + 1] = times[2 * it] + get_off_time(off);
+                it++;
+            }
+        }
+    }
+    qsort(times, num_trans, sizeof(long long int) * 2, compare_transmission_times);
+    
+    for (int i = 1; i < num_trans; i++) {
+        long long int slack = times[2 * i] - times[2 * i - 1];
+        if (slack >= 0 && slack < *distance) {
+            *distance = slack;
+        }
+    }
+    free(times);
+    
+    return 0;
+}
+
+/**
+ Lower the starting value of the link distance to the smallest free time between two consecutive transmissions of
+ the patched schedule, as the no-overlap constraint has no disjunctions to compute it
+
+ @param frames list of frames with the patched schedule
+ @param num number of frames in the list
+ @return 0 if done correctly, -1 otherwise
+ */
+int start_link_distance(Frame *frames, int num) {
+    
+    Offset **offsets = malloc(sizeof(Offset*) * (num + 1));
+    if (offsets == NULL) {
+        fprintf(stderr, "Not enough memory for the starting link distance\n");
+        return -1;
+    }
+    for (int fr_it = 0; fr_it < num; fr_it++) {
+        offsets[fr_it] = get_offset_it(&frames[fr_it], 0);
+    }
+    int error = min_transmission_slack(offsets, num, &scheduler->link_dis_start);
+    free(offsets);
+    
+    return error;
+}
+
+/**
+ Avoid that any frame transmission collides at the same time on the optimize with the no-overlap constraints of the
+ link, covering all the frames added until this iteration and the reservation of the protocol
+
+ @param frames list of frames to create the constraint
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @return 0 if done correctly, -1 otherwise
+ */
+int no_overlap_optimize(Frame *frames, int num, int accum_num) {
+    
+    SelfHealing_Protocol *shp = get_healing_protocol();
+    int instances_protocol = (int)(get_hyperperiod() / shp->period);
+    
+    int num_frames = 0;
+    for (int fr_it = 0; fr_it < accum_num + num; fr_it++) {
+        Offset *off = get_offset_it(&frames[fr_it], 0);
+        num_frames += get_off_num_instances(off) * get_off_num_replicas(off);
+    }
+    
+    int *start_var = malloc(sizeof(int) * (num_frames + instances_protocol));
+    long long int *shift = malloc(sizeof(long long int) * (num_frames + instances_protocol));
+    long long int *length = malloc(sizeof(long long int) * (num_frames + instances_protocol));
+    if (start_var == NULL || shift == NULL || length == NULL) {
+        fprintf(stderr, "Not enough memory to avoid the collisions of the optimize\n");
+        free(start_var);
+        free(shift);
+        free(length);
+        return -1;
+    }
+    
+    int it = 0;
+    for (int fr_it = 0; fr_it < accum_num + num; fr_it++) {
+        it = add_offset_intervals(get_offset_it(&frames[fr_it], 0), start_var, shift, length, it);
+    }
+    for (int i = 0; i < instances_protocol; i++) {
+        start_var[it] = scheduler->var_shp_optimize[i];
+        shift[it] = 0;
+        length[it] = shp->time;
+        it++;
+    }
+    
+    int result = add_no_overlap_link(start_var, shift, length, num_frames, it, scheduler->link_dis[0]);
+    free(start_var);
+    free(shift);
+    free(length);
+    if (result == -1 || (scheduler->patch_times != NULL && start_link_distance(frames, accum_num + num) == -1)) {
+        return -1;
+    }
+    solver_update();
+    return 0;
+}
+
+/**
+ Avoid that the transmissions of the new frames collide with the ones of the previous frames and the reservation in the
+ optimize. The windows of the transmissions are read from the view of the traffic
+ 
+ @param frames list of frames to create the constraint
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @param first position of the first transmission of every frame in the view
+ @param sorted if the windows of the instances of every frame are sorted
+ @return 0 if done correctly, -1 otherwise
+ */
+int avoid_collision_view(Frame *frames, int num, int accum_num, int *first, char *sorted) {
+    
+    Traffic_View *view = scheduler->view;
+    SelfHealing_Protocol *shp = get_healing_protocol();
+    int instances_protocol = (int)(get_hyperperiod() / shp->period);
+    int link_inter = scheduler->link_dis[0];
+    
+    // For all frames, for all its offsets, if the offsets can collide, add constraint to avoid it
+    for (int fr_it = accum_num; (fr_it - accum_num) < num; fr_it++) {
+        Offset *off = get_offset_it(&frames[fr_it], 0);
+        int num_instances = get_off_num_instances(off);
+        int num_replicas = get_off_num_replicas(off);
+        int time = view->trans_time[first[fr_it]];
+        
+        // For all the frames that were added before, check if the offsets ids are the same to add the constraint
+        for (int pre_fr_it = 0; pre_fr_it < fr_it; pre_fr_it++) {
+            
+            Offset *pre_off = get_offset_it(&frames[pre_fr_it], 0);
+            int num_pre_instances = get_off_num_instances(pre_off);
+            int num_pre_replicas = get_off_num_replicas(pre_off);
+            int pre_time = view->trans_time[first[pre_fr_it]];
+            // If the windows of both offsets are sorted, we sweep them together and skip the ones that cannot overlap
+            int sweep = sorted[fr_it] && sorted[pre_fr_it];
+            int first_pre_inst = 0;
+            for (int inst = 0; inst < num_instances; inst++) {
+                
+                int pos = first[fr_it] + inst * num_replicas;
+                long long int min1 = view->trans_min[pos];
+                long long int max1 = view->trans_max[pos] + time;
+                while (sweep && first_pre_inst < num_pre_instances &&
+                       view->trans_max[first[pre_fr_it] + first_pre_inst * num_pre_replicas] + pre_time <= min1) {
+                    first_pre_inst++;
+                }
+                
+                for (int pre_inst = first_pre_inst; pre_inst < num_pre_instances; pre_inst++) {
+                    
+                    // Check if both offsets share an interval and we need to add the constraint
+                    int pre_pos = first[pre_fr_it] + pre_inst * num_pre_replicas;
+                    long long int min2 = view->trans_min[pre_pos];
+                    long long int max2 = view->trans_max[pre_pos] + pre_time;
+                    if (sweep && min2 >= max1) {
+                        break;
+                    }
+                    if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
+                        for (int repl = 0; repl < num_replicas; repl++) {
+                            for (int pre_repl = 0; pre_repl < num_pre_replicas; pre_repl++) {
+                                if (add_avoid_collision(get_var_name(off, inst, repl), time,
+                                                        view->trans_min[pos + repl], view->trans_max[pos + repl],
+                                                        get_var_name(pre_off, pre_inst, pre_repl), pre_time,
+                                                        view->trans_min[pre_pos + pre_repl],
+                                                        view->trans_max[pre_pos + pre_repl], link_inter) == -1) {
+                                    return -1;
+                                }
+                                if (scheduler->patch_times != NULL &&
+                                    add_collision_start(get_trans_time(off, inst, repl), time,
+                                                        get_trans_time(pre_off, pre_inst, pre_repl), pre_time,
+                                                        1) == -1) {
+                                    return -1;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        
+        // Take into account the SHP reservation too, only the reservations around the window can collide
+        for (int pos = first[fr_it]; pos < first[fr_it] + num_instances * num_replicas; pos++) {
+            
+            int inst = (pos - first[fr_it]) / num_replicas;
+            int repl = (pos - first[fr_it]) % num_replicas;
+            long long int min1 = view->trans_min[pos];
+            long long int max1 = view->trans_max[pos];
+            int first_i = (int)((min1 - shp->time) / shp->period);
+            if (first_i < 0) {
+                first_i = 0;
+            }
+            
+            for (int i = first_i; i < instances_protocol && (shp->period * i) < max1; i++) {
+                
+                long long int min2 = (shp->period * i);
+                long long int max2 = (shp->period * i) + shp->time;
+                
+                if ((min1 <= min2 && min2 < max1) || (min2 <= min1 && min1 < max2)) {
+                    if (add_avoid_collision(get_var_name(off, inst, repl), time, min1, max1,
+                                            scheduler->var_shp_optimize[i], shp->time, min2, min2, -1) == -1) {
+                        return -1;
+                    }
+                    if (scheduler->patch_times != NULL &&
+                        add_collision_start(get_trans_time(off, inst, repl), time, min2, shp->time, 0) == -1) {
+                        return -1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ Avoid that any frame transmission collides at the same time on the optimize
+ 
+ @param frames list of frames to create the constraint
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @return 0 if done correctly, -1 otherwise
+ */
+int avoid_collision_optimize(Frame *frames, int num, int accum_num) {
+    
+    profile_phase(phase_collision);
+    
+    // With the no-overlap encoding, the link does not need a disjunction for each pair of transmissions
+    if (scheduler->encoding == no_overlap_encoding) {
+        return no_overlap_optimize(frames, num, accum_num);
+    }
+    
+    // Find the transmissions of every frame in the view, and if the windows of its instances are sorted
+    int *first = malloc(sizeof(int) * (accum_num + num));
+    char *sorted = malloc(sizeof(char) * (accum_num + num));
+    if (first == NULL || sorted == NULL) {
+        fprintf(stderr, "Not enough memory to avoid the collisions of the optimize\n");
+        free(first);
+        free(sorted);
+        return -1;
+    }
+    for (int fr_it = 0; fr_it < accum_num + num; fr_it++) {
+        Offset *off = get_offset_it(&frames[fr_it], 0);
+        first[fr_it] = find_view_transmissions(scheduler->view, get_off_link_id(off), fr_it);
+        if (first[fr_it] == -1) {
+            fprintf(stderr, "The frame %d is not in the view of the traffic of the optimize\n", get_frame_id(fr_it));
+            free(first);
+            free(sorted);
+            return -1;
+        }
+        sorted[fr_it] = (char)sorted_windows(scheduler->view, first[fr_it], get_off_num_instances(off),
+                                             get_off_num_replicas(off));
+    }
+    
+    int result = avoid_collision_view(frames, num, accum_num, first, sorted);
+    free(first);
+    free(sorted);
+    if (result == -1) {
+        return -1;
+    }
+    solver_update();
+    return 0;
+}
+
+/* Heuristic functions */
+
+/**
+ Release the timelines of all the links
+ */
+void free_link_timelines(void) {
+    
+    if (scheduler->link_timelines != NULL) {
+        for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+            free_timeline(&scheduler->link_timelines[link_id]);
+        }
+        free(scheduler->link_timelines);
+        scheduler->link_timelines = NULL;
+    }
+}
+
+/**
+ Init the timelines of all the links with the bandwidth reservation of the self-healing protocol already occupied.
+ If a timeline fails, the ones already built are released
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int prepare_link_timelines(void) {
+    
+    SelfHealing_Protocol *protocol = get_healing_protocol();
+    
+    // The timelines not built yet have no memory, so all of them can be released if one fails
+    scheduler->link_timelines = calloc(get_higher_link_id() + 1, sizeof(Timeline));
+    if (scheduler->link_timelines == NULL) {
+        fprintf(stderr, "Not enough memory for the timelines of the heuristic\n");
+        return -1;
+    }
+    for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+        if (init_timeline(&scheduler->link_timelines[link_id]) == -1) {
+            free_link_timelines();
+            return -1;
+        }
+        // The reservation of the protocol is always in the same place of the period
+        if (protocol->period != 0) {
+            Offset *prot_off = get_offset_by_link(&protocol->reservation, link_id);
+            for (int inst = 0; inst < get_off_num_instances(prot_off); inst++) {
+                long long int trans_time = inst * get_period(&protocol->reservation);
+                set_trans_time(prot_off, inst, 0, trans_time);
+                if (occupy_timeline(&scheduler->link_timelines[link_id], trans_time,
+                                    trans_time + protocol->time - 1) == -1) {
+                    free_link_timelines();
+                    return -1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Free the memory that the scheduler keeps between the functions of an execution
+ */
+void free_scheduler_memory(void) {
+    
+    free_link_timelines();
+    if (scheduler->view != NULL) {
+        free_traffic_view(scheduler->view);
+        free(scheduler->view);
+        scheduler->view = NULL;
+    }
+    free(scheduler->frame_dis);
+    scheduler->frame_dis = NULL;
+    free(scheduler->link_dis);
+    scheduler->link_dis = NULL;
+    free(scheduler->var_shp_optimize);
+    scheduler->var_shp_optimize = NULL;
+    free(scheduler->patch_times);
+    scheduler->patch_times = NULL;
+    free(scheduler->window_starts);
+    scheduler->window_starts = NULL;
+    scheduler->num_windows = 0;
+}
+
+/**
+ Set the parameters of the scheduler to their default values
+ */
+void set_default_parameters(void) {
+    
+    scheduler->frame_dis_w = 0.9;
+    scheduler->link_dis_w = 0.1;
+    scheduler->algorithm = one_shot;
+    scheduler->frames_it = 1;
+    scheduler->MIPGAP = 0.25;
+    scheduler->timelimit = 0.35;
+    scheduler->warm_start = 0;
+    scheduler->presolve = 0;
+    scheduler->requested_presolve = 0;
+    scheduler->symmetry_breaking = 0;
+    scheduler->encoding = indicator_encoding;
+    scheduler->requested_encoding = indicator_encoding;
+    scheduler->patch_index = gap_index;
+    scheduler->patch_threads = 0;
+    scheduler->optimize_mode = patch_start;
+    scheduler->baseline = NULL;
+    scheduler->repair_cache = NULL;
+    scheduler->path_patch = 0;
+    scheduler->num_portfolio = 0;
+    scheduler->portfolio_deadline = 0;
+    scheduler->cancel = NULL;
+    scheduler->adaptive = 0;
+    scheduler->rollback = 0;
+}
+
+/**
+ Compare two frames to decide the order to schedule them in the heuristic.
+ Frames with smaller windows to transmit go first, as they have less freedom
+
+ @param a pointer to the position of the first frame
+ @param b pointer to the position of the second frame
+ @return negative if the first frame goes first, positive otherwise
+ */
+int compare_frames_heuristic(const void *a, const void *b) {
+    
+    Frame *frames = get_traffic()->frames;
+    Frame *frame_a = &frames[*(const int *)a];
+    Frame *frame_b = &frames[*(const int *)b];
+    long long int window_a = get_deadline(frame_a) - get_starting_time(frame_a);
+    long long int window_b = get_deadline(frame_b) - get_starting_time(frame_b);
+    
+    if (window_a != window_b) {
+        return window_a < window_b ? -1 : 1;
+    }
+    if (get_period(frame_a) != get_period(frame_b)) {
+        return get_period(frame_a) < get_period(frame_b) ? -1 : 1;
+    }
+    return *(const int *)a - *(const int *)b;
+}
+
+/**
+ Find the first time after the release where the offset fits in the timeline of its link.
+ If the offset is strictly periodic, all its instances a period after the first have to fit too, so when one of them
+ does not fit the first instance is moved later until all of them do
+
+ @param timeline_pt pointer to the timeline of the link
+ @param release first time the offset can be transmitted
+ @param ub last time the offset can be transmitted
+ @param off_pt pointer to the offset
+ @return time where the offset is transmitted, -1 if it does not fit
+ */
+long long int first_fit_offset(Timeline *timeline_pt, long long int release, long long int ub, Offset *off_pt) {
+    
+    long long int trans_time = first_fit_timeline(timeline_pt, release, get_off_time(off_pt));
+    int inst = 1;
+    while (trans_time != -1 && trans_time <= ub && get_off_period(off_pt) != 0 &&
+           inst < get_off_num_instances(off_pt)) {
+        long long int inst_time = trans_time + (get_off_period(off_pt) * inst);
+        long long int fit_time = first_fit_timeline(timeline_pt, inst_time, get_off_time(off_pt));
+        if (fit_time == inst_time) {
+            inst++;
+        } else if (fit_time == -1) {
+            trans_time = -1;
+        } else {
+            // Move the first instance as much as the instance that did not fit and start again
+            trans_time = first_fit_timeline(timeline_pt, fit_time - (get_off_period(off_pt) * inst),
+                                            get_off_time(off_pt));
+            inst = 1;
+        }
+    }
+    
+    return trans_time;
+}
+
+/**
+ Schedule one instance of a frame in all the links of its paths.
+ Every link takes the first free time after the previous link of the path, if the end to end delay is not
+ satisfied, the first link is moved later and the instance is tried again
+
+ @param frame_pt pointer to the frame
+ @param inst instance of the frame to schedule
+ @return 0 if done correctly, -1 if the instance could not be scheduled
+ */
+int heuristic_instance(Frame *frame_pt, int inst) {
+    
+    long long int lb = get_starting_time(frame_pt) + (get_period(frame_pt) * inst);
+    long long int first_release = lb;
+    
+    while (1) {
+        
+        // Forget the previous try
+        for (int j = 0; j < get_num_offsets(frame_pt); j++) {
+            Offset *off_pt = get_offset_it(frame_pt, j);
+            for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                set_trans_time(off_pt, inst, repl, -1);
+            }
+        }
+        
+        // Place every link of every path after the previous one, links shared between paths are placed once
+        long long int e2e_delay = 0;
+        for (int j = 0; j < get_num_paths(frame_pt); j++) {
+            Path *path_pt = get_path(frame_pt, j);
+            for (int h = 0; h < get_num_links_path(path_pt); h++) {
+                Offset *off_pt = get_offset_path_link(path_pt, h);
+                
+                // OFFSET + MIN TIME SWITCH + TRANSMISSION TIME <= NEXT OFFSET (after the last replica)
+                long long int release = first_release;
+                if (h > 0) {
+                    Offset *pre_off_pt = get_offset_path_link(path_pt, h - 1);
+                    release = get_trans_time(pre_off_pt, inst, get_off_num_replicas(pre_off_pt) - 1) +
+                              get_off_time(pre_off_pt) + get_switch_min_time();
+                }
+                
+                long long int trans_time = get_trans_time(off_pt, inst, 0);
+                if (trans_time == -1) {
+                    // Every replica goes after the previous one, and the last one has to end before the deadline.
+                    // If it does not fit before the deadline, moving the first link later will not help
+                    int num_replicas = get_off_num_replicas(off_pt);
+                    long long int ub = get_deadline(frame_pt) - (num_replicas * get_off_time(off_pt)) +
+                                       (get_period(frame_pt) * inst);
+                    for (int repl = 0; repl < num_replicas; repl++, ub += get_off_time(off_pt)) {
+                        long long int repl_time = first_fit_offset(&scheduler->link_timelines[get_off_link_id(off_pt)],
+                                                                   release, ub, off_pt);
+                        if (repl_time == -1 || repl_time > ub) {
+                            return -1;
+                        }
+                        set_trans_time(off_pt, inst, repl, repl_time);
+                        release = repl_time + get_off_time(off_pt);
+                    }
+                } else if (trans_time < release) {
+                    // The link was placed by another path with a different previous link
+                    return -1;
+                }
+            }
+            
+            // FIRST OFFSET + END TO END DELAY - TRANSMISSION TIME >= LAST OFFSET (0 => not taken into account)
+            if (get_end_to_end(frame_pt) != 0) {
+                Offset *first_off_pt = get_offset_path_link(path_pt, 0);
+                Offset *last_off_pt = get_offset_path_link(path_pt, get_num_links_path(path_pt) - 1);
+                long long int delay = get_trans_time(last_off_pt, inst, get_off_num_replicas(last_off_pt) - 1) -
+                                      get_trans_time(first_off_pt, inst, 0) -
+                                      (get_end_to_end(frame_pt) - get_off_time(first_off_pt));
+                if (delay > e2e_delay) {
+                    e2e_delay = delay;
+                }
+            }
+        }
+        
+        // If the end to end delay is not satisfied, the first link has to wait at least the delay exceeded
+        if (e2e_delay == 0) {
+            break;
+        }
+        first_release = get_trans_time(get_offset_path_link(get_path(frame_pt, 0), 0), inst, 0) + e2e_delay;
+    }
+    
+    // Everything fits, occupy the time of all the links, for all the instances if the offsets are strictly periodic
+    for (int j = 0; j < get_num_offsets(frame_pt); j++) {
+        Offset *off_pt = get_offset_it(frame_pt, j);
+        int last_inst = get_off_period(off_pt) != 0 ? get_off_num_instances(off_pt) : inst + 1;
+        for (int occ_inst = inst; occ_inst < last_inst; occ_inst++) {
+            for (int repl = 0; repl < get_off_num_replicas(off_pt); repl++) {
+                long long int trans_time = get_trans_time(off_pt, occ_inst, repl);
+                if (occupy_timeline(&scheduler->link_timelines[get_off_link_id(off_pt)], trans_time,
+                                    trans_time + get_off_time(off_pt) - 1) == -1) {
+                    return -1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Set the schedule found by the heuristic as starting solution of the solver for the given frames
+
+ @param frames list of frames to set the starting solution
+ @param num number of frames in the list
+ @param accum_num number of frames that were already created their offsets
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_start_offsets(Frame *frames, int num, int accum_num) {
+    
+    profile_phase(phase_start);
+    
+    for (int i = accum_num; (i - accum_num) < num; i++) {
+        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
+            Offset *off = get_offset_it(&frames[i], j);
+            for (int inst = 0; inst < get_off_stored_instances(off); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                    double trans_time = (double) get_trans_time(off, inst, repl);
+                    if (solver_set_start(get_var_name(off, inst, repl), trans_time) == -1) {
+                        return -1;
+                    }
+                }
+            }
+        }
+        // The heuristic places the frames without intermissions
+        solver_set_start(scheduler->frame_dis[i], 0.0);
+    }
+    for (int i = 0; i <= get_higher_link_id(); i++) {
+        solver_set_start(scheduler->link_dis[i], 0.0);
+    }
+    
+    return 0;
+}
+
+/* Incremental functions */
+
+/**
+ Fix the frames to the transmission times already saved in them, and remove their distances from the objective
+
+ @param frames list of frames to fix
+ @param num number of frames in the list
+ @return 0 if done correctly, -1 otherwise
+ */
+int fix_saved_offsets(Frame *frames, int num) {
+    
+    char name[100];
+    
+    for (int i = 0; i < num; i++) {
+        for (int j = 0; j < get_num_offsets(&frames[i]); j++) {
+            Offset *off = get_offset_it(&frames[i], j);
+            for (int inst = 0; inst < get_off_stored_instances(off); inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off); repl++) {
+                    sprintf(name, "Fix_%lld", scheduler->fix_con);
+                    int ind[] = {get_var_name(off, inst, repl)};
+                    double val[] = {1.0};
+                    if (solver_add_constr(1, ind, val, solver_equal, (double) get_trans_time(off, inst, repl),
+                                          name) == -1) {
+                        return -1;
+                    }
+                    scheduler->fix_con += 1;
+                }
+            }
+        }
+        solver_set_objective(scheduler->frame_dis[i], 0.0);
+    }
+    
+    return 0;
+}
+
+/**
+ Replace the model of the incremental approach by one with only the frames already scheduled, fixed to their
+ transmission times, so an iteration that found no schedule is tried again with less frames.
+ With the presolve, the scheduled frames are already reserved intervals, so the new model starts empty
+
+ @param frames list of frames
+ @param num number of frames already scheduled
+ @param it iteration of the new model, for the names of its link distances
+ @return 0 if done correctly, -1 otherwise
+ */
+int rebuild_incremental_model(Frame *frames, int num, int it) {
+    
+    if (reset_model() == -1) {
+        return -1;
+    }
+    if (scheduler->presolve == 1 || num == 0) {
+        return 0;
+    }
+    
+    if (create_offsets_variables(frames, num, 0, 1) == -1 || create_intermission_variables(frames, num, 0, it) == -1 ||
+        path_dependent(frames, num, 0) == -1 || end_to_end_delay(frames, num, 0) == -1 ||
+        contention_free(frames, num, 0) == -1 || fix_saved_offsets(frames, num) == -1) {
+        fprintf(stderr, "Failure adding the scheduled frames to the new model\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Undo the last windows of the incremental approach, so their frames are scheduled again together with the window
+ that found no schedule. The model is built again with the frames before them fixed, and with the presolve, the
+ timelines of the links are built again with only those frames reserved
+
+ @param frames list of frames
+ @param frames_scheduled pointer to the number of frames already scheduled, it goes back to the first undone frame
+ @param it iteration of the new model, for the names of its link distances
+ @return number of frames undone, 0 if there is no window to undo, -1 if something went wrong
+ */
+int rollback_windows(Frame *frames, int *frames_scheduled, int it) {
+    
+    int num = scheduler->rollback < scheduler->num_windows ? scheduler->rollback : scheduler->num_windows;
+    if (num == 0) {
+        return 0;
+    }
+    scheduler->num_windows -= num;
+    int first_frame = scheduler->window_starts[scheduler->num_windows];
+    int undone = *frames_scheduled - first_frame;
+    *frames_scheduled = first_frame;
+    
+    if (scheduler->presolve == 1) {
+        free_link_timelines();
+        if (prepare_link_timelines() == -1 ||
+            (first_frame > 0 && reserve_offsets(frames, first_frame, 0) == -1)) {
+            fprintf(stderr, "Failure reserving the frames before the rollback\n");
+            return -1;
+        }
+    }
+    if (rebuild_incremental_model(frames, first_frame, it) == -1) {
+        return -1;
+    }
+    
+    return undone;
+}
+
+/* Portfolio functions */
+
+/**
+ Get the smallest free time between two consecutive transmissions of the same link in the schedule of the current
+ network, the objective used to compare the schedules of the members of the portfolio
+
+ @param distance pointer where to save the distance, the hyperperiod if no link has two transmissions
+ @return 0 if done correctly, -1 otherwise
+ */
+int get_schedule_distance(long long int *distance) {
+    
+    *distance = get_hyperperiod();
+    for (int link_id = 0; link_id <= get_higher_link_id(); link_id++) {
+        int num = get_num_link_offsets(link_id);
+        if (num == 0) {
+            continue;
+        }
+        Offset **offsets = malloc(sizeof(Offset*) * num);
+        if (offsets == NULL) {
+            fprintf(stderr, "Not enough memory for the distance of the schedule\n");
+            return -1;
+        }
+        Link_Offset *link_off = get_link_offsets(link_id);
+        for (int i = 0; i < num; i++) {
+            offsets[i] = link_off[i].offset_pt;
+        }
+        int error = min_transmission_slack(offsets, num, distance);
+        free(offsets);
+        if (error == -1) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Schedule a new network read from the network file of the portfolio with the algorithm of a member
+
+ @param pool pointer to the shared state of the portfolio
+ @param member_pt pointer to the member
+ @param distance pointer where to save the distance of the schedule found
+ @return pointer to the network with the schedule, NULL if the member did not find one
+ */
+Network * run_portfolio_member(Portfolio_Pool *pool, Portfolio_Member *member_pt, long long int *distance) {
+    
+    Network *network_pt = new_network();
+    Scheduler_Context *scheduler_pt = new_scheduler_context();
+    if (network_pt == NULL || scheduler_pt == NULL) {
+        if (network_pt != NULL) {
+            free_network(network_pt);
+        }
+        if (scheduler_pt != NULL) {
+            free_scheduler_context(scheduler_pt);
+        }
+        return NULL;
+    }
+    
+    // The member runs in its own network and scheduler, with the parameters of the portfolio except its own ones
+    Network *current_network = get_network();
+    Scheduler_Context *current_scheduler = scheduler;
+    set_network(network_pt);
+    set_scheduler_context(scheduler_pt);
+    copy_scheduler_parameters(pool->scheduler_pt);
+    scheduler->algorithm = member_pt->algorithm;
+    scheduler->frames_it = member_pt->frames_it;
+    scheduler->MIPGAP = member_pt->MIPGAP;
+    scheduler->timelimit = member_pt->timelimit;
+    scheduler->cancel = &pool->cancel;
+    
+    int error = 0;
+    if (read_network_xml(pool->network_file) == -1 || set_periodic_offsets(pool->periodic_offsets) == -1 ||
+        set_frame_order(pool->frame_order) == -1 || prepare_network() == -1 || schedule_network() == -1 ||
+        get_schedule_distance(distance) == -1) {
+        error = -1;
+    }
+    
+    // The thread might end after the member, so the solver environment is not kept
+    reset_scheduler();
+    release_solver();
+    set_scheduler_context(current_scheduler);
+    set_network(current_network);
+    free_scheduler_context(scheduler_pt);
+    if (error == -1) {
+        free_network(network_pt);
+        return NULL;
+    }
+    
+    return network_pt;
+}
+
+/**
+ Thread that takes the next member of the portfolio until all the members are run. Once there is a winner, the
+ members not started yet are skipped if the first schedule found wins
+
+ @param pool_pt pointer to the shared state of the portfolio
+ @return NULL
+ */
+void * portfolio_member_thread(void *pool_pt) {
+    
+    Portfolio_Pool *pool = pool_pt;
+    
+    while (1) {
+        pthread_mutex_lock(&pool->lock);
+        int member = pool->next_member;
+        pool->next_member += 1;
+        pthread_mutex_unlock(&pool->lock);
+        if (member >= pool->num_members) {
+            break;
+        }
+        
+        long long int distance = 0;
+        Network *network_pt = NULL;
+        if (__atomic_load_n(&pool->cancel, __ATOMIC_RELAXED) == 0) {
+            network_pt = run_portfolio_member(pool, &pool->members[member], &distance);
+        }
+        
+        // The network of the loser, or of the previous winner, is released outside of the lock
+        pthread_mutex_lock(&pool->lock);
+        if (network_pt != NULL &&
+            (pool->winner_pt == NULL || (pool->keep_best == 1 && distance > pool->winner_distance))) {
+            Network *previous_pt = pool->winner_pt;
+            pool->winner_pt = network_pt;
+            pool->winner = member;
+            pool->winner_distance = distance;
+            network_pt = previous_pt;
+            if (pool->keep_best == 0) {
+                __atomic_store_n(&pool->cancel, 1, __ATOMIC_RELAXED);
+            }
+        }
+        pool->num_finished += 1;
+        pthread_cond_signal(&pool->finished);
+        pthread_mutex_unlock(&pool->lock);
+        if (network_pt != NULL) {
+            free_network(network_pt);
+        }
+    }
+    
+    return NULL;
+}
+
+/* Functions */
+
+/**
+ Get the execution time of the last algorithm applied
+ */
+long long int get_execution_time(void) {
+    
+    return (long long int) scheduler->execution_time;
+}
+
+/**
+ Schedule all the transmission times of all the frames at the same time given the given scheduling parameters.
+ It first init the solver and the variables for all the offsets transmission times between their deadlines.
+ Then avoid that any offset collides.
+ Forces that all frames has to wait at least a minimum switch time
+ There exist a limit between the time the transmission starts and the time all the receivers get the frame
+ If the protocol bandwitch is activated, avoid frames to the transmitted at the reserver bandwidth
+ There might optimization, such as minimize the timespan, of increase the reparability
+ */
+int one_shot_scheduling(void) {
+    
+    init_solver();
+    Traffic *t = get_traffic();
+    
+    if (create_offsets_variables(t->frames, t->num_frames, 0, 1) == -1) {
+        fprintf(stderr, "Failure creating offsets\n");
+        return -1;
+    }
+    
+    if (create_intermission_variables(t->frames, t->num_frames, 0, 0) == -1) {
+        fprintf(stderr, "Failure creating intermission variables\n");
+        return -1;
+    }
+
+    if (path_dependent(t->frames, t->num_frames, 0) == -1) {
+        fprintf(stderr, "Failure adding path dependent constraints\n");
+        return -1;
+    }
+
+    if (end_to_end_delay(t->frames, t->num_frames, 0) == -1) {
+        fprintf(stderr, "Failure adding end to end delay constraints\n");
+        return -1;
+    }
+
+    if (contention_free(t->frames, t->num_frames, 0) == -1) {
+        fprintf(stderr, "Failure adding contention free constraints\n");
+        return -1;
+    }
+    
+    if (scheduler->symmetry_breaking == 1 && break_symmetries(t->frames, t->num_frames) == -1) {
+        fprintf(stderr, "Failure adding symmetry breaking constraints\n");
+        return -1;
+    }
+    
+    // Start from the schedule of the heuristic if asked, if it fails the solver starts from nothing
+    if (scheduler->warm_start == 1) {
+        if (heuristic_scheduling() == 0) {
+            // The identical frames of the heuristic schedule might not follow the order of the symmetry breaking
+            if (scheduler->symmetry_breaking == 1) {
+                order_equivalent_frames(t->frames, t->num_frames);
+            }
+            set_start_offsets(t->frames, t->num_frames, 0);
+        } else {
+            fprintf(stderr, "The heuristic could not find a starting schedule\n");
+        }
+    }
+    
+    profile_phase(phase_solve);
+    solver_optimize();
+    
+    int solcount = solver_get_num_solutions();
+    if (solcount == 0) {
+        fprintf(stderr, "No schedule found\n");
+        return -1;
+    }
+    
+    // Save the obtained model into internal memory and check if the solver is correct (does not violate constraints)
+    save_offsets(t->frames, t->num_frames, 0);
+    if (check_schedule(t) != 0) {
+        fprintf(stderr, "The obtained schedule violates some of the given constraints\n");
+        return -1;
+    }
+    
+    close_solver();
+    return 0;
+}
+
+/**
+ Schedule all the tranmission times of all the frames iteratively.
+ The number of frames per each iteration and the timing limit is given in the scheduling paramenters file.
+ With the presolve, every iteration uses a new model where the frames scheduled before are reserved intervals
+ */
+int incremental_approach(void) {
+    
+    int frames_scheduled = 0;       // Number of frames already scheduled
+    int it = 1;                     // Number of iteration done in the incremental approach
+    int do_protocol = 1;            // Init variables of the self-healing protocol
+    int do_start = 0;               // 1 if the heuristic found a starting schedule, 0 otherwise
+    int rollbacks = 0;              // Number of rollbacks done
+    
+    init_solver();
+    Traffic *t = get_traffic();
+    scheduler->num_windows = 0;
+    scheduler->window_starts = realloc(scheduler->window_starts, sizeof(int) * (t->num_frames + 1));
+    if (scheduler->window_starts == NULL) {
+        fprintf(stderr, "Not enough memory for the windows of the incremental approach\n");
+        return -1;
+    }
+    
+    // Find the starting schedule of all the frames with the heuristic if asked
+    if (scheduler->warm_start == 1) {
+        if (heuristic_scheduling() == 0) {
+            do_start = 1;
+        } else {
+            fprintf(stderr, "The heuristic could not find a starting schedule\n");
+        }
+    }
+    
+    // With the presolve, the bandwidth reservation is a reserved interval from the start
+    if (scheduler->presolve == 1 && prepare_link_timelines() == -1) {
+        fprintf(stderr, "Failure preparing the timelines of the links\n");
+        free_link_timelines();
+        return -1;
+    }
+    
+    // While there are frames to schedule, we iterate
+    while (frames_scheduled < t->num_frames) {
+        
+        // Adjust the frame_it so it does not try to schedule frames that do not exist
+        if (frames_scheduled + scheduler->frames_it > t->num_frames) {
+            scheduler->frames_it = t->num_frames - frames_scheduled;
+        }
+        if (frames_scheduled == 0 && scheduler->presolve == 0) {
+            do_protocol = 1;
+        } else {
+            do_protocol = 0;
+        }
+        
+        // With the presolve, the frames scheduled before are not in the solver, so we start a new model
+        if (scheduler->presolve == 1 && frames_scheduled > 0 && reset_model() == -1) {
+            free_link_timelines();
+            return -1;
+        }
+        
+        if (create_offsets_variables(t->frames, scheduler->frames_it, frames_scheduled, do_protocol) == -1) {
+            fprintf(stderr, "Failure creating offsets\n");
+            return -1;
+        }
+        
+        if (create_intermission_variables(t->frames, scheduler->frames_it, frames_scheduled, it) == -1) {
+            fprintf(stderr, "Failure creating intermission variables\n");
+            return -1;
+        }
+        
+        if (path_dependent(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
+            fprintf(stderr, "Failure adding path dependent constraints\n");
+            return -1;
+        }
+        
+        if (end_to_end_delay(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
+            fprintf(stderr, "Failure adding end to end delay constraints\n");
+            return -1;
+        }
+        
+        if (contention_free(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
+            fprintf(stderr, "Failure adding contention free constraints\n");
+            return -1;
+        }
+        
+        if (do_start == 1) {
+            set_start_offsets(t->frames, scheduler->frames_it, frames_scheduled);
+        }
+        
+        profile_phase(phase_solve);
+        uint64_t solve_start = get_monotonic_time();
+        solver_optimize();
+        double solve_time = (double) (get_monotonic_time() - solve_start) / 1000000000.0;
+        
+        int solcount = solver_get_num_solutions();
+        // The adaptive window tries the same frames again with half of them, in a model without the failed ones
+        if (solcount == 0 && scheduler->adaptive == 1 && scheduler->frames_it > 1) {
+            fprintf(stderr, "No schedule found for the iteration %d, trying %d frames\n", it,
+                    scheduler->frames_it / 2);
+            scheduler->frames_it /= 2;
+            it += 1;
+            if (rebuild_incremental_model(t->frames, frames_scheduled, it) == -1) {
+                free_link_timelines();
+                return -1;
+            }
+            continue;
+        }
+        // With the adaptive window at its minimum, the last windows are undone and scheduled with the failed one
+        if (solcount == 0 && rollbacks < MAX_ROLLBACKS) {
+            it += 1;
+            int undone = rollback_windows(t->frames, &frames_scheduled, it);
+            if (undone == -1) {
+                free_link_timelines();
+                return -1;
+            }
+            if (undone > 0) {
+                fprintf(stderr, "No schedule found for the iteration %d, scheduling again the last %d frames\n",
+                        it - 1, undone);
+                scheduler->frames_it += undone;
+                rollbacks += 1;
+                continue;
+            }
+        }
+        if (solcount == 0) {
+            fprintf(stderr, "No schedule found for the iteration %d\n", it);
+            return -1;
+        }
+        
+        // Save the obtained model into internal memory and check if the solver is correct (does not violate constraints)
+        save_offsets(t->frames, scheduler->frames_it, frames_scheduled);
+        if (scheduler->presolve == 1 && reserve_offsets(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
+            fprintf(stderr, "Failure reserving the scheduled frames\n");
+            free_link_timelines();
+            return -1;
+        }
+        
+        // Adjust the indexes
+        it += 1;
+        scheduler->window_starts[scheduler->num_windows] = frames_scheduled;
+        scheduler->num_windows += 1;
+        frames_scheduled += scheduler->frames_it;
+        
+        // The adaptive window doubles when the solver was fast, and halves when it almost reached its time limit
+        if (scheduler->adaptive == 1 && solve_time < scheduler->timelimit * ADAPTIVE_GROW_TIME) {
+            scheduler->frames_it *= 2;
+        } else if (scheduler->adaptive == 1 && solve_time > scheduler->timelimit * ADAPTIVE_SHRINK_TIME &&
+                   scheduler->frames_it > 1) {
+            scheduler->frames_it /= 2;
+        }
+    }
+    free_link_timelines();
+    
+    if (check_schedule(t) != 0) {
+        fprintf(stderr, "The obtained schedule violates some of the given constraints\n");
+        return -1;
+    }
+    
+    close_solver();
+    return 0;
+}
+
+/**
+ Schedule all the transmission times of all the frames with a fast heuristic without the solver.
+ */
+int heuristic_scheduling(void) {
+    
+    profile_phase(phase_heuristic);
+    
+    Traffic *t = get_traffic();
+    
+    // Order in which the frames are scheduled
+    int *order = malloc(sizeof(int) * t->num_frames);
+    if (order == NULL) {
+        fprintf(stderr, "Not enough memory for the heuristic\n");
+        return -1;
+    }
+    for (int i = 0; i < t->num_frames; i++) {
+        order[i] = i;
+    }
+    qsort(order, t->num_frames, sizeof(int), compare_frames_heuristic);
+    
+    if (prepare_link_timelines() == -1) {
+        fprintf(stderr, "Failure preparing the timelines of the links\n");
+        free_link_timelines();
+        free(order);
+        return -1;
+    }
+    
+    // Schedule all the instances of a frame before going to the next one
+    for (int i = 0; i < t->num_frames; i++) {
+        // A cancelled heuristic stops between two frames
+        if (scheduler->cancel != NULL && __atomic_load_n(scheduler->cancel, __ATOMIC_RELAXED)) {
+            fprintf(stderr, "The heuristic was stopped\n");
+            free_link_timelines();
+            free(order);
+            return -1;
+        }
+        Frame *frame_pt = &t->frames[order[i]];
+        for (int inst = 0; inst < get_off_stored_instances(get_offset_it(frame_pt, 0)); inst++) {
+            if (heuristic_instance(frame_pt, inst) == -1) {
+                fprintf(stderr, "The frame %d could not be scheduled by the heuristic\n", get_frame_id(order[i]));
+                free_link_timelines();
+                free(order);
+                return -1;
+            }
+        }
+    }
+    free_link_timelines();
+    free(order);
+    
+    if (check_schedule(t) != 0) {
+        fprintf(stderr, "The obtained schedule violates some of the given constraints\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Schedule the network racing several algorithms, each one in its own thread with its own copy of the network
+ */
+int portfolio_scheduling(void) {
+    
+    if (get_network_file() == NULL) {
+        fprintf(stderr, "The portfolio needs the network to be read from a network file\n");
+        return -1;
+    }
+    
+    // Without members given, the three algorithms are raced with the parameters of the scheduler
+    Portfolio_Member members[MAX_PORTFOLIO_MEMBERS];
+    int num_members = scheduler->num_portfolio;
+    if (num_members == 0) {
+        Scheduler algorithms[3] = {heuristic, incremental, one_shot};
+        for (int i = 0; i < 3; i++) {
+            members[i].algorithm = algorithms[i];
+            members[i].frames_it = scheduler->frames_it;
+            members[i].MIPGAP = scheduler->MIPGAP;
+            members[i].timelimit = scheduler->timelimit;
+        }
+        num_members = 3;
+    } else {
+        memcpy(members, scheduler->portfolio, sizeof(Portfolio_Member) * num_members);
+    }
+    
+    Portfolio_Pool pool;
+    pool.members = members;
+    pool.num_members = num_members;
+    pool.next_member = 0;
+    pool.num_finished = 0;
+    pool.cancel = 0;
+    pool.keep_best = scheduler->portfolio_deadline > 0 ? 1 : 0;
+    pool.winner_pt = NULL;
+    pool.winner = -1;
+    pool.winner_distance = 0;
+    pool.network_file = get_network_file();
+    pool.periodic_offsets = get_network()->periodic_offsets;
+    pool.frame_order = get_frame_order();
+    pool.scheduler_pt = scheduler;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.finished, NULL);
+    
+    // The members read the network file at the same time, so the parser is initialized before
+    xmlInitParser();
+    pthread_t threads[MAX_PORTFOLIO_MEMBERS];
+    int created = 0;
+    for (int i = 0; i < num_members; i++) {
+        if (pthread_create(&threads[created], NULL, portfolio_member_thread, &pool) == 0) {
+            created++;
+        }
+    }
+    // If no thread can be created, the members are run one after the other
+    if (created == 0) {
+        portfolio_member_thread(&pool);
+    }
+    
+    // Wait for the first winner, or for the deadline if the best schedule wins
+    pthread_mutex_lock(&pool.lock);
+    if (pool.keep_best == 1) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        long long int nanoseconds = deadline.tv_nsec + (long long int) (scheduler->portfolio_deadline * 1000000000.0);
+        deadline.tv_sec += nanoseconds / 1000000000;
+        deadline.tv_nsec = nanoseconds % 1000000000;
+        while (pool.num_finished < num_members) {
+            if (pthread_cond_timedwait(&pool.finished, &pool.lock, &deadline) != 0) {
+                break;
+            }
+        }
+    } else {
+        while (pool.winner_pt == NULL && pool.num_finished < num_members) {
+            pthread_cond_wait(&pool.finished, &pool.lock);
+        }
+    }
+    __atomic_store_n(&pool.cancel, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool.finished);
+    pthread_mutex_destroy(&pool.lock);
+    
+    if (pool.winner_pt == NULL) {
+        fprintf(stderr, "No member of the portfolio found a schedule\n");
+        return -1;
+    }
+    
+    // The winning schedule is copied to the network of the portfolio, and checked again in it
+    int error = copy_network_schedule(pool.winner_pt);
+    free_network(pool.winner_pt);
+    if (error == -1 || check_schedule(get_traffic()) != 0) {
+        fprintf(stderr, "The schedule of the member %d of the portfolio could not be copied\n", pool.winner);
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Schedule the network given the parameters read before
+  */
+int schedule_network(void) {
+    
+    switch (scheduler->algorithm) {
+        case one_shot:
+            if (one_shot_scheduling() != 0) {
+                fprintf(stderr, "The schedule could not be found with the one-shot approach\n");
+                return -1;
+            }
+            break;
+            
+        case incremental:
+            if (incremental_approach() != 0) {
+                fprintf(stderr, "The schedule could not be found with the incremental approach\n");
+                return -1;
+            }
+            break;
+            
+        case heuristic:
+            if (heuristic_scheduling() != 0) {
+                fprintf(stderr, "The schedule could not be found with the heuristic\n");
+                return -1;
+            }
+            break;
+            
+        case portfolio:
+            if (portfolio_scheduling() != 0) {
+                fprintf(stderr, "The schedule could not be found with the portfolio\n");
+                return -1;
+            }
+            break;
+        default:
+            fprintf(stderr, "The given scheduler algorithm is not implemented\n");
+            return -1;
+            break;
+    }
+    return 0;
+}
+
+/**
+ Print the links that could not be patched in one message, so the messages of the failures patched at the same time
+ are not mixed
+ */
+void print_unpatched_links(void) {
+    
+    // Every link id takes at most 11 characters and its separator
+    char *links = malloc(13 * get_num_link_patches() + 1);
+    if (links == NULL) {
+        fprintf(stderr, "Some links could not be patched\n");
+        return;
+    }
+    int len_links = 0;
+    int unpatched = 0;
+    for (int i = 0; i < get_num_link_patches(); i++) {
+        if (get_link_patch(i)->patched == 0) {
+            len_links += sprintf(&links[len_links], unpatched == 0 ? "%d" : ", %d", get_link_patch(i)->link_id);
+            unpatched++;
+        }
+    }
+    if (unpatched > 0) {
+        fprintf(stderr, "The link%s %s could not be patched\n", unpatched == 1 ? "" : "s", links);
+    }
+    free(links);
+}
+
+/**
+ Patch the traffic in a fast heuristic
+ */
+int patch(void) {
+    
+    profile_phase(phase_patch);
+    
+    // Get the starting time to execute
+    scheduler->execution_time = get_monotonic_time();
+    
+    // Several links are patched independently, unless they are the path of a failure patched at once
+    if (get_num_link_patches() > 0) {
+        int derived = 1;
+        for (int i = 0; i < get_num_link_patches(); i++) {
+            derived = derived && get_link_patch(i)->baseline == 1;
+        }
+        int error = scheduler->path_patch == 1 && derived == 1 ? patch_failure_path() : patch_links();
+        if (error == -1) {
+            print_unpatched_links();
+        }
+        scheduler->execution_time = get_monotonic_time() - scheduler->execution_time;
+        return error;
+    }
+    
+    if (apply_repair_plan(scheduler->repair_cache, get_traffic(), get_num_fixed_frames(),
+                          get_network()->patched_link) == -1 &&
+        patch_traffic(get_traffic(), get_num_fixed_frames(), NULL) == -1) {
+        fprintf(stderr, "The traffic could not be patched\n");
+        scheduler->execution_time = get_monotonic_time() - scheduler->execution_time;
+        return -1;
+    }
+    
+    scheduler->execution_time = get_monotonic_time() - scheduler->execution_time;
+    
+    return 0;
+}
+
+/**
+ Set the structure used to search the free time slots when patching
+ */
+int set_patch_index(char *name) {
+    
+    if (strcmp(name, "LinkedList") == 0) {
+        scheduler->patch_index = linked_list;
+    } else if (strcmp(name, "GapIndex") == 0) {
+        scheduler->patch_index = gap_index;
+    } else {
+        fprintf(stderr, "The given patch index is not defined\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Set the number of threads used to patch several links at the same time
+ */
+int set_patch_threads(int num) {
+    
+    if (num < 0) {
+        fprintf(stderr, "The number of patching threads should be equal or larger than 0\n");
+        return -1;
+    }
+    
+    scheduler->patch_threads = num;
+    
+    return 0;
+}
+
+/**
+ Set how the optimize uses the schedule found by the patch
+ */
+int set_optimize_mode(char *name) {
+    
+    if (strcmp(name, "Cold") == 0) {
+        scheduler->optimize_mode = cold_start;
+    } else if (strcmp(name, "PatchStart") == 0) {
+        scheduler->optimize_mode = patch_start;
+    } else if (strcmp(name, "PatchFallback") == 0) {
+        scheduler->optimize_mode = patch_fallback;
+    } else if (strcmp(name, "LocalSearch") == 0) {
+        scheduler->optimize_mode = local_search;
+    } else {
+        fprintf(stderr, "The given optimize mode is not defined\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Set how the disjunctions that avoid the collisions are written in the solver
+ */
+int set_encoding(char *name) {
+    
+    if (strcmp(name, "Indicator") == 0) {
+        scheduler->encoding = indicator_encoding;
+    } else if (strcmp(name, "BigM") == 0) {
+        scheduler->encoding = big_m_encoding;
+    } else if (strcmp(name, "NoOverlap") == 0) {
+        scheduler->encoding = no_overlap_encoding;
+    } else {
+        fprintf(stderr, "The given encoding is not defined\n");
+        return -1;
+    }
+    scheduler->requested_encoding = scheduler->encoding;
+    
+    return 0;
+}
+
+/**
+ Set if the solver environment is kept loaded after the solver is closed
+ */
+int set_persistent_solver(int value) {
+    
+    if (value != 0 && value != 1) {
+        fprintf(stderr, "The persistent solver should be 0 or 1\n");
+        return -1;
+    }
+    
+    scheduler->persistent_solver = value;
+    
+    return 0;
+}
+
+/**
+ Release the solver environment kept loaded between executions
+ */
+int release_solver(void) {
+    
+    solver_free_environment();
+    
+    return 0;
+}
+
+/**
+ Release all the memory of the last execution and set the parameters to their default values
+ */
+int reset_scheduler(void) {
+    
+    // An execution that failed might have left its model open
+    solver_free_model();
+    free_scheduler_memory();
+    reset_profile();
+    scheduler->var_it = 0;
+    scheduler->num_starts = 0;
+    scheduler->link_dis_start = 0;
+    scheduler->execution_time = 0;
+    scheduler->path_con = 0;
+    scheduler->end_con = 0;
+    scheduler->avoid_con = 0;
+    scheduler->x_con = 0;
+    scheduler->y_con = 0;
+    scheduler->z_con = 0;
+    scheduler->or_con = 0;
+    scheduler->fix_con = 0;
+    scheduler->gap_con = 0;
+    scheduler->per_con = 0;
+    scheduler->sym_con = 0;
+    scheduler->noo_con = 0;
+    
+    // Parameters, as the next execution might not read them
+    set_default_parameters();
+    
+    return 0;
+}
+
+/**
+ Create a new scheduler with the default parameters
+ */
+Scheduler_Context * new_scheduler_context(void) {
+    
+    Scheduler_Context *scheduler_pt = calloc(1, sizeof(Scheduler_Context));
+    if (scheduler_pt == NULL) {
+        fprintf(stderr, "Not enough memory for the scheduler\n");
+        return NULL;
+    }
+    Scheduler_Context *current_pt = scheduler;
+    scheduler = scheduler_pt;
+    set_default_parameters();
+    scheduler = current_pt;
+    
+    return scheduler_pt;
+}
+
+/**
+ Release all the memory of a scheduler created with new_scheduler_context, and the scheduler itself
+ */
+int free_scheduler_context(Scheduler_Context *scheduler_pt) {
+    
+    if (scheduler_pt == NULL || scheduler_pt == &default_scheduler) {
+        fprintf(stderr, "Only the schedulers created with new_scheduler_context can be freed\n");
+        return -1;
+    }
+    
+    // The memory is released as the current scheduler of the thread, its network is still the one it used
+    Scheduler_Context *current_pt = scheduler;
+    scheduler = scheduler_pt;
+    free_scheduler_memory();
+    free(scheduler->start_vars);
+    free(scheduler->start_values);
+    scheduler = current_pt == scheduler_pt ? &default_scheduler : current_pt;
+    free(scheduler_pt);
+    
+    return 0;
+}
+
+/**
+ Set the scheduler the calling thread works on
+ */
+int set_scheduler_context(Scheduler_Context *scheduler_pt) {
+    
+    scheduler = scheduler_pt != NULL ? scheduler_pt : &default_scheduler;
     
-    GRBoptimize(model);
+    return 0;
+}
+
+/**
+ Get the scheduler the calling thread works on
+ */
+Scheduler_Context * get_scheduler_context(void) {
     
-    int solcount;
-    GRBgetintattr(model, GRB_INT_ATTR_SOLCOUNT, &solcount);
-    if (solcount == 0) {
-        fprintf(stderr, "No schedule found\n");
-        return -1;
-    }
+    return scheduler;
+}
+
+/**
+ Copy the parameters of the given scheduler to the current scheduler of the thread
+ */
+int copy_scheduler_parameters(Scheduler_Context *scheduler_pt) {
     
-    // Save the obtained model into internal memory and check if the solver is correct (does not violate constraints)
-    save_offsets(t->frames, t->num_frames, 0);
-    if (check_schedule(t->frames, t->num_frames) != 0) {
-        fprintf(stderr, "The obtained schedule violates some of the given constraints\n");
+    if (scheduler_pt == NULL) {
+        fprintf(stderr, "The given scheduler pointer is NULL\n");
         return -1;
     }
     
-    close_solver();
+    scheduler->frame_dis_w = scheduler_pt->frame_dis_w;
+    scheduler->link_dis_w = scheduler_pt->link_dis_w;
+    scheduler->algorithm = scheduler_pt->algorithm;
+    scheduler->frames_it = scheduler_pt->frames_it;
+    scheduler->MIPGAP = scheduler_pt->MIPGAP;
+    scheduler->timelimit = scheduler_pt->timelimit;
+    scheduler->warm_start = scheduler_pt->warm_start;
+    scheduler->presolve = scheduler_pt->presolve;
+    scheduler->requested_presolve = scheduler_pt->requested_presolve;
+    scheduler->symmetry_breaking = scheduler_pt->symmetry_breaking;
+    scheduler->encoding = scheduler_pt->encoding;
+    scheduler->requested_encoding = scheduler_pt->requested_encoding;
+    scheduler->patch_index = scheduler_pt->patch_index;
+    scheduler->patch_threads = scheduler_pt->patch_threads;
+    scheduler->optimize_mode = scheduler_pt->optimize_mode;
+    scheduler->persistent_solver = scheduler_pt->persistent_solver;
+    scheduler->adaptive = scheduler_pt->adaptive;
+    scheduler->rollback = scheduler_pt->rollback;
+    scheduler->path_patch = scheduler_pt->path_patch;
+    memcpy(scheduler->portfolio, scheduler_pt->portfolio, sizeof(Portfolio_Member) * scheduler_pt->num_portfolio);
+    scheduler->num_portfolio = scheduler_pt->num_portfolio;
+    scheduler->portfolio_deadline = scheduler_pt->portfolio_deadline;
+    
     return 0;
 }
 
 /**
- Schedule all the tranmission times of all the frames iteratively.
- The number of frames per each iteration and the timing limit is given in the scheduling paramenters file
+ Build the fixed traffic of every link of the current network, that has to be scheduled
  */
-int incremental_approach(void) {
+int build_baseline_timelines(Baseline_Timelines *baseline) {
     
-    int frames_scheduled = 0;       // Number of frames already scheduled
-    int it = 1;                     // Number of iteration done in the incremental approach
-    int do_protocol = 1;            // Init variables of the self-healing protocol
+    if (baseline == NULL) {
+        fprintf(stderr, "The given baseline pointer is NULL\n");
+        return -1;
+    }
+    memset(baseline, 0, sizeof(Baseline_Timelines));
+    if (get_network()->link_offsets == NULL) {
+        fprintf(stderr, "The network has to be scheduled to build the fixed traffic of its links\n");
+        return -1;
+    }
     
-    init_solver();
-    Traffic *t = get_traffic();
+    baseline->num_links = get_higher_link_id() + 1;
+    baseline->patch_index = scheduler->patch_index;
+    baseline->links = calloc(baseline->num_links, sizeof(Fixed_Timeline));
+    if (baseline->links == NULL) {
+        fprintf(stderr, "Not enough memory for the fixed traffic of the links\n");
+        return -1;
+    }
     
-    // While there are frames to schedule, we iterate
-    while (frames_scheduled < t->num_frames) {
-        
-        // Adjust the frame_it so it does not try to schedule frames that do not exist
-        if (frames_scheduled + frames_it > t->num_frames) {
-            frames_it = t->num_frames - frames_scheduled;
-        }
-        if (frames_scheduled == 0) {
-            do_protocol = 1;
-        } else {
-            do_protocol = 0;
-        }
-        
-        if (create_offsets_variables(t->frames, frames_it, frames_scheduled, do_protocol) == -1) {
-            fprintf(stderr, "Failure creating offsets\n");
-            return -1;
-        }
-        
-        if (create_intermission_variables(t->frames, frames_it, frames_scheduled, it) == -1) {
-            fprintf(stderr, "Failure creating intermission variables\n");
-            return -1;
-        }
-        
-        if (path_dependent(t->frames, frames_it, frames_scheduled) == -1) {
-            fprintf(stderr, "Failure adding path dependent constraints\n");
-            return -1;
+    for (int link_id = 0; link_id < baseline->num_links; link_id++) {
+        if (get_link(link_id) == NULL) {
+            continue;
         }
-        
-        if (end_to_end_delay(t->frames, frames_it, frames_scheduled) == -1) {
-            fprintf(stderr, "Failure adding end to end delay constraints\n");
+        Fixed_Timeline *fixed_pt = &baseline->links[link_id];
+        if (scheduler->patch_index == gap_index && init_timeline(&fixed_pt->timeline) == -1) {
+            free_baseline_timelines(baseline);
             return -1;
         }
+        fixed_pt->built = 1;
         
-        if (contention_free(t->frames, frames_it, frames_scheduled) == -1) {
-            fprintf(stderr, "Failure adding contention free constraints\n");
-            return -1;
+        // Same transmissions as the fixed frames of the patches, from the transmission time to the ending
+        Link_Offset *link_offsets = get_link_offsets(link_id);
+        int error = 0;
+        for (int i = 0; i < get_num_link_offsets(link_id) && error == 0; i++) {
+            Offset *off_pt = link_offsets[i].offset_pt;
+            int time_slots = get_off_time(off_pt) - 1;
+            for (int inst = 0; inst < get_off_num_instances(off_pt) && error == 0; inst++) {
+                for (int repl = 0; repl < get_off_num_replicas(off_pt) && error == 0; repl++) {
+                    long long int trans_time = get_trans_time(off_pt, inst, repl);
+                    error = add_fixed_trans(trans_time, trans_time + time_slots, &fixed_pt->sorted_trans,
+                                            &fixed_pt->timeline);
+                }
+            }
         }
-        
-        GRBoptimize(model);
-        
-        int solcount;
-        GRBgetintattr(model, GRB_INT_ATTR_SOLCOUNT, &solcount);
-        if (solcount == 0) {
-            fprintf(stderr, "No schedule found for the iteration %d\n", it);
+        if (error == -1 || reserve_protocol_traffic(&fixed_pt->sorted_trans, &fixed_pt->timeline) == -1) {
+            fprintf(stderr, "Error building the fixed traffic of the link %d\n", link_id);
+            free_baseline_timelines(baseline);
             return -1;
         }
-        
-        // Save the obtained model into internal memory and check if the solver is correct (does not violate constraints)
-        save_offsets(t->frames, frames_it, frames_scheduled);
-        
-        // Adjust the indexes
-        it += 1;
-        frames_scheduled += frames_it;
     }
     
-    if (check_schedule(t->frames, t->num_frames) != 0) {
-        fprintf(stderr, "The obtained schedule violates some of the given constraints\n");
+    return 0;
+}
+
+/**
+ Release the memory of the fixed traffic of the links of a baseline schedule
+ */
+int free_baseline_timelines(Baseline_Timelines *baseline) {
+    
+    if (baseline == NULL) {
+        fprintf(stderr, "The given baseline pointer is NULL\n");
         return -1;
     }
     
-    close_solver();
+    for (int link_id = 0; link_id < baseline->num_links && baseline->links != NULL; link_id++) {
+        Fixed_Timeline *fixed_pt = &baseline->links[link_id];
+        if (fixed_pt->built == 0) {
+            continue;
+        }
+        if (baseline->patch_index == gap_index) {
+            free_timeline(&fixed_pt->timeline);
+        }
+        while (fixed_pt->sorted_trans != NULL) {
+            LS_Transmission *next_pt = fixed_pt->sorted_trans->next_transmission;
+            free(fixed_pt->sorted_trans);
+            fixed_pt->sorted_trans = next_pt;
+        }
+    }
+    free(baseline->links);
+    baseline->links = NULL;
+    baseline->num_links = 0;
+    
     return 0;
 }
 
 /**
- Schedule the network given the parameters read before
-  */
-int schedule_network(void) {
+ Set the fixed traffic that the current scheduler copies when it patches the links derived from a baseline schedule
+ */
+int set_baseline_timelines(Baseline_Timelines *baseline) {
+    
+    scheduler->baseline = baseline;
     
-    switch (algorithm) {
-        case one_shot:
-            if (one_shot_scheduling() != 0) {
-                fprintf(stderr, "The schedule could not be found with the one-shot approach\n");
-                return -1;
-            }
-            break;
-            
-        case incremental:
-            if (incremental_approach() != 0) {
-                fprintf(stderr, "The schedule could not be found with the incremental approach\n");
-                return -1;
-            }
-            break;
-        default:
-            fprintf(stderr, "The given scheduler algorithm is not implemented\n");
-            return -1;
-            break;
-    }
     return 0;
 }
 
 /**
- Patch the traffic in a fast heuristic
+ Set the repair plans that the current scheduler searches before patching a link
  */
-int patch(void) {
+int set_repair_cache(struct Repair_Cache *cache) {
     
-    // Get the starting time to execute
-    execution_time = clock_gettime_nsec_np(CLOCK_REALTIME);
+    scheduler->repair_cache = cache;
     
-    Traffic *t = get_traffic();
-    int fixed_frames = get_num_fixed_frames();
+    return 0;
+}
+
+/**
+ Get the objective that the optimize maximizes for the current transmission times of the traffic, the weighted frame
+ distances of the patched frames and the link distance of all the frames
+
+ @param frames list of frames of the traffic, the fixed frames first
+ @param fixed_frames number of fixed frames
+ @param num_frames number of frames in the list
+ @param objective pointer where to save the objective
+ @return 0 if done correctly, -1 otherwise
+ */
+int get_optimize_objective(Frame *frames, int fixed_frames, int num_frames, double *objective) {
     
-    // Prepare the fixed traffic
-    if (prepare_fixed_traffic(t->frames, fixed_frames) == -1) {
-        fprintf(stderr, "Error preparing the fixed traffic when patching\n");
-        execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-        return -1;
+    *objective = 0.0;
+    for (int i = fixed_frames; i < num_frames; i++) {
+        Offset *off_pt = get_offset_it(&frames[i], 0);
+        
+        // The frame distance is the smallest distance of the transmissions to the limits of their windows
+        long long int frame_distance = -1;
+        for (int inst = 0; inst < get_off_num_instances(off_pt); inst++) {
+            long long int trans_time = get_trans_time(off_pt, inst, 0);
+            long long int distance = trans_time - get_min_trans_time(off_pt, inst, 0);
+            if (get_max_trans_time(off_pt, inst, 0) - trans_time < distance) {
+                distance = get_max_trans_time(off_pt, inst, 0) - trans_time;
+            }
+            if (frame_distance == -1 || distance < frame_distance) {
+                frame_distance = distance;
+            }
+        }
+        *objective += scheduler->frame_dis_w * (double) (frame_distance < 0 ? 0 : frame_distance);
     }
     
-    // For all frames, allocate a frame at a time
-    if (allocate_patch_traffic(&t->frames[fixed_frames], t->num_frames - fixed_frames) == -1) {
-        execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-        fprintf(stderr, "Error allocating traffic when patching\n");
+    Offset **offsets = malloc(sizeof(Offset*) * (num_frames + 1));
+    if (offsets == NULL) {
+        fprintf(stderr, "Not enough memory for the objective of the optimize\n");
         return -1;
     }
+    for (int i = 0; i < num_frames; i++) {
+        offsets[i] = get_offset_it(&frames[i], 0);
+    }
+    long long int link_distance = get_hyperperiod();
+    int error = min_transmission_slack(offsets, num_frames, &link_distance);
+    free(offsets);
+    *objective += scheduler->link_dis_w * (double) link_distance;
     
-    execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
+    return error;
+}
+
+/**
+ Finish the optimize, releasing the patched schedule and saving the execution time
+
+ @param error value to return
+ @return the given error
+ */
+int finish_optimize(int error) {
     
-    return 0;
+    free(scheduler->patch_times);
+    scheduler->patch_times = NULL;
+    scheduler->execution_time = get_monotonic_time() - scheduler->execution_time;
+    
+    return error;
 }
 
 /**
@@ -1426,18 +4517,56 @@ int patch(void) {
 int optimize(void) {
     
     // Get the starting time to execute
-    execution_time = clock_gettime_nsec_np(CLOCK_REALTIME);
+    scheduler->execution_time = get_monotonic_time();
     
     Traffic *t = get_traffic();
     int fixed_frames = get_num_fixed_frames();
+    
+    // The local search improves the patched schedule without the solver
+    if (scheduler->optimize_mode == local_search) {
+        profile_phase(phase_patch);
+        int error = patch_traffic(t, fixed_frames, NULL);
+        if (error == 0) {
+            error = local_search_traffic(t, fixed_frames);
+        } else {
+            fprintf(stderr, "The traffic could not be patched for the local search\n");
+        }
+        scheduler->execution_time = get_monotonic_time() - scheduler->execution_time;
+        return error;
+    }
 
     init_solver();
     
+    // The collisions read the ranges of the transmissions to optimize from the view of the traffic
+    if (prepare_scheduler_view(0) == -1) {
+        fprintf(stderr, "Error building the view of the traffic when optimizing\n");
+        return finish_optimize(-1);
+    }
+    
     // Add the fixed traffic to the solver
     if (add_fixed_traffic(t->frames, fixed_frames) == -1) {
         fprintf(stderr, "Error adding the fixed variables to the solver when optimizing\n");
-        execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-        return -1;
+        return finish_optimize(-1);
+    }
+    
+    // Patch the traffic first so the solver can start from the patched schedule
+    double patch_objective = 0.0;
+    if (scheduler->optimize_mode != cold_start) {
+        profile_phase(phase_patch);
+        int num_patch_times = 0;
+        for (int i = fixed_frames; i < t->num_frames; i++) {
+            num_patch_times += get_off_num_instances(get_offset_it(&t->frames[i], 0));
+        }
+        scheduler->patch_times = malloc(sizeof(long long int) * (num_patch_times + 1));
+        if (scheduler->patch_times != NULL && patch_traffic(t, fixed_frames, NULL) == 0 &&
+            get_optimize_objective(t->frames, fixed_frames, t->num_frames, &patch_objective) == 0) {
+            copy_patch_times(&t->frames[fixed_frames], t->num_frames - fixed_frames, scheduler->patch_times, 0);
+            scheduler->link_dis_start = get_hyperperiod();
+        } else {
+            fprintf(stderr, "The traffic could not be patched, the optimize starts from nothing\n");
+            free(scheduler->patch_times);
+            scheduler->patch_times = NULL;
+        }
     }
     
     int frames_scheduled = fixed_frames;        // Number of frames already scheduled
@@ -1447,56 +4576,77 @@ int optimize(void) {
     while (frames_scheduled < t->num_frames) {
         
         // Adjust the frame_it so it does not try to schedule frames that do not exist
-        if (frames_scheduled + frames_it > t->num_frames) {
-            frames_it = t->num_frames - frames_scheduled;
+        if (frames_scheduled + scheduler->frames_it > t->num_frames) {
+            scheduler->frames_it = t->num_frames - frames_scheduled;
         }
         
         // Allocate a frame at a time
-        if (add_traffic_optimize(t->frames, frames_it, frames_scheduled) == -1) {
+        if (add_traffic_optimize(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
             fprintf(stderr, "Error allocating traffic when optimizing\n");
-            execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-            return -1;
+            return finish_optimize(-1);
         }
         
         // Create the intermission variables to maximize
-        if (create_intermission_variables_optimize(t->frames, frames_it, frames_scheduled, it) == -1) {
+        if (create_intermission_variables_optimize(t->frames, scheduler->frames_it, frames_scheduled, it) == -1) {
             fprintf(stderr, "Failure creating intermission variables\n");
-            execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-            return -1;
+            return finish_optimize(-1);
         }
         
         // Avoid collision for the new allocated frames
-        if (avoid_collision_optimize(t->frames, frames_it, frames_scheduled) == -1) {
+        if (avoid_collision_optimize(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
             fprintf(stderr, "Error avoiding collision when optimizing\n");
-            execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-            return -1;
+            return finish_optimize(-1);
+        }
+        
+        // Start from the patched schedule, the previous frames are already fixed to the values of the solver
+        if (scheduler->patch_times != NULL &&
+            set_start_optimize(t->frames, scheduler->frames_it, frames_scheduled) == -1) {
+            fprintf(stderr, "Error setting the patched schedule as start when optimizing\n");
+            return finish_optimize(-1);
         }
         
-        GRBoptimize(model);
+        profile_phase(phase_solve);
+        solver_optimize();
         
-        // GRBwrite(model, "model.lp");
+        // solver_write("model.lp");
         
-        int solcount;
-        GRBgetintattr(model, GRB_INT_ATTR_SOLCOUNT, &solcount);
+        int solcount = solver_get_num_solutions();
         if (solcount == 0) {
+            // The patched schedule is only valid as a whole, so all the frames go back to it
+            if (scheduler->patch_times != NULL && scheduler->optimize_mode == patch_fallback) {
+                fprintf(stderr, "No schedule found for the iteration %d, the patched schedule is kept\n", it);
+                copy_patch_times(&t->frames[fixed_frames], t->num_frames - fixed_frames, scheduler->patch_times, 1);
+                close_solver();
+                return finish_optimize(0);
+            }
             fprintf(stderr, "No schedule found for the iteration %d\n", it);
-            execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
-            return -1;
+            return finish_optimize(-1);
         }
         
         // Save the obtained model into internal memory and check if the solver is correct
-        save_offsets(t->frames, frames_it, frames_scheduled);
+        save_offsets(t->frames, scheduler->frames_it, frames_scheduled);
         
         // Adjust the indexes
         it += 1;
-        frames_scheduled += frames_it;
+        frames_scheduled += scheduler->frames_it;
     }
     
-    close_solver();
+    // The solver always has the patched schedule as start, so it is kept unless the solver strictly improved it
+    if (scheduler->patch_times != NULL && scheduler->optimize_mode == patch_fallback) {
+        double objective;
+        if (get_optimize_objective(t->frames, fixed_frames, t->num_frames, &objective) == -1) {
+            close_solver();
+            return finish_optimize(-1);
+        }
+        if (objective <= patch_objective) {
+            fprintf(stderr, "The optimize did not improve the patched schedule, the patched schedule is kept\n");
+            copy_patch_times(&t->frames[fixed_frames], t->num_frames - fixed_frames, scheduler->patch_times, 1);
+        }
+    }
     
-    execution_time = clock_gettime_nsec_np(CLOCK_REALTIME) - execution_time;
+    close_solver();
     
-    return 0;
+    return finish_optimize(0);
 }
 
 /* Input Functions */
@@ -1536,11 +4686,102 @@ double get_float_value_xml(xmlDoc *top_xml, char *path) {
     return return_value;
 }
 
+/**
+ Read the optional parameters of the portfolio, the time it waits for the best schedule and its members. Every member
+ takes the parameters of the portfolio that it does not give
+
+ @param top_xml pointer to the top of the xml tree
+ @return 0 if done correctly, -1 otherwise
+ */
+int read_portfolio_xml(xmlDoc *top_xml) {
+    
+    xmlXPathContextPtr context = xmlXPathNewContext(top_xml);
+    xmlXPathObjectPtr result;
+    xmlChar *value;
+    
+    // The frames per iteration of the incremental members are optional
+    result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/FramesIteration", context);
+    if (result->nodesetval->nodeTab != NULL) {
+        value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+        scheduler->frames_it = atoi((char *)value);
+        xmlFree(value);
+    }
+    xmlXPathFreeObject(result);
+    
+    // The deadline is optional, if it is not given the first schedule found wins
+    result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Deadline", context);
+    if (result->nodesetval->nodeTab != NULL) {
+        value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+        scheduler->portfolio_deadline = atof((char *)value);
+        xmlFree(value);
+        if (scheduler->portfolio_deadline < 0.0) {
+            fprintf(stderr, "The deadline of the portfolio should be equal or larger than 0.0\n");
+            xmlXPathFreeObject(result);
+            xmlXPathFreeContext(context);
+            return -1;
+        }
+    }
+    xmlXPathFreeObject(result);
+    
+    // The members are optional, if none is given the three algorithms are raced
+    int error = 0;
+    scheduler->num_portfolio = 0;
+    result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Member", context);
+    for (int i = 0; result->nodesetval->nodeTab != NULL && i < result->nodesetval->nodeNr && error == 0; i++) {
+        if (scheduler->num_portfolio == MAX_PORTFOLIO_MEMBERS) {
+            fprintf(stderr, "The portfolio can not have more than %d members\n", MAX_PORTFOLIO_MEMBERS);
+            error = -1;
+            break;
+        }
+        Portfolio_Member *member_pt = &scheduler->portfolio[scheduler->num_portfolio];
+        member_pt->frames_it = scheduler->frames_it;
+        member_pt->MIPGAP = scheduler->MIPGAP;
+        member_pt->timelimit = scheduler->timelimit;
+        
+        // The algorithm is read with the same names as the one of the scheduler
+        Scheduler algorithm = scheduler->algorithm;
+        value = xmlGetProp(result->nodesetval->nodeTab[i], (xmlChar*) "name");
+        if (value == NULL || set_algorithm((char *)value) != 0 || scheduler->algorithm == portfolio) {
+            fprintf(stderr, "The algorithm of the member %d of the portfolio was wrongly read\n", i);
+            error = -1;
+        }
+        member_pt->algorithm = scheduler->algorithm;
+        scheduler->algorithm = algorithm;
+        xmlFree(value);
+        
+        for (xmlNode *node = result->nodesetval->nodeTab[i]->children; node != NULL && error == 0; node = node->next) {
+            if (node->type != XML_ELEMENT_NODE) {
+                continue;
+            }
+            value = xmlNodeListGetString(top_xml, node->xmlChildrenNode, 1);
+            if (xmlStrcmp(node->name, (xmlChar*) "FramesIteration") == 0) {
+                member_pt->frames_it = atoi((char *)value);
+            } else if (xmlStrcmp(node->name, (xmlChar*) "MIPGAP") == 0) {
+                member_pt->MIPGAP = atof((char *)value);
+            } else if (xmlStrcmp(node->name, (xmlChar*) "TimeLimit") == 0) {
+                member_pt->timelimit = atof((char *)value);
+            }
+            xmlFree(value);
+        }
+        if (member_pt->frames_it < 1 || member_pt->MIPGAP < 0.0 || member_pt->timelimit < 0.0) {
+            fprintf(stderr, "The parameters of the member %d of the portfolio were wrongly read\n", i);
+            error = -1;
+        }
+        scheduler->num_portfolio += 1;
+    }
+    
+    xmlXPathFreeObject(result);
+    xmlXPathFreeContext(context);
+    return error;
+}
+
 /**
  Read the scheduler parameters
  */
 int read_schedule_parameters_xml(char *parameters_xml) {
     
+    profile_phase(phase_read);
+    
     // Init xml variables needed to search information in the file
     xmlChar *value = NULL, *value2;
     xmlXPathContextPtr context;
@@ -1568,21 +4809,103 @@ int read_schedule_parameters_xml(char *parameters_xml) {
         return -1;
     }
     
-    MIPGAP = get_float_value_xml(top_xml, "/Configuration/Schedule/Algorithm/MIPGAP");
-    if (set_MIPGAP(MIPGAP) != 0) {
-        fprintf(stderr, "The MIPGAP was wrongly read\n");
-        return -1;
+    // The strictly periodic mode is optional, if it is not given all the instances of the frames are scheduled
+    xmlXPathFreeObject(result);
+    xmlXPathFreeContext(context);
+    context = xmlXPathNewContext(top_xml);
+    result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/StrictlyPeriodic", context);
+    int strictly_periodic = 0;
+    if (result->nodesetval->nodeTab != NULL) {
+        value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+        strictly_periodic = atoi((char *)value);
+        if (set_periodic_offsets(strictly_periodic) != 0) {
+            fprintf(stderr, "The strictly periodic mode was wrongly read\n");
+            return -1;
+        }
+        xmlFree(value);
+        value = NULL;
     }
-    timelimit = get_float_value_xml(top_xml, "/Configuration/Schedule/Algorithm/TimeLimit");
-    if (set_timelimit(timelimit) != 0) {
-        fprintf(stderr, "The time limit was wrongly read\n");
-        return -1;
+    
+    // The path patch is optional, if it is not given the links of the path of a failure are patched one by one
+    xmlXPathFreeObject(result);
+    xmlXPathFreeContext(context);
+    context = xmlXPathNewContext(top_xml);
+    result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/PathPatch", context);
+    if (result->nodesetval->nodeTab != NULL) {
+        value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+        if (set_path_patch(atoi((char *)value)) != 0) {
+            fprintf(stderr, "The path patch was wrongly read\n");
+            return -1;
+        }
+        xmlFree(value);
+        value = NULL;
+    }
+    
+    // The heuristic does not use the solver, so it does not need its parameters
+    if (scheduler->algorithm != heuristic) {
+        MIPGAP = get_float_value_xml(top_xml, "/Configuration/Schedule/Algorithm/MIPGAP");
+        if (set_MIPGAP(MIPGAP) != 0) {
+            fprintf(stderr, "The MIPGAP was wrongly read\n");
+            return -1;
+        }
+        timelimit = get_float_value_xml(top_xml, "/Configuration/Schedule/Algorithm/TimeLimit");
+        if (set_timelimit(timelimit) != 0) {
+            fprintf(stderr, "The time limit was wrongly read\n");
+            return -1;
+        }
+        
+        // The encoding is optional, if it is not given the disjunctions use indicator constraints
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Encoding", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_encoding((char *)value) != 0) {
+                fprintf(stderr, "The encoding was wrongly read\n");
+                return -1;
+            }
+            xmlFree(value);
+            value = NULL;
+        }
+        
+        // The symmetry breaking is optional, if it is not given the identical frames are not ordered
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/SymmetryBreaking", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_symmetry_breaking(atoi((char *)value)) != 0) {
+                fprintf(stderr, "The symmetry breaking was wrongly read\n");
+                return -1;
+            }
+            xmlFree(value);
+            value = NULL;
+        }
+        
+        // The warm start is optional, if it is not given the solver starts from nothing
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/WarmStart", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_warm_start(atoi((char *)value)) != 0) {
+                fprintf(stderr, "The warm start was wrongly read\n");
+                return -1;
+            }
+            xmlFree(value);
+            value = NULL;
+        }
     }
     
     // If the algorithm is the incremental approach, read also the number of frames scheduled per iteration
-    if (algorithm == incremental) {
+    if (scheduler->algorithm == incremental) {
         
         // Search for the value
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
         context = xmlXPathNewContext(top_xml);
         result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/FramesIteration", context);
         if (result->nodesetval->nodeTab == NULL) {
@@ -1590,7 +4913,75 @@ int read_schedule_parameters_xml(char *parameters_xml) {
             return -1;
         }
         value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
-        frames_it = atoi((char *)value);
+        scheduler->frames_it = atoi((char *)value);
+        
+        // The presolve is optional, if it is not given the scheduled frames stay fixed in the solver
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Presolve", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            xmlFree(value);
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_presolve(atoi((char *)value)) != 0) {
+                fprintf(stderr, "The presolve was wrongly read\n");
+                return -1;
+            }
+            // The reserved intervals can only keep all the instances of the scheduled frames
+            if (scheduler->presolve == 1 && strictly_periodic == 1) {
+                fprintf(stderr, "The presolve is not used with strictly periodic frames\n");
+                scheduler->presolve = 0;
+            }
+        }
+    }
+    
+    // The adaptive window, the rollback and the order of the frames are optional, for the incremental approach and
+    // its members
+    if (scheduler->algorithm == incremental || scheduler->algorithm == portfolio) {
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Adaptive", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            xmlFree(value);
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_adaptive(atoi((char *)value)) != 0) {
+                fprintf(stderr, "The adaptive window was wrongly read\n");
+                return -1;
+            }
+        }
+        
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/Rollback", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            xmlFree(value);
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_rollback(atoi((char *)value)) != 0) {
+                fprintf(stderr, "The rollback was wrongly read\n");
+                return -1;
+            }
+        }
+        
+        xmlXPathFreeObject(result);
+        xmlXPathFreeContext(context);
+        context = xmlXPathNewContext(top_xml);
+        result = xmlXPathEvalExpression((xmlChar*) "/Configuration/Schedule/Algorithm/FrameOrder", context);
+        if (result->nodesetval->nodeTab != NULL) {
+            xmlFree(value);
+            value = xmlNodeListGetString(top_xml, result->nodesetval->nodeTab[0]->xmlChildrenNode, 1);
+            if (set_incremental_order((char *)value) != 0) {
+                fprintf(stderr, "The frame order was wrongly read\n");
+                return -1;
+            }
+        }
+    }
+    
+    // The portfolio reads also its members, that take the parameters above when they do not give their own
+    if (scheduler->algorithm == portfolio && read_portfolio_xml(top_xml) != 0) {
+        fprintf(stderr, "Error reading the portfolio\n");
+        return -1;
     }
     
     // Free xml objects
@@ -10,6 +10,8 @@
  *  The main approaches used are one-shot and incremental.                                                             *
  *  Every technique has a different performance. The better performance, the worse "quality".                          *
  *  Also numerous optimizations can be applied to different techniques to try to modify the "quality" of the schedules *
+ *  The state of the scheduler is kept in a Scheduler_Context structure, and every thread works on its current one,    *
+ *  together with its current network.                                                                                 *
  *                                                                                                                     *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -17,8 +19,12 @@
 #define Scheduler_h
 
 #include <stdio.h>
-#include <gurobi_c.h>
-#include <Time.h>
+#include "Solver.h"
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "Timeline.h"
 
 #endif /* Scheduler_h */
 
@@ -26,9 +32,85 @@
 
 typedef enum Scheduler{
     one_shot,
-    incremental
+    incremental,
+    heuristic,
+    portfolio
 }Scheduler;
 
+#define MAX_PORTFOLIO_MEMBERS 16        // Maximum number of algorithms raced by the portfolio
+#define ADAPTIVE_GROW_TIME 0.25         // Part of the time limit under which the adaptive window doubles
+#define ADAPTIVE_SHRINK_TIME 0.9        // Part of the time limit over which the adaptive window halves
+#define MAX_ROLLBACKS 8                 // Maximum number of rollbacks of the incremental approach in one schedule
+#define LOCAL_SEARCH_SWEEPS 100         // Maximum number of sweeps of the local search over the transmissions of a link
+
+/**
+ Algorithm raced by the portfolio, with its own parameters
+ */
+typedef struct Portfolio_Member {
+    Scheduler algorithm;                // Algorithm of the member, it can not be the portfolio
+    int frames_it;                      // Frames solved at each iteration if the member is the incremental approach
+    double MIPGAP;                      // MIP GAP limit of the member
+    double timelimit;                   // Time limit of the member (per iteration for the incremental approach)
+}Portfolio_Member;
+
+/**
+ Structure used to search the free time slots of the link when patching
+ */
+typedef enum Patch_Index{
+    linked_list,
+    gap_index
+}Patch_Index;
+
+/**
+ How the optimize uses the schedule found by the patch
+ */
+typedef enum Optimize_Mode{
+    cold_start,                 // The solver starts from nothing
+    patch_start,                // The solver starts from the patched schedule
+    patch_fallback,             // As the patch start, but the patched schedule is kept unless the solver improves it
+    local_search                // The patched schedule is improved by a local search, without the solver
+}Optimize_Mode;
+
+/**
+ How the disjunctions that avoid the collision of two transmissions are written in the solver
+ */
+typedef enum Encoding{
+    indicator_encoding,         // Two binaries forced by an or, and an indicator constraint for each order
+    big_m_encoding,             // One binary and two linear constraints relaxed by the bounds of the transmissions
+    no_overlap_encoding         // One no-overlap constraint over the intervals of each link, if the solver has them
+}Encoding;
+
+/**
+ Shared state of the threads that patch several links at the same time
+ */
+typedef struct Patch_Pool {
+    int next_patch;                 // Position of the next link to patch
+    pthread_mutex_t lock;           // Lock to take the next link to patch
+    struct Network *network_pt;     // Network of the thread that patches the links
+    struct Scheduler_Context *scheduler_pt;     // Scheduler of the thread that patches the links
+}Patch_Pool;
+
+/**
+ Shared state of the threads that run the members of the portfolio, each one in its own network and scheduler
+ */
+typedef struct Portfolio_Pool {
+    Portfolio_Member *members;      // Members to run
+    int num_members;                // Number of members to run
+    int next_member;                // Position of the next member to run
+    int num_finished;               // Number of members that finished, with or without a schedule
+    int cancel;                     // Flag that stops the members that are still running when it is not 0
+    int keep_best;                  // 1 if the best schedule found before the deadline wins, 0 if the first one
+    struct Network *winner_pt;      // Network of the member with the winning schedule, NULL if none was found
+    int winner;                     // Position of the member with the winning schedule, -1 if none was found
+    long long int winner_distance;  // Smallest free time between two transmissions of a link in the winning schedule
+    pthread_mutex_t lock;           // Lock of the winner and the counters
+    pthread_cond_t finished;        // Signaled every time a member finishes
+    char *network_file;             // Network file that every member reads in its own network
+    int periodic_offsets;           // 1 if the networks of the members only store the first instance of the offsets
+    int frame_order;                // Order of the frames in the networks of the members
+    struct Scheduler_Context *scheduler_pt;     // Scheduler with the parameters of the members
+}Portfolio_Pool;
+
 /**
  Sorted linked list transmission block
  */
@@ -38,6 +120,98 @@ typedef struct LS_Transmission{
     struct LS_Transmission *next_transmission;
 }LS_Transmission;
 
+/**
+ Transmission of the link improved by the local search
+ */
+typedef struct Search_Transmission {
+    long long int starting;             // Transmission time
+    long long int ending;               // End of the transmission, the next transmission can start at it
+    long long int min;                  // Earliest transmission time allowed
+    long long int max;                  // Latest transmission time allowed
+    struct Offset *offset_pt;           // Offset of the transmission, NULL if it can not be moved
+    int instance;                       // Instance of the offset
+}Search_Transmission;
+
+/**
+ Fixed traffic of a link in a baseline schedule, with the reservations of the self-healing protocol, built once so
+ every patch of the link copies it instead of building it again
+ */
+typedef struct Fixed_Timeline {
+    int built;                          // 1 if the fixed traffic of the link is built, 0 otherwise
+    LS_Transmission *sorted_trans;      // Sorted transmissions of the link when patching with the linked list
+    Timeline timeline;                  // Free gaps of the link when patching with the gap index
+}Fixed_Timeline;
+
+/**
+ Fixed traffic of all the links of a baseline schedule, shared by all the patches of its failures
+ */
+typedef struct Baseline_Timelines {
+    Fixed_Timeline *links;              // Fixed traffic of every link, indexed by link id
+    int num_links;                      // Number of positions of the links, the higher link id plus one
+    Patch_Index patch_index;            // Structure of the timelines, the patches with another one do not use them
+}Baseline_Timelines;
+
+/**
+ Structure with all the state of the scheduler, so several patches, optimizations or schedules can run at the same
+ time in one process, each one on its own thread with its own network. Every thread works on its current scheduler,
+ the default one until it sets another
+ */
+typedef struct Scheduler_Context {
+    int var_it;                         // Iterator to remember the value to position variables in the solver
+    int *frame_dis;                     // Indexes for the solver variables for the frame distances
+    int *link_dis;                      // Indexes for the solver variables for the link distances
+    double frame_dis_w;                 // Weight for the frame distances
+    double link_dis_w;                  // Link for the link distances
+    long long int path_con;             // Counter of path dependent constraints
+    long long int end_con;              // Counter of end to end constraints
+    long long int avoid_con;            // Counter of avoid collission constraints
+    long long int x_con;                // Counter of x bin variables
+    long long int y_con;                // Counter of y bin variables
+    long long int z_con;                // Counter of z bin variables
+    long long int or_con;               // Counter of z = x or y variables
+    long long int fix_con;              // Counter of fixed variables
+    int frames_it;                      // Frames solved at each iteration of the incremental approach
+    Scheduler algorithm;                // Algorithm used to schedule the network
+    double MIPGAP;                      // MIP GAP limit when to stop searching
+    double timelimit;                   // Time limit when to stop executing the solver (in the case of the incremetal
+                                        // it is the time limit PER ITERATION)
+    Patch_Index patch_index;            // Structure used to search the free time slots when patching
+    int patch_threads;                  // Threads to patch several links, 0 to use one per processor
+    uint64_t execution_time;            // Execution time of the patch or optimization algorithm
+    int *var_shp_optimize;              // Gurobi variables for the SHP reservation for the optimize
+    Timeline *link_timelines;           // Free time of every link, indexed by link id
+    int warm_start;                     // 1 if the solver starts from the schedule of the heuristic, 0 otherwise
+    Optimize_Mode optimize_mode;        // How the optimize uses the schedule found by the patch
+    long long int *patch_times;         // Transmission times found by the patch to start the optimize, NULL if not used
+    int *start_vars;                    // Gurobi variables that get a starting value in the current optimize iteration
+    double *start_values;               // Starting values of the variables in the current optimize iteration
+    int num_starts;                     // Number of starting values in the current optimize iteration
+    int size_starts;                    // Number of starting values allocated
+    long long int link_dis_start;       // Largest link distance that the starting schedule satisfies
+    int presolve;                       // 1 if the incremental replaces the scheduled frames by reserved intervals
+    int requested_presolve;             // Presolve that was set, the runs only use it if the solver can
+    long long int gap_con;              // Counter of gap constraints of the reserved intervals
+    long long int per_con;              // Counter of strictly periodic avoid collision constraints
+    int symmetry_breaking;              // 1 if the one-shot orders the identical frames, 0 otherwise
+    Encoding encoding;                  // Encoding of the disjunctions that avoid the collisions
+    Encoding requested_encoding;        // Encoding that was set, every run falls back from it if the solver can not
+    long long int sym_con;              // Counter of symmetry breaking constraints
+    long long int noo_con;              // Counter of no-overlap constraints
+    int persistent_solver;              // 1 if the solver environment is kept loaded between executions, 0 otherwise
+    Baseline_Timelines *baseline;       // Fixed traffic of the baseline schedule for the patches, NULL if not used
+    Portfolio_Member portfolio[MAX_PORTFOLIO_MEMBERS];  // Members of the portfolio, its algorithms and parameters
+    int num_portfolio;                  // Number of members of the portfolio, 0 to race the three algorithms
+    double portfolio_deadline;          // Seconds the portfolio waits for the best schedule, 0 to take the first one
+    int *cancel;                        // Flag that stops the algorithm when it is not 0, NULL if it is never stopped
+    int adaptive;                       // 1 if the incremental approach adapts its window to the time of the solver
+    int rollback;                       // Windows the incremental approach schedules again when one fails, 0 if none
+    int *window_starts;                 // First frame of every window scheduled by the incremental approach
+    int num_windows;                    // Number of windows scheduled by the incremental approach
+    struct Repair_Cache *repair_cache;  // Repair plans searched before patching a link, NULL if not used
+    int path_patch;                     // 1 if the links of the path of a failure are patched at once, 0 if one by one
+    struct Traffic_View *view;          // Timing of the frames being scheduled, NULL until their variables are created
+}Scheduler_Context;
+
                                                 /* AUXILIAR FUNCTIONS */
 
                                                 /* CODE DEFINITIONS */
@@ -64,6 +238,24 @@ int one_shot_scheduling(void);
  */
 int incremental_approach(void);
 
+/**
+ Schedule all the transmission times of all the frames with a fast heuristic without the solver.
+ Frames are placed one instance at a time in the first free time of every link of their paths
+
+ @return 0 if the schedule was found, -1 otherwise
+ */
+int heuristic_scheduling(void);
+
+/**
+ Schedule the network racing several algorithms, each one in its own thread with its own copy of the network read
+ again from the network file. Without a deadline, the first member that finds a valid schedule wins and the others
+ are stopped. With a deadline, the members run until it is reached and the schedule with the largest free time
+ between the transmissions of the links wins
+
+ @return 0 if the schedule was found, -1 otherwise
+ */
+int portfolio_scheduling(void);
+
 /**
  Schedule the network given the parameters read before
 
@@ -72,12 +264,29 @@ int incremental_approach(void);
 int schedule_network(void);
 
 /**
- Patch the traffic in a fast heuristic
+ Patch the traffic in a fast heuristic.
+ If several links were read, every link is patched independently by a pool of threads
 
  @return 0 if patch was found, -1 otherwise
  */
 int patch(void);
 
+/**
+ Set the number of threads used to patch several links at the same time
+
+ @param num number of threads, 0 to use one per available processor
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_patch_threads(int num);
+
+/**
+ Set the structure used to search the free time slots when patching
+
+ @param name name of the structure ("LinkedList" or "GapIndex")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_patch_index(char *name);
+
 /**
  Optimize the traffic that was patched before
 
@@ -86,7 +295,127 @@ int patch(void);
 int optimize(void);
 
 /**
- Read the scheduler parameters
+ Set how the optimize uses the schedule found by the patch. The local search does not use the solver, it only moves
+ the patched transmissions inside their ranges to leave more free time between them, until the time limit
+
+ @param name name of the mode ("Cold", "PatchStart", "PatchFallback" or "LocalSearch")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_optimize_mode(char *name);
+
+/**
+ Set how the disjunctions that avoid the collisions are written in the solver, for the one-shot, the incremental and
+ the optimize
+
+ @param name name of the encoding ("Indicator", "BigM" or "NoOverlap")
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_encoding(char *name);
+
+/**
+ Set if the solver environment is kept loaded after the solver is closed, so the following executions do not load it
+
+ @param value 1 to keep the environment loaded, 0 to release it every time
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_persistent_solver(int value);
+
+/**
+ Release the solver environment kept loaded between executions
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int release_solver(void);
+
+/**
+ Release all the memory of the last patch, optimize or schedule, and set the parameters to their default values.
+ The profile of the thread is also cleared. It has to be called before resetting the network, as it uses its link ids
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int reset_scheduler(void);
+
+/**
+ Create a new scheduler with the default parameters. To use it, the thread sets it as its current scheduler
+
+ @return pointer to the scheduler, NULL if there is not enough memory
+ */
+Scheduler_Context * new_scheduler_context(void);
+
+/**
+ Release all the memory of a scheduler created with new_scheduler_context, and the scheduler itself.
+ If it is the current scheduler of the thread, the thread works again on the default scheduler
+
+ @param scheduler_pt pointer to the scheduler
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_scheduler_context(Scheduler_Context *scheduler_pt);
+
+/**
+ Set the scheduler the calling thread works on, all the functions of the scheduler use it.
+ The threads start working on the default scheduler of the process. The solver is kept by every thread, so a
+ persistent solver environment is only reused by the thread that loaded it
+
+ @param scheduler_pt pointer to the scheduler, NULL to work on the default scheduler
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_scheduler_context(Scheduler_Context *scheduler_pt);
+
+/**
+ Get the scheduler the calling thread works on
+
+ @return pointer to the scheduler
+ */
+Scheduler_Context * get_scheduler_context(void);
+
+/**
+ Copy the parameters of the given scheduler to the current scheduler of the thread, so a new scheduler runs as the
+ given one. Nothing of the executions of the given scheduler is copied
+
+ @param scheduler_pt pointer to the scheduler with the parameters
+ @return 0 if done correctly, -1 otherwise
+ */
+int copy_scheduler_parameters(Scheduler_Context *scheduler_pt);
+
+/**
+ Build the fixed traffic of every link of the current network, that has to be scheduled, so the patches derived from
+ its schedule copy it instead of building it again. It uses the patch index of the current scheduler
+
+ @param baseline pointer to the timelines to build, they have to be freed with free_baseline_timelines
+ @return 0 if done correctly, -1 otherwise
+ */
+int build_baseline_timelines(Baseline_Timelines *baseline);
+
+/**
+ Release the memory of the fixed traffic of the links of a baseline schedule
+
+ @param baseline pointer to the timelines
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_baseline_timelines(Baseline_Timelines *baseline);
+
+/**
+ Set the fixed traffic that the current scheduler copies when it patches the links whose fixed frames are all their
+ frames in the baseline schedule. The timelines are only read, so several schedulers can share them
+
+ @param baseline pointer to the timelines, NULL to build the fixed traffic of every patch again
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_baseline_timelines(Baseline_Timelines *baseline);
+
+/**
+ Set the repair plans that the current scheduler searches before patching a link. If a plan of the link is valid for
+ its traffic, its transmission times are used instead of patching it. The cache is only read, so several schedulers
+ can share it
+
+ @param cache pointer to the cache with the repair plans, NULL to always patch the links
+ @return 0 if done correctly, -1 otherwise
+ */
+int set_repair_cache(struct Repair_Cache *cache);
+
+/**
+ Read the scheduler parameters.
+ It has to be called before preparing the network, as the strictly periodic mode changes how the offsets are stored
 
  @param parameters_xml name and path of the parameter xml file
  @return 0 if done correctly, -1 otherwise
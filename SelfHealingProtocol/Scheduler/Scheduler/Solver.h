@@ -0,0 +1,229 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Solver.h                                                                                                           *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package with the interface to the MILP solver used to build and solve the models of the scheduler.                 *
+ *  There is a single model at a time in every thread, its variables and constraints are referenced by the order they  *
+ *  were added. The backend is chosen when compiling: Gurobi by default, HiGHS if SCHEDULER_HIGHS is defined, or the   *
+ *  CP-SAT solver of OR-Tools if SCHEDULER_CPSAT is defined. Every backend implements all the functions of this file   *
+ *  in its own translation unit, the rest of the scheduler does not depend on any of them.                             *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Solver_h
+#define Solver_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#endif /* Solver_h */
+
+// The CP-SAT backend is written in C++, so it needs the C linkage of the functions
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Type of a variable of the model
+ */
+typedef enum Solver_Type{
+    solver_integer,
+    solver_binary
+}Solver_Type;
+
+/**
+ Sense of a linear constraint of the model
+ */
+typedef enum Solver_Sense{
+    solver_less_equal,
+    solver_greater_equal,
+    solver_equal
+}Solver_Sense;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Load the environment of the solver if it is not loaded yet and set its parameters
+
+ @param mip_gap relative MIP gap when to stop searching
+ @param time_limit time limit when to stop searching in seconds
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_load_environment(double mip_gap, double time_limit);
+
+/**
+ Free the environment of the solver, and the model if there is one
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_free_environment(void);
+
+/**
+ Set the flag that stops the optimizations of the solver when it is not 0, so another thread can stop them. Gurobi
+ and HiGHS stop in the middle of the search, CP-SAT only checks the flag before starting it
+
+ @param cancel_flag pointer to the flag, NULL if the optimizations never have to be stopped
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_set_cancel(int *cancel_flag);
+
+/**
+ Create a new empty model that maximizes its objective, the previous model is freed
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_new_model(void);
+
+/**
+ Free the current model if there is one
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_free_model(void);
+
+/**
+ Know if the backend supports the or and indicator constraints
+
+ @return 1 if they are supported, 0 otherwise
+ */
+int solver_general_constraints(void);
+
+/**
+ Know if the backend supports the no-overlap constraints over intervals
+
+ @return 1 if they are supported, 0 otherwise
+ */
+int solver_no_overlap(void);
+
+/**
+ Add a variable to the model, it gets the next index of the variables
+
+ @param obj coefficient of the variable in the objective
+ @param lb lower bound of the variable
+ @param ub upper bound of the variable
+ @param type type of the variable
+ @param name name of the variable
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_add_var(double obj, double lb, double ub, Solver_Type type, const char *name);
+
+/**
+ Add a linear constraint to the model
+
+ @param num number of variables of the constraint
+ @param ind indexes of the variables
+ @param val coefficients of the variables
+ @param sense sense of the constraint
+ @param rhs right hand side of the constraint
+ @param name name of the constraint, it can be NULL
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_add_constr(int num, int *ind, double *val, Solver_Sense sense, double rhs, const char *name);
+
+/**
+ Add a constraint that sets a binary variable to the or of other binary variables
+
+ @param res index of the binary variable with the result
+ @param num number of binary variables of the or
+ @param ind indexes of the binary variables of the or
+ @param name name of the constraint
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_add_or(int res, int num, int *ind, const char *name);
+
+/**
+ Add a linear constraint that only has to be satisfied when a binary variable takes the given value
+
+ @param bin_var index of the binary variable
+ @param bin_val value of the binary variable that activates the constraint
+ @param num number of variables of the constraint
+ @param ind indexes of the variables
+ @param val coefficients of the variables
+ @param sense sense of the constraint
+ @param rhs right hand side of the constraint
+ @param name name of the constraint
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_add_indicator(int bin_var, int bin_val, int num, int *ind, double *val, Solver_Sense sense, double rhs,
+                         const char *name);
+
+/**
+ Add a constraint so no two of the given intervals overlap. Every interval starts at a variable plus a shift, and
+ lasts a fixed number of time slots plus, if given, the value of a variable
+
+ @param num number of intervals
+ @param start_var indexes of the variables where the intervals start
+ @param shift time slots added to the start variables
+ @param length fixed time slots of the intervals
+ @param length_var index of the variable added to the length of all intervals, -1 if none
+ @param name name of the constraint
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_add_no_overlap(int num, int *start_var, long long int *shift, long long int *length, int length_var,
+                          const char *name);
+
+/**
+ Change the coefficient of a variable in the objective
+
+ @param var index of the variable
+ @param value new coefficient
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_set_objective(int var, double value);
+
+/**
+ Set the value of a variable in the starting solution of the next optimization
+
+ @param var index of the variable
+ @param value starting value
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_set_start(int var, double value);
+
+/**
+ Apply the pending changes of the model
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_update(void);
+
+/**
+ Search a solution of the model until the MIP gap or the time limit is reached
+
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_optimize(void);
+
+/**
+ Get the number of solutions found by the last optimization
+
+ @return number of solutions found, 0 if none or something went wrong
+ */
+int solver_get_num_solutions(void);
+
+/**
+ Get the value of a variable in the best solution found by the last optimization
+
+ @param var index of the variable
+ @param value pointer where to save the value
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_get_value(int var, double *value);
+
+/**
+ Write the current model in a file, the format is given by its extension
+
+ @param file name and path of the file
+ @return 0 if done correctly, -1 otherwise
+ */
+int solver_write(const char *file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,450 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  SolverCPSAT.cpp                                                                                                    *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Backend of the solver with the CP-SAT solver of OR-Tools, used when SCHEDULER_CPSAT is defined.                    *
+ *  CP-SAT only has a C++ interface, so this is the only file of the scheduler in C++. It supports the no-overlap      *
+ *  constraints over intervals, so the scheduler can avoid the collisions of a link with a single constraint.          *
+ *  The coefficients of the constraints are integers in CP-SAT, the ones of the scheduler always are.                  *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Solver.h"
+#include "Profile.h"
+
+#if defined(SCHEDULER_CPSAT)
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "ortools/sat/cp_model.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/sorted_interval_list.h"
+
+using operations_research::Domain;
+using operations_research::sat::BoolVar;
+using operations_research::sat::CpModelBuilder;
+using operations_research::sat::CpSolverResponse;
+using operations_research::sat::CpSolverStatus;
+using operations_research::sat::DoubleLinearExpr;
+using operations_research::sat::IntervalVar;
+using operations_research::sat::IntVar;
+using operations_research::sat::LinearExpr;
+using operations_research::sat::Model;
+using operations_research::sat::NewSatParameters;
+using operations_research::sat::SatParameters;
+using operations_research::sat::SolutionIntegerValue;
+using operations_research::sat::SolveCpModel;
+
+                                                    /* VARIABLES */
+
+static thread_local std::unique_ptr<CpModelBuilder> cp_model;   // CP-SAT model, NULL if there is none
+static thread_local std::vector<IntVar> cp_vars;                // Variables of the model, by the order they were added
+static thread_local std::vector<BoolVar> cp_bools;              // Same variables as boolean, only for the binaries
+static thread_local std::vector<double> cp_objective;           // Coefficients of the variables in the objective
+static thread_local std::vector<long long int> cp_start;        // Starting values for the next optimization
+static thread_local std::vector<char> cp_has_start;             // 1 if the variable has a starting value, 0 otherwise
+static thread_local std::vector<long long int> cp_solution;     // Values of the solution of the last optimization
+static thread_local double cp_mip_gap = 0;                      // Relative gap of the new optimizations
+static thread_local double cp_time_limit = 0;                   // Time limit of the new optimizations
+static thread_local int *cp_cancel = nullptr;                   // Flag that stops the optimizations, NULL if none
+
+                                                    /* FUNCTIONS */
+
+/* Auxiliar Functions */
+
+/**
+ Build the linear expression of a constraint
+
+ @param num number of variables of the constraint
+ @param ind indexes of the variables
+ @param val coefficients of the variables, they have to be integers
+ @return linear expression
+ */
+static LinearExpr get_cp_expression(int num, int *ind, double *val) {
+
+    LinearExpr expr;
+    for (int i = 0; i < num; i++) {
+        expr += LinearExpr::Term(cp_vars[ind[i]], std::llround(val[i]));
+    }
+
+    return expr;
+}
+
+/**
+ Add a linear constraint to the model with the given sense
+
+ @param expr linear expression of the constraint
+ @param sense sense of the constraint
+ @param rhs right hand side of the constraint, it has to be an integer
+ @return constraint added so it can be enforced or named
+ */
+static operations_research::sat::Constraint add_cp_constraint(const LinearExpr &expr, Solver_Sense sense, double rhs) {
+
+    if (sense == solver_less_equal) {
+        return cp_model->AddLessOrEqual(expr, std::llround(rhs));
+    }
+    if (sense == solver_greater_equal) {
+        return cp_model->AddGreaterOrEqual(expr, std::llround(rhs));
+    }
+    return cp_model->AddEquality(expr, std::llround(rhs));
+}
+
+/**
+ Check that a variable index refers to a variable of the model
+
+ @param var index of the variable
+ @return 1 if it exists, 0 otherwise
+ */
+static int valid_cp_var(int var) {
+
+    return var >= 0 && var < (int)cp_vars.size();
+}
+
+/* Functions */
+
+/**
+ Load the environment of the solver if it is not loaded yet and set its parameters
+ */
+int solver_load_environment(double mip_gap, double time_limit) {
+
+    // CP-SAT has no environment, the parameters are given in every optimization
+    cp_mip_gap = mip_gap;
+    cp_time_limit = time_limit;
+
+    return 0;
+}
+
+/**
+ Free the environment of the solver, and the model if there is one
+ */
+int solver_free_environment(void) {
+
+    return solver_free_model();
+}
+
+/**
+ Set the flag that stops the optimizations of the solver when it is not 0
+ */
+int solver_set_cancel(int *cancel_flag) {
+
+    cp_cancel = cancel_flag;
+
+    return 0;
+}
+
+/**
+ Create a new empty model that maximizes its objective, the previous model is freed
+ */
+int solver_new_model(void) {
+
+    solver_free_model();
+    cp_model.reset(new CpModelBuilder());
+    profile_new_model();
+
+    return 0;
+}
+
+/**
+ Free the current model if there is one
+ */
+int solver_free_model(void) {
+
+    cp_model.reset();
+    cp_vars.clear();
+    cp_bools.clear();
+    cp_objective.clear();
+    cp_start.clear();
+    cp_has_start.clear();
+    cp_solution.clear();
+
+    return 0;
+}
+
+/**
+ Know if the backend supports the or and indicator constraints
+ */
+int solver_general_constraints(void) {
+
+    return 1;
+}
+
+/**
+ Know if the backend supports the no-overlap constraints over intervals
+ */
+int solver_no_overlap(void) {
+
+    return 1;
+}
+
+/**
+ Add a variable to the model, it gets the next index of the variables
+ */
+int solver_add_var(double obj, double lb, double ub, Solver_Type type, const char *name) {
+
+    if (cp_model == nullptr || std::llround(lb) > std::llround(ub)) {
+        fprintf(stderr, "The CP-SAT solver could not add the variable %s\n", name);
+        return -1;
+    }
+
+    // The binaries are kept as boolean too, for the or and the indicator constraints
+    if (type == solver_binary) {
+        BoolVar var = cp_model->NewBoolVar().WithName(name);
+        if (lb > 0.5) {
+            cp_model->FixVariable(var, true);
+        } else if (ub < 0.5) {
+            cp_model->FixVariable(var, false);
+        }
+        cp_bools.push_back(var);
+        cp_vars.push_back(IntVar(var));
+    } else {
+        cp_bools.push_back(BoolVar());
+        cp_vars.push_back(cp_model->NewIntVar(Domain(std::llround(lb), std::llround(ub))).WithName(name));
+    }
+    cp_objective.push_back(obj);
+    cp_start.push_back(0);
+    cp_has_start.push_back(0);
+    profile_count(counter_variables);
+    if (type == solver_binary) {
+        profile_count(counter_binaries);
+    }
+
+    return 0;
+}
+
+/**
+ Add a linear constraint to the model
+ */
+int solver_add_constr(int num, int *ind, double *val, Solver_Sense sense, double rhs, const char *name) {
+
+    for (int i = 0; i < num; i++) {
+        if (!valid_cp_var(ind[i])) {
+            fprintf(stderr, "The CP-SAT solver could not add the constraint %s\n", name != NULL ? name : "");
+            return -1;
+        }
+    }
+    operations_research::sat::Constraint constr = add_cp_constraint(get_cp_expression(num, ind, val), sense, rhs);
+    if (name != NULL) {
+        constr.WithName(name);
+    }
+    profile_count(counter_constraints);
+
+    return 0;
+}
+
+/**
+ Add a constraint that sets a binary variable to the or of other binary variables
+ */
+int solver_add_or(int res, int num, int *ind, const char *name) {
+
+    if (!valid_cp_var(res)) {
+        fprintf(stderr, "The CP-SAT solver could not add the or constraint %s\n", name);
+        return -1;
+    }
+    std::vector<BoolVar> literals;
+    for (int i = 0; i < num; i++) {
+        if (!valid_cp_var(ind[i])) {
+            fprintf(stderr, "The CP-SAT solver could not add the or constraint %s\n", name);
+            return -1;
+        }
+        literals.push_back(cp_bools[ind[i]]);
+        // Any active variable activates the result
+        cp_model->AddImplication(cp_bools[ind[i]], cp_bools[res]);
+    }
+    // And the result needs an active variable
+    cp_model->AddBoolOr(literals).OnlyEnforceIf(cp_bools[res]).WithName(name);
+    profile_count(counter_general);
+
+    return 0;
+}
+
+/**
+ Add a linear constraint that only has to be satisfied when a binary variable takes the given value
+ */
+int solver_add_indicator(int bin_var, int bin_val, int num, int *ind, double *val, Solver_Sense sense, double rhs,
+                         const char *name) {
+
+    if (!valid_cp_var(bin_var)) {
+        fprintf(stderr, "The CP-SAT solver could not add the indicator constraint %s\n", name);
+        return -1;
+    }
+    for (int i = 0; i < num; i++) {
+        if (!valid_cp_var(ind[i])) {
+            fprintf(stderr, "The CP-SAT solver could not add the indicator constraint %s\n", name);
+            return -1;
+        }
+    }
+    BoolVar literal = bin_val == 1 ? cp_bools[bin_var] : cp_bools[bin_var].Not();
+    add_cp_constraint(get_cp_expression(num, ind, val), sense, rhs).OnlyEnforceIf(literal).WithName(name);
+    profile_count(counter_general);
+
+    return 0;
+}
+
+/**
+ Add a constraint so no two of the given intervals overlap
+ */
+int solver_add_no_overlap(int num, int *start_var, long long int *shift, long long int *length, int length_var,
+                          const char *name) {
+
+    if (length_var != -1 && !valid_cp_var(length_var)) {
+        fprintf(stderr, "The CP-SAT solver could not add the no-overlap constraint %s\n", name);
+        return -1;
+    }
+    std::vector<IntervalVar> intervals;
+    for (int i = 0; i < num; i++) {
+        if (!valid_cp_var(start_var[i])) {
+            fprintf(stderr, "The CP-SAT solver could not add the no-overlap constraint %s\n", name);
+            return -1;
+        }
+        // The interval is [start + shift, start + shift + length + length variable)
+        LinearExpr start = LinearExpr(cp_vars[start_var[i]]) + shift[i];
+        LinearExpr size = LinearExpr(length[i]);
+        if (length_var != -1) {
+            size += cp_vars[length_var];
+        }
+        intervals.push_back(cp_model->NewIntervalVar(start, size, start + size));
+    }
+    cp_model->AddNoOverlap(intervals).WithName(name);
+    profile_count(counter_general);
+
+    return 0;
+}
+
+/**
+ Change the coefficient of a variable in the objective
+ */
+int solver_set_objective(int var, double value) {
+
+    if (!valid_cp_var(var)) {
+        fprintf(stderr, "The CP-SAT solver could not change the objective\n");
+        return -1;
+    }
+    cp_objective[var] = value;
+
+    return 0;
+}
+
+/**
+ Set the value of a variable in the starting solution of the next optimization
+ */
+int solver_set_start(int var, double value) {
+
+    if (!valid_cp_var(var)) {
+        fprintf(stderr, "The CP-SAT solver could not set the starting value of the variable %d\n", var);
+        return -1;
+    }
+    // A new value replaces the previous one, so the hints are only given when optimizing
+    cp_start[var] = std::llround(value);
+    cp_has_start[var] = 1;
+
+    return 0;
+}
+
+/**
+ Apply the pending changes of the model
+ */
+int solver_update(void) {
+
+    // The changes of CP-SAT are applied as soon as they are done
+    return 0;
+}
+
+/**
+ Search a solution of the model until the MIP gap or the time limit is reached
+ */
+int solver_optimize(void) {
+
+    cp_solution.clear();
+    if (cp_model == nullptr) {
+        fprintf(stderr, "The CP-SAT solver has no model to optimize\n");
+        return -1;
+    }
+    // CP-SAT only checks the flag here, a search already started runs until its own limits
+    if (cp_cancel != nullptr && __atomic_load_n(cp_cancel, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+
+    // The objective can change between optimizations, so it is given right before solving
+    DoubleLinearExpr objective;
+    for (size_t i = 0; i < cp_vars.size(); i++) {
+        if (cp_objective[i] != 0) {
+            objective.AddTerm(cp_vars[i], cp_objective[i]);
+        }
+    }
+    cp_model->Maximize(objective);
+    cp_model->ClearHints();
+    for (size_t i = 0; i < cp_vars.size(); i++) {
+        if (cp_has_start[i]) {
+            cp_model->AddHint(cp_vars[i], cp_start[i]);
+            cp_has_start[i] = 0;
+        }
+    }
+
+    SatParameters parameters;
+    parameters.set_max_time_in_seconds(cp_time_limit);
+    parameters.set_relative_gap_limit(cp_mip_gap);
+    parameters.set_log_search_progress(true);
+    Model model;
+    model.Add(NewSatParameters(parameters));
+    CpSolverResponse response = SolveCpModel(cp_model->Build(), &model);
+
+    // Save the solution if a feasible one was found, even if the time limit was reached first
+    if (response.status() == CpSolverStatus::OPTIMAL || response.status() == CpSolverStatus::FEASIBLE) {
+        for (size_t i = 0; i < cp_vars.size(); i++) {
+            cp_solution.push_back(SolutionIntegerValue(response, cp_vars[i]));
+        }
+    } else if (response.status() == CpSolverStatus::MODEL_INVALID) {
+        fprintf(stderr, "The CP-SAT solver found the model invalid\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ Get the number of solutions found by the last optimization
+ */
+int solver_get_num_solutions(void) {
+
+    // CP-SAT only returns the best solution
+    return cp_solution.empty() ? 0 : 1;
+}
+
+/**
+ Get the value of a variable in the best solution found by the last optimization
+ */
+int solver_get_value(int var, double *value) {
+
+    if (var < 0 || var >= (int)cp_solution.size()) {
+        fprintf(stderr, "The CP-SAT solver has no solution for the variable %d\n", var);
+        return -1;
+    }
+    *value = (double)cp_solution[var];
+
+    return 0;
+}
+
+/**
+ Write the current model in a file, the format is given by its extension
+ */
+int solver_write(const char *file) {
+
+    // CP-SAT only writes its own protocol buffer format, in text
+    std::ofstream output(file);
+    if (cp_model == nullptr || !output) {
+        fprintf(stderr, "The CP-SAT solver could not write the model in %s\n", file);
+        return -1;
+    }
+    output << cp_model->Build().DebugString();
+
+    return 0;
+}
+
+#endif
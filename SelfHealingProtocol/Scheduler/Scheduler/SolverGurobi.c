@@ -0,0 +1,337 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  SolverGurobi.c                                                                                                     *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Solver.h"
+#include "Profile.h"
+
+// Gurobi is the backend if no other one is chosen
+#if !defined(SCHEDULER_HIGHS) && !defined(SCHEDULER_CPSAT)
+
+#include <gurobi_c.h>
+
+                                                    /* VARIABLES */
+
+_Thread_local GRBenv *env = NULL;       // Gurobi solver environment
+_Thread_local GRBmodel *model = NULL;   // Gurobi model
+_Thread_local int *cancel = NULL;       // Flag that stops the optimizations when it is not 0, NULL if none
+
+                                                    /* FUNCTIONS */
+
+/* Auxiliar Functions */
+
+/**
+ Get the gurobi sense of a constraint
+
+ @param sense sense of the constraint
+ @return gurobi sense
+ */
+char get_gurobi_sense(Solver_Sense sense) {
+    
+    if (sense == solver_less_equal) {
+        return GRB_LESS_EQUAL;
+    }
+    if (sense == solver_greater_equal) {
+        return GRB_GREATER_EQUAL;
+    }
+    return GRB_EQUAL;
+}
+
+/**
+ Callback of gurobi that stops the optimization when the cancel flag given is set
+
+ @param cb_model model being optimized
+ @param cbdata data of the callback
+ @param where place of the optimization where the callback is called
+ @param usrdata pointer to the cancel flag
+ @return 0 always, so gurobi continues until it checks the termination
+ */
+int cancel_callback(GRBmodel *cb_model, void *cbdata, int where, void *usrdata) {
+    
+    // The flag is checked in every call, wherever the optimization is
+    (void) cbdata;
+    (void) where;
+    if (__atomic_load_n((int*)usrdata, __ATOMIC_RELAXED)) {
+        GRBterminate(cb_model);
+    }
+    
+    return 0;
+}
+
+/* Functions */
+
+/**
+ Load the environment of the solver if it is not loaded yet and set its parameters
+ */
+int solver_load_environment(double mip_gap, double time_limit) {
+    
+    // The environment might be still loaded from a previous execution
+    int error = 0;
+    if (env == NULL) {
+        error = GRBloadenv(&env, NULL);
+    }
+    if (error || env == NULL) {
+        fprintf(stderr, "The gurobi solver could not be initialized\n");
+        return -1;
+    }
+    
+    // Silence the output
+    GRBsetintparam(env, GRB_INT_PAR_OUTPUTFLAG, 1);
+    
+    // Set the MIPGAP
+    GRBsetdblparam(env, GRB_DBL_PAR_MIPGAP, mip_gap);
+    // Set the time limit
+    GRBsetdblparam(env, GRB_DBL_PAR_TIMELIMIT, time_limit);
+    
+    return 0;
+}
+
+/**
+ Free the environment of the solver, and the model if there is one
+ */
+int solver_free_environment(void) {
+    
+    GRBfreemodel(model);
+    model = NULL;
+    GRBfreeenv(env);
+    env = NULL;
+    
+    return 0;
+}
+
+/**
+ Set the flag that stops the optimizations of the solver when it is not 0
+ */
+int solver_set_cancel(int *cancel_flag) {
+    
+    cancel = cancel_flag;
+    
+    return 0;
+}
+
+/**
+ Create a new empty model that maximizes its objective, the previous model is freed
+ */
+int solver_new_model(void) {
+    
+    GRBfreemodel(model);
+    if (GRBnewmodel(env, &model, "schedule", 0, NULL, NULL, NULL, NULL, NULL)) {
+        fprintf(stderr, "The gurobi solver could not create the model\n");
+        return -1;
+    }
+    // Set as maximizing
+    GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, -1);
+    profile_new_model();
+    
+    return 0;
+}
+
+/**
+ Free the current model if there is one
+ */
+int solver_free_model(void) {
+    
+    GRBfreemodel(model);
+    model = NULL;
+    
+    return 0;
+}
+
+/**
+ Know if the backend supports the or and indicator constraints
+ */
+int solver_general_constraints(void) {
+    
+    return 1;
+}
+
+/**
+ Know if the backend supports the no-overlap constraints over intervals
+ */
+int solver_no_overlap(void) {
+    
+    return 0;
+}
+
+/**
+ Add a variable to the model, it gets the next index of the variables
+ */
+int solver_add_var(double obj, double lb, double ub, Solver_Type type, const char *name) {
+    
+    if (GRBaddvar(model, 0, NULL, NULL, obj, lb, ub, type == solver_binary ? GRB_BINARY : GRB_INTEGER, name)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    profile_count(counter_variables);
+    if (type == solver_binary) {
+        profile_count(counter_binaries);
+    }
+    
+    return 0;
+}
+
+/**
+ Add a linear constraint to the model
+ */
+int solver_add_constr(int num, int *ind, double *val, Solver_Sense sense, double rhs, const char *name) {
+    
+    if (GRBaddconstr(model, num, ind, val, get_gurobi_sense(sense), rhs, name)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    profile_count(counter_constraints);
+    
+    return 0;
+}
+
+/**
+ Add a constraint that sets a binary variable to the or of other binary variables
+ */
+int solver_add_or(int res, int num, int *ind, const char *name) {
+    
+    if (GRBaddgenconstrOr(model, name, res, num, ind)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    profile_count(counter_general);
+    
+    return 0;
+}
+
+/**
+ Add a linear constraint that only has to be satisfied when a binary variable takes the given value
+ */
+int solver_add_indicator(int bin_var, int bin_val, int num, int *ind, double *val, Solver_Sense sense, double rhs,
+                         const char *name) {
+    
+    if (GRBaddgenconstrIndicator(model, name, bin_var, bin_val, num, ind, val, get_gurobi_sense(sense), rhs)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    profile_count(counter_general);
+    
+    return 0;
+}
+
+/**
+ Add a constraint so no two of the given intervals overlap
+ */
+int solver_add_no_overlap(int num, int *start_var, long long int *shift, long long int *length, int length_var,
+                          const char *name) {
+    
+    // Gurobi has no interval variables, the no-overlap encoding is only available in the CP-SAT solver
+    (void) num;
+    (void) start_var;
+    (void) shift;
+    (void) length;
+    (void) length_var;
+    fprintf(stderr, "The gurobi solver does not support the no-overlap constraint %s\n", name);
+    return -1;
+}
+
+/**
+ Change the coefficient of a variable in the objective
+ */
+int solver_set_objective(int var, double value) {
+    
+    if (GRBsetdblattrelement(model, GRB_DBL_ATTR_OBJ, var, value)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Set the value of a variable in the starting solution of the next optimization
+ */
+int solver_set_start(int var, double value) {
+    
+    if (GRBsetdblattrelement(model, GRB_DBL_ATTR_START, var, value)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Apply the pending changes of the model
+ */
+int solver_update(void) {
+    
+    if (GRBupdatemodel(model)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Search a solution of the model until the MIP gap or the time limit is reached
+ */
+int solver_optimize(void) {
+    
+    // A cancelled search does not start, and a running one is stopped by the callback
+    if (cancel != NULL && __atomic_load_n(cancel, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    if (GRBsetcallbackfunc(model, cancel != NULL ? cancel_callback : NULL, cancel)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    if (GRBoptimize(model)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Get the number of solutions found by the last optimization
+ */
+int solver_get_num_solutions(void) {
+    
+    int solcount = 0;
+    if (GRBgetintattr(model, GRB_INT_ATTR_SOLCOUNT, &solcount)) {
+        return 0;
+    }
+    
+    return solcount;
+}
+
+/**
+ Get the value of a variable in the best solution found by the last optimization
+ */
+int solver_get_value(int var, double *value) {
+    
+    if (GRBgetdblattrelement(model, GRB_DBL_ATTR_X, var, value)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Write the current model in a file, the format is given by its extension
+ */
+int solver_write(const char *file) {
+    
+    if (GRBwrite(model, file)) {
+        printf("%s\n", GRBgeterrormsg(env));
+        return -1;
+    }
+    
+    return 0;
+}
+
+#endif
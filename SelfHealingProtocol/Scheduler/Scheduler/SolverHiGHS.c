@@ -0,0 +1,403 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  SolverHiGHS.c                                                                                                      *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Backend of the solver with the open source HiGHS MILP solver, used when SCHEDULER_HIGHS is defined.                *
+ *  HiGHS has no general constraints, so the scheduler writes the disjunctions with the big-M encoding.                *
+ *  The starting values are kept until the optimization, as HiGHS takes them all at once.                              *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Solver.h"
+#include "Profile.h"
+
+#if defined(SCHEDULER_HIGHS)
+
+#include <interfaces/highs_c_api.h>
+
+                                                    /* VARIABLES */
+
+_Thread_local void *highs = NULL;               // HiGHS model, it also keeps the parameters
+_Thread_local double highs_mip_gap = 0;         // MIP gap of the new models
+_Thread_local double highs_time_limit = 0;      // Time limit of the new models
+_Thread_local HighsInt *start_index = NULL;     // Variables with a starting value for the next optimization
+_Thread_local double *start_value = NULL;       // Starting values for the next optimization
+_Thread_local int num_start = 0;                // Number of starting values
+_Thread_local int size_start = 0;               // Number of starting values allocated
+_Thread_local double *solution = NULL;          // Values of the solution of the last optimization
+_Thread_local int num_solution = 0;             // Number of variables in the solution, 0 if there is no solution
+_Thread_local int *cancel = NULL;               // Flag that stops the optimizations when it is not 0, NULL if none
+
+                                                    /* FUNCTIONS */
+
+/* Auxiliar Functions */
+
+/**
+ Forget the starting values and the solution of the last optimization
+ */
+void clear_highs_solution(void) {
+    
+    free(start_index);
+    start_index = NULL;
+    free(start_value);
+    start_value = NULL;
+    num_start = 0;
+    size_start = 0;
+    free(solution);
+    solution = NULL;
+    num_solution = 0;
+}
+
+/**
+ Callback of HiGHS that interrupts the MIP search when the cancel flag given is set
+
+ @param callback_type type of the callback
+ @param message message of the callback
+ @param data_out data given by HiGHS
+ @param data_in data given back to HiGHS
+ @param user_callback_data pointer to the cancel flag
+ */
+void cancel_callback(int callback_type, const char *message, const HighsCallbackDataOut *data_out,
+                     HighsCallbackDataIn *data_in, void *user_callback_data) {
+    
+    // Only the interrupt of the MIP search is used, its message and data are not needed
+    (void) message;
+    (void) data_out;
+    if (callback_type == kHighsCallbackMipInterrupt && __atomic_load_n((int*)user_callback_data, __ATOMIC_RELAXED)) {
+        data_in->user_interrupt = 1;
+    }
+}
+
+/* Functions */
+
+/**
+ Load the environment of the solver if it is not loaded yet and set its parameters
+ */
+int solver_load_environment(double mip_gap, double time_limit) {
+    
+    // HiGHS has no environment, the parameters are set in every new model
+    highs_mip_gap = mip_gap;
+    highs_time_limit = time_limit;
+    
+    return 0;
+}
+
+/**
+ Free the environment of the solver, and the model if there is one
+ */
+int solver_free_environment(void) {
+    
+    return solver_free_model();
+}
+
+/**
+ Set the flag that stops the optimizations of the solver when it is not 0
+ */
+int solver_set_cancel(int *cancel_flag) {
+    
+    cancel = cancel_flag;
+    
+    return 0;
+}
+
+/**
+ Create a new empty model that maximizes its objective, the previous model is freed
+ */
+int solver_new_model(void) {
+    
+    solver_free_model();
+    highs = Highs_create();
+    if (highs == NULL) {
+        fprintf(stderr, "The HiGHS solver could not create the model\n");
+        return -1;
+    }
+    Highs_setBoolOptionValue(highs, "output_flag", 1);
+    Highs_setDoubleOptionValue(highs, "mip_rel_gap", highs_mip_gap);
+    Highs_setDoubleOptionValue(highs, "time_limit", highs_time_limit);
+    // Set as maximizing
+    Highs_changeObjectiveSense(highs, kHighsObjSenseMaximize);
+    profile_new_model();
+    
+    return 0;
+}
+
+/**
+ Free the current model if there is one
+ */
+int solver_free_model(void) {
+    
+    if (highs != NULL) {
+        Highs_destroy(highs);
+        highs = NULL;
+    }
+    clear_highs_solution();
+    
+    return 0;
+}
+
+/**
+ Know if the backend supports the or and indicator constraints
+ */
+int solver_general_constraints(void) {
+    
+    return 0;
+}
+
+/**
+ Know if the backend supports the no-overlap constraints over intervals
+ */
+int solver_no_overlap(void) {
+    
+    return 0;
+}
+
+/**
+ Add a variable to the model, it gets the next index of the variables
+ */
+int solver_add_var(double obj, double lb, double ub, Solver_Type type, const char *name) {
+    
+    HighsInt col = Highs_getNumCol(highs);
+    // The binaries are integers bounded by 0 and 1
+    if (Highs_addCol(highs, obj, lb, ub, 0, NULL, NULL) == kHighsStatusError ||
+        Highs_changeColIntegrality(highs, col, kHighsVarTypeInteger) == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver could not add the variable %s\n", name);
+        return -1;
+    }
+    Highs_passColName(highs, col, name);
+    profile_count(counter_variables);
+    if (type == solver_binary) {
+        profile_count(counter_binaries);
+    }
+    
+    return 0;
+}
+
+/**
+ Add a linear constraint to the model
+ */
+int solver_add_constr(int num, int *ind, double *val, Solver_Sense sense, double rhs, const char *name) {
+    
+    double inf = Highs_getInfinity(highs);
+    double lower = sense == solver_less_equal ? -inf : rhs;
+    double upper = sense == solver_greater_equal ? inf : rhs;
+    
+    // The indexes of HiGHS might be wider than the ones of the scheduler
+    HighsInt *index = malloc(sizeof(HighsInt) * num);
+    if (index == NULL) {
+        fprintf(stderr, "Not enough memory to add the constraint\n");
+        return -1;
+    }
+    for (int i = 0; i < num; i++) {
+        index[i] = ind[i];
+    }
+    HighsInt row = Highs_getNumRow(highs);
+    HighsInt status = Highs_addRow(highs, lower, upper, num, index, val);
+    free(index);
+    if (status == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver could not add the constraint %s\n", name != NULL ? name : "");
+        return -1;
+    }
+    if (name != NULL) {
+        Highs_passRowName(highs, row, name);
+    }
+    profile_count(counter_constraints);
+    
+    return 0;
+}
+
+/**
+ Add a constraint that sets a binary variable to the or of other binary variables
+ */
+int solver_add_or(int res, int num, int *ind, const char *name) {
+    
+    // HiGHS has no general constraints, so the model fails instead of leaving the constraint out. Only the big-M
+    // encoding, with linear constraints, can be used with HiGHS
+    (void) res;
+    (void) num;
+    (void) ind;
+    fprintf(stderr, "The HiGHS solver does not support the or constraint %s\n", name);
+    return -1;
+}
+
+/**
+ Add a linear constraint that only has to be satisfied when a binary variable takes the given value
+ */
+int solver_add_indicator(int bin_var, int bin_val, int num, int *ind, double *val, Solver_Sense sense, double rhs,
+                         const char *name) {
+    
+    // As the or constraint, it is not linear, so the model fails and the big-M encoding has to be used
+    (void) bin_var;
+    (void) bin_val;
+    (void) num;
+    (void) ind;
+    (void) val;
+    (void) sense;
+    (void) rhs;
+    fprintf(stderr, "The HiGHS solver does not support the indicator constraint %s\n", name);
+    return -1;
+}
+
+/**
+ Add a constraint so no two of the given intervals overlap
+ */
+int solver_add_no_overlap(int num, int *start_var, long long int *shift, long long int *length, int length_var,
+                          const char *name) {
+    
+    // HiGHS has no interval variables, the no-overlap encoding is only available in the CP-SAT solver
+    (void) num;
+    (void) start_var;
+    (void) shift;
+    (void) length;
+    (void) length_var;
+    fprintf(stderr, "The HiGHS solver does not support the no-overlap constraint %s\n", name);
+    return -1;
+}
+
+/**
+ Change the coefficient of a variable in the objective
+ */
+int solver_set_objective(int var, double value) {
+    
+    if (Highs_changeColCost(highs, var, value) == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver could not change the objective\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ Set the value of a variable in the starting solution of the next optimization
+ */
+int solver_set_start(int var, double value) {
+    
+    if (num_start == size_start) {
+        int size = size_start == 0 ? 1024 : size_start * 2;
+        HighsInt *new_index = realloc(start_index, sizeof(HighsInt) * size);
+        if (new_index != NULL) {
+            start_index = new_index;
+        }
+        double *new_value = realloc(start_value, sizeof(double) * size);
+        if (new_value != NULL) {
+            start_value = new_value;
+        }
+        if (new_index == NULL || new_value == NULL) {
+            fprintf(stderr, "Not enough memory for the starting solution\n");
+            return -1;
+        }
+        size_start = size;
+    }
+    start_index[num_start] = var;
+    start_value[num_start] = value;
+    num_start++;
+    
+    return 0;
+}
+
+/**
+ Apply the pending changes of the model
+ */
+int solver_update(void) {
+    
+    // The changes of HiGHS are applied as soon as they are done
+    return 0;
+}
+
+/**
+ Search a solution of the model until the MIP gap or the time limit is reached
+ */
+int solver_optimize(void) {
+    
+    free(solution);
+    solution = NULL;
+    num_solution = 0;
+    
+    if (num_start > 0 &&
+        Highs_setSparseSolution(highs, num_start, start_index, start_value) == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver did not accept the starting solution\n");
+    }
+    num_start = 0;
+    
+    // A cancelled search does not start, and a running one is interrupted by the callback
+    if (cancel != NULL) {
+        if (__atomic_load_n(cancel, __ATOMIC_RELAXED)) {
+            return 0;
+        }
+        Highs_setCallback(highs, cancel_callback, cancel);
+        Highs_startCallback(highs, kHighsCallbackMipInterrupt);
+    }
+    if (Highs_run(highs) == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver failed to optimize the model\n");
+        return -1;
+    }
+    
+    // Save the solution if a feasible one was found, even if the time limit was reached first
+    HighsInt status = 0;
+    Highs_getIntInfoValue(highs, "primal_solution_status", &status);
+    if (status == kHighsSolutionStatusFeasible) {
+        // The duals are not used, but HiGHS writes them too
+        HighsInt num_col = Highs_getNumCol(highs);
+        HighsInt num_row = Highs_getNumRow(highs);
+        solution = malloc(sizeof(double) * (num_col + 1));
+        double *col_dual = malloc(sizeof(double) * (num_col + 1));
+        double *row_value = malloc(sizeof(double) * (num_row + 1));
+        double *row_dual = malloc(sizeof(double) * (num_row + 1));
+        if (solution != NULL && col_dual != NULL && row_value != NULL && row_dual != NULL) {
+            Highs_getSolution(highs, solution, col_dual, row_value, row_dual);
+            num_solution = (int)num_col;
+        }
+        free(col_dual);
+        free(row_value);
+        free(row_dual);
+        if (num_solution == 0) {
+            free(solution);
+            solution = NULL;
+            fprintf(stderr, "Not enough memory for the solution\n");
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Get the number of solutions found by the last optimization
+ */
+int solver_get_num_solutions(void) {
+    
+    // HiGHS only keeps the best solution
+    return solution != NULL ? 1 : 0;
+}
+
+/**
+ Get the value of a variable in the best solution found by the last optimization
+ */
+int solver_get_value(int var, double *value) {
+    
+    if (solution == NULL || var < 0 || var >= num_solution) {
+        fprintf(stderr, "The HiGHS solver has no solution for the variable %d\n", var);
+        return -1;
+    }
+    *value = solution[var];
+    
+    return 0;
+}
+
+/**
+ Write the current model in a file, the format is given by its extension
+ */
+int solver_write(const char *file) {
+    
+    if (Highs_writeModel(highs, file) == kHighsStatusError) {
+        fprintf(stderr, "The HiGHS solver could not write the model in %s\n", file);
+        return -1;
+    }
+    
+    return 0;
+}
+
+#endif
@@ -0,0 +1,413 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Timeline.c                                                                                                         *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Timeline.h                                                                                          *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Timeline.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Get a new node from the pool of the timeline with the given gap
+
+ @param pt pointer to the timeline
+ @param start first free time slot of the gap
+ @param end last free time slot of the gap
+ @return index of the new node, TIMELINE_NULL if there is no memory
+ */
+int new_gap_node(Timeline *pt, long long int start, long long int end) {
+    
+    int index;
+    
+    // Reuse a released node if there is any, otherwise take a new one from the pool
+    if (pt->free_nodes != TIMELINE_NULL) {
+        index = pt->free_nodes;
+        pt->free_nodes = pt->nodes[index].left;
+    } else {
+        if (pt->top_nodes == pt->size_nodes) {
+            int size = pt->size_nodes * 2;
+            Gap_Node *nodes = realloc(pt->nodes, sizeof(Gap_Node) * size);
+            if (nodes == NULL) {
+                fprintf(stderr, "Not enough memory to grow the timeline\n");
+                return TIMELINE_NULL;
+            }
+            pt->nodes = nodes;
+            pt->size_nodes = size;
+        }
+        index = pt->top_nodes;
+        pt->top_nodes++;
+    }
+    
+    // Xorshift, we only need the priorities to be well spread
+    pt->seed ^= pt->seed << 13;
+    pt->seed ^= pt->seed >> 17;
+    pt->seed ^= pt->seed << 5;
+    
+    pt->nodes[index].start = start;
+    pt->nodes[index].end = end;
+    pt->nodes[index].max_length = end - start + 1;
+    pt->nodes[index].priority = pt->seed;
+    pt->nodes[index].left = TIMELINE_NULL;
+    pt->nodes[index].right = TIMELINE_NULL;
+    pt->num_gaps++;
+    return index;
+}
+
+/**
+ Release all the nodes of the subtree to be reused later
+
+ @param pt pointer to the timeline
+ @param node index of the root of the subtree
+ */
+void release_gap_nodes(Timeline *pt, int node) {
+    
+    if (node == TIMELINE_NULL) {
+        return;
+    }
+    release_gap_nodes(pt, pt->nodes[node].left);
+    release_gap_nodes(pt, pt->nodes[node].right);
+    pt->nodes[node].left = pt->free_nodes;
+    pt->free_nodes = node;
+    pt->num_gaps--;
+}
+
+/**
+ Update the largest gap of the node from its own gap and its children
+
+ @param pt pointer to the timeline
+ @param node index of the node
+ */
+void update_gap_node(Timeline *pt, int node) {
+    
+    Gap_Node *node_pt = &pt->nodes[node];
+    node_pt->max_length = node_pt->end - node_pt->start + 1;
+    if (node_pt->left != TIMELINE_NULL && pt->nodes[node_pt->left].max_length > node_pt->max_length) {
+        node_pt->max_length = pt->nodes[node_pt->left].max_length;
+    }
+    if (node_pt->right != TIMELINE_NULL && pt->nodes[node_pt->right].max_length > node_pt->max_length) {
+        node_pt->max_length = pt->nodes[node_pt->right].max_length;
+    }
+}
+
+/**
+ Split the subtree in the gaps that start before the key and the gaps that start at the key or later
+
+ @param pt pointer to the timeline
+ @param node index of the root of the subtree
+ @param key time slot where to split
+ @param left_pt returns the index of the subtree with the gaps starting before the key
+ @param right_pt returns the index of the subtree with the rest of the gaps
+ */
+void split_gap_nodes(Timeline *pt, int node, long long int key, int *left_pt, int *right_pt) {
+    
+    if (node == TIMELINE_NULL) {
+        *left_pt = TIMELINE_NULL;
+        *right_pt = TIMELINE_NULL;
+        return;
+    }
+    if (pt->nodes[node].start < key) {
+        split_gap_nodes(pt, pt->nodes[node].right, key, &pt->nodes[node].right, right_pt);
+        *left_pt = node;
+    } else {
+        split_gap_nodes(pt, pt->nodes[node].left, key, left_pt, &pt->nodes[node].left);
+        *right_pt = node;
+    }
+    update_gap_node(pt, node);
+}
+
+/**
+ Merge two subtrees, all the gaps of the left subtree must start before the gaps of the right subtree
+
+ @param pt pointer to the timeline
+ @param left index of the left subtree
+ @param right index of the right subtree
+ @return index of the merged subtree
+ */
+int merge_gap_nodes(Timeline *pt, int left, int right) {
+    
+    if (left == TIMELINE_NULL) {
+        return right;
+    }
+    if (right == TIMELINE_NULL) {
+        return left;
+    }
+    if (pt->nodes[left].priority > pt->nodes[right].priority) {
+        pt->nodes[left].right = merge_gap_nodes(pt, pt->nodes[left].right, right);
+        update_gap_node(pt, left);
+        return left;
+    }
+    pt->nodes[right].left = merge_gap_nodes(pt, left, pt->nodes[right].left);
+    update_gap_node(pt, right);
+    return right;
+}
+
+/**
+ Detach the last gap of the subtree
+
+ @param pt pointer to the timeline
+ @param node index of the root of the subtree
+ @param last_pt returns the index of the detached node, TIMELINE_NULL if the subtree is empty
+ @return index of the subtree without the last gap
+ */
+int detach_last_gap(Timeline *pt, int node, int *last_pt) {
+    
+    if (node == TIMELINE_NULL) {
+        *last_pt = TIMELINE_NULL;
+        return TIMELINE_NULL;
+    }
+    if (pt->nodes[node].right == TIMELINE_NULL) {
+        *last_pt = node;
+        int left = pt->nodes[node].left;
+        pt->nodes[node].left = TIMELINE_NULL;
+        update_gap_node(pt, node);
+        return left;
+    }
+    pt->nodes[node].right = detach_last_gap(pt, pt->nodes[node].right, last_pt);
+    update_gap_node(pt, node);
+    return node;
+}
+
+/**
+ Search the gap with the largest start that is equal or smaller than the instant
+
+ @param pt pointer to the timeline
+ @param instant time slot to search
+ @return index of the node, TIMELINE_NULL if there is none
+ */
+int search_gap_before(Timeline *pt, long long int instant) {
+    
+    int node = pt->root;
+    int found = TIMELINE_NULL;
+    while (node != TIMELINE_NULL) {
+        if (pt->nodes[node].start <= instant) {
+            found = node;
+            node = pt->nodes[node].right;
+        } else {
+            node = pt->nodes[node].left;
+        }
+    }
+    return found;
+}
+
+/**
+ Search the first gap that starts after the instant and has at least the given length.
+ The subtrees that do not have a gap large enough are discarded with the largest gap of the node.
+
+ @param pt pointer to the timeline
+ @param node index of the root of the subtree
+ @param instant time slot that the gap should start after
+ @param length minimum length of the gap
+ @return index of the node, TIMELINE_NULL if there is none
+ */
+int search_gap_after(Timeline *pt, int node, long long int instant, long long int length) {
+    
+    if (node == TIMELINE_NULL || pt->nodes[node].max_length < length) {
+        return TIMELINE_NULL;
+    }
+    // The node and all its left subtree start before the instant
+    if (pt->nodes[node].start <= instant) {
+        return search_gap_after(pt, pt->nodes[node].right, instant, length);
+    }
+    int found = search_gap_after(pt, pt->nodes[node].left, instant, length);
+    if (found != TIMELINE_NULL) {
+        return found;
+    }
+    if (pt->nodes[node].end - pt->nodes[node].start + 1 >= length) {
+        return node;
+    }
+    return search_gap_after(pt, pt->nodes[node].right, instant, length);
+}
+
+                                                    /* FUNCTIONS */
+
+/* Getters */
+
+/**
+ Get the number of free gaps in the timeline
+ */
+int get_num_gaps(Timeline *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    
+    return pt->num_gaps;
+}
+
+/**
+ Get the last free time slot of the gap that contains the given instant
+ */
+long long int get_free_until(Timeline *pt, long long int instant) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    
+    int node = search_gap_before(pt, instant);
+    if (node == TIMELINE_NULL || pt->nodes[node].end < instant) {
+        return -1;
+    }
+    return pt->nodes[node].end;
+}
+
+/* Functions */
+
+/**
+ Init the timeline with all the time free
+ */
+int init_timeline(Timeline *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    
+    pt->size_nodes = 64;
+    pt->nodes = malloc(sizeof(Gap_Node) * pt->size_nodes);
+    if (pt->nodes == NULL) {
+        fprintf(stderr, "Not enough memory to init the timeline\n");
+        return -1;
+    }
+    pt->top_nodes = 0;
+    pt->free_nodes = TIMELINE_NULL;
+    pt->num_gaps = 0;
+    pt->seed = 2463534242;
+    pt->root = new_gap_node(pt, 0, TIMELINE_END);
+    return 0;
+}
+
+/**
+ Release the memory of the timeline
+ */
+int free_timeline(Timeline *pt) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    
+    free(pt->nodes);
+    pt->nodes = NULL;
+    pt->size_nodes = 0;
+    pt->top_nodes = 0;
+    pt->free_nodes = TIMELINE_NULL;
+    pt->num_gaps = 0;
+    pt->root = TIMELINE_NULL;
+    return 0;
+}
+
+/**
+ Copy a timeline into another one that is not initialized
+ */
+int copy_timeline(Timeline *dst, Timeline *src) {
+    
+    if (dst == NULL || src == NULL || src->nodes == NULL) {
+        fprintf(stderr, "The given timeline pointers are NULL or the timeline to copy is not initialized\n");
+        return -1;
+    }
+    
+    // The nodes are linked by indexes, so only the used part of the pool is copied
+    *dst = *src;
+    dst->nodes = malloc(sizeof(Gap_Node) * src->size_nodes);
+    if (dst->nodes == NULL) {
+        fprintf(stderr, "Not enough memory to copy the timeline\n");
+        return -1;
+    }
+    memcpy(dst->nodes, src->nodes, sizeof(Gap_Node) * src->top_nodes);
+    return 0;
+}
+
+/**
+ Mark the time slots from starting to ending (both included) as occupied.
+ */
+int occupy_timeline(Timeline *pt, long long int starting, long long int ending) {
+    
+    int left, middle, right, last, node;
+    long long int last_end;
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    if (starting < 0 || ending < starting || ending >= TIMELINE_END) {
+        fprintf(stderr, "The occupied interval is outside the timeline\n");
+        return -1;
+    }
+    
+    // Separate the gaps that start before, inside and after the occupied interval
+    split_gap_nodes(pt, pt->root, starting, &left, &middle);
+    split_gap_nodes(pt, middle, ending + 1, &middle, &right);
+    
+    // The last gap starting before can reach into the occupied interval, keep only what is free on both sides
+    left = detach_last_gap(pt, left, &last);
+    if (last != TIMELINE_NULL) {
+        last_end = pt->nodes[last].end;
+        if (last_end >= starting) {
+            pt->nodes[last].end = starting - 1;
+            update_gap_node(pt, last);
+            if (last_end > ending) {
+                node = new_gap_node(pt, ending + 1, last_end);
+                if (node == TIMELINE_NULL) {
+                    return -1;
+                }
+                right = merge_gap_nodes(pt, node, right);
+            }
+        }
+        left = merge_gap_nodes(pt, left, last);
+    }
+    
+    // The gaps starting inside are occupied, but the last one can continue after the occupied interval
+    middle = detach_last_gap(pt, middle, &last);
+    if (last != TIMELINE_NULL) {
+        last_end = pt->nodes[last].end;
+        release_gap_nodes(pt, last);
+        if (last_end > ending) {
+            node = new_gap_node(pt, ending + 1, last_end);
+            if (node == TIMELINE_NULL) {
+                return -1;
+            }
+            right = merge_gap_nodes(pt, node, right);
+        }
+    }
+    release_gap_nodes(pt, middle);
+    
+    pt->root = merge_gap_nodes(pt, left, right);
+    return 0;
+}
+
+/**
+ Find the first time slot equal or larger than the minimum where a transmission of the given length fits
+ */
+long long int first_fit_timeline(Timeline *pt, long long int min, int length) {
+    
+    if (pt == NULL) {
+        fprintf(stderr, "The given timeline pointer is NULL\n");
+        return -1;
+    }
+    if (length <= 0 || min < 0) {
+        fprintf(stderr, "The transmission to fit in the timeline is not valid\n");
+        return -1;
+    }
+    
+    // It fits directly at the minimum
+    int node = search_gap_before(pt, min);
+    if (node != TIMELINE_NULL && pt->nodes[node].end >= min + length - 1) {
+        return min;
+    }
+    
+    // If not, it goes at the start of the first gap large enough
+    node = search_gap_after(pt, pt->root, min, length);
+    if (node == TIMELINE_NULL) {
+        return -1;
+    }
+    return pt->nodes[node].start;
+}
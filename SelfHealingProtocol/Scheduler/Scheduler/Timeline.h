@@ -0,0 +1,124 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Timeline.h                                                                                                         *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that contains the free time of a single link as an index of gaps.                                          *
+ *  Every gap is a maximal interval of free time slots [start, end]. The gaps are kept in a treap sorted by their      *
+ *  start, and every node remembers the largest gap of its subtree, so the first gap where a transmission fits can be  *
+ *  found in logarithmic time instead of walking all the transmissions of the link.                                    *
+ *  The nodes are stored in a single array and linked by indexes, so a timeline can be copied with a single memcpy.    *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Timeline_h
+#define Timeline_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#endif /* Timeline_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define TIMELINE_END (LLONG_MAX / 4)        // Last time slot of the timeline, big enough to never be reached
+#define TIMELINE_NULL (-1)                  // Index of an empty node
+
+/**
+ Node of the treap containing a free gap
+ */
+typedef struct Gap_Node {
+    long long int start;                // First free time slot of the gap
+    long long int end;                  // Last free time slot of the gap
+    long long int max_length;           // Length of the largest gap in the subtree of the node
+    unsigned int priority;              // Random priority of the treap
+    int left;                           // Index of the left child
+    int right;                          // Index of the right child
+}Gap_Node;
+
+/**
+ Structure with the free gaps of a link
+ */
+typedef struct Timeline {
+    Gap_Node *nodes;                    // Pool of nodes of the treap
+    int size_nodes;                     // Number of nodes allocated in the pool
+    int top_nodes;                      // Number of nodes of the pool that have been used at least once
+    int free_nodes;                     // Index of the first node released and ready to be reused
+    int num_gaps;                       // Number of gaps currently in the treap
+    int root;                           // Index of the root of the treap
+    unsigned int seed;                  // Seed to generate the priorities
+}Timeline;
+
+                                                /* CODE DEFINITIONS */
+
+/* Getters */
+
+/**
+ Get the number of free gaps in the timeline
+
+ @param pt pointer to the timeline
+ @return number of gaps, -1 if something went wrong
+ */
+int get_num_gaps(Timeline *pt);
+
+/**
+ Get the last free time slot of the gap that contains the given instant
+
+ @param pt pointer to the timeline
+ @param instant time slot to search
+ @return last free time slot of the gap, -1 if the instant is not free
+ */
+long long int get_free_until(Timeline *pt, long long int instant);
+
+/* Functions */
+
+/**
+ Init the timeline with all the time free
+
+ @param pt pointer to the timeline
+ @return 0 if done correctly, -1 otherwise
+ */
+int init_timeline(Timeline *pt);
+
+/**
+ Release the memory of the timeline
+
+ @param pt pointer to the timeline
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_timeline(Timeline *pt);
+
+/**
+ Copy a timeline into another one that is not initialized, the copy has to be released on its own
+
+ @param dst pointer to the timeline where to copy
+ @param src pointer to the timeline to copy
+ @return 0 if done correctly, -1 otherwise
+ */
+int copy_timeline(Timeline *dst, Timeline *src);
+
+/**
+ Mark the time slots from starting to ending (both included) as occupied.
+ The occupied interval can overlap with other occupied intervals.
+
+ @param pt pointer to the timeline
+ @param starting first occupied time slot
+ @param ending last occupied time slot
+ @return 0 if done correctly, -1 otherwise
+ */
+int occupy_timeline(Timeline *pt, long long int starting, long long int ending);
+
+/**
+ Find the first time slot equal or larger than the minimum where a transmission of the given length fits
+
+ @param pt pointer to the timeline
+ @param min minimum time slot to start the transmission
+ @param length number of time slots of the transmission
+ @return first time slot where it fits, -1 if it does not fit anywhere
+ */
+long long int first_fit_timeline(Timeline *pt, long long int min, int length);
@@ -0,0 +1,513 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Validator.c                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in Validator.h                                                                                         *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Network.h"
+#include "View.h"
+#include "Validator.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Add a violation at the end of the report
+
+ @param report pointer to the report
+ @param type constraint violated
+ @param frame_id frame that violates the constraint
+ @param other_frame_id frame it collides with, -1 if it is not a collision
+ @param link_id link where the violation happens, -1 if it is the whole path
+ @param instance instance of the transmission
+ @param replica replica of the transmission
+ @return 0 if done correctly, -1 otherwise
+ */
+int add_violation(Schedule_Report *report, Violation_Type type, int frame_id, int other_frame_id, int link_id,
+                  int instance, int replica) {
+    
+    if (report->num_violations == report->size_violations) {
+        int size = report->size_violations == 0 ? 16 : report->size_violations * 2;
+        Schedule_Violation *violations = realloc(report->violations, sizeof(Schedule_Violation) * size);
+        if (violations == NULL) {
+            fprintf(stderr, "Not enough memory to save the violations of the schedule\n");
+            return -1;
+        }
+        report->violations = violations;
+        report->size_violations = size;
+    }
+    
+    Schedule_Violation *violation = &report->violations[report->num_violations];
+    violation->type = type;
+    violation->frame_id = frame_id;
+    violation->other_frame_id = other_frame_id;
+    violation->link_id = link_id;
+    violation->instance = instance;
+    violation->replica = replica;
+    report->num_violations += 1;
+    
+    return 0;
+}
+
+/**
+ Compare two transmissions of a link by their starting time, qsort style
+
+ @param a pointer to the first transmission
+ @param b pointer to the second transmission
+ @return negative if a goes first, positive if b goes first, 0 if they are the same
+ */
+int compare_transmissions(const void *a, const void *b) {
+    
+    const Link_Transmission *trans_a = a;
+    const Link_Transmission *trans_b = b;
+    
+    if (trans_a->start != trans_b->start) {
+        return trans_a->start < trans_b->start ? -1 : 1;
+    }
+    if (trans_a->frame_pos != trans_b->frame_pos) {
+        return trans_a->frame_pos - trans_b->frame_pos;
+    }
+    if (trans_a->instance != trans_b->instance) {
+        return trans_a->instance - trans_b->instance;
+    }
+    return trans_a->replica - trans_b->replica;
+}
+
+/**
+ Compare two violations by frame, constraint, link, instance and replica, qsort style.
+ The order makes the report the same no matter which thread found every violation
+
+ @param a pointer to the first violation
+ @param b pointer to the second violation
+ @return negative if a goes first, positive if b goes first, 0 if they are the same
+ */
+int compare_violations(const void *a, const void *b) {
+    
+    const Schedule_Violation *vio_a = a;
+    const Schedule_Violation *vio_b = b;
+    
+    if (vio_a->frame_id != vio_b->frame_id) {
+        return vio_a->frame_id - vio_b->frame_id;
+    }
+    if (vio_a->type != vio_b->type) {
+        return (int) vio_a->type - (int) vio_b->type;
+    }
+    if (vio_a->link_id != vio_b->link_id) {
+        return vio_a->link_id - vio_b->link_id;
+    }
+    if (vio_a->other_frame_id != vio_b->other_frame_id) {
+        return vio_a->other_frame_id - vio_b->other_frame_id;
+    }
+    if (vio_a->instance != vio_b->instance) {
+        return vio_a->instance - vio_b->instance;
+    }
+    return vio_a->replica - vio_b->replica;
+}
+
+/**
+ Check the limits of all the transmissions of a link, and sweep them sorted by their starting time to find the
+ collisions with other frames and with the bandwidth reservation.
+ As they are sorted, a transmission can only collide with the ones that start before it ends
+
+ @param pool pointer to the pool of the validation
+ @param link_it position of the link in the pool
+ @param report pointer to the report of the thread
+ @return 0 if done correctly, -1 otherwise
+ */
+int check_link_transmissions(Validator_Pool *pool, int link_it, Schedule_Report *report) {
+    
+    Traffic *t = pool->traffic_pt;
+    Traffic_View *view = pool->view_pt;
+    int link_id = pool->link_ids[link_it];
+    Link_Transmission *trans = &pool->transmissions[pool->link_first[link_it]];
+    int num_trans = pool->link_first[link_it + 1] - pool->link_first[link_it];
+    
+    qsort(trans, num_trans, sizeof(Link_Transmission), compare_transmissions);
+    
+    for (int i = 0; i < num_trans; i++) {
+        
+        // Check if the transmission time is between its limits
+        if (trans[i].frame_pos != -1) {
+            int frame_id = t->frames_id[trans[i].frame_pos];
+            long long int period = get_view_period(view, trans[i].frame_pos);
+            long long int lb = (period * trans[i].instance) + get_view_starting(view, trans[i].frame_pos);
+            long long int ub = (period * trans[i].instance) + get_view_deadline(view, trans[i].frame_pos) -
+                               trans[i].time;
+            if (trans[i].start < lb && add_violation(report, violation_lower_bound, frame_id, -1, link_id,
+                                                     trans[i].instance, trans[i].replica) == -1) {
+                return -1;
+            }
+            if (trans[i].start > ub && add_violation(report, violation_upper_bound, frame_id, -1, link_id,
+                                                     trans[i].instance, trans[i].replica) == -1) {
+                return -1;
+            }
+        }
+        
+        // Check the collisions with the transmissions that start before this one ends
+        for (int j = i + 1; j < num_trans && trans[j].start < trans[i].start + trans[i].time; j++) {
+            
+            Link_Transmission *first = &trans[i], *second = &trans[j];
+            if (first->frame_pos == second->frame_pos) {
+                continue;
+            }
+            
+            // With the bandwidth reservation, the whole transmissions can not overlap
+            if (first->frame_pos == -1 || second->frame_pos == -1) {
+                Link_Transmission *frame_trans = first->frame_pos == -1 ? second : first;
+                if (second->start < first->start + first->time && first->start < second->start + second->time &&
+                    add_violation(report, violation_protocol, t->frames_id[frame_trans->frame_pos], -1, link_id,
+                                  frame_trans->instance, frame_trans->replica) == -1) {
+                    return -1;
+                }
+                continue;
+            }
+            
+            // Between frames, the last time slot of a transmission can be the first of the other
+            if (second->start < first->start + first->time - 1 && first->start < second->start + second->time - 1) {
+                Link_Transmission *later = first->frame_pos > second->frame_pos ? first : second;
+                Link_Transmission *earlier = later == first ? second : first;
+                if (add_violation(report, violation_collision, t->frames_id[later->frame_pos],
+                                  t->frames_id[earlier->frame_pos], link_id, later->instance, later->replica) == -1) {
+                    return -1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Check that the paths of the given frames are followed in order and that the end to end delays are satisfied
+
+ @param t pointer to the traffic
+ @param first_frame position of the first frame to check
+ @param last_frame position after the last frame to check
+ @param report pointer to the report of the thread
+ @return 0 if done correctly, -1 otherwise
+ */
+int check_frame_paths(Traffic *t, int first_frame, int last_frame, Schedule_Report *report) {
+    
+    for (int i = first_frame; i < last_frame; i++) {
+        for (int j = 0; j < get_num_paths(&t->frames[i]); j++) {
+            
+            // Every link of the path has to start after the last replica of the previous link finished and the
+            // switch processed it
+            Path *path_pt = get_path(&t->frames[i], j);
+            for (int h = 0; h < get_num_links_path(path_pt) - 1; h++) {
+                Offset *off = get_offset_path_link(path_pt, h);
+                Offset *next_off = get_offset_path_link(path_pt, h + 1);
+                int last_repl = get_off_num_replicas(off) - 1;
+                long long int distance = get_off_time(off) + get_switch_min_time();
+                for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+                    long long int trans_time = get_trans_time(off, inst, last_repl);
+                    long long int next_trans_time = get_trans_time(next_off, inst, 0);
+                    if ((next_trans_time - trans_time) < distance &&
+                        add_violation(report, violation_path, t->frames_id[i], -1, get_off_link_id(next_off),
+                                      inst, 0) == -1) {
+                        return -1;
+                    }
+                }
+            }
+            
+            // Check the first and last links in the path for the end to end delay (0 => not taken into account)
+            if (get_end_to_end(&t->frames[i]) == 0) {
+                continue;
+            }
+            Offset *off = get_offset_path_link(path_pt, 0);
+            Offset *last_off = get_offset_path_link(path_pt, get_num_links_path(path_pt) - 1);
+            int last_repl = get_off_num_replicas(last_off) - 1;
+            long long int distance = get_end_to_end(&t->frames[i]) - get_off_time(off) + 1;
+            for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+                long long int trans_time = get_trans_time(off, inst, 0);
+                long long int last_trans_time = get_trans_time(last_off, inst, last_repl);
+                if ((last_trans_time - trans_time) > distance &&
+                    add_violation(report, violation_end_to_end, t->frames_id[i], -1, -1, inst, last_repl) == -1) {
+                    return -1;
+                }
+            }
+        }
+        
+        // The replicas of every link are transmitted one after the other, the period of strictly periodic offsets
+        // shifts all the replicas of an instance the same
+        for (int j = 0; j < get_num_offsets(&t->frames[i]); j++) {
+            Offset *off = get_offset_it(&t->frames[i], j);
+            int num_replicas = get_off_num_replicas(off);
+            int time = get_off_time(off);
+            for (int inst = 0; inst < get_off_stored_instances(off) && num_replicas > 1; inst++) {
+                long long int *times = get_replica_times(off, inst);
+                for (int repl = 1; repl < num_replicas; repl++) {
+                    if ((times[repl] - times[repl - 1]) < time &&
+                        add_violation(report, violation_replica, t->frames_id[i], -1, get_off_link_id(off), inst,
+                                      repl) == -1) {
+                        return -1;
+                    }
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ Thread that takes the next task of the validation until all the links and frames are checked
+
+ @param thread_pt pointer to the state of the thread
+ @return NULL
+ */
+void * validate_thread(void *thread_pt) {
+    
+    Validator_Thread *thread = thread_pt;
+    Validator_Pool *pool = thread->pool;
+    
+    // The frames and links are checked in the network of the thread that started the pool
+    set_network(pool->network_pt);
+    
+    while (1) {
+        pthread_mutex_lock(&pool->lock);
+        int task = pool->next_task;
+        pool->next_task += 1;
+        pthread_mutex_unlock(&pool->lock);
+        if (task >= pool->num_tasks) {
+            break;
+        }
+        
+        // The first tasks are the links, the rest are blocks of frames. A task that fails is not retried, the
+        // validation fails as its violations might be missing
+        if (task < pool->num_links) {
+            if (check_link_transmissions(pool, task, &thread->report) == -1) {
+                thread->error = -1;
+            }
+        } else {
+            int first_frame = (task - pool->num_links) * VALIDATOR_FRAME_BLOCK;
+            int last_frame = first_frame + VALIDATOR_FRAME_BLOCK;
+            if (last_frame > pool->traffic_pt->num_frames) {
+                last_frame = pool->traffic_pt->num_frames;
+            }
+            if (check_frame_paths(pool->traffic_pt, first_frame, last_frame, &thread->report) == -1) {
+                thread->error = -1;
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ Group the transmissions of all the frames, and of the bandwidth reservation, by the link they use.
+ They are copied from the view of the traffic, that already has them grouped
+
+ @param pool pointer to the pool of the validation, the links and transmissions are saved in it
+ @return 0 if done correctly, -1 otherwise
+ */
+int prepare_link_transmissions(Validator_Pool *pool) {
+    
+    Traffic_View *view = pool->view_pt;
+    
+    // Only the links with transmissions are checked
+    int num_links = 0;
+    for (int link_id = 0; link_id < view->num_links; link_id++) {
+        num_links += get_view_link_trans(view, link_id) != 0;
+    }
+    int total = view->link_first[view->num_links];
+    pool->num_links = num_links;
+    pool->link_ids = malloc(sizeof(int) * (num_links + 1));
+    pool->link_first = malloc(sizeof(int) * (num_links + 1));
+    pool->transmissions = malloc(sizeof(Link_Transmission) * (total + 1));
+    if (pool->link_ids == NULL || pool->link_first == NULL || pool->transmissions == NULL) {
+        fprintf(stderr, "Not enough memory to validate the schedule\n");
+        return -1;
+    }
+    int link_it = 0;
+    for (int link_id = 0; link_id < view->num_links; link_id++) {
+        if (get_view_link_trans(view, link_id) != 0) {
+            pool->link_ids[link_it] = link_id;
+            pool->link_first[link_it] = get_view_link_first(view, link_id);
+            link_it++;
+        }
+    }
+    pool->link_first[num_links] = total;
+    
+    // Copy the transmissions, the bandwidth reservation has no frame position
+    for (int i = 0; i < total; i++) {
+        Link_Transmission *trans = &pool->transmissions[i];
+        trans->start = view->trans_start[i];
+        trans->time = view->trans_time[i];
+        trans->frame_pos = view->trans_frame[i] != view->num_frames ? view->trans_frame[i] : -1;
+        trans->instance = view->trans_instance[i];
+        trans->replica = view->trans_replica[i];
+    }
+    
+    return 0;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Check all the constraints of the schedule of the traffic and save all the violations found in the report
+ */
+int validate_schedule(Traffic *t, int num_threads, Schedule_Report *report) {
+    
+    if (t == NULL || report == NULL) {
+        fprintf(stderr, "The given traffic or report pointer is NULL\n");
+        return -1;
+    }
+    memset(report, 0, sizeof(Schedule_Report));
+    
+    SelfHealing_Protocol *protocol = get_healing_protocol();
+    Traffic_View view;
+    if (build_traffic_view(t, protocol->period != 0 ? &protocol->reservation : NULL, &view) == -1) {
+        return -1;
+    }
+    Validator_Pool pool;
+    memset(&pool, 0, sizeof(Validator_Pool));
+    pool.traffic_pt = t;
+    pool.view_pt = &view;
+    if (prepare_link_transmissions(&pool) == -1) {
+        free(pool.link_ids);
+        free(pool.link_first);
+        free(pool.transmissions);
+        free_traffic_view(&view);
+        return -1;
+    }
+    pool.num_tasks = pool.num_links + (t->num_frames + VALIDATOR_FRAME_BLOCK - 1) / VALIDATOR_FRAME_BLOCK;
+    pool.next_task = 0;
+    pool.network_pt = get_network();
+    pthread_mutex_init(&pool.lock, NULL);
+    
+    if (num_threads == 0) {
+        num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (num_threads > pool.num_tasks) {
+        num_threads = pool.num_tasks;
+    }
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+    Validator_Thread *threads = calloc(num_threads, sizeof(Validator_Thread));
+    pthread_t *threads_id = malloc(sizeof(pthread_t) * num_threads);
+    int error = 0;
+    if (threads == NULL || threads_id == NULL) {
+        fprintf(stderr, "Not enough memory for the validation threads\n");
+        error = -1;
+    } else {
+        
+        // If a thread can not be created, the ones already created check everything
+        int created = 0;
+        for (int i = 0; i < num_threads; i++) {
+            threads[i].pool = &pool;
+            if (pthread_create(&threads_id[created], NULL, validate_thread, &threads[created]) == 0) {
+                created++;
+            }
+        }
+        if (created == 0) {
+            validate_thread(&threads[0]);
+            created = 1;
+        } else {
+            for (int i = 0; i < created; i++) {
+                pthread_join(threads_id[i], NULL);
+            }
+        }
+        
+        // Join the violations found by all the threads
+        for (int i = 0; i < created; i++) {
+            if (threads[i].error == -1) {
+                fprintf(stderr, "Some links or frames could not be validated\n");
+                error = -1;
+                break;
+            }
+        }
+        for (int i = 0; i < created && error == 0; i++) {
+            for (int j = 0; j < threads[i].report.num_violations && error == 0; j++) {
+                Schedule_Violation *vio = &threads[i].report.violations[j];
+                error = add_violation(report, vio->type, vio->frame_id, vio->other_frame_id, vio->link_id,
+                                      vio->instance, vio->replica);
+            }
+        }
+        for (int i = 0; i < num_threads; i++) {
+            free_schedule_report(&threads[i].report);
+        }
+        if (report->num_violations > 1) {
+            qsort(report->violations, report->num_violations, sizeof(Schedule_Violation), compare_violations);
+        }
+    }
+    
+    free(threads);
+    free(threads_id);
+    free(pool.link_ids);
+    free(pool.link_first);
+    free(pool.transmissions);
+    free_traffic_view(&view);
+    pthread_mutex_destroy(&pool.lock);
+    
+    return error == -1 ? -1 : report->num_violations;
+}
+
+/**
+ Write all the violations of the report, one per line
+ */
+int print_schedule_report(Schedule_Report *report, FILE *stream) {
+    
+    if (report == NULL || stream == NULL) {
+        fprintf(stderr, "The given report or stream pointer is NULL\n");
+        return -1;
+    }
+    
+    for (int i = 0; i < report->num_violations; i++) {
+        Schedule_Violation *vio = &report->violations[i];
+        switch (vio->type) {
+            case violation_lower_bound:
+                fprintf(stream, "The transmission time of frame %d link %d is smaller than should be",
+                        vio->frame_id, vio->link_id);
+                break;
+            case violation_upper_bound:
+                fprintf(stream, "The transmission time of frame %d link %d is larger than should be",
+                        vio->frame_id, vio->link_id);
+                break;
+            case violation_protocol:
+                fprintf(stream, "The frame %d collides with the protocol in link %d", vio->frame_id, vio->link_id);
+                break;
+            case violation_collision:
+                fprintf(stream, "The frames %d and %d collide in link %d", vio->frame_id, vio->other_frame_id,
+                        vio->link_id);
+                break;
+            case violation_path:
+                fprintf(stream, "The distances of the path of frame %d is wrong in link %d", vio->frame_id,
+                        vio->link_id);
+                break;
+            case violation_end_to_end:
+                fprintf(stream, "The end to end delay of frame %d is wrong", vio->frame_id);
+                break;
+            case violation_replica:
+                fprintf(stream, "The replicas of frame %d overlap in link %d", vio->frame_id, vio->link_id);
+                break;
+        }
+        fprintf(stream, " (instance %d, replica %d)\n", vio->instance, vio->replica);
+    }
+    
+    return 0;
+}
+
+/**
+ Free the violations of the report
+ */
+int free_schedule_report(Schedule_Report *report) {
+    
+    if (report == NULL) {
+        fprintf(stderr, "The given report pointer is NULL\n");
+        return -1;
+    }
+    
+    free(report->violations);
+    report->violations = NULL;
+    report->num_violations = 0;
+    report->size_violations = 0;
+    
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Validator.h                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that checks that a schedule does not violate any of its constraints and reports all the violations found.  *
+ *  The transmissions of every link are sorted once by their starting time and swept to find the collisions, instead   *
+ *  of comparing every frame with all the frames before it. The links and the paths of the frames are checked by a     *
+ *  pool of threads, every thread keeps its own violations and they are joined and sorted at the end.                  *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef Validator_h
+#define Validator_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#endif /* Validator_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+#define VALIDATOR_FRAME_BLOCK 64    // Number of frames whose paths are checked by a thread at a time
+
+/**
+ Constraint violated by a transmission
+ */
+typedef enum Violation_Type {
+    violation_lower_bound,          // The transmission starts before the period of the instance or the starting time
+    violation_upper_bound,          // The transmission ends after the deadline of the instance
+    violation_protocol,             // The transmission collides with the bandwidth reservation of the protocol
+    violation_collision,            // The transmission collides with a transmission of another frame
+    violation_path,                 // The transmission starts before the previous link of the path finished
+    violation_end_to_end,           // The path takes longer than the end to end delay of the frame
+    violation_replica               // The replica starts before the previous replica of the link finished
+}Violation_Type;
+
+/**
+ Violation of a constraint found in the schedule
+ */
+typedef struct Schedule_Violation {
+    Violation_Type type;            // Constraint violated
+    int frame_id;                   // Frame that violates the constraint
+    int other_frame_id;             // Frame it collides with, -1 if the violation is not a collision
+    int link_id;                    // Link where the violation happens, -1 if it is the whole path
+    int instance;                   // Instance of the transmission
+    int replica;                    // Replica of the transmission
+}Schedule_Violation;
+
+/**
+ Report with all the violations found in a schedule
+ */
+typedef struct Schedule_Report {
+    Schedule_Violation *violations; // List of violations
+    int num_violations;             // Number of violations in the list
+    int size_violations;            // Number of violations allocated
+}Schedule_Report;
+
+/**
+ Transmission of a link to sort them by their starting time
+ */
+typedef struct Link_Transmission {
+    long long int start;            // Transmission time
+    int time;                       // Time to transmit
+    int frame_pos;                  // Position of the frame in the traffic, -1 for the bandwidth reservation
+    int instance;                   // Instance of the transmission
+    int replica;                    // Replica of the transmission
+}Link_Transmission;
+
+/**
+ Shared state of the threads that validate a schedule
+ */
+typedef struct Validator_Pool {
+    Traffic *traffic_pt;            // Traffic to validate
+    struct Traffic_View *view_pt;   // Packed view of the traffic, with the transmissions grouped by link
+    int num_links;                  // Number of links with transmissions
+    int *link_ids;                  // Id of every link with transmissions
+    int *link_first;                // Position of the first transmission of every link, with one more at the end
+    Link_Transmission *transmissions;   // Transmissions of all links, grouped by link
+    int num_tasks;                  // Number of tasks, one per link and one per block of frames
+    int next_task;                  // Next task to be taken by a thread
+    pthread_mutex_t lock;           // Lock to take the next task
+    Network *network_pt;            // Network of the thread that validates the schedule
+}Validator_Pool;
+
+/**
+ State of a thread that validates a schedule
+ */
+typedef struct Validator_Thread {
+    Validator_Pool *pool;           // Pool shared by all the threads
+    Schedule_Report report;         // Violations found by the thread
+    int error;                      // -1 if a task of the thread could not be checked, 0 otherwise
+}Validator_Thread;
+
+                                                /* CODE DEFINITIONS */
+
+/**
+ Check all the constraints of the schedule of the traffic and save all the violations found in the report
+
+ @param t pointer to the traffic
+ @param num_threads number of threads, 0 to use one per available processor
+ @param report pointer to the report to fill, it has to be freed with free_schedule_report
+ @return number of violations found, -1 if something went wrong
+ */
+int validate_schedule(Traffic *t, int num_threads, Schedule_Report *report);
+
+/**
+ Write all the violations of the report, one per line
+
+ @param report pointer to the report
+ @param stream stream where to write
+ @return 0 if done correctly, -1 otherwise
+ */
+int print_schedule_report(Schedule_Report *report, FILE *stream);
+
+/**
+ Free the violations of the report
+
+ @param report pointer to the report
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_schedule_report(Schedule_Report *report);
@@ -0,0 +1,193 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  View.c                                                                                                             *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Description in View.h                                                                                              *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "Network.h"
+#include "View.h"
+
+                                                /* AUXILIAR FUNCTIONS */
+
+/**
+ Add the transmissions of an offset at the given position of the flat arrays of the view
+
+ @param view pointer to the view
+ @param off pointer to the offset
+ @param frame_pos position of the frame of the offset
+ @param pos position of the first transmission of the offset in the flat arrays
+ @return position after the last transmission of the offset
+ */
+int add_view_transmissions(Traffic_View *view, Offset *off, int frame_pos, int pos) {
+    
+    int num_replicas = get_off_num_replicas(off);
+    int time = get_off_time(off);
+    int range = has_trans_range(off) == 1;
+    for (int inst = 0; inst < get_off_num_instances(off); inst++) {
+        for (int repl = 0; repl < num_replicas; repl++, pos++) {
+            view->trans_start[pos] = get_trans_time(off, inst, repl);
+            view->trans_min[pos] = range ? get_min_trans_time(off, inst, repl) : view->trans_start[pos];
+            view->trans_max[pos] = range ? get_max_trans_time(off, inst, repl) : view->trans_start[pos];
+            view->trans_time[pos] = time;
+            view->trans_frame[pos] = frame_pos;
+            view->trans_instance[pos] = inst;
+            view->trans_replica[pos] = repl;
+        }
+    }
+    
+    return pos;
+}
+
+                                                    /* FUNCTIONS */
+
+/**
+ Build the view of the traffic with the current transmission times of its schedule
+ */
+int build_traffic_view(Traffic *t, Frame *reservation, Traffic_View *view) {
+    
+    if (t == NULL || view == NULL) {
+        fprintf(stderr, "The given traffic or view pointer is NULL\n");
+        return -1;
+    }
+    memset(view, 0, sizeof(Traffic_View));
+    
+    // The timing of the frames, and the reservation after them
+    int num_timings = t->num_frames + 1;
+    view->num_frames = t->num_frames;
+    view->periods = malloc(sizeof(long long int) * num_timings);
+    view->deadlines = malloc(sizeof(long long int) * num_timings);
+    view->startings = malloc(sizeof(long long int) * num_timings);
+    if (view->periods == NULL || view->deadlines == NULL || view->startings == NULL) {
+        fprintf(stderr, "Not enough memory for the view of the traffic\n");
+        free_traffic_view(view);
+        return -1;
+    }
+    for (int i = 0; i < t->num_frames; i++) {
+        view->periods[i] = get_period(&t->frames[i]);
+        view->deadlines[i] = get_deadline(&t->frames[i]);
+        view->startings[i] = get_starting_time(&t->frames[i]);
+    }
+    view->periods[t->num_frames] = reservation != NULL ? get_period(reservation) : 0;
+    view->deadlines[t->num_frames] = reservation != NULL ? get_deadline(reservation) : 0;
+    view->startings[t->num_frames] = reservation != NULL ? get_starting_time(reservation) : 0;
+    
+    // Count the transmissions of every link, the reservation is only added in the links used by the frames
+    for (int i = 0; i < t->num_frames; i++) {
+        for (int j = 0; j < get_num_offsets(&t->frames[i]); j++) {
+            if (get_link_id_offset_it(&t->frames[i], j) >= view->num_links) {
+                view->num_links = get_link_id_offset_it(&t->frames[i], j) + 1;
+            }
+        }
+    }
+    view->link_first = calloc(view->num_links + 1, sizeof(int));
+    if (view->link_first == NULL) {
+        fprintf(stderr, "Not enough memory for the view of the traffic\n");
+        free_traffic_view(view);
+        return -1;
+    }
+    for (int i = 0; i < t->num_frames; i++) {
+        for (int j = 0; j < get_num_offsets(&t->frames[i]); j++) {
+            Offset *off = get_offset_it(&t->frames[i], j);
+            view->link_first[get_link_id_offset_it(&t->frames[i], j) + 1] += get_off_num_instances(off) *
+                                                                             get_off_num_replicas(off);
+        }
+    }
+    for (int link_id = 0; link_id < view->num_links && reservation != NULL; link_id++) {
+        Offset *off = get_offset_by_link(reservation, link_id);
+        if (view->link_first[link_id + 1] != 0 && off != NULL) {
+            view->link_first[link_id + 1] += get_off_num_instances(off) * get_off_num_replicas(off);
+        }
+    }
+    for (int link_id = 0; link_id < view->num_links; link_id++) {
+        view->link_first[link_id + 1] += view->link_first[link_id];
+    }
+    
+    // Copy the transmissions in the place of their link, sorted by the position of their frames
+    int total = view->link_first[view->num_links];
+    view->trans_start = malloc(sizeof(long long int) * (total + 1));
+    view->trans_min = malloc(sizeof(long long int) * (total + 1));
+    view->trans_max = malloc(sizeof(long long int) * (total + 1));
+    view->trans_time = malloc(sizeof(int) * (total + 1));
+    view->trans_frame = malloc(sizeof(int) * (total + 1));
+    view->trans_instance = malloc(sizeof(int) * (total + 1));
+    view->trans_replica = malloc(sizeof(int) * (total + 1));
+    int *link_pos = malloc(sizeof(int) * (view->num_links + 1));
+    if (view->trans_start == NULL || view->trans_min == NULL || view->trans_max == NULL || view->trans_time == NULL ||
+        view->trans_frame == NULL || view->trans_instance == NULL || view->trans_replica == NULL || link_pos == NULL) {
+        fprintf(stderr, "Not enough memory for the view of the traffic\n");
+        free(link_pos);
+        free_traffic_view(view);
+        return -1;
+    }
+    memcpy(link_pos, view->link_first, sizeof(int) * (view->num_links + 1));
+    for (int i = 0; i < t->num_frames; i++) {
+        for (int j = 0; j < get_num_offsets(&t->frames[i]); j++) {
+            int link_id = get_link_id_offset_it(&t->frames[i], j);
+            link_pos[link_id] = add_view_transmissions(view, get_offset_it(&t->frames[i], j), i, link_pos[link_id]);
+        }
+    }
+    for (int link_id = 0; link_id < view->num_links && reservation != NULL; link_id++) {
+        Offset *off = get_offset_by_link(reservation, link_id);
+        if (link_pos[link_id] != view->link_first[link_id] && off != NULL) {
+            link_pos[link_id] = add_view_transmissions(view, off, t->num_frames, link_pos[link_id]);
+        }
+    }
+    
+    free(link_pos);
+    return 0;
+}
+
+/**
+ Find the first transmission of a frame in a link, the transmissions of a link are sorted by the position of frames
+ */
+int find_view_transmissions(Traffic_View *view, int link_id, int frame_pos) {
+    
+    if (view == NULL || link_id < 0 || link_id >= view->num_links) {
+        return -1;
+    }
+    
+    // Binary search of the first transmission of the link with a frame position not lower than the given one
+    int low = view->link_first[link_id], high = view->link_first[link_id + 1];
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (view->trans_frame[middle] < frame_pos) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    
+    return low < view->link_first[link_id + 1] && view->trans_frame[low] == frame_pos ? low : -1;
+}
+
+/**
+ Free the arrays of the view
+ */
+int free_traffic_view(Traffic_View *view) {
+    
+    if (view == NULL) {
+        fprintf(stderr, "The given view pointer is NULL\n");
+        return -1;
+    }
+    
+    free(view->periods);
+    free(view->deadlines);
+    free(view->startings);
+    free(view->link_first);
+    free(view->trans_start);
+    free(view->trans_min);
+    free(view->trans_max);
+    free(view->trans_time);
+    free(view->trans_frame);
+    free(view->trans_instance);
+    free(view->trans_replica);
+    memset(view, 0, sizeof(Traffic_View));
+    
+    return 0;
+}
@@ -0,0 +1,134 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  View.h                                                                                                             *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Package that keeps a packed view of a traffic for the loops that build the constraints and validate a schedule.    *
+ *  The timing of the frames is kept in arrays by the position of the frames in the traffic, and the transmissions of  *
+ *  every link are kept together in flat arrays, so the loops read them directly instead of calling the getters of     *
+ *  every frame and offset. The view is a copy, so it has to be built again once the traffic or its schedule changes.  *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef View_h
+#define View_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#endif /* View_h */
+
+                                                /* STRUCT DEFINITIONS */
+
+/**
+ Packed view of a traffic. The reservation of the protocol, if given, goes after the frames in the timing arrays and
+ in the transmissions of the links used by the frames
+ */
+typedef struct Traffic_View {
+    int num_frames;                     // Number of frames of the traffic, the position of the reservation
+    long long int *periods;             // Period of every frame in time slots
+    long long int *deadlines;           // Deadline of every frame in time slots
+    long long int *startings;           // Starting time of every frame in time slots
+    int num_links;                      // Number of link ids, the higher link id plus one
+    int *link_first;                    // Position of the first transmission of every link, the total at the end
+    long long int *trans_start;         // Transmission time of every transmission, sorted by link and frame
+    long long int *trans_min;           // Minimum transmission time of every transmission, its time if it has no range
+    long long int *trans_max;           // Maximum transmission time of every transmission, its time if it has no range
+    int *trans_time;                    // Time slots of every transmission
+    int *trans_frame;                   // Position of the frame of every transmission
+    int *trans_instance;                // Instance of every transmission
+    int *trans_replica;                 // Replica of every transmission
+}Traffic_View;
+
+                                                /* CODE DEFINITIONS */
+
+/* Inline getters, they do not check their arguments as they are called for every transmission */
+
+/**
+ Get the period of the frame at the given position
+
+ @param view pointer to the view
+ @param frame_pos position of the frame in the traffic, the number of frames for the reservation
+ @return period of the frame in time slots
+ */
+static inline long long int get_view_period(Traffic_View *view, int frame_pos) {
+    return view->periods[frame_pos];
+}
+
+/**
+ Get the deadline of the frame at the given position
+
+ @param view pointer to the view
+ @param frame_pos position of the frame in the traffic, the number of frames for the reservation
+ @return deadline of the frame in time slots
+ */
+static inline long long int get_view_deadline(Traffic_View *view, int frame_pos) {
+    return view->deadlines[frame_pos];
+}
+
+/**
+ Get the starting time of the frame at the given position
+
+ @param view pointer to the view
+ @param frame_pos position of the frame in the traffic, the number of frames for the reservation
+ @return starting time of the frame in time slots
+ */
+static inline long long int get_view_starting(Traffic_View *view, int frame_pos) {
+    return view->startings[frame_pos];
+}
+
+/**
+ Get the position of the first transmission of a link in the flat arrays of the transmissions
+
+ @param view pointer to the view
+ @param link_id id of the link
+ @return position of the first transmission of the link
+ */
+static inline int get_view_link_first(Traffic_View *view, int link_id) {
+    return view->link_first[link_id];
+}
+
+/**
+ Get the number of transmissions of a link
+
+ @param view pointer to the view
+ @param link_id id of the link
+ @return number of transmissions of the link
+ */
+static inline int get_view_link_trans(Traffic_View *view, int link_id) {
+    return view->link_first[link_id + 1] - view->link_first[link_id];
+}
+
+/* Functions */
+
+/**
+ Find the first transmission of a frame in a link, the transmissions of a link are sorted by the position of frames
+
+ @param view pointer to the view
+ @param link_id id of the link
+ @param frame_pos position of the frame in the traffic, the number of frames for the reservation
+ @return position of the first transmission of the frame in the flat arrays, -1 if the frame does not use the link
+ */
+int find_view_transmissions(Traffic_View *view, int link_id, int frame_pos);
+
+/**
+ Build the view of the traffic with the current transmission times of its schedule
+
+ @param t pointer to the traffic
+ @param reservation pointer to the frame of the reservation of the protocol, NULL if there is no protocol
+ @param view pointer to the view, it has to be freed with free_traffic_view
+ @return 0 if done correctly, -1 otherwise
+ */
+int build_traffic_view(Traffic *t, Frame *reservation, Traffic_View *view);
+
+/**
+ Free the arrays of the view
+
+ @param view pointer to the view
+ @return 0 if done correctly, -1 otherwise
+ */
+int free_traffic_view(Traffic_View *view);
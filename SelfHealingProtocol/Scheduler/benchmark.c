@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Benchmark.c                                                                                                        *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Measures the scheduling algorithms, the patch and the optimize on a network, adding the results at the end of a    *
+ *  csv file. If the size of the network is given, a synthetic network is generated first in the network file:         *
+ *      Benchmark <network_file> <parameters_file> <csv_file> [<repetitions> [<workloads> [<switches> <end_systems>    *
+ *                <frames> [<topology> [<utilization> [<seed>]]]]]]                                                    *
+ *  An optional argument "-" is left out, so the next ones keep their position.                                        *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Scheduler/Network.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/Generator.h"
+#include "Scheduler/Benchmark.h"
+
+int main(int argc, const char * argv[]) {
+    
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <network_file> <parameters_file> <csv_file> [<repetitions> [<workloads> "
+                "[<switches> <end_systems> <frames> [<topology> [<utilization> [<seed>]]]]]], \"-\" leaves an "
+                "optional argument out\n", argv[0]);
+        return -1;
+    }
+    
+    // Optional synthetic network, the other parameters of the generator keep their default values
+    if (has_argument(argc, (char**) argv, 6)) {
+        if (!has_argument(argc, (char**) argv, 7) || !has_argument(argc, (char**) argv, 8)) {
+            fprintf(stderr, "The generated network needs the number of switches, end systems and frames\n");
+            return -1;
+        }
+        Generator_Parameters params;
+        set_default_generator_parameters(&params);
+        params.num_switches = atoi(argv[6]);
+        params.num_end_systems = atoi(argv[7]);
+        params.num_frames = atoi(argv[8]);
+        if (has_argument(argc, (char**) argv, 9) && set_generator_topology(&params, (char*) argv[9]) == -1) {
+            return -1;
+        }
+        if (has_argument(argc, (char**) argv, 10)) {
+            params.utilization = atof(argv[10]);
+        }
+        if (has_argument(argc, (char**) argv, 11)) {
+            params.seed = (unsigned int) strtoul(argv[11], NULL, 10);
+        }
+        // The mesh gets as many extra links as switches
+        if (params.topology == topology_mesh) {
+            params.num_extra_links = params.num_switches;
+        }
+        if (generate_network_xml(&params, (char*) argv[1]) == -1) {
+            return -1;
+        }
+    }
+    
+    // The parameters are read once, and every run of the benchmark copies them
+    if (read_schedule_parameters_xml((char*) argv[2]) == -1) {
+        return -1;
+    }
+    Benchmark_Report report;
+    int repetitions = has_argument(argc, (char**) argv, 4) ? atoi(argv[4]) : 1;
+    if (init_benchmark_report(&report, (char*) argv[1], repetitions) == -1) {
+        return -1;
+    }
+    // Optional workloads to measure, separated by commas, all of them by default
+    if (has_argument(argc, (char**) argv, 5) && set_benchmark_workloads(&report, (char*) argv[5]) == -1) {
+        return -1;
+    }
+    
+    int error = run_benchmark(&report);
+    if (error == 0) {
+        error = write_benchmark_report_csv(&report, (char*) argv[3]);
+    }
+    
+    free_benchmark_report(&report);
+    return error;
+}
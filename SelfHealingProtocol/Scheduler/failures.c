@@ -0,0 +1,91 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Failures.c                                                                                                         *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Schedules a network once and evaluates the failure of every one of its links, writing the result of all of them    *
+ *  in a single csv file:                                                                                              *
+ *      Failures <network_file> <parameters_file> <csv_file> [<threads> [<patch_index> [<cache_file>]]]                *
+ *  An optional argument "-" is left out, so the next ones keep their position.                                        *
+ *  With a cache file, the failures are repaired from its plans, and the plans are built and written in it first if    *
+ *  the file does not exist or the network file changed since it was written.                                          *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Scheduler/Network.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/Repair.h"
+#include "Scheduler/Failure.h"
+
+int main(int argc, const char * argv[]) {
+    
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <network_file> <parameters_file> <csv_file> [<threads> [<patch_index> "
+                "[<cache_file>]]], \"-\" leaves an optional argument out\n", argv[0]);
+        return -1;
+    }
+    // Optional number of threads that evaluate the failures, one per processor by default
+    int num_threads = has_argument(argc, (char**) argv, 4) ? atoi(argv[4]) : 0;
+    if (num_threads < 0) {
+        fprintf(stderr, "The number of threads should be equal or larger than 0\n");
+        return -1;
+    }
+    
+    if (read_network_xml((char*) argv[1]) == -1) {
+        return -1;
+    }
+    // The parameters go before preparing the network, as they decide how the offsets are stored
+    if (read_schedule_parameters_xml((char*) argv[2]) == -1) {
+        return -1;
+    }
+    // Optional structure to search the free slots when patching ("LinkedList" or "GapIndex")
+    if (has_argument(argc, (char**) argv, 5) && set_patch_index((char*) argv[5]) == -1) {
+        return -1;
+    }
+    if (prepare_network() == -1 || schedule_network() == -1) {
+        fprintf(stderr, "The network could not be scheduled, its link failures can not be evaluated\n");
+        return -1;
+    }
+    
+    // Optional cache of repair plans, built again if it is outdated
+    Repair_Cache cache;
+    int cached = has_argument(argc, (char**) argv, 6);
+    if (cached == 1) {
+        if (read_repair_cache((char*) argv[6], &cache) == -1) {
+            int num_plans = build_repair_cache(num_threads, &cache);
+            if (num_plans == -1) {
+                return -1;
+            }
+            if (write_repair_cache(&cache, (char*) argv[6]) == -1) {
+                free_repair_cache(&cache);
+                return -1;
+            }
+            printf("Built %d repair plans\n", num_plans);
+        }
+        set_repair_cache(&cache);
+    }
+    
+    Failure_Report report;
+    int num_patched = evaluate_link_failures(num_threads, &report);
+    if (num_patched == -1) {
+        if (cached == 1) {
+            free_repair_cache(&cache);
+        }
+        return -1;
+    }
+    int error = write_failure_report_csv(&report, (char*) argv[3]);
+    printf("Successfully patched %d/%d link failures\n", num_patched, report.num_results);
+    
+    free_failure_report(&report);
+    if (cached == 1) {
+        set_repair_cache(NULL);
+        free_repair_cache(&cache);
+    }
+    release_network_offsets();
+    return error;
+}
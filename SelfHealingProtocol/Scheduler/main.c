@@ -11,13 +11,30 @@
 #include <stdio.h>
 #include "Scheduler/Network.h"
 #include "Scheduler/Scheduler.h"
+#include "Scheduler/Profile.h"
 
 int main(int argc, const char * argv[]) {
     
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <network_file> <parameters_file> <schedule_file> [<output_format> "
+                "[<profile_file>]], \"-\" leaves an optional argument out\n", argv[0]);
+        return -1;
+    }
+    // Optional format of the schedule file ("XML" or "Binary"), xml by default
+    if (has_argument(argc, (char**) argv, 4) && set_output_format((char*) argv[4]) == -1) {
+        return -1;
+    }
+    
     read_network_xml((char*) argv[1]);
-    prepare_network();
+    // The parameters go before preparing the network, as they decide how the offsets are stored
     read_schedule_parameters_xml((char*) argv[2]);
+    prepare_network();
     schedule_network();
-    write_schedule_xml((char*) argv[3]);
+    write_schedule_file((char*) argv[3]);
+    // Optional json file with the time of every phase of the schedule
+    if (has_argument(argc, (char**) argv, 5)) {
+        write_profile_json((char*) argv[5]);
+    }
+    release_network_offsets();
     return 0;
 }
@@ -11,18 +11,47 @@
 #include <stdio.h>
 #include "Scheduler/Network.h"
 #include "Scheduler/Scheduler.h"
+#include "Scheduler/Profile.h"
 
 int main(int argc, const char * argv[]) {
 //    read_optimize_xml("/Users/fpo01/OneDrive - Mälardalens högskola/PhD Folder/Software/SelfHealingProtocol/SelfHealingProtocol/Files/Outputs/Optimize_21_22.xml");
 //    optimize();
 //    write_optimize_xml("/Users/fpo01/OneDrive - Mälardalens högskola/PhD Folder/Software/SelfHealingProtocol/SelfHealingProtocol/Files/Outputs/OptimizedSchedule_21_22.xml");
     
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <optimize_file> <optimized_file> <execution_file> [<optimize_mode> "
+                "[<output_format> [<encoding> [<profile_file> [<baseline_file>]]]]], \"-\" leaves an optional "
+                "argument out\n", argv[0]);
+        return -1;
+    }
+    // Optional use of the patched schedule ("Cold", "PatchStart", "PatchFallback" or "LocalSearch"), to compare them
+    if (has_argument(argc, (char**) argv, 4) && set_optimize_mode((char*) argv[4]) == -1) {
+        return -1;
+    }
+    // Optional format of the optimized schedule file ("XML", "Binary" or "Delta"), xml by default
+    if (has_argument(argc, (char**) argv, 5) && set_output_format((char*) argv[5]) == -1) {
+        return -1;
+    }
+    // Optional encoding of the disjunctions in the solver ("Indicator", "BigM" or "NoOverlap"), indicator by default
+    if (has_argument(argc, (char**) argv, 6) && set_encoding((char*) argv[6]) == -1) {
+        return -1;
+    }
+    // Optional binary schedule that the delta format is relative to, usually the patched schedule already distributed
+    if (has_argument(argc, (char**) argv, 8) && set_delta_baseline((char*) argv[8]) == -1) {
+        return -1;
+    }
+    
     read_optimize_xml((char*) argv[1]);
     if (optimize() == -1) {
         write_execution_time_xml((char*) argv[3]);
         return 0;
     }
-    write_optimize_xml((char*) argv[2]);
+    write_optimize_file((char*) argv[2]);
     write_execution_time_xml((char*) argv[3]);
+    // Optional json file with the time of every phase, as the profile of the execution time file
+    if (has_argument(argc, (char**) argv, 7)) {
+        write_profile_json((char*) argv[7]);
+    }
+    release_network_offsets();
     return 0;
 }
@@ -9,8 +9,11 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include "Scheduler/Network.h"
 #include "Scheduler/Scheduler.h"
+#include "Scheduler/Profile.h"
+#include "Scheduler/Repair.h"
 
 int main(int argc, const char * argv[]) {
 
@@ -22,12 +25,53 @@ int main(int argc, const char * argv[]) {
 //    write_execution_time_xml("/Users/fpo01/OneDrive - Mälardalens högskola/PhD Folder/Software/SelfHealingProtocol/SelfHealingProtocol/Files/Outputs/Execution.xml");
 //    write_patch_xml("/Users/fpo01/OneDrive - Mälardalens högskola/PhD Folder/Software/SelfHealingProtocol/SelfHealingProtocol/Files/Outputs/PatchedSchedule_6_1.xml");
     
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <patch_file> <patched_file> <execution_file> [<patch_index> [<patch_threads> "
+                "[<output_format> [<profile_file> [<baseline_file> [<cache_file>]]]]]], \"-\" leaves an optional "
+                "argument out\n", argv[0]);
+        return -1;
+    }
+    // Optional structure to search the free slots ("LinkedList" or "GapIndex"), to compare both of them
+    if (has_argument(argc, (char**) argv, 4) && set_patch_index((char*) argv[4]) == -1) {
+        return -1;
+    }
+    // Optional number of threads when the patch file has several links
+    if (has_argument(argc, (char**) argv, 5) && set_patch_threads(atoi(argv[5])) == -1) {
+        return -1;
+    }
+    // Optional format of the patched schedule file ("XML", "Binary" or "Delta"), xml by default
+    if (has_argument(argc, (char**) argv, 6) && set_output_format((char*) argv[6]) == -1) {
+        return -1;
+    }
+    // Optional binary schedule that the delta format is relative to, the patched frames are new in their links
+    // without it
+    if (has_argument(argc, (char**) argv, 8) && set_delta_baseline((char*) argv[8]) == -1) {
+        return -1;
+    }
+    
+    // Optional cache of repair plans, a valid plan of a link replaces its patch
+    Repair_Cache cache;
+    int cached = has_argument(argc, (char**) argv, 9) && read_repair_cache((char*) argv[9], &cache) == 0;
+    if (cached == 1) {
+        set_repair_cache(&cache);
+    }
+    
     read_patch_xml((char*) argv[1]);
-    if (patch() == -1) {
+    // With several links, the links that could be patched are written even if some failed
+    if (patch() == -1 && get_num_link_patches() == 0) {
         write_execution_time_xml((char*) argv[3]);
         return 0;
     }
+    write_patch_file((char*) argv[2]);
     write_execution_time_xml((char*) argv[3]);
-    write_patch_xml((char*) argv[2]);
+    // Optional json file with the time of every phase, as the profile of the execution time file
+    if (has_argument(argc, (char**) argv, 7)) {
+        write_profile_json((char*) argv[7]);
+    }
+    if (cached == 1) {
+        set_repair_cache(NULL);
+        free_repair_cache(&cache);
+    }
+    release_network_offsets();
     return 0;
 }
@@ -0,0 +1,313 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                                                                     *
+ *  Server.c                                                                                                           *
+ *  SelfHealingProtocol Scheduler                                                                                      *
+ *                                                                                                                     *
+ *  Created by the SelfHealingProtocol Scheduler contributors on 14/10/26.                                             *
+ *  Copyright © 2026 SelfHealingProtocol Scheduler contributors.                                                       *
+ *                                                                                                                     *
+ *  Long-running scheduler that executes the schedule, patch and optimize without starting a new process for every     *
+ *  event, so the solver environment is loaded only once.                                                              *
+ *  Every request is a line with the command and its files separated by tabs, so the paths can have spaces, the same   *
+ *  as the arguments of the executables:                                                                               *
+ *      Schedule <network_file> <parameters_file> <schedule_file> [<output_format> [<profile_file>]]                   *
+ *      Patch <patch_file> <patched_file> <execution_file> [<patch_index> [<patch_threads> [<output_format>            *
+ *            [<profile_file> [<baseline_file> [<cache_file>]]]]]]                                                     *
+ *      Optimize <optimize_file> <optimized_file> <execution_file> [<optimize_mode> [<output_format> [<encoding>       *
+ *               [<profile_file> [<baseline_file>]]]]]                                                                 *
+ *      Apply <baseline_file> <delta_file> <schedule_file>                                                             *
+ *      Quit                                                                                                           *
+ *  Every request is answered with a line: "OK" if a schedule was found, "FAIL" if not, or "ERROR <reason>" if the     *
+ *  request could not be executed. The requests are read from the standard input, or from the connections to a Unix    *
+ *  socket if its path is given as argument. The output of the solver goes to the standard error.                      *
+ *  The baseline file is the binary schedule that the "Delta" output format is relative to. An optional argument "-"   *
+ *  is left out, so the next ones keep their position. The cache file has the repair plans of the links, as in the     *
+ *  Patch executable. The apply request writes the binary schedule that results of a delta file over its baseline,     *
+ *  the schedule file can be the baseline file itself.                                                                 *
+ *  The patch and optimize files carry the fixed traffic of their links, so every request reads its own network and    *
+ *  only the solver environment stays loaded between requests. A client that disconnects does not stop the server.     *
+ *                                                                                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Scheduler/Network.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/Profile.h"
+#include "Scheduler/Repair.h"
+
+#define MAX_ARGUMENTS 10            // Maximum number of words in a request
+
+/**
+ Schedule a network, as the SelfHealingProtocol executable
+
+ @param argc number of arguments of the request
+ @param argv arguments of the request
+ @param out stream to answer the request
+ */
+void serve_schedule(int argc, char *argv[], FILE *out) {
+    
+    if (argc < 4) {
+        fprintf(out, "ERROR Schedule needs the network, parameters and schedule files\n");
+        return;
+    }
+    if (has_argument(argc, argv, 4) && set_output_format(argv[4]) == -1) {
+        fprintf(out, "ERROR The output format is not valid\n");
+        return;
+    }
+    if (read_network_xml(argv[1]) == -1 || read_schedule_parameters_xml(argv[2]) == -1 || prepare_network() == -1) {
+        fprintf(out, "ERROR The network or the parameters could not be read\n");
+        return;
+    }
+    if (schedule_network() == -1) {
+        fprintf(out, "FAIL\n");
+        return;
+    }
+    write_schedule_file(argv[3]);
+    if (has_argument(argc, argv, 5)) {
+        write_profile_json(argv[5]);
+    }
+    fprintf(out, "OK\n");
+}
+
+/**
+ Patch a link or several links, as the Patch executable
+
+ @param argc number of arguments of the request
+ @param argv arguments of the request
+ @param out stream to answer the request
+ */
+void serve_patch(int argc, char *argv[], FILE *out) {
+    
+    if (argc < 4) {
+        fprintf(out, "ERROR Patch needs the patch, patched schedule and execution files\n");
+        return;
+    }
+    if ((has_argument(argc, argv, 4) && set_patch_index(argv[4]) == -1) ||
+        (has_argument(argc, argv, 5) && set_patch_threads(atoi(argv[5])) == -1) ||
+        (has_argument(argc, argv, 6) && set_output_format(argv[6]) == -1) ||
+        (has_argument(argc, argv, 8) && set_delta_baseline(argv[8]) == -1)) {
+        fprintf(out, "ERROR The patch options are not valid\n");
+        return;
+    }
+    if (read_patch_xml(argv[1]) == -1) {
+        fprintf(out, "ERROR The patch file could not be read\n");
+        return;
+    }
+    
+    // As in the executable, a cache that can not be read or is outdated is not used
+    Repair_Cache cache;
+    int cached = has_argument(argc, argv, 9) && read_repair_cache(argv[9], &cache) == 0;
+    if (cached == 1) {
+        set_repair_cache(&cache);
+    }
+    // With several links, the links that could be patched are written even if some failed
+    int error = patch();
+    if (cached == 1) {
+        set_repair_cache(NULL);
+        free_repair_cache(&cache);
+    }
+    write_execution_time_xml(argv[3]);
+    if (error == -1 && get_num_link_patches() == 0) {
+        fprintf(out, "FAIL\n");
+        return;
+    }
+    write_patch_file(argv[2]);
+    if (has_argument(argc, argv, 7)) {
+        write_profile_json(argv[7]);
+    }
+    fprintf(out, error == -1 ? "FAIL\n" : "OK\n");
+}
+
+/**
+ Optimize a link, as the Optimize executable
+
+ @param argc number of arguments of the request
+ @param argv arguments of the request
+ @param out stream to answer the request
+ */
+void serve_optimize(int argc, char *argv[], FILE *out) {
+    
+    if (argc < 4) {
+        fprintf(out, "ERROR Optimize needs the optimize, optimized schedule and execution files\n");
+        return;
+    }
+    if ((has_argument(argc, argv, 4) && set_optimize_mode(argv[4]) == -1) ||
+        (has_argument(argc, argv, 5) && set_output_format(argv[5]) == -1) ||
+        (has_argument(argc, argv, 6) && set_encoding(argv[6]) == -1) ||
+        (has_argument(argc, argv, 8) && set_delta_baseline(argv[8]) == -1)) {
+        fprintf(out, "ERROR The optimize options are not valid\n");
+        return;
+    }
+    if (read_optimize_xml(argv[1]) == -1) {
+        fprintf(out, "ERROR The optimize file could not be read\n");
+        return;
+    }
+    if (optimize() == -1) {
+        write_execution_time_xml(argv[3]);
+        fprintf(out, "FAIL\n");
+        return;
+    }
+    write_optimize_file(argv[2]);
+    write_execution_time_xml(argv[3]);
+    if (has_argument(argc, argv, 7)) {
+        write_profile_json(argv[7]);
+    }
+    fprintf(out, "OK\n");
+}
+
+/**
+ Apply a delta schedule over its baseline, as the nodes do when they receive a delta
+
+ @param argc number of arguments of the request
+ @param argv arguments of the request
+ @param out stream to answer the request
+ */
+void serve_apply(int argc, char *argv[], FILE *out) {
+    
+    if (argc < 4) {
+        fprintf(out, "ERROR Apply needs the baseline, delta and schedule files\n");
+        return;
+    }
+    if (apply_delta_binary(argv[1], argv[2], argv[3]) == -1) {
+        fprintf(out, "FAIL\n");
+        return;
+    }
+    fprintf(out, "OK\n");
+}
+
+/**
+ Answer all the requests of the input stream until it ends or a quit request is received.
+ Between requests, the network and the scheduler are reset, but the solver environment stays loaded
+
+ @param in stream where the requests are read
+ @param out stream to answer the requests
+ @return 1 if a quit request was received, 0 otherwise
+ */
+int serve_requests(FILE *in, FILE *out) {
+    
+    char *line = NULL;
+    size_t size_line = 0;
+    int quit = 0;
+    
+    while (quit == 0 && getline(&line, &size_line, in) != -1) {
+        
+        // Split the request in words, only by tabs as the paths might have spaces
+        char *argv[MAX_ARGUMENTS];
+        int argc = 0;
+        char *word = strtok(line, "\t\r\n");
+        while (word != NULL && argc < MAX_ARGUMENTS) {
+            argv[argc++] = word;
+            word = strtok(NULL, "\t\r\n");
+        }
+        if (argc == 0) {
+            continue;
+        }
+        
+        if (strcmp(argv[0], "Schedule") == 0) {
+            serve_schedule(argc, argv, out);
+        } else if (strcmp(argv[0], "Patch") == 0) {
+            serve_patch(argc, argv, out);
+        } else if (strcmp(argv[0], "Optimize") == 0) {
+            serve_optimize(argc, argv, out);
+        } else if (strcmp(argv[0], "Apply") == 0) {
+            serve_apply(argc, argv, out);
+        } else if (strcmp(argv[0], "Quit") == 0) {
+            fprintf(out, "OK\n");
+            quit = 1;
+        } else {
+            fprintf(out, "ERROR The request %s is not recognized\n", argv[0]);
+        }
+        int write_error = fflush(out) == EOF ? errno : 0;
+        
+        // Leave everything ready for the next request
+        reset_scheduler();
+        reset_network();
+        
+        // A client that disconnected can not read more answers, so the rest of its requests are not served
+        if (write_error != 0) {
+            fprintf(stderr, write_error == EPIPE ? "The client disconnected before reading the answer\n" :
+                    "The answer to the request could not be written\n");
+            break;
+        }
+    }
+    
+    free(line);
+    return quit;
+}
+
+/**
+ Answer the requests of all the clients connected to the Unix socket, one client at a time
+
+ @param socket_path path of the socket
+ @return 0 if done correctly, -1 otherwise
+ */
+int serve_socket(const char *socket_path) {
+    
+    struct sockaddr_un address;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "The socket path is too long\n");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path);
+    if (server_fd == -1 || bind(server_fd, (struct sockaddr*) &address, sizeof(address)) == -1 ||
+        listen(server_fd, 1) == -1) {
+        fprintf(stderr, "The socket %s could not be opened\n", socket_path);
+        return -1;
+    }
+    
+    int quit = 0;
+    while (quit == 0) {
+        int client_fd = accept(server_fd, NULL, NULL);
+        if (client_fd == -1) {
+            fprintf(stderr, "The connection to the socket failed\n");
+            continue;
+        }
+        FILE *in = fdopen(client_fd, "r");
+        FILE *out = fdopen(dup(client_fd), "w");
+        quit = serve_requests(in, out);
+        fclose(in);
+        fclose(out);
+    }
+    
+    close(server_fd);
+    unlink(socket_path);
+    return 0;
+}
+
+int main(int argc, const char * argv[]) {
+    
+    // The solver writes its log in the standard output, move it to the standard error so it does not mix with the
+    // answers to the requests
+    FILE *out = fdopen(dup(STDOUT_FILENO), "w");
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    
+    // A client that disconnects while its answer is written gives an error in the write instead of a signal
+    signal(SIGPIPE, SIG_IGN);
+    
+    xmlInitParser();
+    set_persistent_solver(1);
+    
+    int error = 0;
+    if (argc > 1) {
+        error = serve_socket(argv[1]);
+    } else {
+        serve_requests(stdin, out);
+    }
+    
+    release_solver();
+    xmlCleanupParser();
+    fclose(out);
+    return error;
+}
@@ -22,11 +22,13 @@ from SimulatedNode import SimulatedNode
 from math import ceil, log2, floor
 from Event import InternalEvent, FrameEvent, ExecutionEvent
 from xml.dom import minidom
-from subprocess import run
+from subprocess import Popen, PIPE
 from os import remove
 from os.path import isfile
 import xml.etree.ElementTree as Xml
 import pandas
+from struct import Struct
+from mmap import mmap, ACCESS_READ
 
 
 class Simulation:
@@ -117,6 +119,7 @@ class Simulation:
         self.__no_path: Dict[int, bool] = {}  # Failed because no path
         self.__no_schedule: Dict[int, bool] = {}  # Failure because no schedule
         self.__no_transmission: Dict[int, bool] = {}    # There were no transmissions in the link
+        self.__server: Union[Popen, None] = None  # Scheduler server that executes the patches and optimizations
 
         # Init all the simulated nodes
         for node_id in self.__network.nodes_id:
@@ -124,6 +127,19 @@ class Simulation:
 
     # Auxiliary Functions #
 
+    def __request_server(self, request: List[str]) -> bool:
+        """
+        Send a request to the scheduler server and wait for its answer
+        :param request: command and files of the request, the same as the arguments of the executables
+        :return: true if the server found a schedule, false otherwise
+        """
+        self.__server.stdin.write('\t'.join(request) + '\n')
+        self.__server.stdin.flush()
+        answer = self.__server.stdout.readline().strip()
+        if answer.startswith('ERROR'):
+            raise ValueError('The scheduler server could not execute the request: ' + answer)
+        return answer == 'OK'
+
     def __prepare_simulation(self) -> None:
         """
         Prepare the simulation by adding all the simulation configuration read in the xml file to the events to
@@ -155,16 +171,16 @@ class Simulation:
         """
         if event.name is ExecutionEvent.ExecutionName.Patch:
 
-            # For all links in the new path, create the patching file and execute it
+            # For all links in the new path, create their patch and execute all of them in a single patch file
             size_schedule = []
+            patches_xml: List[Xml.Element] = []
+            patch_file = '../Files/Outputs/Patch_' + str(event.event_id) + '.xml'
+            patched_file = '../Files/Outputs/PatchedSchedule_' + str(event.event_id) + '.xml'
+            execution_file = '../Files/Outputs/Execution.xml'
             for link_it, link_id in enumerate(self.__new_path_links[event.event_id]):
                 size_schedule.append(0)
                 link = self.__network.get_link(link_id)
 
-                patch_file = '../Files/Outputs/Patch_' + str(event.event_id) + '_' + str(link_id) + '.xml'
-                patched_file = '../Files/Outputs/PatchedSchedule_' + str(event.event_id) + '_' + str(link_id) + '.xml'
-                execution_file = '../Files/Outputs/Execution.xml'
-
                 transmission_ranges: Dict[int, List[List[int]]] = {}
 
                 for frame_id, frame, offset in self.__network.get_offsets_by_link(event.event_id):
@@ -179,17 +195,16 @@ class Simulation:
                     bit_trans = self.__SIZE_CODE_INST + self.__SIZE_CODE_TRANS
                     size_schedule[link_it] += bit_trans * len(transmission_ranges[frame_id])
 
-                self.__write_patch_xml(patch_file, link, link_id, transmission_ranges)
-                run(['./../Files/Executables/Patch', patch_file, patched_file, execution_file])
+                patches_xml.append(self.__create_patch_xml(link, link_id, transmission_ranges))
 
-                self.__read_execution_time_xml(execution_file)
-                self.__patching_time[event.event_id][link_id] = self.__execution_time
-                remove(patch_file)
-                remove(execution_file)
+            # The links are patched in parallel, and the execution time of every link is read
+            self.__write_multi_patch_xml(patch_file, patches_xml)
+            self.__request_server(['Patch', patch_file, patched_file, execution_file, 'GapIndex', '0', 'Binary'])
 
-                if isfile(patched_file):
-                    pass
-                    remove(patched_file)
+            for link_id, execution_time in self.__read_links_execution_time_xml(execution_file).items():
+                self.__patching_time[event.event_id][link_id] = execution_time
+            remove(patch_file)
+            remove(execution_file)
 
             # We assume parallel patching execution
             time_patch = max(self.__patching_time[event.event_id].values()) + event.time
@@ -203,6 +218,14 @@ class Simulation:
 
         elif event.name is ExecutionEvent.ExecutionName.Optimize:
 
+            # The nodes already have the patched schedule, so only the transmissions that the optimization changed
+            # from it are distributed
+            patched_file = '../Files/Outputs/PatchedSchedule_' + str(event.event_id) + '.xml'
+            baseline = []
+            if isfile(patched_file):
+                self.__read_patched_schedule_binary(patched_file, event.event_id)
+                baseline = [patched_file]
+
             size_schedule = []
             # For all links in the new path, create the optimization file and execute it
             for link_it, link_id in enumerate(self.__new_path_links[event.event_id]):
@@ -221,12 +244,9 @@ class Simulation:
                                                                            self.__new_path_links[event.event_id],
                                                                            link_id)
 
-                    size_schedule[link_it] += self.__SIZE_CODE_FRAME_ID
-                    bit_trans = self.__SIZE_CODE_INST + self.__SIZE_CODE_TRANS
-                    size_schedule[link_it] += bit_trans * len(transmission_ranges[frame_id])
-
                 self.__write_optimize_xml(optimize_file, link, link_id, transmission_ranges)
-                run(['./../Files/Executables/Optimize', optimize_file, optimized_file, execution_file])
+                self.__request_server(['Optimize', optimize_file, optimized_file, execution_file, 'PatchStart',
+                                       'Delta', 'Indicator', '-'] + baseline)
 
                 self.__read_execution_time_xml(execution_file)
                 self.__optimize_time[event.event_id][link_id] = self.__execution_time
@@ -234,13 +254,16 @@ class Simulation:
                 remove(execution_file)
 
                 if isfile(optimized_file):
-                    self.__read_patched_schedule_xml(optimized_file, event.event_id)
+                    size_schedule[link_it] = self.__read_schedule_delta_binary(optimized_file, event.event_id)
                     remove(optimized_file)
 
                 else:
                     self.__no_schedule[event.event_id] = True
                     raise self.NoSchedule('Optimization step failed, no schedule found')
 
+            if isfile(patched_file):
+                remove(patched_file)
+
             # We assume parallel patching execution
             time_optimize = max(self.__optimize_time[event.event_id].values()) + event.time
             for node_it, patch_node_id in enumerate(self.__new_path[event.event_id][1:]):
@@ -590,6 +613,9 @@ class Simulation:
         Given the simulated nodes and its events, simulate all the executions
         :return: nothing
         """
+        # The scheduler server stays running during all the simulation, so every event does not start a new process
+        self.__server = Popen(['./../Files/Executables/Server'], stdin=PIPE, stdout=PIPE, universal_newlines=True)
+
         event, node_id = self.__select_next_event()
         # While there are events to simulate, keep simulating
         while event is not None:
@@ -607,6 +633,9 @@ class Simulation:
 
             event, node_id = self.__select_next_event()
 
+        self.__request_server(['Quit'])
+        self.__server.wait()
+
         # Test everything done was correct and there are no collisions in the schedule or the protocol bandwidth
         self.__test_link_usage()
         self.__network.check_schedule()
@@ -708,14 +737,13 @@ class Simulation:
                     Xml.SubElement(instance_xml, 'MinTransmission').text = str(transmission_ranges[instance][0])
                     Xml.SubElement(instance_xml, 'MaxTransmission').text = str(transmission_ranges[instance][1])
 
-    def __write_patch_xml(self, patch_file: str, link: Link, link_id: int, ranges: Dict[int, List[List[int]]]) -> None:
+    def __create_patch_xml(self, link: Link, link_id: int, ranges: Dict[int, List[List[int]]]) -> Xml.Element:
         """
-        For the given file, write the patch xml file for the scheduler to solve
-        :param patch_file: file and path of the patch file
+        Create the patch xml tree of a link for the scheduler to solve
         :param link: information of the link to patch
         :param link_id: link to patch
         :param ranges: dictionary with all the frame ids to add and its transmission ranges
-        :return: nothing
+        :return: the patch xml tree
         """
         top_xml = Xml.Element('Patch')
 
@@ -724,6 +752,19 @@ class Simulation:
         self.__write_patch_fixed_traffic_xml(Xml.SubElement(top_xml, 'FixedTraffic'), link_id)
         self.__write_patch_traffic_xml(Xml.SubElement(top_xml, 'Traffic'), link, link_id, ranges)
 
+        return top_xml
+
+    def __write_multi_patch_xml(self, patch_file: str, patches_xml: List[Xml.Element]) -> None:
+        """
+        For the given file, write the patch xml file of several links for the scheduler to solve at the same time
+        :param patch_file: file and path of the patch file
+        :param patches_xml: patch xml tree of every link
+        :return: nothing
+        """
+        top_xml = Xml.Element('MultiPatch')
+        for patch_xml in patches_xml:
+            top_xml.append(patch_xml)
+
         # Write the final file
         output_xml = minidom.parseString(Xml.tostring(top_xml)).toprettyxml(encoding="UTF-8", indent="    ")
         output_xml = output_xml.decode("utf-8")
@@ -969,6 +1010,96 @@ class Simulation:
                 frames[frame_id].set_offset_transmission_time(patched_link, instance, 0, transmission_time)
                 frames[frame_id].set_offset_ending_time(patched_link, instance, 0, ending_time)
 
+    def __read_patched_schedule_binary(self, patched_file: str, broken_link: int) -> None:
+        """
+        Read and save the patched or optimized schedule from a binary file
+        :param patched_file: file and path of the binary patched file
+        :param broken_link: broken link identifier
+        :return: nothing
+        """
+        with open(patched_file, 'rb') as file, mmap(file.fileno(), 0, access=ACCESS_READ) as schedule:
+            magic, version, kind, num_links = Network.BINARY_HEADER.unpack_from(schedule, 0)[:4]
+            if magic != Network.BINARY_MAGIC or version != Network.BINARY_VERSION or kind == 1:
+                raise ValueError('The file is not a binary patched schedule of a supported version')
+            position = Network.BINARY_HEADER.size
+
+            # Read all the transmissions of all the patched frames of every link and save them into the frame
+            frames = self.__network.frames
+            for _ in range(num_links):
+                patched_link, num_frames, _ = Network.BINARY_LINK.unpack_from(schedule, position)
+                position += Network.BINARY_LINK.size
+                for _ in range(num_frames):
+                    frame_id, _, num_instances, num_replicas, time, _ = Network.BINARY_OFFSET.unpack_from(schedule,
+                                                                                                          position)
+                    position += Network.BINARY_OFFSET.size
+                    transmissions = Struct('=%dq' % (num_instances * num_replicas)).unpack_from(schedule, position)
+                    position += 8 * num_instances * num_replicas
+
+                    frames[frame_id].add_offset(patched_link)
+                    frames[frame_id].prepare_link_offset(patched_link,
+                                                         frames[frame_id].offsets[broken_link].num_instances, 0)
+                    for instance in range(num_instances):
+                        transmission = transmissions[instance * num_replicas]
+                        transmission_time = transmission * self.__network.time_slot_size
+                        ending_time = (transmission + time - 1) * self.__network.time_slot_size
+
+                        frames[frame_id].set_offset_transmission_time(patched_link, instance, 0, transmission_time)
+                        frames[frame_id].set_offset_ending_time(patched_link, instance, 0, ending_time)
+
+    def __read_schedule_delta_binary(self, delta_file: str, broken_link: int) -> int:
+        """
+        Read the transmissions that changed from the patched schedule in a binary delta file and save them into the
+        frames, the frames that are not in a link yet are added to it
+        :param delta_file: file and path of the binary delta file
+        :param broken_link: broken link identifier
+        :return: size in bits of the changes to distribute
+        """
+        size = 0
+        with open(delta_file, 'rb') as file, mmap(file.fileno(), 0, access=ACCESS_READ) as schedule:
+            magic, version, kind, num_links = Network.BINARY_HEADER.unpack_from(schedule, 0)[:4]
+            if magic != Network.BINARY_MAGIC or version != Network.BINARY_VERSION or kind != 4:
+                raise ValueError('The file is not a binary delta schedule of a supported version')
+            position = Network.BINARY_HEADER.size
+
+            # Read the changed transmissions of the frames of every link and save them into the frame
+            frames = self.__network.frames
+            for _ in range(num_links):
+                patched_link, num_frames, _ = Network.BINARY_LINK.unpack_from(schedule, position)
+                position += Network.BINARY_LINK.size
+                for _ in range(num_frames):
+                    frame_id, _, num_instances, num_replicas, time, num_changes = \
+                        Network.BINARY_DELTA.unpack_from(schedule, position)
+                    position += Network.BINARY_DELTA.size
+
+                    # If all the transmissions changed they come in order, otherwise each one comes with its position
+                    if num_changes == num_instances * num_replicas:
+                        changes = list(enumerate(Struct('=%dq' % num_changes).unpack_from(schedule, position)))
+                        position += 8 * num_changes
+                    else:
+                        changes = []
+                        for _ in range(num_changes):
+                            transmission, _, transmission_time = Network.BINARY_CHANGE.unpack_from(schedule, position)
+                            changes.append((transmission, transmission_time))
+                            position += Network.BINARY_CHANGE.size
+                    size += self.__SIZE_CODE_FRAME_ID + (self.__SIZE_CODE_INST + self.__SIZE_CODE_TRANS) * num_changes
+
+                    if patched_link not in frames[frame_id].offsets.keys():
+                        frames[frame_id].add_offset(patched_link)
+                        frames[frame_id].prepare_link_offset(patched_link,
+                                                             frames[frame_id].offsets[broken_link].num_instances, 0)
+
+                    # The replicas are not used yet, only the first one of every instance is saved
+                    for transmission, transmission_time in changes:
+                        if transmission % num_replicas == 0:
+                            instance = transmission // num_replicas
+                            transmission_time *= self.__network.time_slot_size
+                            ending_time = transmission_time + (time - 1) * self.__network.time_slot_size
+                            frames[frame_id].set_offset_transmission_time(patched_link, instance, 0,
+                                                                          transmission_time)
+                            frames[frame_id].set_offset_ending_time(patched_link, instance, 0, ending_time)
+
+        return size
+
     def __read_execution_time_xml(self, execution_file: str) -> None:
         """
         Read the execution of the last algorithm called
@@ -979,3 +1110,17 @@ class Simulation:
         root_xml: Xml.Element = Xml.parse(execution_file).getroot()
 
         self.__execution_time = int(root_xml.find('Timing/ExecutionTime').text)
+
+    def __read_links_execution_time_xml(self, execution_file: str) -> Dict[int, int]:
+        """
+        Read the execution time of every link of the last patch with several links
+        :param execution_file: path and name of the execution file
+        :return: dictionary with the execution time of every link
+        """
+        # Open the xml file and get the root
+        root_xml: Xml.Element = Xml.parse(execution_file).getroot()
+
+        execution_times: Dict[int, int] = {}
+        for link_xml in root_xml.findall('Link'):  # type: Xml.Element
+            execution_times[int(link_xml.find('LinkID').text)] = int(link_xml.find('ExecutionTime').text)
+        return execution_times